@@ -0,0 +1,4 @@
+# Copy a proto file, enabling arena allocation of its messages.
+# Usage: cmake -DINPUT=<proto> -DOUTPUT=<proto> -P ProtoArena.cmake
+file(READ ${INPUT} PROTO_CONTENT)
+file(WRITE ${OUTPUT} "${PROTO_CONTENT}\noption cc_enable_arenas = true;\n")
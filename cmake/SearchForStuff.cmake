@@ -7,6 +7,7 @@ include (${gazebo_cmake_dir}/FindFreeimage.cmake)
 
 execute_process(COMMAND ${PKG_CONFIG_EXECUTABLE} --modversion protobuf
   OUTPUT_VARIABLE PROTOBUF_VERSION
+  OUTPUT_STRIP_TRAILING_WHITESPACE
   RESULT_VARIABLE protobuf_modversion_failed)
 
 ########################################
@@ -29,6 +30,14 @@ if (PROTOBUF_VERSION LESS 2.3.0)
   BUILD_ERROR("Incorrect version: Gazebo requires protobuf version 2.3.0 or greater")
 endif()
 
+# Protobuf 3 can allocate messages and their fields from arenas
+if (NOT PROTOBUF_VERSION VERSION_LESS 3.0.0)
+  message (STATUS "Protobuf arenas enabled")
+  set (HAVE_PROTOBUF_ARENA TRUE)
+else ()
+  set (HAVE_PROTOBUF_ARENA FALSE)
+endif ()
+
 ########################################
 # The Google Protobuf library for message generation + serialization
 find_package(Protobuf REQUIRED)
@@ -528,6 +537,19 @@ if (PKG_CONFIG_FOUND)
     BUILD_WARNING ("GNU Triangulation Surface library not found - Gazebo will not have CSG support.")
   endif ()
 
+  ########################################
+  # Find LZ4, used to compress transport messages
+  pkg_check_modules(lz4 liblz4)
+  if (lz4_FOUND)
+    message (STATUS "Looking for liblz4 - found")
+    set (HAVE_LZ4 TRUE)
+    include_directories(${lz4_INCLUDE_DIRS})
+    link_directories(${lz4_LIBRARY_DIRS})
+  else ()
+    set (HAVE_LZ4 FALSE)
+    BUILD_WARNING ("liblz4 not found - transport messages can only be compressed with zlib.")
+  endif ()
+
   #################################################
   # Find bullet
   # First and preferred option is to look for bullet standard pkgconfig,
@@ -18,11 +18,14 @@
 #include <functional>
 #include <thread>
 #include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <boost/bind.hpp>
 #include <boost/make_shared.hpp>
 #include <google/protobuf/descriptor.h>
-#include <set>
 #include "gazebo/transport/IOManager.hh"
 
 #include "Master.hh"
@@ -35,15 +38,35 @@ namespace gazebo
 {
   struct MasterPrivate
   {
-    /// \brief All the known publishers.
-    gazebo::Master::PubList publishers;
+    /// \brief All the known publishers, indexed by topic.
+    std::unordered_map<std::string, gazebo::Master::PubList> publishers;
+
+    /// \brief All the known subscribers, indexed by topic.
+    std::unordered_map<std::string, gazebo::Master::SubList> subscribers;
 
-    /// \brief All the known subscribers.
-    gazebo::Master::SubList subscribers;
+    /// \brief Topics advertised by each connection, indexed by
+    /// connection id.
+    std::unordered_map<unsigned int, std::set<std::string>>
+        connectionPublishers;
+
+    /// \brief Topics subscribed to by each connection, indexed by
+    /// connection id.
+    std::unordered_map<unsigned int, std::set<std::string>>
+        connectionSubscribers;
 
     /// \brief All the known connections.
     gazebo::Master::Connection_M connections;
 
+    /// \brief Index of the next accepted connection.
+    unsigned int nextConnectionIndex = 0;
+
+    /// \brief Publisher changes not yet sent to the connections.
+    msgs::Publishers pendingPublishers;
+
+    /// \brief Type of the pending publisher changes, "publishers_add" or
+    /// "publishers_del".
+    std::string pendingType;
+
     /// \brief All the worlds.
     std::list<std::string> worldNames;
 
@@ -116,29 +139,29 @@ void Master::OnAccept(transport::ConnectionPtr _newConnection)
   _newConnection->EnqueueMsg(msgs::Package("topic_namepaces_init",
                               namespacesMsg), true);
 
-  // Send all the publishers
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
+
+  // Send all the publishers. Changes are sent from now on, so those still
+  // pending go to the other connections first.
+  this->SendPublisherChanges();
   msgs::Publishers publishersMsg;
-  PubList::iterator pubiter;
-  for (pubiter = this->dataPtr->publishers.begin();
-       pubiter != this->dataPtr->publishers.end(); ++pubiter)
+  for (auto const &topic : this->dataPtr->publishers)
   {
-    msgs::Publish *pub = publishersMsg.add_publisher();
-    pub->CopyFrom(pubiter->first);
+    for (auto const &publisher : topic.second)
+      publishersMsg.add_publisher()->CopyFrom(publisher.first);
   }
   _newConnection->EnqueueMsg(
       msgs::Package("publishers_init", publishersMsg), true);
 
-  // Add the connection to our list
-  {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
-    int index = this->dataPtr->connections.size();
-
-    this->dataPtr->connections[index] = _newConnection;
+  // Add the connection to our list. Indices are not reused, so that
+  // messages read from a removed connection are never attributed to a new
+  // one.
+  unsigned int index = this->dataPtr->nextConnectionIndex++;
+  this->dataPtr->connections[index] = _newConnection;
 
-    // Start reading from the connection
-    _newConnection->AsyncRead(
-        boost::bind(&Master::OnRead, this, index, _1));
-  }
+  // Start reading from the connection
+  _newConnection->AsyncRead(
+      boost::bind(&Master::OnRead, this, index, _1));
 }
 
 //////////////////////////////////////////////////
@@ -148,12 +171,17 @@ void Master::OnRead(const unsigned int _connectionIndex,
   if (this->dataPtr->stop)
     return;
 
-  if (!this->dataPtr->connections[_connectionIndex] ||
-      !this->dataPtr->connections[_connectionIndex]->IsOpen())
-    return;
-
   // Get the connection
-  transport::ConnectionPtr conn = this->dataPtr->connections[_connectionIndex];
+  transport::ConnectionPtr conn;
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
+    auto iter = this->dataPtr->connections.find(_connectionIndex);
+    if (iter != this->dataPtr->connections.end())
+      conn = iter->second;
+  }
+
+  if (!conn || !conn->IsOpen())
+    return;
 
   // Read the next message
   if (conn && conn->IsOpen())
@@ -177,11 +205,14 @@ void Master::OnRead(const unsigned int _connectionIndex,
 void Master::SendSubscribers(const std::string &_topic,
                              const std::string &_buffer)
 {
+  auto topicIter = this->dataPtr->subscribers.find(_topic);
+  if (topicIter == this->dataPtr->subscribers.end())
+    return;
+
   // Find all subscribers for this topic
   std::set<transport::ConnectionPtr> uniqueConnections;
-  for (auto const &subscriber : this->dataPtr->subscribers)
-    if (subscriber.first.topic() == _topic)
-      uniqueConnections.insert(subscriber.second);
+  for (auto const &subscriber : topicIter->second)
+    uniqueConnections.insert(subscriber.second);
 
   // Send message to all unique connections
   for (auto &conn : uniqueConnections)
@@ -192,11 +223,14 @@ void Master::SendSubscribers(const std::string &_topic,
 void Master::ProcessMessage(const unsigned int _connectionIndex,
                             const std::string &_data)
 {
-  if (!this->dataPtr->connections[_connectionIndex] ||
-      !this->dataPtr->connections[_connectionIndex]->IsOpen())
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
+
+  auto connIter = this->dataPtr->connections.find(_connectionIndex);
+  if (connIter == this->dataPtr->connections.end() ||
+      !connIter->second || !connIter->second->IsOpen())
     return;
 
-  transport::ConnectionPtr conn = this->dataPtr->connections[_connectionIndex];
+  transport::ConnectionPtr conn = connIter->second;
 
   msgs::Packet packet;
   packet.ParseFromString(_data);
@@ -212,33 +246,22 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
                      worldNameMsg.data());
     if (iter == this->dataPtr->worldNames.end())
     {
-      std::lock_guard<std::recursive_mutex>
-          lock(this->dataPtr->connectionMutex);
       this->dataPtr->worldNames.push_back(worldNameMsg.data());
 
-      Connection_M::iterator iter2;
-      for (iter2 = this->dataPtr->connections.begin();
-          iter2 != this->dataPtr->connections.end(); ++iter2)
-      {
-        iter2->second->EnqueueMsg(
-            msgs::Package("topic_namespace_add", worldNameMsg));
-      }
+      std::string buffer = msgs::Package("topic_namespace_add", worldNameMsg);
+      for (auto const &connection : this->dataPtr->connections)
+        connection.second->EnqueueMsg(buffer);
     }
   }
   else if (packet.type() == "advertise")
   {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
     msgs::Publish pub;
     pub.ParseFromString(packet.serialized_data());
 
-    Connection_M::iterator iter2;
-    for (iter2 = this->dataPtr->connections.begin();
-         iter2 != this->dataPtr->connections.end(); ++iter2)
-    {
-      iter2->second->EnqueueMsg(msgs::Package("publisher_add", pub));
-    }
+    this->NotifyPublisher("publishers_add", pub);
 
-    this->dataPtr->publishers.push_back(std::make_pair(pub, conn));
+    this->dataPtr->publishers[pub.topic()].push_back(std::make_pair(pub, conn));
+    this->dataPtr->connectionPublishers[conn->GetId()].insert(pub.topic());
 
     this->SendSubscribers(pub.topic(),
         msgs::Package("publisher_advertise", pub));
@@ -260,17 +283,18 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
     msgs::Subscribe sub;
     sub.ParseFromString(packet.serialized_data());
 
-    this->dataPtr->subscribers.push_back(std::make_pair(sub, conn));
-
-    PubList::iterator iter;
+    this->dataPtr->subscribers[sub.topic()].push_back(
+        std::make_pair(sub, conn));
+    this->dataPtr->connectionSubscribers[conn->GetId()].insert(sub.topic());
 
-    // Find all publishers of the topic
-    for (iter = this->dataPtr->publishers.begin();
-        iter != this->dataPtr->publishers.end(); ++iter)
+    // Send all publishers of the topic
+    auto topicIter = this->dataPtr->publishers.find(sub.topic());
+    if (topicIter != this->dataPtr->publishers.end())
     {
-      if (iter->first.topic() == sub.topic())
+      for (auto const &publisher : topicIter->second)
       {
-        conn->EnqueueMsg(msgs::Package("publisher_subscribe", iter->first));
+        conn->EnqueueMsg(
+            msgs::Package("publisher_subscribe", publisher.first));
       }
     }
   }
@@ -282,12 +306,10 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
     if (req.request() == "get_publishers")
     {
       msgs::Publishers msg;
-      PubList::iterator iter;
-      for (iter = this->dataPtr->publishers.begin();
-          iter != this->dataPtr->publishers.end(); ++iter)
+      for (auto const &topic : this->dataPtr->publishers)
       {
-        msgs::Publish *pub = msg.add_publisher();
-        pub->CopyFrom(iter->first);
+        for (auto const &publisher : topic.second)
+          msg.add_publisher()->CopyFrom(publisher.first);
       }
       conn->EnqueueMsg(msgs::Package("publisher_list", msg), true);
     }
@@ -297,18 +319,12 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
       msgs::GzString_V msg;
 
       // Add all topics that are published
-      for (PubList::iterator iter = this->dataPtr->publishers.begin();
-          iter != this->dataPtr->publishers.end(); ++iter)
-      {
-        topics.insert(iter->first.topic());
-      }
+      for (auto const &topic : this->dataPtr->publishers)
+        topics.insert(topic.first);
 
       // Add all topics that are subscribed
-      for (SubList::iterator iter = this->dataPtr->subscribers.begin();
-           iter != this->dataPtr->subscribers.end(); ++iter)
-      {
-        topics.insert(iter->first.topic());
-      }
+      for (auto const &topic : this->dataPtr->subscribers)
+        topics.insert(topic.first);
 
       // Construct the message of only unique names
       for (std::set<std::string>::iterator iter =
@@ -326,33 +342,26 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
       msgs::TopicInfo ti;
       ti.set_msg_type(pub.msg_type());
 
-      PubList::iterator piter;
-      SubList::iterator siter;
-
       // Find all publishers of the topic
-      for (piter = this->dataPtr->publishers.begin();
-          piter != this->dataPtr->publishers.end(); ++piter)
+      auto pubIter = this->dataPtr->publishers.find(req.data());
+      if (pubIter != this->dataPtr->publishers.end())
       {
-        if (piter->first.topic() == req.data())
-        {
-          msgs::Publish *pubPtr = ti.add_publisher();
-          pubPtr->CopyFrom(piter->first);
-        }
+        for (auto const &publisher : pubIter->second)
+          ti.add_publisher()->CopyFrom(publisher.first);
       }
 
       // Find all subscribers of the topic
-      for (siter = this->dataPtr->subscribers.begin();
-          siter != this->dataPtr->subscribers.end(); ++siter)
+      auto subIter = this->dataPtr->subscribers.find(req.data());
+      if (subIter != this->dataPtr->subscribers.end())
       {
-        if (siter->first.topic() == req.data())
+        for (auto const &subscriber : subIter->second)
         {
           // If the topic info message type has not been set or the
           // topic info message type is an empty string, then set the topic
           // info message type based on a subscriber's message type.
           if (!ti.has_msg_type() || ti.msg_type().empty())
-            ti.set_msg_type(siter->first.msg_type());
-          msgs::Subscribe *sub = ti.add_subscriber();
-          sub->CopyFrom(siter->first);
+            ti.set_msg_type(subscriber.first.msg_type());
+          ti.add_subscriber()->CopyFrom(subscriber.first);
         }
       }
 
@@ -414,6 +423,10 @@ void Master::RunOnce()
   // Process all the connections
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
+
+    // Publishers advertised or removed by the processed messages
+    this->SendPublisherChanges();
+
     for (iter = this->dataPtr->connections.begin();
         iter != this->dataPtr->connections.end();)
     {
@@ -427,9 +440,39 @@ void Master::RunOnce()
         this->RemoveConnection(iter++);
       }
     }
+
+    // Publishers of removed connections
+    this->SendPublisherChanges();
   }
 }
 
+/////////////////////////////////////////////////
+void Master::NotifyPublisher(const std::string &_type,
+                             const msgs::Publish &_pub)
+{
+  // Changes are sent in order, so a new batch starts when the type of
+  // change differs from the pending one.
+  if (_type != this->dataPtr->pendingType)
+    this->SendPublisherChanges();
+
+  this->dataPtr->pendingType = _type;
+  this->dataPtr->pendingPublishers.add_publisher()->CopyFrom(_pub);
+}
+
+/////////////////////////////////////////////////
+void Master::SendPublisherChanges()
+{
+  if (this->dataPtr->pendingPublishers.publisher_size() == 0)
+    return;
+
+  std::string buffer = msgs::Package(this->dataPtr->pendingType,
+      this->dataPtr->pendingPublishers);
+  for (auto const &connection : this->dataPtr->connections)
+    connection.second->EnqueueMsg(buffer);
+
+  this->dataPtr->pendingPublishers.Clear();
+}
+
 /////////////////////////////////////////////////
 void Master::RemoveConnection(Connection_M::iterator _connIter)
 {
@@ -451,44 +494,53 @@ void Master::RemoveConnection(Connection_M::iterator _connIter)
     }
   }
 
+  unsigned int id = _connIter->second->GetId();
+
   // Remove all publishers for this connection
-  bool done = false;
-  while (!done)
+  auto pubTopics = this->dataPtr->connectionPublishers.find(id);
+  if (pubTopics != this->dataPtr->connectionPublishers.end())
   {
-    done = true;
-    PubList::iterator pubIter = this->dataPtr->publishers.begin();
-    while (pubIter != this->dataPtr->publishers.end())
+    // Copy, since removing a publisher updates the index
+    std::set<std::string> topics = pubTopics->second;
+    for (auto const &topic : topics)
     {
-      if ((*pubIter).second->GetId() == _connIter->second->GetId())
+      auto topicIter = this->dataPtr->publishers.find(topic);
+      if (topicIter == this->dataPtr->publishers.end())
+        continue;
+
+      std::vector<msgs::Publish> pubs;
+      for (auto const &publisher : topicIter->second)
       {
-        this->RemovePublisher((*pubIter).first);
-        done = false;
-        break;
+        if (publisher.second->GetId() == id)
+          pubs.push_back(publisher.first);
       }
-      else
-        ++pubIter;
+      for (auto const &pub : pubs)
+        this->RemovePublisher(pub);
     }
+    this->dataPtr->connectionPublishers.erase(id);
   }
 
-
-  done = false;
-  while (!done)
+  // Remove all subscribers for this connection
+  auto subTopics = this->dataPtr->connectionSubscribers.find(id);
+  if (subTopics != this->dataPtr->connectionSubscribers.end())
   {
-    done = true;
-
-    // Remove all subscribers for this connection
-    SubList::iterator subIter = this->dataPtr->subscribers.begin();
-    while (subIter != this->dataPtr->subscribers.end())
+    std::set<std::string> topics = subTopics->second;
+    for (auto const &topic : topics)
     {
-      if ((*subIter).second->GetId() == _connIter->second->GetId())
+      auto topicIter = this->dataPtr->subscribers.find(topic);
+      if (topicIter == this->dataPtr->subscribers.end())
+        continue;
+
+      std::vector<msgs::Subscribe> subs;
+      for (auto const &subscriber : topicIter->second)
       {
-        this->RemoveSubscriber((*subIter).first);
-        done = false;
-        break;
+        if (subscriber.second->GetId() == id)
+          subs.push_back(subscriber.first);
       }
-      else
-        ++subIter;
+      for (auto const &sub : subs)
+        this->RemoveSubscriber(sub);
     }
+    this->dataPtr->connectionSubscribers.erase(id);
   }
 
   this->dataPtr->connections.erase(_connIter);
@@ -499,56 +551,88 @@ void Master::RemovePublisher(const msgs::Publish _pub)
 {
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
-    Connection_M::iterator iter2;
-    for (iter2 = this->dataPtr->connections.begin();
-        iter2 != this->dataPtr->connections.end(); ++iter2)
-    {
-      iter2->second->EnqueueMsg(msgs::Package("publisher_del", _pub));
-    }
+    this->NotifyPublisher("publishers_del", _pub);
   }
 
   this->SendSubscribers(_pub.topic(), msgs::Package("unadvertise", _pub));
 
-  PubList::iterator pubIter = this->dataPtr->publishers.begin();
-  while (pubIter != this->dataPtr->publishers.end())
+  auto topicIter = this->dataPtr->publishers.find(_pub.topic());
+  if (topicIter == this->dataPtr->publishers.end())
+    return;
+
+  PubList &pubs = topicIter->second;
+  std::set<unsigned int> removed;
+  PubList::iterator pubIter = pubs.begin();
+  while (pubIter != pubs.end())
   {
-    if (pubIter->first.topic() == _pub.topic() &&
-        pubIter->first.host() == _pub.host() &&
+    if (pubIter->first.host() == _pub.host() &&
         pubIter->first.port() == _pub.port())
     {
-      pubIter = this->dataPtr->publishers.erase(pubIter);
+      removed.insert(pubIter->second->GetId());
+      pubIter = pubs.erase(pubIter);
     }
     else
       ++pubIter;
   }
+
+  // Update the topics of the connections that no longer advertise it
+  for (auto const &pub : pubs)
+    removed.erase(pub.second->GetId());
+  for (auto const &id : removed)
+  {
+    auto connTopics = this->dataPtr->connectionPublishers.find(id);
+    if (connTopics != this->dataPtr->connectionPublishers.end())
+      connTopics->second.erase(_pub.topic());
+  }
+
+  if (pubs.empty())
+    this->dataPtr->publishers.erase(topicIter);
 }
 
 /////////////////////////////////////////////////
 void Master::RemoveSubscriber(const msgs::Subscribe _sub)
 {
   // Find all publishers of the topic, and remove the subscriptions
-  for (PubList::iterator iter = this->dataPtr->publishers.begin();
-      iter != this->dataPtr->publishers.end(); ++iter)
+  auto pubIter = this->dataPtr->publishers.find(_sub.topic());
+  if (pubIter != this->dataPtr->publishers.end())
   {
-    if (iter->first.topic() == _sub.topic())
-    {
-      iter->second->EnqueueMsg(msgs::Package("unsubscribe", _sub));
-    }
+    std::string buffer = msgs::Package("unsubscribe", _sub);
+    for (auto const &publisher : pubIter->second)
+      publisher.second->EnqueueMsg(buffer);
   }
 
+  auto topicIter = this->dataPtr->subscribers.find(_sub.topic());
+  if (topicIter == this->dataPtr->subscribers.end())
+    return;
+
   // Remove the subscribers from our list
-  SubList::iterator subiter = this->dataPtr->subscribers.begin();
-  while (subiter != this->dataPtr->subscribers.end())
+  SubList &subs = topicIter->second;
+  std::set<unsigned int> removed;
+  SubList::iterator subIter = subs.begin();
+  while (subIter != subs.end())
   {
-    if (subiter->first.topic() == _sub.topic() &&
-        subiter->first.host() == _sub.host() &&
-        subiter->first.port() == _sub.port())
+    if (subIter->first.host() == _sub.host() &&
+        subIter->first.port() == _sub.port())
     {
-      subiter = this->dataPtr->subscribers.erase(subiter);
+      removed.insert(subIter->second->GetId());
+      subIter = subs.erase(subIter);
     }
     else
-      ++subiter;
+      ++subIter;
   }
+
+  // Update the topics of the connections that no longer subscribe to it
+  for (auto const &sub : subs)
+    removed.erase(sub.second->GetId());
+  for (auto const &id : removed)
+  {
+    auto connTopics = this->dataPtr->connectionSubscribers.find(id);
+    if (connTopics != this->dataPtr->connectionSubscribers.end())
+      connTopics->second.erase(_sub.topic());
+  }
+
+  if (subs.empty())
+    this->dataPtr->subscribers.erase(topicIter);
 }
 
 //////////////////////////////////////////////////
@@ -581,6 +665,9 @@ void Master::Fini()
   this->dataPtr->connections.clear();
   this->dataPtr->subscribers.clear();
   this->dataPtr->publishers.clear();
+  this->dataPtr->connectionSubscribers.clear();
+  this->dataPtr->connectionPublishers.clear();
+  this->dataPtr->pendingPublishers.Clear();
 }
 
 //////////////////////////////////////////////////
@@ -588,18 +675,10 @@ msgs::Publish Master::GetPublisher(const std::string &_topic)
 {
   msgs::Publish msg;
 
-  PubList::iterator iter;
-
-  // Find all publishers of the topic
-  for (iter = this->dataPtr->publishers.begin();
-       iter != this->dataPtr->publishers.end(); ++iter)
-  {
-    if (iter->first.topic() == _topic)
-    {
-      msg = iter->first;
-      break;
-    }
-  }
+  // Get the first publisher of the topic
+  auto iter = this->dataPtr->publishers.find(_topic);
+  if (iter != this->dataPtr->publishers.end() && !iter->second.empty())
+    msg = iter->second.front().first;
 
   return msg;
 }
@@ -128,6 +128,17 @@ namespace gazebo
     /// remove a subscriber.
     private: void RemoveSubscriber(const msgs::Subscribe _sub);
 
+    /// \brief Queue a change of publisher for all the connections. Changes
+    /// are sent in batches by SendPublisherChanges.
+    /// \param[in] _type Type of change, "publishers_add" or
+    /// "publishers_del".
+    /// \param[in] _pub The publisher that changed.
+    private: void NotifyPublisher(const std::string &_type,
+                                  const msgs::Publish &_pub);
+
+    /// \brief Send the queued publisher changes to all the connections.
+    private: void SendPublisherChanges();
+
     /// \internal
     /// \brief Pointer to private data.
     private: std::unique_ptr<MasterPrivate> dataPtr;
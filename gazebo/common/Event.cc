@@ -15,6 +15,9 @@
  *
  */
 
+#include <atomic>
+#include <cmath>
+
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Event.hh"
 
@@ -75,3 +78,75 @@ int Connection::Id() const
 {
   return this->id;
 }
+
+//////////////////////////////////////////////////
+UpdateThrottle::UpdateThrottle(const double _rate, const double _phase)
+{
+  if (_rate > 0)
+    this->period = 1.0 / _rate;
+
+  if (_phase < 0)
+    this->phase = NextPhase();
+  else
+    this->phase = _phase - std::floor(_phase);
+}
+
+//////////////////////////////////////////////////
+double UpdateThrottle::Rate() const
+{
+  return this->period > 0 ? 1.0 / this->period : 0.0;
+}
+
+//////////////////////////////////////////////////
+double UpdateThrottle::Phase() const
+{
+  return this->phase;
+}
+
+//////////////////////////////////////////////////
+bool UpdateThrottle::Due(const common::Time &_simTime)
+{
+  if (this->period <= 0)
+    return true;
+
+  // Tolerance for floating point slot times, as a fraction of the period
+  const double eps = 1e-6;
+  const double t = _simTime.Double();
+
+  // Align to the first slot at or after the current time
+  if (!this->started || t < this->last)
+  {
+    double slot = std::ceil(t / this->period - this->phase - eps);
+    this->next = (slot + this->phase) * this->period;
+    this->started = true;
+  }
+  this->last = t;
+
+  if (t < this->next - eps * this->period)
+    return false;
+
+  // Schedule the slot after the current one, dropping any that were missed
+  // because the step size is larger than the period.
+  double slot = std::floor(t / this->period - this->phase + eps) + 1;
+  this->next = (slot + this->phase) * this->period;
+  return true;
+}
+
+//////////////////////////////////////////////////
+double UpdateThrottle::NextPhase()
+{
+  static std::atomic<unsigned int> counter(0);
+
+  // Van der Corput sequence in base 2: reverse the bits of the counter
+  unsigned int n = counter++;
+  double result = 0;
+  double base = 0.5;
+  while (n)
+  {
+    if (n & 1u)
+      result += base;
+    n >>= 1;
+    base *= 0.5;
+  }
+  return result;
+}
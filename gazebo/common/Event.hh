@@ -27,6 +27,8 @@
 #include <gazebo/gazebo_config.h>
 #include <gazebo/common/Time.hh>
 #include <gazebo/common/CommonTypes.hh>
+#include <gazebo/common/PluginProfiler.hh>
+#include <gazebo/common/UpdateInfo.hh>
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -92,6 +94,58 @@ namespace gazebo
       public: template<typename T> friend class EventT;
     };
 
+    /// \class UpdateThrottle Event.hh common/common.hh
+    /// \brief Decides on which simulation steps a rate limited event
+    /// connection is due. Each connection fires on the first step at or
+    /// after the slots `(k + phase) / rate` of simulation time, missed slots
+    /// are dropped rather than queued.
+    class GZ_COMMON_VISIBLE UpdateThrottle
+    {
+      /// \brief Constructor.
+      /// \param[in] _rate Target rate in Hz of simulation time, 0 or
+      /// negative to fire on every step.
+      /// \param[in] _phase Offset of the slots as a fraction of the period,
+      /// in [0, 1). Use a negative value to have it assigned by NextPhase.
+      public: UpdateThrottle(const double _rate, const double _phase);
+
+      /// \brief Get the target rate.
+      /// \return Rate in Hz, 0 if unthrottled.
+      public: double Rate() const;
+
+      /// \brief Get the phase.
+      /// \return Offset as a fraction of the period, in [0, 1).
+      public: double Phase() const;
+
+      /// \brief Check whether the connection is due, and if so schedule the
+      /// next slot. Simulation time going backwards, as after a world reset,
+      /// restarts the schedule.
+      /// \param[in] _simTime Current simulation time.
+      /// \return True if the callback should be called on this step.
+      public: bool Due(const common::Time &_simTime);
+
+      /// \brief Get the next phase of a process wide low discrepancy
+      /// sequence (0, 1/2, 1/4, 3/4, 1/8, ...), so that connections with
+      /// the same rate are spread evenly over their period whatever their
+      /// number.
+      /// \return Phase in [0, 1).
+      public: static double NextPhase();
+
+      /// \brief Period in seconds, 0 if unthrottled.
+      private: double period = 0;
+
+      /// \brief Phase as a fraction of the period.
+      private: double phase = 0;
+
+      /// \brief Simulation time of the next slot in seconds.
+      private: double next = 0;
+
+      /// \brief Simulation time of the previous check in seconds.
+      private: double last = 0;
+
+      /// \brief False until the first check.
+      private: bool started = false;
+    };
+
     /// \brief A class for event processing.
     template<typename T>
     class EventT : public Event
@@ -108,11 +162,27 @@ namespace gazebo
       /// Disconnect when it goes out of scope.
       public: ConnectionPtr Connect(const std::function<T> &_subscriber);
 
+      /// \brief Connect a rate limited callback to this event. The event
+      /// skips the callback on the steps where it is not due, without
+      /// calling it. Only events whose single argument is a
+      /// common::UpdateInfo can be throttled, the rate is ignored otherwise.
+      /// \param[in] _subscriber Pointer to a callback function.
+      /// \param[in] _rate Target rate in Hz of simulation time, 0 or
+      /// negative to call it on every signal.
+      /// \param[in] _phase Offset as a fraction of the period in [0, 1).
+      /// Negative values pick a phase which spreads the connections evenly.
+      /// \return A Connection object, which will automatically call
+      /// Disconnect when it goes out of scope.
+      /// \sa UpdateThrottle
+      public: ConnectionPtr Connect(const std::function<T> &_subscriber,
+                  const double _rate, const double _phase = -1.0);
+
       /// \brief Disconnect a callback to this event.
       /// \param[in] _id The id of the connection to disconnect.
       public: virtual void Disconnect(int _id);
 
-      /// \brief Get the number of connections.
+      /// \brief Get the number of connections, not counting the
+      /// disconnected ones which are still waiting to be removed.
       /// \return Number of connection to this Event.
       public: unsigned int ConnectionCount() const;
 
@@ -274,7 +344,7 @@ namespace gazebo
         for (const auto &iter: this->connections)
         {
           if (iter.second->on)
-            iter.second->callback();
+            iter.second->Invoke();
         }
       }
 
@@ -289,7 +359,7 @@ namespace gazebo
         for (const auto &iter: this->connections)
         {
           if (iter.second->on)
-            iter.second->callback(_p);
+            iter.second->Invoke(_p);
         }
       }
 
@@ -305,7 +375,7 @@ namespace gazebo
         for (const auto &iter: this->connections)
         {
           if (iter.second->on)
-            iter.second->callback(_p1, _p2);
+            iter.second->Invoke(_p1, _p2);
         }
       }
 
@@ -322,7 +392,7 @@ namespace gazebo
         for (const auto &iter: this->connections)
         {
           if (iter.second->on)
-            iter.second->callback(_p1, _p2, _p3);
+            iter.second->Invoke(_p1, _p2, _p3);
         }
       }
 
@@ -341,7 +411,7 @@ namespace gazebo
         for (const auto &iter: this->connections)
         {
           if (iter.second->on)
-            iter.second->callback(_p1, _p2, _p3, _p4);
+            iter.second->Invoke(_p1, _p2, _p3, _p4);
         }
       }
 
@@ -362,7 +432,7 @@ namespace gazebo
         for (const auto &iter: this->connections)
         {
           if (iter.second->on)
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5);
+            iter.second->Invoke(_p1, _p2, _p3, _p4, _p5);
         }
       }
 
@@ -384,7 +454,7 @@ namespace gazebo
         for (const auto &iter: this->connections)
         {
           if (iter.second->on)
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6);
+            iter.second->Invoke(_p1, _p2, _p3, _p4, _p5, _p6);
         }
       }
 
@@ -407,7 +477,7 @@ namespace gazebo
         for (const auto &iter: this->connections)
         {
           if (iter.second->on)
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7);
+            iter.second->Invoke(_p1, _p2, _p3, _p4, _p5, _p6, _p7);
         }
       }
 
@@ -433,7 +503,7 @@ namespace gazebo
         {
           if (iter.second->on)
           {
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
+            iter.second->Invoke(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
           }
         }
       }
@@ -462,7 +532,7 @@ namespace gazebo
         {
           if (iter.second->on)
           {
-            iter.second->callback(
+            iter.second->Invoke(
                 _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9);
           }
         }
@@ -493,7 +563,7 @@ namespace gazebo
         {
           if (iter.second->on)
           {
-            iter.second->callback(
+            iter.second->Invoke(
                 _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9, _p10);
           }
         }
@@ -516,11 +586,55 @@ namespace gazebo
           this->on = _on;
         }
 
+        /// \brief Call the callback function, recording its wall time if
+        /// the connection belongs to a plugin.
+        /// \param[in] _args Arguments of the callback.
+        public: template<typename ...Args>
+                void Invoke(const Args &... _args)
+        {
+          if (!this->Due(_args...))
+            return;
+
+          if (!this->stats)
+          {
+            this->callback(_args...);
+            return;
+          }
+
+          common::PluginTimer timer(this->stats.get());
+          this->callback(_args...);
+        }
+
+        /// \brief Check whether a throttled callback is due. Only events
+        /// which carry a common::UpdateInfo can be throttled.
+        /// \return Always true.
+        public: template<typename ...Args>
+                bool Due(const Args &...)
+        {
+          return true;
+        }
+
+        /// \brief Check whether a throttled callback is due.
+        /// \param[in] _info Update info of the current iteration.
+        /// \return True if the callback should be called.
+        public: bool Due(const common::UpdateInfo &_info)
+        {
+          return !this->throttle || this->throttle->Due(_info.simTime);
+        }
+
         /// \brief On/off value for the event callback
         public: std::atomic_bool on;
 
         /// \brief Callback function
         public: std::function<T> callback;
+
+        /// \brief Update time stats of the plugin which created the
+        /// connection, null if it wasn't created by a plugin.
+        public: std::shared_ptr<common::PluginTimeStats> stats;
+
+        /// \brief Rate limit of the callback, null if it is called on every
+        /// signal.
+        public: std::unique_ptr<UpdateThrottle> throttle;
       };
 
       /// \def EvtConnectionMap
@@ -564,15 +678,36 @@ namespace gazebo
         index = iter->first + 1;
       }
       this->connections[index].reset(new EventConnection(true, _subscriber));
+      this->connections[index]->stats =
+          common::PluginProfiler::Instance()->CurrentStats();
       return ConnectionPtr(new Connection(this, index));
     }
 
+    template<typename T>
+    ConnectionPtr EventT<T>::Connect(const std::function<T> &_subscriber,
+        const double _rate, const double _phase)
+    {
+      ConnectionPtr result = this->Connect(_subscriber);
+      if (_rate > 0)
+      {
+        this->connections[result->Id()]->throttle.reset(
+            new UpdateThrottle(_rate, _phase));
+      }
+      return result;
+    }
+
     /// \brief Get the number of connections.
     /// \return Number of connections.
     template<typename T>
     unsigned int EventT<T>::ConnectionCount() const
     {
-      return this->connections.size();
+      unsigned int count = 0;
+      for (auto const &conn : this->connections)
+      {
+        if (conn.second->on)
+          ++count;
+      }
+      return count;
     }
 
     /// \brief Removes a connection.
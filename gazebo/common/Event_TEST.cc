@@ -15,10 +15,13 @@
  *
 */
 
+#include <algorithm>
 #include <functional>
+#include <vector>
 #include <gtest/gtest.h>
 #include <gazebo/common/Time.hh>
 #include <gazebo/common/Event.hh>
+#include <gazebo/common/UpdateInfo.hh>
 #include "test/util.hh"
 
 using namespace gazebo;
@@ -123,12 +126,15 @@ TEST_F(EventTest, Disconnect)
 
   event::EventT<void ()> evt;
   event::ConnectionPtr conn = evt.Connect(std::bind(&callback));
+  EXPECT_EQ(evt.ConnectionCount(), 1u);
 
   conn.reset();
+  EXPECT_EQ(evt.ConnectionCount(), 0u);
 
   evt();
 
   EXPECT_EQ(g_callback, 0);
+  EXPECT_EQ(evt.ConnectionCount(), 0u);
 }
 
 /////////////////////////////////////////////////
@@ -220,6 +226,92 @@ TEST_F(EventTest, ManyChanges)
   EXPECT_EQ(g_callback1, 2);
 }
 
+/////////////////////////////////////////////////
+TEST_F(EventTest, UpdateThrottle)
+{
+  // 100 Hz with a phase of half a period
+  event::UpdateThrottle throttle(100, 0.5);
+  EXPECT_DOUBLE_EQ(throttle.Rate(), 100.0);
+  EXPECT_DOUBLE_EQ(throttle.Phase(), 0.5);
+
+  // 1 kHz steps over one second, due at 0.005, 0.015, ...
+  int due = 0;
+  for (int i = 1; i <= 1000; ++i)
+  {
+    if (throttle.Due(common::Time(i * 0.001)))
+    {
+      ++due;
+      EXPECT_EQ(i % 10, 5) << i;
+    }
+  }
+  EXPECT_EQ(due, 100);
+
+  // Steps longer than the period don't accumulate missed slots
+  event::UpdateThrottle slow(100, 0.0);
+  due = 0;
+  for (int i = 1; i <= 10; ++i)
+    due += slow.Due(common::Time(i * 0.05)) ? 1 : 0;
+  EXPECT_EQ(due, 10);
+
+  // Going back in time restarts the schedule
+  EXPECT_TRUE(slow.Due(common::Time(0.0)));
+  EXPECT_FALSE(slow.Due(common::Time(0.001)));
+  EXPECT_TRUE(slow.Due(common::Time(0.01)));
+
+  // Unthrottled
+  event::UpdateThrottle always(0, 0);
+  EXPECT_DOUBLE_EQ(always.Rate(), 0.0);
+  EXPECT_TRUE(always.Due(common::Time(0.001)));
+  EXPECT_TRUE(always.Due(common::Time(0.001)));
+}
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, UpdateThrottlePhases)
+{
+  // Any 8 consecutive automatic phases fall in distinct eighths of the
+  // period
+  std::vector<int> eighths;
+  for (int i = 0; i < 8; ++i)
+  {
+    event::UpdateThrottle throttle(50, -1);
+    EXPECT_GE(throttle.Phase(), 0.0);
+    EXPECT_LT(throttle.Phase(), 1.0);
+    eighths.push_back(static_cast<int>(throttle.Phase() * 8));
+  }
+  std::sort(eighths.begin(), eighths.end());
+  for (int i = 0; i < 8; ++i)
+    EXPECT_EQ(eighths[i], i);
+}
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, ThrottledConnection)
+{
+  event::EventT<void (const common::UpdateInfo &)> evt;
+  int fast = 0;
+  int slow = 0;
+  event::ConnectionPtr fastConn = evt.Connect(
+      [&fast](const common::UpdateInfo &) {++fast;});
+  event::ConnectionPtr slowConn = evt.Connect(
+      [&slow](const common::UpdateInfo &) {++slow;}, 50);
+
+  common::UpdateInfo info;
+  for (int i = 1; i <= 1000; ++i)
+  {
+    info.simTime = common::Time(i * 0.001);
+    evt(info);
+  }
+  EXPECT_EQ(fast, 1000);
+  EXPECT_EQ(slow, 50);
+
+  // The rate is ignored by events which don't carry an UpdateInfo
+  event::EventT<void (int)> other;
+  event::ConnectionPtr otherConn = other.Connect(
+      [&fast](int _i) {fast += _i;}, 50);
+  other(1);
+  other(1);
+  EXPECT_EQ(fast, 1002);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -108,6 +108,22 @@ namespace gazebo
               static ConnectionPtr ConnectWorldUpdateBegin(T _subscriber)
               { return worldUpdateBegin.Connect(_subscriber); }
 
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief Connect a rate limited callback to the world update start
+      /// signal. The callback is skipped on the iterations where it is not
+      /// due, which is cheaper than checking the time inside the callback.
+      /// \param[in] _subscriber the subscriber to this event
+      /// \param[in] _rate target update rate in Hz of simulation time, 0 to
+      /// update on every iteration
+      /// \param[in] _phase offset as a fraction of the period in [0, 1), or
+      /// negative to spread the callbacks evenly over the period
+      /// \return a connection
+      /// \sa UpdateThrottle
+      public: template<typename T>
+              static ConnectionPtr ConnectWorldUpdateBegin(T _subscriber,
+                  const double _rate, const double _phase = -1.0)
+              { return worldUpdateBegin.Connect(_subscriber, _rate, _phase); }
+
       //////////////////////////////////////////////////////////////////////////
       /// \brief Connect a callback to the before physics update signal
       /// \param[in] _subscriber the subscriber to this event
@@ -120,6 +136,23 @@ namespace gazebo
               static ConnectionPtr ConnectBeforePhysicsUpdate(T _subscriber)
               { return beforePhysicsUpdate.Connect(_subscriber); }
 
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief Connect a rate limited callback to the before physics update
+      /// signal.
+      /// \param[in] _subscriber the subscriber to this event
+      /// \param[in] _rate target update rate in Hz of simulation time, 0 to
+      /// update on every iteration
+      /// \param[in] _phase offset as a fraction of the period in [0, 1), or
+      /// negative to spread the callbacks evenly over the period
+      /// \return a connection
+      /// \sa ConnectWorldUpdateBegin(T, double, double)
+      public: template<typename T>
+              static ConnectionPtr ConnectBeforePhysicsUpdate(T _subscriber,
+                  const double _rate, const double _phase = -1.0)
+              {
+                return beforePhysicsUpdate.Connect(_subscriber, _rate, _phase);
+              }
+
       //////////////////////////////////////////////////////////////////////////
       /// \brief Connect a callback to the world update end signal
       /// \param[in] _subscriber the subscriber to this event
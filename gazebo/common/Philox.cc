@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cmath>
+
+#include "gazebo/common/Philox.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Multipliers of the Philox4x32 rounds.
+static const uint32_t kPhiloxM0 = 0xD2511F53;
+static const uint32_t kPhiloxM1 = 0xCD9E8D57;
+
+/// \brief Weyl sequence increments of the Philox4x32 keys.
+static const uint32_t kPhiloxW0 = 0x9E3779B9;
+static const uint32_t kPhiloxW1 = 0xBB67AE85;
+
+/// \brief 2 pi.
+static const double kTwoPi = 6.283185307179586476925286766559;
+
+//////////////////////////////////////////////////
+/// \brief Compute a Philox4x32-10 block.
+/// \param[in] _counter Index of the block, the high words of the counter
+/// are zero.
+/// \param[in] _seed Key.
+/// \param[out] _out Random bits.
+static inline void PhiloxBlock(const uint64_t _counter, const uint64_t _seed,
+    uint32_t _out[4])
+{
+  uint32_t c0 = static_cast<uint32_t>(_counter);
+  uint32_t c1 = static_cast<uint32_t>(_counter >> 32);
+  uint32_t c2 = 0;
+  uint32_t c3 = 0;
+  uint32_t k0 = static_cast<uint32_t>(_seed);
+  uint32_t k1 = static_cast<uint32_t>(_seed >> 32);
+
+  for (int round = 0; round < 10; ++round)
+  {
+    if (round > 0)
+    {
+      k0 += kPhiloxW0;
+      k1 += kPhiloxW1;
+    }
+
+    const uint64_t p0 = static_cast<uint64_t>(kPhiloxM0) * c0;
+    const uint64_t p1 = static_cast<uint64_t>(kPhiloxM1) * c2;
+    c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+    c1 = static_cast<uint32_t>(p1);
+    c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+    c3 = static_cast<uint32_t>(p0);
+  }
+
+  _out[0] = c0;
+  _out[1] = c1;
+  _out[2] = c2;
+  _out[3] = c3;
+}
+
+//////////////////////////////////////////////////
+/// \brief Convert 64 random bits to a double in (0, 1).
+/// \param[in] _hi High bits.
+/// \param[in] _lo Low bits.
+/// \return The double.
+static inline double ToUniform(const uint32_t _hi, const uint32_t _lo)
+{
+  const uint64_t bits =
+    ((static_cast<uint64_t>(_hi) << 32) | _lo) >> 11;
+  return (static_cast<double>(bits) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+//////////////////////////////////////////////////
+Philox::Philox(const uint64_t _seed)
+  : seed(_seed)
+{
+}
+
+//////////////////////////////////////////////////
+void Philox::SetSeed(const uint64_t _seed)
+{
+  this->seed = _seed;
+  this->counter = 0;
+}
+
+//////////////////////////////////////////////////
+uint64_t Philox::Seed() const
+{
+  return this->seed;
+}
+
+//////////////////////////////////////////////////
+void Philox::SetCounter(const uint64_t _counter)
+{
+  this->counter = _counter;
+}
+
+//////////////////////////////////////////////////
+uint64_t Philox::Counter() const
+{
+  return this->counter;
+}
+
+//////////////////////////////////////////////////
+void Philox::Next(uint32_t _out[4])
+{
+  PhiloxBlock(this->counter++, this->seed, _out);
+}
+
+//////////////////////////////////////////////////
+void Philox::Uniform(double *_out, const size_t _count)
+{
+  uint32_t block[4];
+  size_t i = 0;
+  for (; i + 1 < _count; i += 2)
+  {
+    PhiloxBlock(this->counter++, this->seed, block);
+    _out[i] = ToUniform(block[0], block[1]);
+    _out[i + 1] = ToUniform(block[2], block[3]);
+  }
+
+  if (i < _count)
+  {
+    PhiloxBlock(this->counter++, this->seed, block);
+    _out[i] = ToUniform(block[0], block[1]);
+  }
+}
+
+//////////////////////////////////////////////////
+void Philox::Normal(double *_out, const size_t _count, const double _mean,
+    const double _stdDev)
+{
+  // Uniform pairs first, then transform them in a loop without branches
+  const size_t pairs = _count / 2;
+  this->Uniform(_out, 2 * pairs);
+  for (size_t p = 0; p < pairs; ++p)
+  {
+    const double radius = _stdDev * std::sqrt(-2.0 * std::log(_out[2 * p]));
+    const double angle = kTwoPi * _out[2 * p + 1];
+    _out[2 * p] = _mean + radius * std::cos(angle);
+    _out[2 * p + 1] = _mean + radius * std::sin(angle);
+  }
+
+  if (_count % 2 == 1)
+  {
+    uint32_t block[4];
+    PhiloxBlock(this->counter++, this->seed, block);
+    const double radius = _stdDev *
+      std::sqrt(-2.0 * std::log(ToUniform(block[0], block[1])));
+    _out[_count - 1] = _mean +
+      radius * std::cos(kTwoPi * ToUniform(block[2], block[3]));
+  }
+}
+
+//////////////////////////////////////////////////
+double Philox::Normal(const double _mean, const double _stdDev)
+{
+  double value;
+  this->Normal(&value, 1, _mean, _stdDev);
+  return value;
+}
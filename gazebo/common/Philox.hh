@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_PHILOX_HH_
+#define GAZEBO_COMMON_PHILOX_HH_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class Philox Philox.hh common/common.hh
+    /// \brief Counter-based random number generator (Philox4x32-10, from
+    /// "Parallel random numbers: as easy as 1, 2, 3", Salmon et al. 2011).
+    ///
+    /// Each block of random bits is a function of the seed and of the
+    /// block's index only. A generator has no shared state and no lock, and
+    /// its output for a seed doesn't depend on what other generators or
+    /// threads do. Many values are generated at once in tight loops which
+    /// the compiler can vectorize.
+    class GZ_COMMON_VISIBLE Philox
+    {
+      /// \brief Constructor.
+      /// \param[in] _seed Seed of the generator.
+      public: explicit Philox(const uint64_t _seed = 0);
+
+      /// \brief Set the seed, and go back to the start of the stream.
+      /// \param[in] _seed Seed of the generator.
+      public: void SetSeed(const uint64_t _seed);
+
+      /// \brief Get the seed.
+      /// \return Seed of the generator.
+      public: uint64_t Seed() const;
+
+      /// \brief Set the position in the stream.
+      /// \param[in] _counter Index of the next block of random bits.
+      public: void SetCounter(const uint64_t _counter);
+
+      /// \brief Get the position in the stream. Each block gives four 32
+      /// bit values, or two doubles.
+      /// \return Index of the next block of random bits.
+      public: uint64_t Counter() const;
+
+      /// \brief Generate one block of random bits, and move to the next.
+      /// \param[out] _out Four random 32 bit values.
+      public: void Next(uint32_t _out[4]);
+
+      /// \brief Generate values uniformly distributed in (0, 1).
+      /// \param[out] _out Array to fill.
+      /// \param[in] _count Number of values.
+      public: void Uniform(double *_out, const size_t _count);
+
+      /// \brief Generate normally distributed values, with the Box-Muller
+      /// transform.
+      /// \param[out] _out Array to fill.
+      /// \param[in] _count Number of values.
+      /// \param[in] _mean Mean of the distribution.
+      /// \param[in] _stdDev Standard deviation of the distribution.
+      public: void Normal(double *_out, const size_t _count,
+                          const double _mean, const double _stdDev);
+
+      /// \brief Generate one normally distributed value. Uses a whole
+      /// block, prefer generating arrays.
+      /// \param[in] _mean Mean of the distribution.
+      /// \param[in] _stdDev Standard deviation of the distribution.
+      /// \return The value.
+      public: double Normal(const double _mean, const double _stdDev);
+
+      /// \brief Seed of the generator.
+      private: uint64_t seed;
+
+      /// \brief Index of the next block.
+      private: uint64_t counter = 0;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "gazebo/common/Philox.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class PhiloxTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(PhiloxTest, KnownAnswer)
+{
+  // Philox4x32-10 with a zero counter and key, from the reference
+  // implementation's test vectors
+  common::Philox philox(0);
+  uint32_t block[4];
+  philox.Next(block);
+  EXPECT_EQ(block[0], 0x6627e8d5u);
+  EXPECT_EQ(block[1], 0xe169c58du);
+  EXPECT_EQ(block[2], 0xbc57ac4cu);
+  EXPECT_EQ(block[3], 0x9b00dbd8u);
+  EXPECT_EQ(philox.Counter(), 1u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PhiloxTest, Reproducible)
+{
+  common::Philox a(1234);
+  common::Philox b(1234);
+  common::Philox c(1235);
+
+  std::vector<double> va(101);
+  std::vector<double> vb(101);
+  std::vector<double> vc(101);
+  a.Normal(va.data(), va.size(), 0.0, 1.0);
+  b.Normal(vb.data(), vb.size(), 0.0, 1.0);
+  c.Normal(vc.data(), vc.size(), 0.0, 1.0);
+  EXPECT_EQ(va, vb);
+  EXPECT_NE(va, vc);
+
+  // Going back in the stream gives the same values again
+  EXPECT_EQ(a.Counter(), 51u);
+  a.SetCounter(0);
+  a.Normal(vb.data(), vb.size(), 0.0, 1.0);
+  EXPECT_EQ(va, vb);
+
+  // And a new seed starts a new stream
+  a.SetSeed(1235);
+  EXPECT_EQ(a.Seed(), 1235u);
+  a.Normal(vb.data(), vb.size(), 0.0, 1.0);
+  EXPECT_EQ(vb, vc);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PhiloxTest, Distributions)
+{
+  common::Philox philox(42);
+  const unsigned int count = 100000;
+  std::vector<double> values(count);
+
+  philox.Uniform(values.data(), count);
+  double sum = 0.0;
+  for (auto const value : values)
+  {
+    EXPECT_GT(value, 0.0);
+    EXPECT_LT(value, 1.0);
+    sum += value;
+  }
+  EXPECT_NEAR(sum / count, 0.5, 0.01);
+
+  philox.Normal(values.data(), count, 3.0, 2.0);
+  double mean = 0.0;
+  for (auto const value : values)
+    mean += value;
+  mean /= count;
+
+  double variance = 0.0;
+  for (auto const value : values)
+    variance += (value - mean) * (value - mean);
+  variance /= count;
+
+  EXPECT_NEAR(mean, 3.0, 0.05);
+  EXPECT_NEAR(std::sqrt(variance), 2.0, 0.05);
+
+  double single = philox.Normal(3.0, 0.0);
+  EXPECT_DOUBLE_EQ(single, 3.0);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
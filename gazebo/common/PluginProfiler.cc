@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <map>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/PluginProfiler.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace
+{
+  /// \brief Name of the plugin in scope on each thread.
+  thread_local std::string currentPlugin;
+}
+
+/// \brief Private data for the PluginProfiler class.
+class gazebo::common::PluginProfilerPrivate
+{
+  /// \brief Protects the stats containers.
+  public: mutable std::mutex mutex;
+
+  /// \brief Stats indexed by plugin name.
+  public: std::map<std::string, std::shared_ptr<PluginTimeStats>> statsMap;
+
+  /// \brief Stats in creation order.
+  public: std::vector<std::shared_ptr<PluginTimeStats>> stats;
+
+  /// \brief Budget of a single callback in seconds, 0 if disabled.
+  public: std::atomic<double> budget;
+};
+
+//////////////////////////////////////////////////
+const unsigned int PluginTimeStats::HistogramSize;
+
+//////////////////////////////////////////////////
+PluginTimeStats::PluginTimeStats(const std::string &_name)
+  : name(_name)
+{
+}
+
+//////////////////////////////////////////////////
+const std::string &PluginTimeStats::Name() const
+{
+  return this->name;
+}
+
+//////////////////////////////////////////////////
+bool PluginTimeStats::Record(const double _seconds)
+{
+  // Bucket i holds [2^(i-1), 2^i) microseconds
+  unsigned int bucket = 0;
+  double us = _seconds * 1e6;
+  if (us >= 1.0)
+  {
+    bucket = std::min(static_cast<unsigned int>(std::log2(us)) + 1,
+        HistogramSize - 1);
+  }
+
+  double budget = PluginProfiler::Instance()->Budget();
+  bool overBudget = budget > 0 && _seconds > budget;
+  bool warn = false;
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ++this->count;
+    this->total += _seconds;
+    this->max = std::max(this->max, _seconds);
+    ++this->histogram[bucket];
+
+    if (overBudget)
+    {
+      ++this->overBudget;
+
+      // Don't flood the console, warn at most once per second per plugin
+      auto now = std::chrono::steady_clock::now();
+      if (now - this->lastWarning > std::chrono::seconds(1))
+      {
+        this->lastWarning = now;
+        warn = true;
+      }
+    }
+  }
+
+  if (warn)
+  {
+    gzwarn << "Plugin [" << this->name << "] took " << _seconds * 1e3
+           << " ms to update, over its budget of " << budget * 1e3
+           << " ms" << std::endl;
+  }
+
+  return overBudget;
+}
+
+//////////////////////////////////////////////////
+uint64_t PluginTimeStats::Count() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->count;
+}
+
+//////////////////////////////////////////////////
+double PluginTimeStats::TotalTime() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->total;
+}
+
+//////////////////////////////////////////////////
+double PluginTimeStats::MeanTime() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->count == 0)
+    return 0;
+  return this->total / this->count;
+}
+
+//////////////////////////////////////////////////
+double PluginTimeStats::MaxTime() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->max;
+}
+
+//////////////////////////////////////////////////
+uint64_t PluginTimeStats::OverBudgetCount() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->overBudget;
+}
+
+//////////////////////////////////////////////////
+std::vector<uint64_t> PluginTimeStats::Histogram() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return std::vector<uint64_t>(this->histogram,
+      this->histogram + HistogramSize);
+}
+
+//////////////////////////////////////////////////
+double PluginTimeStats::BucketUpperBound(const unsigned int _bucket)
+{
+  if (_bucket >= HistogramSize - 1)
+    return std::numeric_limits<double>::infinity();
+  return std::ldexp(1.0, _bucket) * 1e-6;
+}
+
+//////////////////////////////////////////////////
+void PluginTimeStats::Reset()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->count = 0;
+  this->total = 0;
+  this->max = 0;
+  this->overBudget = 0;
+  std::fill(this->histogram, this->histogram + HistogramSize, 0u);
+}
+
+//////////////////////////////////////////////////
+PluginProfiler::PluginProfiler()
+  : dataPtr(new PluginProfilerPrivate)
+{
+  this->dataPtr->budget = 0.0;
+
+  const char *budgetStr = std::getenv("GAZEBO_PLUGIN_BUDGET_MS");
+  if (budgetStr)
+  {
+    double budgetMs = std::atof(budgetStr);
+    if (budgetMs > 0)
+      this->dataPtr->budget = budgetMs * 1e-3;
+    else
+      gzwarn << "Ignoring invalid GAZEBO_PLUGIN_BUDGET_MS [" << budgetStr
+             << "]" << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+PluginProfiler::~PluginProfiler()
+{
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<PluginTimeStats> PluginProfiler::Stats(
+    const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &stats = this->dataPtr->statsMap[_name];
+  if (!stats)
+  {
+    stats.reset(new PluginTimeStats(_name));
+    this->dataPtr->stats.push_back(stats);
+  }
+  return stats;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<PluginTimeStats> PluginProfiler::CurrentStats()
+{
+  if (currentPlugin.empty())
+    return nullptr;
+  return this->Stats(currentPlugin);
+}
+
+//////////////////////////////////////////////////
+std::vector<std::shared_ptr<PluginTimeStats>> PluginProfiler::AllStats() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->stats;
+}
+
+//////////////////////////////////////////////////
+void PluginProfiler::SetBudget(const double _seconds)
+{
+  this->dataPtr->budget = std::max(0.0, _seconds);
+}
+
+//////////////////////////////////////////////////
+double PluginProfiler::Budget() const
+{
+  return this->dataPtr->budget;
+}
+
+//////////////////////////////////////////////////
+void PluginProfiler::Reset()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto &stats : this->dataPtr->stats)
+    stats->Reset();
+}
+
+//////////////////////////////////////////////////
+std::string PluginProfiler::SetCurrent(const std::string &_name)
+{
+  std::string previous = currentPlugin;
+  currentPlugin = _name;
+  return previous;
+}
+
+//////////////////////////////////////////////////
+PluginProfilerScope::PluginProfilerScope(const std::string &_name)
+{
+  this->previous = PluginProfiler::Instance()->SetCurrent(_name);
+}
+
+//////////////////////////////////////////////////
+PluginProfilerScope::~PluginProfilerScope()
+{
+  PluginProfiler::Instance()->SetCurrent(this->previous);
+}
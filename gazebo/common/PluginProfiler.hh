@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_PLUGINPROFILER_HH_
+#define GAZEBO_COMMON_PLUGINPROFILER_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, PluginProfiler)
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data classes.
+    class PluginProfilerPrivate;
+
+    /// \addtogroup gazebo_common
+    /// \{
+
+    /// \class PluginTimeStats PluginProfiler.hh common/common.hh
+    /// \brief Wall time spent in the event callbacks of one plugin.
+    /// Times are bucketed in a histogram of power of two microseconds.
+    /// All functions are thread safe.
+    class GZ_COMMON_VISIBLE PluginTimeStats
+    {
+      /// \brief Number of buckets in the histogram. Bucket 0 holds calls
+      /// shorter than 1 us, bucket i holds calls in [2^(i-1), 2^i) us and the
+      /// last bucket holds every call longer than that.
+      public: static const unsigned int HistogramSize = 24;
+
+      /// \brief Constructor.
+      /// \param[in] _name Name of the plugin, scoped by the entity which
+      /// owns it.
+      public: explicit PluginTimeStats(const std::string &_name);
+
+      /// \brief Get the name of the plugin.
+      /// \return Scoped plugin name.
+      public: const std::string &Name() const;
+
+      /// \brief Record the duration of one callback.
+      /// \param[in] _seconds Wall time of the callback in seconds.
+      /// \return True if the duration is over the profiler's budget.
+      public: bool Record(const double _seconds);
+
+      /// \brief Get the number of callbacks recorded.
+      /// \return Number of callbacks.
+      public: uint64_t Count() const;
+
+      /// \brief Get the total wall time of all recorded callbacks.
+      /// \return Total time in seconds.
+      public: double TotalTime() const;
+
+      /// \brief Get the mean wall time of a callback.
+      /// \return Mean time in seconds, 0 if nothing was recorded.
+      public: double MeanTime() const;
+
+      /// \brief Get the longest callback recorded.
+      /// \return Maximum time in seconds.
+      public: double MaxTime() const;
+
+      /// \brief Get the number of callbacks which went over the budget.
+      /// \return Number of callbacks over budget.
+      /// \sa PluginProfiler::SetBudget
+      public: uint64_t OverBudgetCount() const;
+
+      /// \brief Get a copy of the histogram.
+      /// \return Callback count of each bucket, HistogramSize entries.
+      public: std::vector<uint64_t> Histogram() const;
+
+      /// \brief Get the upper bound of a histogram bucket.
+      /// \param[in] _bucket Bucket index.
+      /// \return Upper bound in seconds, infinity for the last bucket.
+      public: static double BucketUpperBound(const unsigned int _bucket);
+
+      /// \brief Clear all the recorded times.
+      public: void Reset();
+
+      /// \brief Name of the plugin.
+      private: std::string name;
+
+      /// \brief Protects the recorded values.
+      private: mutable std::mutex mutex;
+
+      /// \brief Number of callbacks.
+      private: uint64_t count = 0;
+
+      /// \brief Total time in seconds.
+      private: double total = 0;
+
+      /// \brief Longest callback in seconds.
+      private: double max = 0;
+
+      /// \brief Number of callbacks over budget.
+      private: uint64_t overBudget = 0;
+
+      /// \brief Wall time of the last over budget warning.
+      private: std::chrono::steady_clock::time_point lastWarning;
+
+      /// \brief Histogram of callback durations.
+      private: uint64_t histogram[HistogramSize] = {0};
+    };
+
+    /// \class PluginProfiler PluginProfiler.hh common/common.hh
+    /// \brief Registry of the update time of every plugin.
+    ///
+    /// Event connections created while a PluginProfilerScope is alive on the
+    /// calling thread are attributed to the scope's plugin, and the wall
+    /// time of each of their callbacks is recorded. Plugins are scoped when
+    /// Gazebo calls their Load and Init functions, so the usual
+    /// `event::Events::ConnectWorldUpdateBegin` connections are accounted
+    /// for without changes to the plugins.
+    ///
+    /// A budget can be set with SetBudget or with the
+    /// GAZEBO_PLUGIN_BUDGET_MS environment variable. Callbacks which take
+    /// longer than the budget are counted and trigger a throttled warning.
+    class GZ_COMMON_VISIBLE PluginProfiler
+      : public SingletonT<PluginProfiler>
+    {
+      /// \brief Get the stats of a plugin, creating them if needed.
+      /// \param[in] _name Scoped plugin name.
+      /// \return Stats of the plugin.
+      public: std::shared_ptr<PluginTimeStats> Stats(const std::string &_name);
+
+      /// \brief Get the stats of the plugin in scope on the calling thread.
+      /// \return Stats of the plugin, or nullptr if no plugin is in scope.
+      public: std::shared_ptr<PluginTimeStats> CurrentStats();
+
+      /// \brief Get the stats of all the plugins.
+      /// \return Stats of all plugins, in the order they were created.
+      public: std::vector<std::shared_ptr<PluginTimeStats>> AllStats() const;
+
+      /// \brief Set the time budget of a single plugin callback.
+      /// \param[in] _seconds Budget in seconds, 0 to disable.
+      public: void SetBudget(const double _seconds);
+
+      /// \brief Get the time budget of a single plugin callback.
+      /// \return Budget in seconds, 0 if disabled.
+      public: double Budget() const;
+
+      /// \brief Clear the recorded times of all plugins.
+      public: void Reset();
+
+      /// \brief Constructor.
+      private: PluginProfiler();
+
+      /// \brief Destructor.
+      private: virtual ~PluginProfiler();
+
+      /// \brief Set the plugin in scope on the calling thread.
+      /// \param[in] _name Scoped plugin name, empty for none.
+      /// \return Name of the plugin which was previously in scope.
+      private: std::string SetCurrent(const std::string &_name);
+
+      /// \brief This is a singleton class.
+      private: friend class SingletonT<PluginProfiler>;
+
+      /// \brief The scope sets the current plugin.
+      private: friend class PluginProfilerScope;
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<PluginProfilerPrivate> dataPtr;
+    };
+
+    /// \class PluginProfilerScope PluginProfiler.hh common/common.hh
+    /// \brief Attributes the event connections created on this thread to a
+    /// plugin while the scope is alive. Scopes can be nested.
+    class GZ_COMMON_VISIBLE PluginProfilerScope
+    {
+      /// \brief Constructor.
+      /// \param[in] _name Scoped plugin name.
+      public: explicit PluginProfilerScope(const std::string &_name);
+
+      /// \brief Destructor. Restores the previous scope.
+      public: ~PluginProfilerScope();
+
+      /// \brief Name of the plugin which was in scope before this one.
+      private: std::string previous;
+    };
+
+    /// \class PluginTimer PluginProfiler.hh common/common.hh
+    /// \brief Records the wall time between its construction and destruction
+    /// into a plugin's stats.
+    class GZ_COMMON_VISIBLE PluginTimer
+    {
+      /// \brief Constructor, starts the timer.
+      /// \param[in] _stats Stats to record into.
+      public: explicit PluginTimer(PluginTimeStats *_stats)
+              : stats(_stats), start(std::chrono::steady_clock::now())
+      {
+      }
+
+      /// \brief Destructor, records the elapsed time.
+      public: ~PluginTimer()
+      {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - this->start;
+        this->stats->Record(elapsed.count());
+      }
+
+      /// \brief Stats to record into.
+      private: PluginTimeStats *stats;
+
+      /// \brief Time the timer was started.
+      private: std::chrono::steady_clock::time_point start;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <gazebo/common/Event.hh>
+#include <gazebo/common/PluginProfiler.hh>
+#include <gazebo/common/Time.hh>
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class PluginProfilerTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(PluginProfilerTest, Histogram)
+{
+  common::PluginTimeStats stats("model::plugin");
+  EXPECT_EQ(stats.Name(), "model::plugin");
+  EXPECT_EQ(stats.Count(), 0u);
+  EXPECT_DOUBLE_EQ(stats.MeanTime(), 0.0);
+
+  stats.Record(0.5e-6);
+  stats.Record(3e-6);
+  stats.Record(3e-6);
+  stats.Record(10.0);
+
+  EXPECT_EQ(stats.Count(), 4u);
+  EXPECT_DOUBLE_EQ(stats.MaxTime(), 10.0);
+  EXPECT_NEAR(stats.TotalTime(), 10.0000065, 1e-9);
+
+  auto histogram = stats.Histogram();
+  ASSERT_EQ(histogram.size(), common::PluginTimeStats::HistogramSize);
+  EXPECT_EQ(histogram[0], 1u);
+  // [2, 4) us
+  EXPECT_EQ(histogram[2], 2u);
+  EXPECT_EQ(histogram.back(), 1u);
+
+  EXPECT_DOUBLE_EQ(common::PluginTimeStats::BucketUpperBound(0), 1e-6);
+  EXPECT_DOUBLE_EQ(common::PluginTimeStats::BucketUpperBound(2), 4e-6);
+  EXPECT_TRUE(std::isinf(common::PluginTimeStats::BucketUpperBound(
+      common::PluginTimeStats::HistogramSize - 1)));
+
+  stats.Reset();
+  EXPECT_EQ(stats.Count(), 0u);
+  EXPECT_DOUBLE_EQ(stats.MaxTime(), 0.0);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PluginProfilerTest, Budget)
+{
+  auto profiler = common::PluginProfiler::Instance();
+  profiler->SetBudget(0.001);
+  EXPECT_DOUBLE_EQ(profiler->Budget(), 0.001);
+
+  common::PluginTimeStats stats("budget");
+  EXPECT_FALSE(stats.Record(0.0005));
+  EXPECT_TRUE(stats.Record(0.002));
+  EXPECT_EQ(stats.OverBudgetCount(), 1u);
+
+  profiler->SetBudget(0);
+  EXPECT_FALSE(stats.Record(0.002));
+  EXPECT_EQ(stats.OverBudgetCount(), 1u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PluginProfilerTest, EventConnections)
+{
+  event::EventT<void (int)> evt;
+  int calls = 0;
+  auto cb = [&calls](int _i)
+  {
+    calls += _i;
+    common::Time::MSleep(2);
+  };
+
+  // Not attributed to any plugin
+  event::ConnectionPtr anonymous = evt.Connect(cb);
+  EXPECT_TRUE(common::PluginProfiler::Instance()->CurrentStats() == nullptr);
+
+  event::ConnectionPtr owned;
+  {
+    common::PluginProfilerScope scope("robot::controller");
+    owned = evt.Connect(cb);
+
+    // Scopes can be nested
+    {
+      common::PluginProfilerScope nested("robot::other");
+      auto current = common::PluginProfiler::Instance()->CurrentStats();
+      ASSERT_TRUE(current != nullptr);
+      EXPECT_EQ(current->Name(), "robot::other");
+    }
+    auto current = common::PluginProfiler::Instance()->CurrentStats();
+    ASSERT_TRUE(current != nullptr);
+    EXPECT_EQ(current->Name(), "robot::controller");
+  }
+  EXPECT_TRUE(common::PluginProfiler::Instance()->CurrentStats() == nullptr);
+
+  evt(1);
+  evt(1);
+  EXPECT_EQ(calls, 4);
+
+  auto stats = common::PluginProfiler::Instance()->Stats("robot::controller");
+  EXPECT_EQ(stats->Count(), 2u);
+  EXPECT_GE(stats->TotalTime(), 0.004);
+  EXPECT_GE(stats->MaxTime(), 0.002);
+
+  bool found = false;
+  for (auto const &s : common::PluginProfiler::Instance()->AllStats())
+    found = found || s == stats;
+  EXPECT_TRUE(found);
+
+  common::PluginProfiler::Instance()->Reset();
+  EXPECT_EQ(stats->Count(), 0u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -201,6 +201,24 @@ namespace gazebo
                   const bool _loop = true) const;
 
 
+      /// \brief Returns the time at which a named node transformation's
+      /// translational value along the X axis is equal to _x. This is the
+      /// time used by PoseAtX to sample the animation.
+      /// \param[in] _x the value along x. You must ensure that _x is within a
+      /// valid range.
+      /// \param[in] _node the name of the animation node
+      /// \param[in] _loop when true, _x wraps around the animation's range
+      /// along the X axis
+      /// \return the time in seconds
+      public: double TimeAtX(const double _x, const std::string &_node,
+                  const bool _loop = true) const;
+
+      /// \brief Returns the animation of a named node.
+      /// \param[in] _node the name of the animation node
+      /// \return the node animation, or nullptr if the node is not animated
+      public: NodeAnimation *NodeAnimationByName(
+                  const std::string &_node) const;
+
       /// \brief Scales every animation in the animations list
       /// \param[in] _scale the scaling factor
       public: void Scale(const double _scale);
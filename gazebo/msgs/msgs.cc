@@ -15,8 +15,10 @@
  *
 */
 
+#include <google/protobuf/arena.h>
 #include <google/protobuf/descriptor.h>
 #include <algorithm>
+#include <cstddef>
 #include <ignition/math/MassMatrix3.hh>
 #include <ignition/math/Rand.hh>
 
@@ -25,6 +27,7 @@
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/gazebo_config.h"
 
 namespace gazebo
 {
@@ -3430,5 +3433,42 @@ namespace gazebo
 
       return result;
     }
+
+    /////////////////////////////////////////////
+    boost::shared_ptr<google::protobuf::Message> NewArenaMessage(
+        const google::protobuf::Message &_prototype, const size_t _size)
+    {
+#ifdef HAVE_PROTOBUF_ARENA
+      // Bytes and string contents aren't stored in the arena, so a large
+      // first block would be wasted on messages such as images
+      const size_t maxBlockSize = 64 * 1024;
+      const size_t blockSize =
+        std::min(std::max(_size, static_cast<size_t>(256)), maxBlockSize);
+
+      // The arena and its first block share one allocation
+      const size_t align = alignof(std::max_align_t);
+      const size_t arenaSize =
+        (sizeof(google::protobuf::Arena) + align - 1) / align * align;
+      char *memory = new char[arenaSize + blockSize];
+
+      google::protobuf::ArenaOptions options;
+      options.initial_block = memory + arenaSize;
+      options.initial_block_size = blockSize;
+      options.start_block_size = blockSize;
+      options.max_block_size = maxBlockSize;
+      google::protobuf::Arena *arena =
+        new (memory) google::protobuf::Arena(options);
+
+      return boost::shared_ptr<google::protobuf::Message>(
+          _prototype.New(arena),
+          [arena, memory](google::protobuf::Message *)
+          {
+            arena->~Arena();
+            delete [] memory;
+          });
+#else
+      return boost::shared_ptr<google::protobuf::Message>(_prototype.New());
+#endif
+    }
   }
 }
@@ -19,6 +19,7 @@
 
 #include <string>
 
+#include <boost/shared_ptr.hpp>
 #include <sdf/sdf.hh>
 
 #include <ignition/math/Inertial.hh>
@@ -773,6 +774,32 @@ namespace gazebo
     /// \return The resulting message
     GAZEBO_VISIBLE
     msgs::Material ConvertIgnMsg(const ignition::msgs::Material &_msg);
+
+    /// \brief Create an empty message of the same type as another one, with
+    /// its fields allocated from an arena that lives as long as the message.
+    /// Building or parsing a large message then takes a few allocations
+    /// instead of one per nested message and repeated field. Without arena
+    /// support in protobuf, the message is allocated on the heap.
+    /// \param[in] _prototype Message of the type to create.
+    /// \param[in] _size Expected size of the message in bytes, used to size
+    /// the first block of the arena, or 0 for a default size.
+    /// \return The new message.
+    GAZEBO_VISIBLE
+    boost::shared_ptr<google::protobuf::Message> NewArenaMessage(
+        const google::protobuf::Message &_prototype, const size_t _size = 0);
+
+    /// \brief Create an empty message with its fields allocated from an
+    /// arena that lives as long as the message.
+    /// \param[in] _size Expected size of the message in bytes, used to size
+    /// the first block of the arena, or 0 for a default size.
+    /// \return The new message.
+    /// \sa NewArenaMessage(const google::protobuf::Message &, const size_t)
+    template<typename M>
+    boost::shared_ptr<M> NewArenaMessage(const size_t _size = 0)
+    {
+      return boost::static_pointer_cast<M>(
+          NewArenaMessage(M::default_instance(), _size));
+    }
     /// \}
   }
 }
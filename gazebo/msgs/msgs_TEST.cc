@@ -3932,3 +3932,54 @@ TEST_F(MsgsTest, ConvertIgnMsgMaterial)
   EXPECT_DOUBLE_EQ(ignMsg.ambient().a(), ignMsg2.ambient().a());
   EXPECT_EQ(ignMsg.lighting(), ignMsg2.lighting());
 }
+
+/////////////////////////////////////////////////
+TEST_F(MsgsTest, NewArenaMessage)
+{
+  msgs::PosesStamped source;
+  msgs::Set(source.mutable_time(), common::Time(3, 4));
+  for (int i = 0; i < 100; ++i)
+  {
+    msgs::Pose *pose = source.add_pose();
+    pose->set_name("model_" + std::to_string(i) + "::link");
+    pose->set_id(i);
+    msgs::Set(pose, ignition::math::Pose3d(i, 1, 2, 0, 0, 0.1 * i));
+  }
+
+  // Typed, built in place
+  auto poses = msgs::NewArenaMessage<msgs::PosesStamped>();
+  ASSERT_TRUE(poses != nullptr);
+  EXPECT_EQ(poses->pose_size(), 0);
+  poses->CopyFrom(source);
+  EXPECT_EQ(poses->SerializeAsString(), source.SerializeAsString());
+
+  // Untyped, parsed with a size hint larger than the arena blocks
+  std::string data = source.SerializeAsString();
+  boost::shared_ptr<google::protobuf::Message> msg =
+    msgs::NewArenaMessage(msgs::PosesStamped::default_instance(),
+        1024 * 1024);
+  ASSERT_TRUE(msg != nullptr);
+  EXPECT_EQ(msg->GetTypeName(), "gazebo.msgs.PosesStamped");
+  ASSERT_TRUE(msg->ParseFromString(data));
+  EXPECT_EQ(msg->SerializeAsString(), data);
+
+  // The message and its arena outlive the other pointers
+  auto parsed = boost::dynamic_pointer_cast<msgs::PosesStamped>(msg);
+  ASSERT_TRUE(parsed != nullptr);
+  msg.reset();
+  poses.reset();
+  ASSERT_EQ(parsed->pose_size(), 100);
+  EXPECT_EQ(parsed->pose(99).name(), "model_99::link");
+  EXPECT_DOUBLE_EQ(parsed->pose(42).position().x(), 42.0);
+
+  // Messages on and off arenas mix
+  msgs::PosesStamped copy = *parsed;
+  msgs::Pose *pose = new msgs::Pose;
+  pose->set_name("heap");
+  auto mixed = msgs::NewArenaMessage<msgs::PosesStamped>();
+  mixed->Swap(&copy);
+  mixed->mutable_pose()->AddAllocated(pose);
+  EXPECT_EQ(mixed->pose_size(), 101);
+  EXPECT_EQ(mixed->pose(100).name(), "heap");
+  EXPECT_EQ(copy.pose_size(), 0);
+}
@@ -23,7 +23,9 @@
 #include <sstream>
 #include <limits>
 #include <algorithm>
+#include <mutex>
 
+#include "gazebo/common/Assert.hh"
 #include "gazebo/common/BVHLoader.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/KeyFrame.hh"
@@ -41,9 +43,141 @@
 
 #include "gazebo/transport/Node.hh"
 
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \brief Interpolated key frames of a skeleton animation. Actors which
+    /// play the same animation share one of these, so that actors playing
+    /// the same clip with the same time offset only interpolate it once.
+    class SharedAnimationSample
+    {
+      /// \brief Get the shared sample for an animation, creating it if
+      /// needed.
+      /// \param[in] _anim Skeleton animation.
+      /// \return Shared sample for the animation.
+      public: static std::shared_ptr<SharedAnimationSample> Get(
+                  const common::SkeletonAnimation *_anim)
+      {
+        static std::mutex registryMutex;
+        static std::map<const common::SkeletonAnimation *,
+            std::weak_ptr<SharedAnimationSample>> registry;
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+
+        // Drop samples which are no longer used by any actor
+        for (auto iter = registry.begin(); iter != registry.end();)
+        {
+          if (iter->second.expired())
+            iter = registry.erase(iter);
+          else
+            ++iter;
+        }
+
+        auto sample = registry[_anim].lock();
+        if (!sample)
+        {
+          sample.reset(new SharedAnimationSample);
+          registry[_anim] = sample;
+        }
+        return sample;
+      }
+
+      /// \brief Get the index of a track within `frames`, adding it to the
+      /// sampled tracks if needed. Must be called with `mutex` locked.
+      /// \param[in] _track Animation track.
+      /// \return Index of the track.
+      public: int TrackIndex(common::NodeAnimation *_track)
+      {
+        auto iter = std::find(this->tracks.begin(), this->tracks.end(),
+            _track);
+        if (iter != this->tracks.end())
+          return iter - this->tracks.begin();
+
+        this->tracks.push_back(_track);
+        this->frames.resize(this->tracks.size());
+        this->time = std::numeric_limits<double>::quiet_NaN();
+        return this->tracks.size() - 1;
+      }
+
+      /// \brief Interpolate all tracks at the given time, unless they have
+      /// already been interpolated at that time. Must be called with
+      /// `mutex` locked.
+      /// \param[in] _time Animation time in seconds.
+      public: void Sample(const double _time)
+      {
+        if (_time == this->time)
+          return;
+
+        for (unsigned int i = 0; i < this->tracks.size(); ++i)
+          this->frames[i] = this->tracks[i]->FrameAt(_time, true);
+        this->time = _time;
+      }
+
+      /// \brief Animation tracks being sampled.
+      public: std::vector<common::NodeAnimation *> tracks;
+
+      /// \brief Interpolated transform of each track, same order as
+      /// `tracks`.
+      public: std::vector<ignition::math::Matrix4d> frames;
+
+      /// \brief Time of the last interpolation, NaN if it must be redone.
+      public: double time = std::numeric_limits<double>::quiet_NaN();
+
+      /// \brief Protects the sample when actors are updated from different
+      /// worlds.
+      public: std::mutex mutex;
+    };
+
+    /// \brief A node of the skin skeleton, resolved when the actor is
+    /// initialized.
+    class ActorBone
+    {
+      /// \brief Skeleton node.
+      public: common::SkeletonNode *node = nullptr;
+
+      /// \brief Link which follows the node.
+      public: LinkPtr link;
+
+      /// \brief Handle of the parent node, -1 for the root node.
+      public: int parent = -1;
+    };
+
+    /// \brief Association between the nodes of the skin skeleton and the
+    /// tracks of one of the actor's animations.
+    class ActorAnimationBinding
+    {
+      /// \brief Shared interpolated frames of the animation.
+      public: std::shared_ptr<SharedAnimationSample> sample;
+
+      /// \brief Index into the sample's frames for each skin node handle,
+      /// -1 if the node isn't animated.
+      public: std::vector<int> trackIndex;
+
+      /// \brief Name of the animation node which drives the skin root.
+      public: std::string rootNode;
+    };
+  }
+}
+
 /// \brief Private data for Actor class
 class gazebo::physics::ActorPrivate
 {
+  /// \brief Skin skeleton nodes, indexed by their handle.
+  public: std::vector<ActorBone> bones;
+
+  /// \brief Handle of the skeleton root node.
+  public: unsigned int rootHandle = 0;
+
+  /// \brief Animation bindings, indexed by animation name.
+  public: std::map<std::string, ActorAnimationBinding> bindings;
+
+  /// \brief Bone transforms relative to their parents, indexed by handle.
+  /// Kept between updates to avoid reallocating.
+  public: std::vector<ignition::math::Matrix4d> frame;
+
+  /// \brief World transform of each bone, indexed by handle.
+  public: std::vector<ignition::math::Matrix4d> worldTransforms;
 };
 
 using namespace gazebo;
@@ -508,6 +642,76 @@ void Actor::Init()
   if (this->autoStart)
     this->Play();
   this->mainLink = this->GetChildLink(this->GetName() + "_pose");
+  this->ResolveBones();
+}
+
+//////////////////////////////////////////////////
+void Actor::ResolveBones()
+{
+  this->dataPtr->bones.clear();
+  this->dataPtr->bindings.clear();
+
+  if (!this->skeleton)
+    return;
+
+  // Handles are assigned depth first from the root, so a node's parent
+  // always comes before the node itself.
+  unsigned int nodeCount = this->skeleton->GetNumNodes();
+  this->dataPtr->bones.resize(nodeCount);
+  for (unsigned int i = 0; i < nodeCount; ++i)
+  {
+    ActorBone &bone = this->dataPtr->bones[i];
+    bone.node = this->skeleton->GetNodeByHandle(i);
+    bone.link = this->GetChildLink(bone.node->GetName());
+    if (!bone.link)
+    {
+      gzerr << "Missing link for skeleton node [" << bone.node->GetName()
+          << "]" << std::endl;
+    }
+
+    SkeletonNode *parentNode = bone.node->GetParent();
+    if (parentNode)
+    {
+      bone.parent = static_cast<int>(parentNode->GetHandle());
+      GZ_ASSERT(bone.parent < static_cast<int>(i),
+          "Parent skeleton node must have a lower handle than its child");
+    }
+    else
+    {
+      this->dataPtr->rootHandle = i;
+    }
+  }
+  this->dataPtr->frame.resize(nodeCount);
+  this->dataPtr->worldTransforms.resize(nodeCount);
+
+  std::string rootName = this->skeleton->GetRootNode()->GetName();
+  for (auto const &anim : this->skelAnimation)
+  {
+    if (!anim.second)
+      continue;
+
+    auto &skelMap = this->skelNodesMap[anim.first];
+
+    ActorAnimationBinding binding;
+    binding.sample = SharedAnimationSample::Get(anim.second);
+    binding.trackIndex.resize(nodeCount, -1);
+    binding.rootNode = skelMap[rootName];
+
+    std::lock_guard<std::mutex> lock(binding.sample->mutex);
+    for (unsigned int i = 0; i < nodeCount; ++i)
+    {
+      auto nameIter = skelMap.find(this->dataPtr->bones[i].node->GetName());
+      if (nameIter == skelMap.end())
+        continue;
+
+      NodeAnimation *track = anim.second->NodeAnimationByName(
+          nameIter->second);
+      if (track)
+        binding.trackIndex[i] = binding.sample->TrackIndex(track);
+    }
+
+    this->dataPtr->bindings[anim.first] = binding;
+  }
 }
 
 //////////////////////////////////////////////////
@@ -635,36 +839,47 @@ void Actor::Update()
     return;
   }
 
-  auto skelMap = this->skelNodesMap[tinfo->type];
-
-  std::map<std::string, ignition::math::Matrix4d> frame;
-  if (!this->customTrajectoryInfo)
+  auto bindingIter = this->dataPtr->bindings.find(tinfo->type);
+  if (bindingIter == this->dataPtr->bindings.end())
   {
-    if (this->interpolateX[tinfo->type] &&
-          this->trajectories.find(tinfo->id) != this->trajectories.end())
-    {
-      frame = skelAnim->PoseAtX(this->pathLength,
-                skelMap[this->skeleton->GetRootNode()->GetName()]);
-    }
-    else
-    {
-      frame = skelAnim->PoseAt(this->scriptTime);
-    }
+    gzerr << "Animation [" << tinfo->type << "] isn't bound to the skin "
+        << "skeleton" << std::endl;
+    return;
   }
-  else
+  ActorAnimationBinding &binding = bindingIter->second;
+  const unsigned int rootHandle = this->dataPtr->rootHandle;
+  const bool rootAnimated = binding.trackIndex[rootHandle] >= 0;
+
+  double animTime = this->scriptTime;
+  if (!this->customTrajectoryInfo && rootAnimated &&
+      this->interpolateX[tinfo->type] &&
+      this->trajectories.find(tinfo->id) != this->trajectories.end())
   {
-    frame = skelAnim->PoseAt(this->scriptTime);
+    animTime = skelAnim->TimeAtX(this->pathLength, binding.rootNode);
   }
 
   this->lastTraj = tinfo->id;
 
-  ignition::math::Matrix4d rootTrans = ignition::math::Matrix4d::Identity;
-  auto iter = frame.find(skelMap[this->skeleton->GetRootNode()->GetName()]);
-  if (iter != frame.end())
+  // Fill the frame from the shared sample, by skin node handle. Nodes which
+  // aren't animated keep their bind transform.
+  auto &frame = this->dataPtr->frame;
   {
-    rootTrans = frame[skelMap[this->skeleton->GetRootNode()->GetName()]];
+    std::lock_guard<std::mutex> lock(binding.sample->mutex);
+    binding.sample->Sample(animTime);
+    for (unsigned int i = 0; i < frame.size(); ++i)
+    {
+      int track = binding.trackIndex[i];
+      if (track >= 0)
+        frame[i] = binding.sample->frames[track];
+      else
+        frame[i] = this->dataPtr->bones[i].node->Transform();
+    }
   }
 
+  ignition::math::Matrix4d rootTrans = ignition::math::Matrix4d::Identity;
+  if (rootAnimated)
+    rootTrans = frame[rootHandle];
+
   ignition::math::Vector3d rootPos = rootTrans.Translation();
   ignition::math::Quaterniond rootRot = rootTrans.Rotation();
 
@@ -694,98 +909,98 @@ void Actor::Update()
     // workaround for rotation bug
     rootM.SetTranslation(rootM.Translation() * this->skinScale);
   }
-  frame[skelMap[this->skeleton->GetRootNode()->GetName()]] = rootM;
+  frame[rootHandle] = rootM;
 
-  this->SetPose(frame, skelMap, currentTime.Double());
+  this->SetPose(frame, currentTime.Double());
 }
 
 //////////////////////////////////////////////////
-void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
-    std::map<std::string, std::string> _skelMap, const double _time)
+void Actor::SetPose(const std::vector<ignition::math::Matrix4d> &_frame,
+    const double _time)
 {
+  // Only build the bone message if someone is listening
+  const bool publish = this->bonePosePub &&
+      this->bonePosePub->HasConnections();
+
   msgs::PoseAnimation msg;
-  msg.set_model_name(this->visualName);
-  msg.set_model_id(this->visualId);
+  if (publish)
+  {
+    msg.set_model_name(this->visualName);
+    msg.set_model_id(this->visualId);
+  }
 
-  ignition::math::Matrix4d modelTrans(ignition::math::Matrix4d::Identity);
   ignition::math::Pose3d mainLinkPose;
 
   if (this->customTrajectoryInfo)
     mainLinkPose.Rot() = this->worldPose.Rot();
 
-  for (unsigned int i = 0; i < this->skeleton->GetNumNodes(); ++i)
+  auto &worldTransforms = this->dataPtr->worldTransforms;
+  for (unsigned int i = 0; i < this->dataPtr->bones.size(); ++i)
   {
-    SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
-    SkeletonNode *parentBone = bone->GetParent();
-    ignition::math::Matrix4d transform(ignition::math::Matrix4d::Identity);
-    if (_frame.find(_skelMap[bone->GetName()]) != _frame.end())
-      transform = _frame[_skelMap[bone->GetName()]];
-    else
-      transform = bone->Transform();
-
-    LinkPtr currentLink = this->GetChildLink(bone->GetName());
+    const ActorBone &bone = this->dataPtr->bones[i];
+    ignition::math::Matrix4d transform = _frame[i];
     ignition::math::Pose3d bonePose = transform.Pose();
 
     if (!bonePose.IsFinite())
     {
-      std::cerr << "ACTOR: " << _time << " " << bone->GetName()
+      std::cerr << "ACTOR: " << _time << " " << bone.node->GetName()
                 << " " << bonePose << "\n";
       bonePose.Correct();
     }
 
-    msgs::Pose *bone_pose = msg.add_pose();
-    bone_pose->set_name(bone->GetName());
-
-    if (!parentBone)
+    if (bone.parent < 0)
     {
-      bone_pose->mutable_position()->CopyFrom(
-          msgs::Convert(ignition::math::Vector3d()));
-      bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(
-            ignition::math::Quaterniond()));
+      if (publish)
+      {
+        msgs::Pose *bone_pose = msg.add_pose();
+        bone_pose->set_name(bone.node->GetName());
+        msgs::Set(bone_pose, ignition::math::Pose3d::Zero);
+      }
       if (!this->customTrajectoryInfo)
         mainLinkPose = bonePose;
     }
     else
     {
-      bone_pose->mutable_position()->CopyFrom(msgs::Convert(bonePose.Pos()));
-      bone_pose->mutable_orientation()->CopyFrom(msgs::Convert(bonePose.Rot()));
-      LinkPtr parentLink = this->GetChildLink(parentBone->GetName());
-      auto parentPose = parentLink->WorldPose();
-      ignition::math::Matrix4d parentTrans(parentPose);
-      transform = parentTrans * transform;
+      if (publish)
+      {
+        msgs::Pose *bone_pose = msg.add_pose();
+        bone_pose->set_name(bone.node->GetName());
+        msgs::Set(bone_pose, bonePose);
+      }
+      // Parents are always updated before their children
+      transform = worldTransforms[bone.parent] * transform;
     }
+    worldTransforms[i] = transform;
 
-    msgs::Pose *link_pose = msg.add_pose();
-    link_pose->set_name(currentLink->GetScopedName());
-    link_pose->set_id(currentLink->GetId());
-    ignition::math::Pose3d linkPose = transform.Pose() - mainLinkPose;
-    link_pose->mutable_position()->CopyFrom(msgs::Convert(linkPose.Pos()));
-    link_pose->mutable_orientation()->CopyFrom(msgs::Convert(linkPose.Rot()));
-    currentLink->SetWorldPose(transform.Pose(), true, false);
-  }
-
-  msgs::Time *stamp = msg.add_time();
-  stamp->CopyFrom(msgs::Convert(_time));
+    if (!bone.link)
+      continue;
 
-  msgs::Pose *model_pose = msg.add_pose();
-  model_pose->set_name(this->GetScopedName());
-  model_pose->set_id(this->GetId());
-  if (!this->customTrajectoryInfo)
-  {
-    model_pose->mutable_position()->CopyFrom(msgs::Convert(mainLinkPose.Pos()));
-    model_pose->mutable_orientation()->CopyFrom(
-        msgs::Convert(mainLinkPose.Rot()));
+    if (publish)
+    {
+      msgs::Pose *link_pose = msg.add_pose();
+      link_pose->set_name(bone.link->GetScopedName());
+      link_pose->set_id(bone.link->GetId());
+      msgs::Set(link_pose, transform.Pose() - mainLinkPose);
+    }
+    bone.link->SetWorldPose(transform.Pose(), true, false);
   }
-  else
+
+  if (publish)
   {
-    model_pose->mutable_position()->CopyFrom(
-        msgs::Convert(this->worldPose.Pos()));
-    model_pose->mutable_orientation()->CopyFrom(
-        msgs::Convert(this->worldPose.Rot()));
-  }
+    msgs::Time *stamp = msg.add_time();
+    stamp->CopyFrom(msgs::Convert(_time));
+
+    msgs::Pose *model_pose = msg.add_pose();
+    model_pose->set_name(this->GetScopedName());
+    model_pose->set_id(this->GetId());
+    if (!this->customTrajectoryInfo)
+      msgs::Set(model_pose, mainLinkPose);
+    else
+      msgs::Set(model_pose, this->worldPose);
 
-  if (this->bonePosePub && this->bonePosePub->HasConnections())
     this->bonePosePub->Publish(msg);
+  }
+
   if (!this->customTrajectoryInfo)
     this->SetWorldPose(mainLinkPose, true, false);
 }
@@ -272,14 +272,17 @@ namespace gazebo
 
       /// \brief Set the actor's pose. This sets the pose for each bone in the
       /// skeleton and also the actor's pose in the world.
-      /// \param[in] _frame Each frame name and transform.
-      /// \param[in] _skelMap Map of bone relationships.
+      /// \param[in] _frame Transform of each bone relative to its parent,
+      /// indexed by the skin skeleton node handle.
       /// \param[in] _time Time over which to animate the set pose.
       private: void SetPose(
-                   std::map<std::string, ignition::math::Matrix4d> _frame,
-                   std::map<std::string, std::string> _skelMap,
+                   const std::vector<ignition::math::Matrix4d> &_frame,
                    const double _time);
 
+      /// \brief Resolve skeleton nodes to their links and animation
+      /// tracks, so that updates don't need to look them up by name.
+      private: void ResolveBones();
+
       /// \brief Pointer to the actor's mesh.
       protected: const common::Mesh *mesh = nullptr;
 
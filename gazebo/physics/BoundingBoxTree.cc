@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <limits>
+
+#include "gazebo/physics/BoundingBoxTree.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+//////////////////////////////////////////////////
+BoundingBoxTree::BoundingBoxTree()
+{
+}
+
+//////////////////////////////////////////////////
+BoundingBoxTree::~BoundingBoxTree()
+{
+}
+
+//////////////////////////////////////////////////
+void BoundingBoxTree::Build(const std::vector<ignition::math::Box> &_boxes)
+{
+  this->Clear();
+  if (_boxes.empty())
+    return;
+
+  this->items.resize(_boxes.size());
+  for (unsigned int i = 0; i < this->items.size(); ++i)
+    this->items[i] = i;
+
+  // A binary tree with leaves of at least one item
+  this->nodes.reserve(2 * _boxes.size());
+  this->BuildNode(0, this->items.size(), _boxes, 0);
+}
+
+//////////////////////////////////////////////////
+void BoundingBoxTree::Refit(const std::vector<ignition::math::Box> &_boxes)
+{
+  if (_boxes.size() != this->items.size())
+  {
+    this->Build(_boxes);
+    return;
+  }
+
+  // Children come after their parent, so going backwards updates them
+  // first
+  for (unsigned int index = this->nodes.size(); index-- > 0;)
+  {
+    Node &node = this->nodes[index];
+    for (int a = 0; a < 3; ++a)
+    {
+      node.min[a] = std::numeric_limits<double>::max();
+      node.max[a] = -std::numeric_limits<double>::max();
+    }
+
+    if (node.count > 0)
+    {
+      for (unsigned int i = node.first; i < node.first + node.count; ++i)
+      {
+        const ignition::math::Box &box = _boxes[this->items[i]];
+        for (int a = 0; a < 3; ++a)
+        {
+          node.min[a] = std::min(node.min[a], box.Min()[a]);
+          node.max[a] = std::max(node.max[a], box.Max()[a]);
+        }
+      }
+    }
+    else
+    {
+      const Node &left = this->nodes[index + 1];
+      const Node &right = this->nodes[node.first];
+      for (int a = 0; a < 3; ++a)
+      {
+        node.min[a] = std::min(left.min[a], right.min[a]);
+        node.max[a] = std::max(left.max[a], right.max[a]);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void BoundingBoxTree::Clear()
+{
+  this->nodes.clear();
+  this->items.clear();
+}
+
+//////////////////////////////////////////////////
+unsigned int BoundingBoxTree::Size() const
+{
+  return this->items.size();
+}
+
+//////////////////////////////////////////////////
+unsigned int BoundingBoxTree::BuildNode(const unsigned int _begin,
+    const unsigned int _end, const std::vector<ignition::math::Box> &_boxes,
+    const unsigned int _depth)
+{
+  const unsigned int index = this->nodes.size();
+  this->nodes.emplace_back();
+
+  // Bounds of the boxes, and of their centers to choose the split
+  double centerMin[3], centerMax[3];
+  for (int a = 0; a < 3; ++a)
+  {
+    this->nodes[index].min[a] = std::numeric_limits<double>::max();
+    this->nodes[index].max[a] = -std::numeric_limits<double>::max();
+    centerMin[a] = std::numeric_limits<double>::max();
+    centerMax[a] = -std::numeric_limits<double>::max();
+  }
+  for (unsigned int i = _begin; i < _end; ++i)
+  {
+    const ignition::math::Box &box = _boxes[this->items[i]];
+    for (int a = 0; a < 3; ++a)
+    {
+      Node &node = this->nodes[index];
+      node.min[a] = std::min(node.min[a], box.Min()[a]);
+      node.max[a] = std::max(node.max[a], box.Max()[a]);
+      double center = 0.5 * (box.Min()[a] + box.Max()[a]);
+      centerMin[a] = std::min(centerMin[a], center);
+      centerMax[a] = std::max(centerMax[a], center);
+    }
+  }
+
+  unsigned int axis = 0;
+  for (unsigned int a = 1; a < 3; ++a)
+  {
+    if (centerMax[a] - centerMin[a] > centerMax[axis] - centerMin[axis])
+      axis = a;
+  }
+
+  // Small ranges, and boxes which can't be told apart, make a leaf
+  if (_end - _begin <= kLeafSize || _depth >= kMaxDepth ||
+      centerMax[axis] <= centerMin[axis])
+  {
+    this->nodes[index].first = _begin;
+    this->nodes[index].count = _end - _begin;
+    return index;
+  }
+
+  // Split at the median center along the longest axis
+  const unsigned int middle = _begin + (_end - _begin) / 2;
+  std::nth_element(this->items.begin() + _begin,
+      this->items.begin() + middle, this->items.begin() + _end,
+      [&_boxes, axis](const unsigned int _a, const unsigned int _b)
+      {
+        return _boxes[_a].Min()[axis] + _boxes[_a].Max()[axis] <
+               _boxes[_b].Min()[axis] + _boxes[_b].Max()[axis];
+      });
+
+  this->BuildNode(_begin, middle, _boxes, _depth + 1);
+  unsigned int right = this->BuildNode(middle, _end, _boxes, _depth + 1);
+
+  this->nodes[index].first = right;
+  this->nodes[index].count = 0;
+  this->nodes[index].axis = axis;
+  return index;
+}
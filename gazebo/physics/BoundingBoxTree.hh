@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_BOUNDINGBOXTREE_HH_
+#define GAZEBO_PHYSICS_BOUNDINGBOXTREE_HH_
+
+#include <utility>
+#include <vector>
+
+#include <ignition/math/Box.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class BoundingBoxTree BoundingBoxTree.hh physics/physics.hh
+    /// \brief Bounding volume hierarchy over a set of axis aligned boxes,
+    /// used to find the items a ray may hit, or which may be inside a
+    /// volume, without testing all of them.
+    ///
+    /// The tree is a snapshot: it must be refit or built again when the
+    /// boxes move. Queries don't modify the tree, several threads can run
+    /// them at once.
+    class GZ_PHYSICS_VISIBLE BoundingBoxTree
+    {
+      /// \brief Constructor.
+      public: BoundingBoxTree();
+
+      /// \brief Destructor.
+      public: virtual ~BoundingBoxTree();
+
+      /// \brief Build the tree.
+      /// \param[in] _boxes Boxes of the items, an item is identified by the
+      /// index of its box.
+      public: void Build(const std::vector<ignition::math::Box> &_boxes);
+
+      /// \brief Update the bounds of the nodes after boxes moved, keeping
+      /// the structure of the tree. This is faster than Build, but queries
+      /// get slower as the boxes move away from where they were when the
+      /// tree was built.
+      /// \param[in] _boxes Boxes of the items, as many as the tree was
+      /// built with.
+      public: void Refit(const std::vector<ignition::math::Box> &_boxes);
+
+      /// \brief Remove all the items.
+      public: void Clear();
+
+      /// \brief Get the number of items.
+      /// \return Number of boxes the tree was built with.
+      public: unsigned int Size() const;
+
+      /// \brief Find the items whose box is crossed by a ray, nearest
+      /// nodes first.
+      /// \param[in] _start Start of the ray.
+      /// \param[in] _dir Unit direction of the ray.
+      /// \param[in] _length Length of the ray.
+      /// \param[in] _test Called with the index of each item the ray may
+      /// hit and the current length of the ray. Returns the new length of
+      /// the ray, which is shorter when the item was hit, so farther items
+      /// are skipped.
+      public: template<typename T>
+              void Raycast(const ignition::math::Vector3d &_start,
+                           const ignition::math::Vector3d &_dir,
+                           double _length, T _test) const
+      {
+        if (this->nodes.empty())
+          return;
+
+        const double start[3] = {_start.X(), _start.Y(), _start.Z()};
+        const double dir[3] = {_dir.X(), _dir.Y(), _dir.Z()};
+        double inv[3];
+        for (int a = 0; a < 3; ++a)
+          inv[a] = dir[a] != 0 ? 1.0 / dir[a] : 0.0;
+
+        unsigned int stack[kMaxDepth + 2];
+        unsigned int top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+          const unsigned int index = stack[--top];
+          const Node &node = this->nodes[index];
+          if (!Crosses(node, start, dir, inv, _length))
+            continue;
+
+          if (node.count > 0)
+          {
+            for (unsigned int i = node.first; i < node.first + node.count; ++i)
+              _length = _test(this->items[i], _length);
+          }
+          else
+          {
+            // The left child follows its parent. Visit the child on the side
+            // of the ray start first.
+            const unsigned int left = index + 1;
+            if (dir[node.axis] < 0)
+            {
+              stack[top++] = left;
+              stack[top++] = node.first;
+            }
+            else
+            {
+              stack[top++] = node.first;
+              stack[top++] = left;
+            }
+          }
+        }
+      }
+
+      /// \brief Find the items whose box may overlap a volume.
+      /// \param[in] _overlaps Called with the bounds of nodes, returns
+      /// false if they are outside of the volume, so that all the items
+      /// below them are skipped. It may return true for bounds which are
+      /// outside, but not the other way around.
+      /// \param[in] _visit Called with the index of each item below the
+      /// nodes which overlap the volume. The item's own box is not tested.
+      public: template<typename T, typename U>
+              void Query(T _overlaps, U _visit) const
+      {
+        if (this->nodes.empty())
+          return;
+
+        unsigned int stack[kMaxDepth + 2];
+        unsigned int top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+          const unsigned int index = stack[--top];
+          const Node &node = this->nodes[index];
+          if (!_overlaps(ignition::math::Box(
+                  node.min[0], node.min[1], node.min[2],
+                  node.max[0], node.max[1], node.max[2])))
+          {
+            continue;
+          }
+
+          if (node.count > 0)
+          {
+            for (unsigned int i = node.first; i < node.first + node.count; ++i)
+              _visit(this->items[i]);
+          }
+          else
+          {
+            stack[top++] = node.first;
+            stack[top++] = index + 1;
+          }
+        }
+      }
+
+      /// \brief Node of the tree.
+      private: class Node
+               {
+                 /// \brief Lower corner of the bounds.
+                 public: double min[3];
+
+                 /// \brief Upper corner of the bounds.
+                 public: double max[3];
+
+                 /// \brief Index of the first item of a leaf, or of the
+                 /// right child of an inner node.
+                 public: unsigned int first = 0;
+
+                 /// \brief Number of items of a leaf, 0 for an inner node.
+                 public: unsigned int count = 0;
+
+                 /// \brief Axis the children of an inner node are split on.
+                 public: unsigned int axis = 0;
+               };
+
+      /// \brief Build the node of a range of items.
+      /// \param[in] _begin First item.
+      /// \param[in] _end Past the last item.
+      /// \param[in] _boxes Boxes of all the items.
+      /// \param[in] _depth Depth of the node.
+      /// \return Index of the node.
+      private: unsigned int BuildNode(const unsigned int _begin,
+                   const unsigned int _end,
+                   const std::vector<ignition::math::Box> &_boxes,
+                   const unsigned int _depth);
+
+      /// \brief Check whether a ray crosses the bounds of a node.
+      /// \param[in] _node The node.
+      /// \param[in] _start Start of the ray.
+      /// \param[in] _dir Direction of the ray.
+      /// \param[in] _inv Inverse of each component of the direction, or 0
+      /// when it's 0.
+      /// \param[in] _length Length of the ray.
+      /// \return True if the ray crosses the bounds.
+      private: static bool Crosses(const Node &_node, const double _start[3],
+                   const double _dir[3], const double _inv[3],
+                   const double _length)
+      {
+        double enter = 0;
+        double exit = _length;
+        for (int a = 0; a < 3; ++a)
+        {
+          if (_dir[a] == 0)
+          {
+            if (_start[a] < _node.min[a] || _start[a] > _node.max[a])
+              return false;
+            continue;
+          }
+
+          double t1 = (_node.min[a] - _start[a]) * _inv[a];
+          double t2 = (_node.max[a] - _start[a]) * _inv[a];
+          if (t1 > t2)
+            std::swap(t1, t2);
+          enter = t1 > enter ? t1 : enter;
+          exit = t2 < exit ? t2 : exit;
+          if (enter > exit)
+            return false;
+        }
+        return true;
+      }
+
+      /// \brief Largest number of items in a leaf.
+      private: static const unsigned int kLeafSize = 4;
+
+      /// \brief Largest depth of the tree. Nodes deeper than this are
+      /// leaves, whatever their size.
+      private: static const unsigned int kMaxDepth = 48;
+
+      /// \brief Nodes, the root first.
+      private: std::vector<Node> nodes;
+
+      /// \brief Item indices, ordered so each leaf has a contiguous range.
+      private: std::vector<unsigned int> items;
+    };
+    /// \}
+  }
+}
+#endif
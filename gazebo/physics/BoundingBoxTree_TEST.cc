@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "test/util.hh"
+#include "gazebo/physics/BoundingBoxTree.hh"
+
+using namespace gazebo;
+
+class BoundingBoxTreeTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Distance along a ray to a box, using the slab test.
+/// \return Distance, or a negative value if the ray misses the box.
+double RayBoxDistance(const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_dir, const double _length,
+    const ignition::math::Box &_box)
+{
+  double enter = 0;
+  double exit = _length;
+  for (int a = 0; a < 3; ++a)
+  {
+    if (_dir[a] == 0)
+    {
+      if (_start[a] < _box.Min()[a] || _start[a] > _box.Max()[a])
+        return -1;
+      continue;
+    }
+    double t1 = (_box.Min()[a] - _start[a]) / _dir[a];
+    double t2 = (_box.Max()[a] - _start[a]) / _dir[a];
+    enter = std::max(enter, std::min(t1, t2));
+    exit = std::min(exit, std::max(t1, t2));
+  }
+  return enter <= exit ? enter : -1;
+}
+
+/////////////////////////////////////////////////
+TEST_F(BoundingBoxTreeTest, Empty)
+{
+  physics::BoundingBoxTree tree;
+  EXPECT_EQ(tree.Size(), 0u);
+
+  bool called = false;
+  tree.Raycast(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d::UnitX, 10,
+      [&called](const unsigned int, const double _length)
+      {
+        called = true;
+        return _length;
+      });
+  EXPECT_FALSE(called);
+}
+
+/////////////////////////////////////////////////
+TEST_F(BoundingBoxTreeTest, Raycast)
+{
+  // A grid of unit boxes, with a few large ones overlapping it
+  std::vector<ignition::math::Box> boxes;
+  for (int x = 0; x < 20; ++x)
+  {
+    for (int y = 0; y < 20; ++y)
+    {
+      boxes.push_back(ignition::math::Box(
+            ignition::math::Vector3d(x * 2, y * 2, 0),
+            ignition::math::Vector3d(x * 2 + 1, y * 2 + 1, 1)));
+    }
+  }
+  boxes.push_back(ignition::math::Box(
+        ignition::math::Vector3d(-5, -5, -1),
+        ignition::math::Vector3d(50, 50, -0.5)));
+  boxes.push_back(ignition::math::Box(
+        ignition::math::Vector3d(10, 10, 0),
+        ignition::math::Vector3d(10, 10, 0)));
+
+  physics::BoundingBoxTree tree;
+  tree.Build(boxes);
+  EXPECT_EQ(tree.Size(), boxes.size());
+
+  unsigned int seed = 1;
+  auto random = [&seed](const double _min, const double _max)
+  {
+    seed = seed * 1103515245u + 12345u;
+    return _min + (_max - _min) * ((seed >> 16) & 0x7FFF) / 32767.0;
+  };
+
+  for (int r = 0; r < 500; ++r)
+  {
+    ignition::math::Vector3d start(random(-5, 45), random(-5, 45),
+        random(-2, 3));
+    ignition::math::Vector3d dir(random(-1, 1), random(-1, 1),
+        random(-1, 1));
+    // Some rays parallel to the axes
+    if (r % 5 == 0)
+      dir.Z(0);
+    if (r % 7 == 0)
+      dir.Y(0);
+    if (dir == ignition::math::Vector3d::Zero)
+      dir = ignition::math::Vector3d::UnitX;
+    dir.Normalize();
+    const double length = random(1, 30);
+
+    // Without shortening the ray, the tree reports every box it crosses
+    std::set<unsigned int> expected;
+    for (unsigned int i = 0; i < boxes.size(); ++i)
+    {
+      if (RayBoxDistance(start, dir, length, boxes[i]) >= 0)
+        expected.insert(i);
+    }
+    std::set<unsigned int> found;
+    tree.Raycast(start, dir, length,
+        [&found](const unsigned int _index, const double _length)
+        {
+          EXPECT_TRUE(found.insert(_index).second);
+          return _length;
+        });
+    EXPECT_TRUE(std::includes(found.begin(), found.end(),
+          expected.begin(), expected.end()));
+
+    // Shortening the ray at each hit finds the nearest box
+    double nearest = length;
+    for (auto const &i : expected)
+      nearest = std::min(nearest, RayBoxDistance(start, dir, length, boxes[i]));
+    double result = length;
+    tree.Raycast(start, dir, length,
+        [&](const unsigned int _index, const double _length)
+        {
+          double distance = RayBoxDistance(start, dir, _length, boxes[_index]);
+          if (distance >= 0 && distance < result)
+            result = distance;
+          return result;
+        });
+    EXPECT_DOUBLE_EQ(result, nearest);
+  }
+
+  tree.Clear();
+  EXPECT_EQ(tree.Size(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(BoundingBoxTreeTest, QueryAndRefit)
+{
+  // A line of unit boxes along X
+  std::vector<ignition::math::Box> boxes;
+  for (int i = 0; i < 100; ++i)
+  {
+    boxes.push_back(ignition::math::Box(
+          ignition::math::Vector3d(i * 2, 0, 0),
+          ignition::math::Vector3d(i * 2 + 1, 1, 1)));
+  }
+
+  physics::BoundingBoxTree tree;
+  tree.Build(boxes);
+
+  // Items in a volume, with whole nodes culled
+  const ignition::math::Box volume(
+      ignition::math::Vector3d(10.5, -1, -1),
+      ignition::math::Vector3d(20.5, 2, 2));
+  auto overlaps = [&volume](const ignition::math::Box &_box)
+  {
+    return _box.Max().X() >= volume.Min().X() &&
+           _box.Min().X() <= volume.Max().X();
+  };
+
+  unsigned int nodeCount = 0;
+  std::set<unsigned int> found;
+  tree.Query([&](const ignition::math::Box &_box)
+      {
+        ++nodeCount;
+        return overlaps(_box);
+      },
+      [&](const unsigned int _index)
+      {
+        if (overlaps(boxes[_index]))
+          found.insert(_index);
+      });
+  EXPECT_EQ(found, std::set<unsigned int>({5, 6, 7, 8, 9, 10}));
+  EXPECT_LT(nodeCount, 2 * boxes.size() / 3);
+
+  // Move the boxes, refitting finds them where they are now
+  for (auto &box : boxes)
+  {
+    box = ignition::math::Box(box.Min() + ignition::math::Vector3d(100, 0, 0),
+        box.Max() + ignition::math::Vector3d(100, 0, 0));
+  }
+  tree.Refit(boxes);
+  EXPECT_EQ(tree.Size(), boxes.size());
+
+  found.clear();
+  tree.Query(overlaps, [&](const unsigned int _index)
+      {
+        if (overlaps(boxes[_index]))
+          found.insert(_index);
+      });
+  EXPECT_TRUE(found.empty());
+
+  const ignition::math::Box moved(
+      ignition::math::Vector3d(110.5, -1, -1),
+      ignition::math::Vector3d(120.5, 2, 2));
+  found.clear();
+  tree.Query([&moved](const ignition::math::Box &_box)
+      {
+        return _box.Max().X() >= moved.Min().X() &&
+               _box.Min().X() <= moved.Max().X();
+      },
+      [&](const unsigned int _index)
+      {
+        if (boxes[_index].Max().X() >= moved.Min().X() &&
+            boxes[_index].Min().X() <= moved.Max().X())
+        {
+          found.insert(_index);
+        }
+      });
+  EXPECT_EQ(found, std::set<unsigned int>({5, 6, 7, 8, 9, 10}));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -25,6 +25,8 @@
   #include <Winsock2.h>
 #endif
 
+#include <algorithm>
+
 #include "gazebo/physics/physics.hh"
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/Contact.hh"
@@ -57,8 +59,9 @@ Contact &Contact::operator =(const Contact &_contact)
   this->collision1 = _contact.collision1;
   this->collision2 = _contact.collision2;
 
+  // Only the first count entries are valid, the arrays are large
   this->count = _contact.count;
-  for (int i = 0; i < MAX_CONTACT_JOINTS; i++)
+  for (int i = 0; i < std::min(this->count, MAX_CONTACT_JOINTS); i++)
   {
     this->wrench[i] = _contact.wrench[i];
     this->positions[i] = _contact.positions[i];
@@ -98,6 +98,15 @@ bool ContactManager::NeverDropContacts() const
   return this->neverDropContacts;
 }
 
+/////////////////////////////////////////////////
+bool ContactManager::SubscribersConnected() const
+{
+  if (this->contactPub->HasConnections()) return true;
+
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  return !this->customContactPublishers.empty();
+}
+
 /////////////////////////////////////////////////
 bool ContactManager::SubscribersConnected(Collision *_collision1,
                                           Collision *_collision2) const
@@ -304,17 +313,19 @@ void ContactManager::PublishContacts()
   // publish to default topic, ~/physics/contacts
   if (!transport::getMinimalComms())
   {
-    msgs::Contacts msg;
+    // Built in an arena and shared with the subscribers, which saves the
+    // allocations of each contact and its repeated fields
+    auto msg = msgs::NewArenaMessage<msgs::Contacts>();
     for (unsigned int i = 0; i < this->contactIndex; ++i)
     {
       if (this->contacts[i]->count == 0)
         continue;
 
-      msgs::Contact *contactMsg = msg.add_contact();
+      msgs::Contact *contactMsg = msg->add_contact();
       this->contacts[i]->FillMsg(*contactMsg);
     }
 
-    msgs::Set(msg.mutable_time(), this->world->SimTime());
+    msgs::Set(msg->mutable_time(), this->world->SimTime());
     this->contactPub->Publish(msg);
   }
 
@@ -325,18 +336,25 @@ void ContactManager::PublishContacts()
       iter != this->customContactPublishers.end(); ++iter)
   {
     ContactPublisher *contactPublisher = iter->second;
-    msgs::Contacts msg2;
-    for (unsigned int j = 0;
-        j < contactPublisher->contacts.size(); ++j)
+    if (contactPublisher->callback)
+      contactPublisher->callback(contactPublisher->contacts);
+
+    // Only serialize the contacts if someone subscribed to the topic
+    if (contactPublisher->publisher->HasConnections())
     {
-      if (contactPublisher->contacts[j]->count == 0)
-        continue;
+      auto msg2 = msgs::NewArenaMessage<msgs::Contacts>();
+      for (unsigned int j = 0;
+          j < contactPublisher->contacts.size(); ++j)
+      {
+        if (contactPublisher->contacts[j]->count == 0)
+          continue;
 
-      msgs::Contact *contactMsg = msg2.add_contact();
-      contactPublisher->contacts[j]->FillMsg(*contactMsg);
+        msgs::Contact *contactMsg = msg2->add_contact();
+        contactPublisher->contacts[j]->FillMsg(*contactMsg);
+      }
+      msgs::Set(msg2->mutable_time(), this->world->SimTime());
+      contactPublisher->publisher->Publish(msg2);
     }
-    msgs::Set(msg2.mutable_time(), this->world->SimTime());
-    contactPublisher->publisher->Publish(msg2);
     contactPublisher->contacts.clear();
   }
 }
@@ -430,6 +448,22 @@ std::string ContactManager::CreateFilter(const std::string &_name,
   return topic;
 }
 
+/////////////////////////////////////////////////
+bool ContactManager::SetFilterCallback(const std::string &_name,
+    const ContactFilterCallback &_callback)
+{
+  std::string name = _name;
+  boost::replace_all(name, "::", "/");
+
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  auto iter = this->customContactPublishers.find(name);
+  if (iter == this->customContactPublishers.end())
+    return false;
+
+  iter->second->callback = _callback;
+  return true;
+}
+
 /////////////////////////////////////////////////
 void ContactManager::RemoveFilter(const std::string &_name)
 {
@@ -18,6 +18,7 @@
 #ifndef GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 #define GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 
+#include <functional>
 #include <vector>
 #include <string>
 #include <map>
@@ -37,6 +38,13 @@ namespace gazebo
 {
   namespace physics
   {
+    /// \def ContactFilterCallback
+    /// \brief Function which receives the contacts of a filter after each
+    /// world update. The contacts are owned by the ContactManager and are
+    /// only valid during the call.
+    using ContactFilterCallback =
+        std::function<void (const std::vector<Contact *> &)>;
+
     /// \brief A custom contact publisher created for each contact filter
     /// in the Contact Manager.
     class GZ_PHYSICS_VISIBLE ContactPublisher
@@ -56,6 +64,9 @@ namespace gazebo
       /// \brief A list of contacts associated to the collisions.
       public: std::vector<Contact *> contacts;
 
+      /// \brief Function which receives the contacts directly, if set.
+      public: ContactFilterCallback callback;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
@@ -140,6 +151,13 @@ namespace gazebo
       public: bool SubscribersConnected(Collision *_collision1,
                                         Collision *_collision2) const;
 
+      /// \brief Returns true if any subscriber may be interested in contacts,
+      /// either on the contacts topic or through a filter. This is cheaper
+      /// than the test for a pair of collisions and may be used before
+      /// skipping a group of collisions.
+      /// \return true if any subscriber or filter exists
+      public: bool SubscribersConnected() const;
+
       /// \brief Return the number of valid contacts.
       public: unsigned int GetContactCount() const;
 
@@ -191,6 +209,16 @@ namespace gazebo
                   const std::map<std::string, physics::CollisionPtr>
                   &_collisions);
 
+      /// \brief Set a function which receives the contacts of a filter
+      /// directly, on the world update thread, when the contacts are
+      /// published. Unlike subscribing to the filter's topic, the contacts
+      /// are not serialized.
+      /// \param[in] _name Filter name.
+      /// \param[in] _callback Function to call, or nullptr to remove it.
+      /// \return False if the filter doesn't exist.
+      public: bool SetFilterCallback(const std::string &_name,
+                  const ContactFilterCallback &_callback);
+
       /// \brief Remove a contacts filter and the associated custom publisher
       /// param[in] _name Filter name.
       public: void RemoveFilter(const std::string &_name);
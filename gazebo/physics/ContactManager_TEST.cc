@@ -41,6 +41,7 @@ TEST_F(ContactManagerTest, CreateFilter)
   ASSERT_TRUE(physics != nullptr);
 
   EXPECT_EQ(manager->GetFilterCount(), 0u);
+  EXPECT_FALSE(manager->SubscribersConnected());
 
   // Verify that no topic is created if passing in an empty collisions
   std::vector<std::string> collisions;
@@ -58,6 +59,7 @@ TEST_F(ContactManagerTest, CreateFilter)
   EXPECT_TRUE(topic.find(collisionMapName) != std::string::npos);
   EXPECT_TRUE(manager->HasFilter(collisionMapName));
   EXPECT_EQ(manager->GetFilterCount(), 1u);
+  EXPECT_TRUE(manager->SubscribersConnected());
 
   std::vector<std::string> collisionVector;
   collisionVector.push_back("test_collision2");
@@ -194,6 +196,57 @@ TEST_F(ContactManagerTest, NeverDropContacts)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, FilterCallback)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::ContactManager *manager =
+      world->Physics()->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+
+  // No filter with that name yet
+  EXPECT_FALSE(manager->SetFilterCallback("box_filter",
+      [](const std::vector<physics::Contact *> &) {}));
+
+  std::string topic = manager->CreateFilter("box_filter",
+      "box::link::collision");
+  EXPECT_FALSE(topic.empty());
+
+  unsigned int calls = 0;
+  unsigned int contactCount = 0;
+  EXPECT_TRUE(manager->SetFilterCallback("box_filter",
+      [&](const std::vector<physics::Contact *> &_contacts)
+      {
+        ++calls;
+        for (auto const &contact : _contacts)
+        {
+          if (contact->count == 0)
+            continue;
+          ++contactCount;
+          EXPECT_TRUE(
+              contact->collision1->GetScopedName() == "box::link::collision" ||
+              contact->collision2->GetScopedName() == "box::link::collision");
+        }
+      }));
+
+  // The box rests on the ground plane
+  world->Step(10);
+  EXPECT_EQ(calls, 10u);
+  EXPECT_GT(contactCount, 0u);
+
+  // No more calls once the callback is removed
+  EXPECT_TRUE(manager->SetFilterCallback("box_filter", nullptr));
+  world->Step(10);
+  EXPECT_EQ(calls, 10u);
+
+  manager->RemoveFilter("box_filter");
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -45,6 +45,7 @@
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/Link.hh"
+#include "gazebo/physics/LinkStateBuffer.hh"
 #include "gazebo/physics/Wind.hh"
 
 #include "gazebo/util/IntrospectionManager.hh"
@@ -108,6 +109,9 @@ class gazebo::physics::LinkPrivate
   /// \brief All the attached batteries.
   public: std::vector<common::BatteryPtr> batteries;
 
+  /// \brief Slot in the world's link state buffer, -1 if none.
+  public: int stateIndex = -1;
+
 #ifdef HAVE_OPENAL
       /// \brief All the audio sources
       public: std::vector<util::OpenALSourcePtr> audioSources;
@@ -330,6 +334,8 @@ void Link::Init()
   if (this->WindMode() && this->world->WindEnabled())
     this->SetWindEnabled(true);
 
+  this->world->LinkStates().Add(this);
+
   this->initialized = true;
 }
 
@@ -338,6 +344,9 @@ void Link::Fini()
 {
   this->dataPtr->updateConnection.reset();
 
+  if (this->world)
+    this->world->LinkStates().Remove(this);
+
   this->dataPtr->attachedModels.clear();
   this->dataPtr->parentJoints.clear();
   this->dataPtr->childJoints.clear();
@@ -670,6 +679,18 @@ Link_V Link::GetParentJointsLinks() const
   return links;
 }
 
+//////////////////////////////////////////////////
+int Link::StateIndex() const
+{
+  return this->dataPtr->stateIndex;
+}
+
+//////////////////////////////////////////////////
+void Link::SetStateIndex(const int _index)
+{
+  this->dataPtr->stateIndex = _index;
+}
+
 //////////////////////////////////////////////////
 void Link::LoadCollision(sdf::ElementPtr _sdf)
 {
@@ -1153,6 +1174,12 @@ void Link::DetachAllStaticModels()
 //////////////////////////////////////////////////
 void Link::OnPoseChange()
 {
+  // Publish the new pose to the link state buffer right away, the physics
+  // engine may not report it on the next step if the body is disabled.
+  // This may run on any thread, e.g. for a model moved through transport.
+  if (this->dataPtr->stateIndex >= 0)
+    this->world->LinkStates().WritePose(this, this->WorldPose());
+
   ignition::math::Pose3d p;
   for (unsigned int i = 0; i < this->dataPtr->attachedModels.size(); i++)
   {
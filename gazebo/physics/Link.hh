@@ -622,9 +622,18 @@ namespace gazebo
       /// \return a map of unique ID to visual message
       public: const Visuals_M &Visuals() const;
 
+      /// \brief Get the slot of this link in the world's link state buffer.
+      /// \return Index of the slot, -1 if the link isn't initialized.
+      /// \sa World::LinkStates
+      public: int StateIndex() const;
+
       /// \brief Publish timestamped link data such as velocity.
       private: void PublishData();
 
+      /// \brief Set the slot of this link in the link state buffer.
+      /// \param[in] _index Index of the slot, -1 for none.
+      private: void SetStateIndex(const int _index);
+
       /// \brief Load a new collision helper function.
       /// \param[in] _sdf SDF element used to load the collision.
       private: void LoadCollision(sdf::ElementPtr _sdf);
@@ -687,6 +696,9 @@ namespace gazebo
 
       /// \brief Pointer to private data
       private: std::unique_ptr<LinkPrivate> dataPtr;
+
+      /// \brief The link state buffer assigns the state index.
+      private: friend class LinkStateBuffer;
     };
     /// \}
   }
@@ -17,6 +17,7 @@
 
 #include "gazebo/common/Exception.hh"
 #include "gazebo/physics/Link.hh"
+#include "gazebo/physics/LinkStateBuffer.hh"
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/LinkState.hh"
@@ -28,6 +29,30 @@ using namespace physics;
 // move to class member variable when merging forward.
 static bool gRecordVelocity = false;
 
+/////////////////////////////////////////////////
+/// \brief Read the pose and velocity of a link from the world's link state
+/// buffer, falling back to the Link API for links without a slot.
+/// \param[in] _link Link to read.
+/// \param[out] _pose World pose of the link.
+/// \param[out] _velocity Linear and angular velocity of the link.
+static void ReadKinematics(const LinkPtr &_link,
+    ignition::math::Pose3d &_pose, ignition::math::Pose3d &_velocity)
+{
+  ignition::math::Vector3d linearVel;
+  ignition::math::Vector3d angularVel;
+
+  int index = _link->StateIndex();
+  if (index < 0 || !_link->GetWorld()->LinkStates().State(
+      static_cast<unsigned int>(index), _pose, linearVel, angularVel))
+  {
+    _pose = _link->WorldPose();
+    linearVel = _link->WorldLinearVel();
+    angularVel = _link->WorldAngularVel();
+  }
+
+  _velocity.Set(linearVel, angularVel);
+}
+
 /////////////////////////////////////////////////
 LinkState::LinkState()
 : State()
@@ -39,9 +64,7 @@ LinkState::LinkState(const LinkPtr _link, const common::Time &_realTime,
                   const common::Time &_simTime, const uint64_t _iterations)
   : State(_link->GetName(), _realTime, _simTime, _iterations)
 {
-  this->pose = _link->WorldPose();
-  this->velocity.Set(_link->WorldLinearVel(),
-                     _link->WorldAngularVel());
+  ReadKinematics(_link, this->pose, this->velocity);
   this->acceleration.Set(_link->WorldLinearAccel(),
                          _link->WorldAngularAccel());
   this->wrench.Set(_link->WorldForce(), ignition::math::Quaterniond::Identity);
@@ -52,9 +75,7 @@ LinkState::LinkState(const LinkPtr _link)
   : State(_link->GetName(), _link->GetWorld()->RealTime(),
           _link->GetWorld()->SimTime(), _link->GetWorld()->Iterations())
 {
-  this->pose = _link->WorldPose();
-  this->velocity.Set(_link->WorldLinearVel(),
-                     _link->WorldAngularVel());
+  ReadKinematics(_link, this->pose, this->velocity);
   this->acceleration.Set(_link->WorldLinearAccel(),
                          _link->WorldAngularAccel());
   this->wrench.Set(_link->WorldForce(), ignition::math::Quaterniond::Identity);
@@ -93,9 +114,7 @@ void LinkState::Load(const LinkPtr _link, const common::Time &_realTime,
   this->simTime = _simTime;
   this->iterations = _iterations;
 
-  this->pose = _link->WorldPose();
-  this->velocity.Set(_link->WorldLinearVel(),
-                     _link->WorldAngularVel());
+  ReadKinematics(_link, this->pose, this->velocity);
   this->acceleration.Set(_link->WorldLinearAccel(),
                          _link->WorldAngularAccel());
   this->wrench.Set(_link->WorldForce(), ignition::math::Quaterniond::Identity);
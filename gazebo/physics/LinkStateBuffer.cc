@@ -0,0 +1,353 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <mutex>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/LinkStateBuffer.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+//////////////////////////////////////////////////
+LinkStateBuffer::LinkStateBuffer()
+  : sequence(0), writeDepth(0)
+{
+}
+
+//////////////////////////////////////////////////
+LinkStateBuffer::~LinkStateBuffer()
+{
+}
+
+//////////////////////////////////////////////////
+unsigned int LinkStateBuffer::Add(Link *_link)
+{
+  GZ_ASSERT(_link != nullptr, "Link is null");
+
+  std::unique_lock<std::shared_timed_mutex> lock(this->structureMutex);
+
+  if (_link->StateIndex() >= 0)
+    return static_cast<unsigned int>(_link->StateIndex());
+
+  // The physics engine body may not exist yet, so only the pose is read.
+  // The velocities are filled in by the next step.
+  auto index = static_cast<unsigned int>(this->links.size());
+  this->links.push_back(_link);
+  this->writePoses.push_back(_link->WorldPose());
+  this->writeLinearVels.push_back(ignition::math::Vector3d::Zero);
+  this->writeAngularVels.push_back(ignition::math::Vector3d::Zero);
+  this->dirty.push_back(0);
+  this->poses.push_back(this->writePoses.back());
+  this->linearVels.push_back(ignition::math::Vector3d::Zero);
+  this->angularVels.push_back(ignition::math::Vector3d::Zero);
+  this->linearAccels.push_back(ignition::math::Vector3d::Zero);
+  this->angularAccels.push_back(ignition::math::Vector3d::Zero);
+  this->prevLinearVels.push_back(ignition::math::Vector3d::Zero);
+  this->prevAngularVels.push_back(ignition::math::Vector3d::Zero);
+
+  _link->SetStateIndex(static_cast<int>(index));
+  return index;
+}
+
+//////////////////////////////////////////////////
+void LinkStateBuffer::Remove(Link *_link)
+{
+  GZ_ASSERT(_link != nullptr, "Link is null");
+
+  {
+    std::lock_guard<std::mutex> pendingLock(this->pendingMutex);
+    this->pending.erase(std::remove_if(this->pending.begin(),
+          this->pending.end(),
+          [_link](const std::pair<Link *, ignition::math::Pose3d> &_p)
+          {
+            return _p.first == _link;
+          }), this->pending.end());
+  }
+
+  std::unique_lock<std::shared_timed_mutex> lock(this->structureMutex);
+
+  int index = _link->StateIndex();
+  if (index < 0 || static_cast<size_t>(index) >= this->links.size() ||
+      this->links[index] != _link)
+  {
+    return;
+  }
+
+  // Move the last slot into the removed one to keep the arrays packed
+  size_t last = this->links.size() - 1;
+  if (static_cast<size_t>(index) != last)
+  {
+    this->links[index] = this->links[last];
+    this->writePoses[index] = this->writePoses[last];
+    this->writeLinearVels[index] = this->writeLinearVels[last];
+    this->writeAngularVels[index] = this->writeAngularVels[last];
+    this->dirty[index] = this->dirty[last];
+    this->poses[index] = this->poses[last];
+    this->linearVels[index] = this->linearVels[last];
+    this->angularVels[index] = this->angularVels[last];
+    this->linearAccels[index] = this->linearAccels[last];
+    this->angularAccels[index] = this->angularAccels[last];
+    this->prevLinearVels[index] = this->prevLinearVels[last];
+    this->prevAngularVels[index] = this->prevAngularVels[last];
+    this->links[index]->SetStateIndex(index);
+  }
+
+  this->links.pop_back();
+  this->writePoses.pop_back();
+  this->writeLinearVels.pop_back();
+  this->writeAngularVels.pop_back();
+  this->dirty.pop_back();
+  this->poses.pop_back();
+  this->linearVels.pop_back();
+  this->angularVels.pop_back();
+  this->linearAccels.pop_back();
+  this->angularAccels.pop_back();
+  this->prevLinearVels.pop_back();
+  this->prevAngularVels.pop_back();
+
+  _link->SetStateIndex(-1);
+}
+
+//////////////////////////////////////////////////
+void LinkStateBuffer::Clear()
+{
+  {
+    std::lock_guard<std::mutex> pendingLock(this->pendingMutex);
+    this->pending.clear();
+  }
+
+  std::unique_lock<std::shared_timed_mutex> lock(this->structureMutex);
+
+  for (auto &link : this->links)
+    link->SetStateIndex(-1);
+
+  this->links.clear();
+  this->writePoses.clear();
+  this->writeLinearVels.clear();
+  this->writeAngularVels.clear();
+  this->dirty.clear();
+  this->poses.clear();
+  this->linearVels.clear();
+  this->angularVels.clear();
+  this->linearAccels.clear();
+  this->angularAccels.clear();
+  this->prevLinearVels.clear();
+  this->prevAngularVels.clear();
+}
+
+//////////////////////////////////////////////////
+unsigned int LinkStateBuffer::Size() const
+{
+  return static_cast<unsigned int>(this->links.size());
+}
+
+//////////////////////////////////////////////////
+const std::vector<Link *> &LinkStateBuffer::Links() const
+{
+  return this->links;
+}
+
+//////////////////////////////////////////////////
+const ignition::math::Pose3d *LinkStateBuffer::Poses() const
+{
+  return this->poses.data();
+}
+
+//////////////////////////////////////////////////
+const ignition::math::Vector3d *LinkStateBuffer::LinearVels() const
+{
+  return this->linearVels.data();
+}
+
+//////////////////////////////////////////////////
+const ignition::math::Vector3d *LinkStateBuffer::AngularVels() const
+{
+  return this->angularVels.data();
+}
+
+//////////////////////////////////////////////////
+const ignition::math::Vector3d *LinkStateBuffer::LinearAccels() const
+{
+  return this->linearAccels.data();
+}
+
+//////////////////////////////////////////////////
+const ignition::math::Vector3d *LinkStateBuffer::AngularAccels() const
+{
+  return this->angularAccels.data();
+}
+
+//////////////////////////////////////////////////
+bool LinkStateBuffer::State(const unsigned int _index,
+    ignition::math::Pose3d &_pose, ignition::math::Vector3d &_linearVel,
+    ignition::math::Vector3d &_angularVel) const
+{
+  std::shared_lock<std::shared_timed_mutex> lock(this->structureMutex);
+
+  if (_index >= this->links.size())
+    return false;
+
+  // Retry until the copy wasn't interleaved with a write
+  uint64_t before;
+  uint64_t after;
+  do
+  {
+    before = this->sequence.load(std::memory_order_acquire);
+    _pose = this->poses[_index];
+    _linearVel = this->linearVels[_index];
+    _angularVel = this->angularVels[_index];
+    std::atomic_thread_fence(std::memory_order_acquire);
+    after = this->sequence.load(std::memory_order_relaxed);
+  } while ((before & 1u) || before != after);
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+common::Time LinkStateBuffer::SimTime() const
+{
+  return this->simTime;
+}
+
+//////////////////////////////////////////////////
+uint64_t LinkStateBuffer::Sequence() const
+{
+  return this->sequence.load(std::memory_order_acquire);
+}
+
+//////////////////////////////////////////////////
+void LinkStateBuffer::BeginWrite()
+{
+  this->writeMutex.lock();
+
+  // Poses queued too late for the previous write are staged first, so that
+  // this write can override them
+  if (this->writeDepth.fetch_add(1) == 0)
+    this->ApplyPending();
+}
+
+//////////////////////////////////////////////////
+void LinkStateBuffer::EndWrite(const common::Time &_simTime)
+{
+  GZ_ASSERT(this->writeDepth > 0, "EndWrite called without BeginWrite");
+  std::lock_guard<std::recursive_mutex> lock(this->writeMutex,
+      std::adopt_lock);
+  if (this->writeDepth.fetch_sub(1) > 1)
+    return;
+
+  this->ApplyPending();
+
+  // Publish the written slots. Readers only retry during this copy, not
+  // for the whole physics update.
+  this->sequence.fetch_add(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < this->links.size(); ++i)
+  {
+    if (!this->dirty[i])
+      continue;
+    this->dirty[i] = 0;
+    this->poses[i] = this->writePoses[i];
+    this->linearVels[i] = this->writeLinearVels[i];
+    this->angularVels[i] = this->writeAngularVels[i];
+  }
+  this->sequence.fetch_add(1, std::memory_order_release);
+
+  // Accelerations are only read on the world update thread
+  double dt = (_simTime - this->simTime).Double();
+  if (dt > 0)
+  {
+    double invDt = 1.0 / dt;
+    for (size_t i = 0; i < this->links.size(); ++i)
+    {
+      this->linearAccels[i] =
+          (this->linearVels[i] - this->prevLinearVels[i]) * invDt;
+      this->angularAccels[i] =
+          (this->angularVels[i] - this->prevAngularVels[i]) * invDt;
+    }
+    this->prevLinearVels = this->linearVels;
+    this->prevAngularVels = this->angularVels;
+  }
+  else if (dt < 0)
+  {
+    // Time went backwards, e.g. after a reset
+    for (size_t i = 0; i < this->links.size(); ++i)
+    {
+      this->linearAccels[i] = ignition::math::Vector3d::Zero;
+      this->angularAccels[i] = ignition::math::Vector3d::Zero;
+    }
+    this->prevLinearVels = this->linearVels;
+    this->prevAngularVels = this->angularVels;
+  }
+  this->simTime = _simTime;
+}
+
+//////////////////////////////////////////////////
+void LinkStateBuffer::WritePose(Link *_link,
+    const ignition::math::Pose3d &_pose)
+{
+  // Waiting for another thread's write could deadlock, since the world
+  // takes other locks while it writes
+  std::unique_lock<std::recursive_mutex> lock(this->writeMutex,
+      std::try_to_lock);
+  if (!lock.owns_lock())
+  {
+    std::lock_guard<std::mutex> pendingLock(this->pendingMutex);
+    this->pending.emplace_back(_link, _pose);
+    return;
+  }
+
+  int index = _link->StateIndex();
+  if (index < 0)
+    return;
+
+  // Nested in a write of this thread, the pose is published with it.
+  // Otherwise the time doesn't advance, which keeps the accelerations.
+  this->BeginWrite();
+  this->SetPose(index, _pose);
+  this->EndWrite(this->simTime);
+}
+
+//////////////////////////////////////////////////
+void LinkStateBuffer::ApplyPending()
+{
+  std::lock_guard<std::mutex> lock(this->pendingMutex);
+  for (auto const &p : this->pending)
+  {
+    int index = p.first->StateIndex();
+    if (index >= 0 && static_cast<size_t>(index) < this->links.size() &&
+        this->links[index] == p.first)
+    {
+      this->SetPose(index, p.second);
+    }
+  }
+  this->pending.clear();
+}
+
+//////////////////////////////////////////////////
+void LinkStateBuffer::Fill()
+{
+  for (size_t i = 0; i < this->links.size(); ++i)
+  {
+    this->writePoses[i] = this->links[i]->WorldPose();
+    this->writeLinearVels[i] = this->links[i]->WorldLinearVel();
+    this->writeAngularVels[i] = this->links[i]->WorldAngularVel();
+    this->dirty[i] = 1;
+  }
+}
@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_LINKSTATEBUFFER_HH_
+#define GAZEBO_PHYSICS_LINKSTATEBUFFER_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class LinkStateBuffer LinkStateBuffer.hh physics/physics.hh
+    /// \brief Kinematic state of all the links of a world, stored as one
+    /// contiguous array per quantity.
+    ///
+    /// The world owns the buffer. Every link gets a slot when it is
+    /// initialized, see Link::StateIndex. Physics engines which support it
+    /// write the state of the bodies directly while stepping, the world
+    /// fills the buffer through the Link API for the others. Either way the
+    /// buffer is complete once World::Update has published the new poses.
+    ///
+    /// Writers fill a staging copy of the poses and velocities and mark the
+    /// slots they change. EndWrite publishes the changed slots in one short
+    /// pass, which is the only time the sequence number is odd.
+    ///
+    /// A single thread writes at a time. Other threads, such as those
+    /// teleporting models, use WritePose, which never waits for the
+    /// world's write to end.
+    ///
+    /// Code running on the world update thread, such as world update event
+    /// callbacks, can read the arrays directly without any synchronization.
+    /// Other threads should use State, which only retries while the changed
+    /// slots are published, and blocks while links are added or removed.
+    class GZ_PHYSICS_VISIBLE LinkStateBuffer
+    {
+      /// \brief Constructor.
+      public: LinkStateBuffer();
+
+      /// \brief Destructor.
+      public: virtual ~LinkStateBuffer();
+
+      /// \brief Add a link and initialize its slot with the link's pose
+      /// and zero velocity. Called by the link itself.
+      /// \param[in] _link Link to add.
+      /// \return Index of the link's slot.
+      public: unsigned int Add(Link *_link);
+
+      /// \brief Remove a link. The last slot is moved into the freed one.
+      /// Called by the link itself.
+      /// \param[in] _link Link to remove.
+      public: void Remove(Link *_link);
+
+      /// \brief Remove all the links.
+      public: void Clear();
+
+      /// \brief Get the number of slots.
+      /// \return Number of links in the buffer.
+      public: unsigned int Size() const;
+
+      /// \brief Get the link of each slot.
+      /// \return Links indexed by slot.
+      public: const std::vector<Link *> &Links() const;
+
+      /// \brief Get the world pose of the link frames.
+      /// \return Poses indexed by slot, Size() entries.
+      public: const ignition::math::Pose3d *Poses() const;
+
+      /// \brief Get the world linear velocity of the link frames.
+      /// \return Velocities indexed by slot, Size() entries.
+      public: const ignition::math::Vector3d *LinearVels() const;
+
+      /// \brief Get the world angular velocity of the links.
+      /// \return Velocities indexed by slot, Size() entries.
+      public: const ignition::math::Vector3d *AngularVels() const;
+
+      /// \brief Get the world linear acceleration of the link frames,
+      /// computed from the change of velocity over the last step.
+      /// \return Accelerations indexed by slot, Size() entries.
+      public: const ignition::math::Vector3d *LinearAccels() const;
+
+      /// \brief Get the world angular acceleration of the links, computed
+      /// from the change of velocity over the last step.
+      /// \return Accelerations indexed by slot, Size() entries.
+      public: const ignition::math::Vector3d *AngularAccels() const;
+
+      /// \brief Get a consistent copy of the state of one link. Safe to
+      /// call from any thread.
+      /// \param[in] _index Slot of the link.
+      /// \param[out] _pose World pose.
+      /// \param[out] _linearVel World linear velocity.
+      /// \param[out] _angularVel World angular velocity.
+      /// \return False if the index is out of range.
+      public: bool State(const unsigned int _index,
+                         ignition::math::Pose3d &_pose,
+                         ignition::math::Vector3d &_linearVel,
+                         ignition::math::Vector3d &_angularVel) const;
+
+      /// \brief Get the simulation time of the state.
+      /// \return Simulation time of the last completed write.
+      public: common::Time SimTime() const;
+
+      /// \brief Get the write sequence number. It is odd while EndWrite
+      /// publishes the written slots, and increases by two with every
+      /// completed write.
+      /// \return Sequence number.
+      public: uint64_t Sequence() const;
+
+      /// \brief Start writing, waiting for the write of another thread to
+      /// end. Writes of a thread can be nested, only the outermost EndWrite
+      /// publishes them. EndWrite must be called by the same thread.
+      public: void BeginWrite();
+
+      /// \brief Finish writing. The outermost call publishes the slots
+      /// written since the last publication, and the poses queued by
+      /// WritePose, changing the sequence number. If the simulation time
+      /// advanced since the last write, the accelerations are updated from
+      /// the velocities.
+      /// \param[in] _simTime Simulation time of the state written.
+      public: void EndWrite(const common::Time &_simTime);
+
+      /// \brief Write and publish the pose of a link from any thread,
+      /// e.g. when it is teleported. Within a write of this thread, the
+      /// pose is published with it. While another thread writes, the pose
+      /// is queued and published by that write, or at the latest by the
+      /// next one, without waiting. Otherwise it is published right away,
+      /// at the simulation time of the last write.
+      /// \param[in] _link The link.
+      /// \param[in] _pose World pose of the link frame.
+      public: void WritePose(Link *_link,
+                             const ignition::math::Pose3d &_pose);
+
+      /// \brief Write the pose of a link, between BeginWrite and EndWrite.
+      /// Readers see it once EndWrite publishes it.
+      /// \param[in] _index Slot of the link.
+      /// \param[in] _pose World pose of the link frame.
+      public: inline void SetPose(const unsigned int _index,
+                                  const ignition::math::Pose3d &_pose)
+              {
+                this->writePoses[_index] = _pose;
+                this->MarkDirty(_index);
+              }
+
+      /// \brief Write the velocity of a link, between BeginWrite and
+      /// EndWrite. Readers see it once EndWrite publishes it.
+      /// \param[in] _index Slot of the link.
+      /// \param[in] _linear World linear velocity of the link frame.
+      /// \param[in] _angular World angular velocity.
+      public: inline void SetVelocity(const unsigned int _index,
+                  const ignition::math::Vector3d &_linear,
+                  const ignition::math::Vector3d &_angular)
+              {
+                this->writeLinearVels[_index] = _linear;
+                this->writeAngularVels[_index] = _angular;
+                this->MarkDirty(_index);
+              }
+
+      /// \brief Read the pose and velocity of every link through the Link
+      /// API. Used for physics engines which don't write the buffer.
+      public: void Fill();
+
+      /// \brief Stage the poses queued by WritePose. Called by the writing
+      /// thread.
+      private: void ApplyPending();
+
+      /// \brief Remember that a slot was written since the last
+      /// publication.
+      /// \param[in] _index Slot of the link.
+      private: inline void MarkDirty(const unsigned int _index)
+               {
+                 this->dirty[_index] = 1;
+               }
+
+      /// \brief Link of each slot.
+      private: std::vector<Link *> links;
+
+      /// \brief World poses being written, published by EndWrite.
+      private: std::vector<ignition::math::Pose3d> writePoses;
+
+      /// \brief World linear velocities being written.
+      private: std::vector<ignition::math::Vector3d> writeLinearVels;
+
+      /// \brief World angular velocities being written.
+      private: std::vector<ignition::math::Vector3d> writeAngularVels;
+
+      /// \brief 1 for the slots written since the last publication.
+      private: std::vector<uint8_t> dirty;
+
+      /// \brief World poses.
+      private: std::vector<ignition::math::Pose3d> poses;
+
+      /// \brief World linear velocities.
+      private: std::vector<ignition::math::Vector3d> linearVels;
+
+      /// \brief World angular velocities.
+      private: std::vector<ignition::math::Vector3d> angularVels;
+
+      /// \brief World linear accelerations.
+      private: std::vector<ignition::math::Vector3d> linearAccels;
+
+      /// \brief World angular accelerations.
+      private: std::vector<ignition::math::Vector3d> angularAccels;
+
+      /// \brief Linear velocities at the previous simulation time.
+      private: std::vector<ignition::math::Vector3d> prevLinearVels;
+
+      /// \brief Angular velocities at the previous simulation time.
+      private: std::vector<ignition::math::Vector3d> prevAngularVels;
+
+      /// \brief Write sequence number.
+      private: std::atomic<uint64_t> sequence;
+
+      /// \brief Depth of nested writes.
+      private: std::atomic<unsigned int> writeDepth;
+
+      /// \brief Held by the writing thread from BeginWrite to EndWrite.
+      private: std::recursive_mutex writeMutex;
+
+      /// \brief Poses written by WritePose while another thread wrote.
+      private: std::vector<std::pair<Link *, ignition::math::Pose3d>>
+               pending;
+
+      /// \brief Protects pending.
+      private: std::mutex pendingMutex;
+
+      /// \brief Simulation time of the last write.
+      private: common::Time simTime;
+
+      /// \brief Protects the arrays against reallocation while links are
+      /// added or removed.
+      private: mutable std::shared_timed_mutex structureMutex;
+    };
+    /// \}
+  }
+}
+#endif
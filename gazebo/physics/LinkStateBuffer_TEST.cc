@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <thread>
+
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/LinkStateBuffer.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class LinkStateBufferTest : public ServerFixture {};
+
+//////////////////////////////////////////////////
+TEST_F(LinkStateBufferTest, MatchesLinkApi)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // The ground plane is static but has a slot too
+  physics::LinkStateBuffer &states = world->LinkStates();
+  EXPECT_EQ(states.Size(), 1u);
+
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 2), ignition::math::Vector3d(0.3, 0, 0));
+  auto model = world->ModelByName("box");
+  ASSERT_TRUE(model != nullptr);
+  auto link = model->GetLink();
+  ASSERT_TRUE(link != nullptr);
+  ASSERT_GE(link->StateIndex(), 0);
+  EXPECT_EQ(states.Size(), 2u);
+  EXPECT_EQ(states.Links()[link->StateIndex()], link.get());
+
+  // Each step is one complete write
+  uint64_t sequence = states.Sequence();
+  EXPECT_EQ(sequence % 2, 0u);
+  world->Step(100);
+  EXPECT_EQ(states.Sequence(), sequence + 200);
+  EXPECT_EQ(states.SimTime(), world->SimTime());
+
+  // The box is falling
+  unsigned int index = link->StateIndex();
+  EXPECT_EQ(states.Poses()[index], link->WorldPose());
+  EXPECT_EQ(states.LinearVels()[index], link->WorldLinearVel());
+  EXPECT_EQ(states.AngularVels()[index], link->WorldAngularVel());
+  EXPECT_LT(states.LinearVels()[index].Z(), -0.5);
+  EXPECT_NEAR(states.LinearAccels()[index].Z(), -9.8, 1e-3);
+
+  ignition::math::Pose3d pose;
+  ignition::math::Vector3d linearVel;
+  ignition::math::Vector3d angularVel;
+  EXPECT_TRUE(states.State(index, pose, linearVel, angularVel));
+  EXPECT_EQ(pose, link->WorldPose());
+  EXPECT_EQ(linearVel, link->WorldLinearVel());
+  EXPECT_FALSE(states.State(states.Size(), pose, linearVel, angularVel));
+
+  // Teleports are visible right away
+  ignition::math::Pose3d target(5, 0, 3, 0, 0, 0);
+  model->SetWorldPose(target);
+  EXPECT_EQ(states.Poses()[link->StateIndex()], target);
+
+  // Writes are published together by the outermost EndWrite
+  sequence = states.Sequence();
+  ignition::math::Pose3d staged(1, 2, 3, 0, 0, 0);
+  states.BeginWrite();
+  states.SetPose(link->StateIndex(), staged);
+  EXPECT_EQ(states.Poses()[link->StateIndex()], target);
+  EXPECT_EQ(states.Sequence(), sequence);
+  states.EndWrite(world->SimTime());
+  EXPECT_EQ(states.Poses()[link->StateIndex()], staged);
+  EXPECT_EQ(states.Sequence(), sequence + 2);
+
+  // A teleport from another thread doesn't wait for the write in progress,
+  // which publishes it
+  ignition::math::Pose3d teleported(-1, 0, 3, 0, 0, 0);
+  states.BeginWrite();
+  std::thread other([&]()
+      {
+        model->SetWorldPose(teleported);
+      });
+  other.join();
+  EXPECT_EQ(states.Poses()[link->StateIndex()], staged);
+  states.EndWrite(world->SimTime());
+  EXPECT_EQ(states.Poses()[link->StateIndex()], teleported);
+
+  // Removing the model frees its slot
+  world->RemoveModel("box");
+  EXPECT_EQ(states.Size(), 1u);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -35,6 +35,7 @@
 #include "gazebo/common/KeyFrame.hh"
 #include "gazebo/common/Animation.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/PluginProfiler.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
@@ -1074,6 +1075,10 @@ void Model::LoadPlugin(sdf::ElementPtr _sdf)
 
     ModelPtr myself = boost::static_pointer_cast<Model>(shared_from_this());
 
+    // Attribute the event connections of the plugin to it
+    common::PluginProfilerScope scope(this->GetScopedName(true) + "::" +
+        pluginName);
+
     try
     {
       plugin->Load(myself, _sdf);
@@ -22,7 +22,10 @@
 
 #include "gazebo/common/Exception.hh"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/Link.hh"
 #include "gazebo/physics/MultiRayShape.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/World.hh"
 
 using namespace gazebo;
 using namespace physics;
@@ -138,6 +141,9 @@ double MultiRayShape::GetRange(unsigned int _index)
     gzthrow(stream.str());
   }
 
+  if (_index < this->ranges.size())
+    return this->ranges[_index];
+
   // Add min range, because we measured from min range.
   return this->GetMinRange() + this->rays[_index]->GetLength();
 }
@@ -153,6 +159,9 @@ double MultiRayShape::GetRetro(unsigned int _index)
     gzthrow(stream.str());
   }
 
+  if (_index < this->retros.size())
+    return this->retros[_index];
+
   return this->rays[_index]->GetRetro();
 }
 
@@ -167,6 +176,9 @@ int MultiRayShape::GetFiducial(unsigned int _index)
     gzthrow(stream.str());
   }
 
+  if (_index < this->fiducials.size())
+    return this->fiducials[_index];
+
   return this->rays[_index]->GetFiducial();
 }
 
@@ -176,25 +188,116 @@ void MultiRayShape::Update()
   // The measurable range is (max-min)
   double fullRange = this->GetMaxRange() - this->GetMinRange();
 
-  // Reset the ray lengths and mark the collisions as dirty (so they get
-  // redrawn)
   unsigned int raySize = this->rays.size();
-  for (unsigned int i = 0; i < raySize; ++i)
+  this->ranges.resize(raySize);
+  this->retros.resize(raySize);
+  this->fiducials.resize(raySize);
+
+  if (!this->UpdateBatch(fullRange))
   {
-    this->rays[i]->SetLength(fullRange);
-    this->rays[i]->SetRetro(0.0);
+    // Reset the ray lengths and mark the collisions as dirty (so they get
+    // redrawn)
+    for (unsigned int i = 0; i < raySize; ++i)
+    {
+      this->rays[i]->SetLength(fullRange);
+      this->rays[i]->SetRetro(0.0);
 
-    // Get the global points of the line
-    this->rays[i]->Update();
-  }
+      // Get the global points of the line
+      this->rays[i]->Update();
+    }
+
+    // do actual collision checks
+    this->UpdateRays();
 
-  // do actual collision checks
-  this->UpdateRays();
+    for (unsigned int i = 0; i < raySize; ++i)
+    {
+      // Add min range, because we measured from min range.
+      this->ranges[i] = this->GetMinRange() + this->rays[i]->GetLength();
+      this->retros[i] = this->rays[i]->GetRetro();
+      this->fiducials[i] = this->rays[i]->GetFiducial();
+    }
+  }
 
   // for plugin
   this->newLaserScans();
 }
 
+//////////////////////////////////////////////////
+bool MultiRayShape::UpdateBatch(const double _fullRange)
+{
+  // Stand alone shapes have their rays in the world frame, and are updated
+  // through UpdateRays
+  if (!this->batchedUpdates || !this->collisionParent || this->rays.empty())
+    return false;
+
+  // Same points as RayShape::SetLength and Update, from the link pose
+  ignition::math::Pose3d linkPose =
+    this->collisionParent->GetLink()->WorldPose();
+  unsigned int raySize = this->rays.size();
+  this->batch.Resize(raySize);
+  for (unsigned int i = 0; i < raySize; ++i)
+  {
+    ignition::math::Vector3d start, end;
+    this->rays[i]->RelativePoints(start, end);
+    ignition::math::Vector3d dir = end - start;
+    dir.Normalize();
+
+    this->batch.starts[i] = linkPose.CoordPositionAdd(start);
+    this->batch.ends[i] = linkPose.CoordPositionAdd(dir * _fullRange + start);
+  }
+
+  if (!this->GetWorld()->Physics()->CastRays(this->batch))
+    return false;
+
+  // Keep the rays up to date, for code which reads them one at a time
+  this->lastHits.resize(raySize, nullptr);
+  for (unsigned int i = 0; i < raySize; ++i)
+  {
+    this->ranges[i] = this->GetMinRange() + this->batch.lengths[i];
+    this->retros[i] = this->batch.retros[i];
+    this->fiducials[i] = this->batch.fiducials[i];
+
+    this->rays[i]->SetLength(this->batch.lengths[i]);
+    this->rays[i]->SetRetro(this->batch.retros[i]);
+    this->rays[i]->SetFiducial(this->batch.fiducials[i]);
+    if (this->batch.hits[i] && this->batch.hits[i] != this->lastHits[i])
+      this->rays[i]->SetCollisionName(this->batch.hits[i]->GetScopedName());
+    this->lastHits[i] = this->batch.hits[i];
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &MultiRayShape::Ranges() const
+{
+  return this->ranges;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &MultiRayShape::Retros() const
+{
+  return this->retros;
+}
+
+//////////////////////////////////////////////////
+const std::vector<int> &MultiRayShape::Fiducials() const
+{
+  return this->fiducials;
+}
+
+//////////////////////////////////////////////////
+void MultiRayShape::SetBatchedUpdates(const bool _batched)
+{
+  this->batchedUpdates = _batched;
+}
+
+//////////////////////////////////////////////////
+bool MultiRayShape::BatchedUpdates() const
+{
+  return this->batchedUpdates;
+}
+
 //////////////////////////////////////////////////
 bool MultiRayShape::SetRay(const unsigned int _rayIndex,
     const ignition::math::Vector3d &_start,
@@ -22,6 +22,7 @@
 #include <ignition/math/Angle.hh>
 
 #include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/RayCastBatch.hh"
 #include "gazebo/physics/Shape.hh"
 #include "gazebo/physics/RayShape.hh"
 #include "gazebo/util/system.hh"
@@ -127,6 +128,32 @@ namespace gazebo
       /// \brief Update the ray collisions.
       public: void Update();
 
+      /// \brief Get the detected range of all the rays, as of the last
+      /// Update.
+      /// \return Range of each ray, indexed like GetRange.
+      public: const std::vector<double> &Ranges() const;
+
+      /// \brief Get the detected retro value of all the rays, as of the
+      /// last Update.
+      /// \return Retro value of each ray, indexed like GetRetro.
+      public: const std::vector<double> &Retros() const;
+
+      /// \brief Get the detected fiducial of all the rays, as of the last
+      /// Update.
+      /// \return Fiducial of each ray, indexed like GetFiducial.
+      public: const std::vector<int> &Fiducials() const;
+
+      /// \brief Set whether Update casts all the rays at once, through
+      /// PhysicsEngine::CastRays, when the physics engine supports it.
+      /// Otherwise each ray is updated in turn. Enabled by default.
+      /// \param[in] _batched True to cast the rays at once.
+      public: void SetBatchedUpdates(const bool _batched);
+
+      /// \brief Get whether Update casts all the rays at once.
+      /// \return True if the rays are cast at once.
+      /// \sa SetBatchedUpdates
+      public: bool BatchedUpdates() const;
+
       /// \TODO This function is not implemented.
       /// \brief Fill a message with this shape's values.
       /// \param[out] _msg Message that contains the shape's values.
@@ -208,6 +235,29 @@ namespace gazebo
 
       /// \brief Max range of a ray
       private: double maxRange = 1000;
+
+      /// \brief Cast all the rays through the physics engine.
+      /// \param[in] _fullRange Length of the rays.
+      /// \return False if the physics engine doesn't support it.
+      private: bool UpdateBatch(const double _fullRange);
+
+      /// \brief Rays cast by UpdateBatch, and their results.
+      private: RayCastBatch batch;
+
+      /// \brief Collision hit by each ray during the last batched update.
+      private: std::vector<Collision *> lastHits;
+
+      /// \brief Range of each ray.
+      private: std::vector<double> ranges;
+
+      /// \brief Retro value of each ray.
+      private: std::vector<double> retros;
+
+      /// \brief Fiducial of each ray.
+      private: std::vector<int> fiducials;
+
+      /// \brief True to cast the rays at once.
+      private: bool batchedUpdates = true;
     };
     /// \}
   }
@@ -32,6 +32,7 @@ namespace gazebo
   namespace physics
   {
     class ContactManager;
+    class RayCastBatch;
 
     /// \addtogroup gazebo_physics
     /// \{
@@ -130,6 +131,22 @@ namespace gazebo
       /// \sa PhysicsEngine::UpdateCollision()
       public: virtual void UpdatePhysics() {}
 
+      /// \brief Get whether the engine writes the pose and velocity of its
+      /// bodies into the world's link state buffer while updating. If not,
+      /// the world fills the buffer through the Link API after each update.
+      /// \return True if the engine writes the link state buffer.
+      /// \sa World::LinkStates
+      public: virtual bool WritesLinkStates() const {return false;}
+
+      /// \brief Cast a batch of rays against the collisions of the world,
+      /// and fill their results. Engines which support it test many rays
+      /// at once, in parallel, which is much faster than updating one
+      /// RayShape at a time.
+      /// \param[in,out] _batch Rays to cast, and their results.
+      /// \return False if the engine doesn't support batched ray casts, in
+      /// which case the results are left untouched.
+      public: virtual bool CastRays(RayCastBatch &/*_batch*/) {return false;}
+
       /// \brief Create a new model.
       /// \param[in] _base Boost shared pointer to a new model.
       public: virtual ModelPtr CreateModel(BasePtr _base);
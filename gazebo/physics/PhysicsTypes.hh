@@ -69,6 +69,7 @@ namespace gazebo
     class ModelState;
     class LightState;
     class LinkState;
+    class LinkStateBuffer;
     class JointState;
     class TrajectoryInfo;
 
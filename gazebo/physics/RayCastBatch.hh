@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_RAYCASTBATCH_HH_
+#define GAZEBO_PHYSICS_RAYCASTBATCH_HH_
+
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class RayCastBatch RayCastBatch.hh physics/physics.hh
+    /// \brief Rays cast at once against the collisions of a world, and
+    /// their results, stored as one contiguous array per quantity.
+    /// \sa PhysicsEngine::CastRays
+    class GZ_PHYSICS_VISIBLE RayCastBatch
+    {
+      /// \brief Set the number of rays.
+      /// \param[in] _count Number of rays.
+      public: void Resize(const unsigned int _count)
+              {
+                this->starts.resize(_count);
+                this->ends.resize(_count);
+                this->lengths.resize(_count);
+                this->retros.resize(_count);
+                this->fiducials.resize(_count);
+                this->hits.resize(_count);
+              }
+
+      /// \brief Get the number of rays.
+      /// \return Number of rays.
+      public: unsigned int Size() const
+              {
+                return this->starts.size();
+              }
+
+      /// \brief Start of each ray, in the world frame.
+      public: std::vector<ignition::math::Vector3d> starts;
+
+      /// \brief End of each ray, in the world frame.
+      public: std::vector<ignition::math::Vector3d> ends;
+
+      /// \brief Distance from the start of each ray to the nearest hit, or
+      /// the length of the ray when nothing was hit.
+      public: std::vector<double> lengths;
+
+      /// \brief Laser retro of the collision hit by each ray, 0 when
+      /// nothing was hit.
+      public: std::vector<double> retros;
+
+      /// \brief Fiducial of the collision hit by each ray, -1 when there is
+      /// none.
+      public: std::vector<int> fiducials;
+
+      /// \brief Collision hit by each ray, nullptr when nothing was hit.
+      public: std::vector<Collision *> hits;
+
+      /// \brief When true, the rays only hit the collisions of static
+      /// models, and go through the others.
+      public: bool staticOnly = false;
+    };
+    /// \}
+  }
+}
+#endif
@@ -60,6 +60,7 @@
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/PluginProfiler.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/URI.hh"
 
@@ -133,6 +134,7 @@ World::World(const std::string &_name)
   this->dataPtr->loaded = false;
   this->dataPtr->stepInc = 0;
   this->dataPtr->pause = false;
+  this->dataPtr->posesMsgSize = 0;
   this->dataPtr->thread = nullptr;
   this->dataPtr->logThread = nullptr;
   this->dataPtr->stop = false;
@@ -244,9 +246,14 @@ void World::Load(sdf::ElementPtr _sdf)
 
   this->dataPtr->responsePub = this->dataPtr->node->Advertise<msgs::Response>(
       "~/response");
+  // Each statistics message replaces the previous one, only the latest is
+  // sent to subscribers which lag behind
   this->dataPtr->statPub =
     this->dataPtr->node->Advertise<msgs::WorldStatistics>(
-        "~/world_stats", 100, 5);
+        "~/world_stats", 100, 5, true);
+  this->dataPtr->pluginStatPub =
+    this->dataPtr->node->Advertise<msgs::PluginStatistics>(
+        "~/plugin_stats", 10, 1);
   this->dataPtr->modelPub = this->dataPtr->node->Advertise<msgs::Model>(
       "~/model/info");
   this->dataPtr->lightPub = this->dataPtr->node->Advertise<msgs::Light>(
@@ -782,6 +789,9 @@ void World::Update()
   // Update the physics engine
   if (this->dataPtr->enablePhysicsEngine && this->dataPtr->physicsEngine)
   {
+    // Engines which support it write the link states while updating
+    this->dataPtr->linkStates.BeginWrite();
+
     // This must be called directly after PhysicsEngine::UpdateCollision.
     this->dataPtr->physicsEngine->UpdatePhysics();
 
@@ -804,6 +814,12 @@ void World::Update()
     }
 
     DIAG_TIMER_LAP("World::Update", "SetWorldPose(dirtyPoses)");
+
+    if (!this->dataPtr->physicsEngine->WritesLinkStates())
+      this->dataPtr->linkStates.Fill();
+    this->dataPtr->linkStates.EndWrite(this->dataPtr->simTime);
+
+    DIAG_TIMER_LAP("World::Update", "LinkStateBuffer");
   }
 
   // Only update state information if logging data.
@@ -848,6 +864,7 @@ void World::Fini()
     this->dataPtr->guiPub.reset();
     this->dataPtr->responsePub.reset();
     this->dataPtr->statPub.reset();
+    this->dataPtr->pluginStatPub.reset();
     this->dataPtr->modelPub.reset();
     this->dataPtr->lightPub.reset();
     this->dataPtr->lightFactoryPub.reset();
@@ -1618,6 +1635,9 @@ void World::LoadPlugin(const std::string &_filename,
             << "Plugin filename[" << _filename << "] name[" << _name << "]\n";
       return;
     }
+    // Attribute the event connections of the plugin to it
+    common::PluginProfilerScope scope(this->Name() + "::" + _name);
+
     plugin->Load(shared_from_this(), _sdf);
     this->dataPtr->plugins.push_back(plugin);
 
@@ -2571,10 +2591,13 @@ void World::ProcessMessages()
         (this->dataPtr->poseLocalPub &&
          this->dataPtr->poseLocalPub->HasConnections()))
     {
-      msgs::PosesStamped msg;
+      // Built in an arena and shared with the subscribers, which saves an
+      // allocation per pose
+      auto msg = msgs::NewArenaMessage<msgs::PosesStamped>(
+          this->dataPtr->posesMsgSize);
 
       // Time stamp this PosesStamped message
-      msgs::Set(msg.mutable_time(), this->SimTime());
+      msgs::Set(msg->mutable_time(), this->SimTime());
 
       if (!this->dataPtr->publishModelPoses.empty() ||
           !this->dataPtr->publishLightPoses.empty())
@@ -2587,7 +2610,7 @@ void World::ProcessMessages()
           {
             ModelPtr m = modelList.front();
             modelList.pop_front();
-            msgs::Pose *poseMsg = msg.add_pose();
+            msgs::Pose *poseMsg = msg->add_pose();
 
             // Publish the model's relative pose
             poseMsg->set_name(m->GetScopedName());
@@ -2598,7 +2621,7 @@ void World::ProcessMessages()
             Link_V links = m->GetLinks();
             for (auto const &link : links)
             {
-              poseMsg = msg.add_pose();
+              poseMsg = msg->add_pose();
               poseMsg->set_name(link->GetScopedName());
               poseMsg->set_id(link->GetId());
               msgs::Set(poseMsg, link->RelativePose());
@@ -2613,7 +2636,7 @@ void World::ProcessMessages()
 
         for (auto const &light : this->dataPtr->publishLightPoses)
         {
-          msgs::Pose *poseMsg = msg.add_pose();
+          msgs::Pose *poseMsg = msg->add_pose();
 
           // Publish the light's pose
           poseMsg->set_name(light->GetScopedName());
@@ -2623,6 +2646,11 @@ void World::ProcessMessages()
 
         if (this->dataPtr->posePub && this->dataPtr->posePub->HasConnections())
           this->dataPtr->posePub->Publish(msg);
+
+        // The next message likely has as many poses
+        this->dataPtr->posesMsgSize = msg->pose_size() *
+          (sizeof(msgs::Pose) + sizeof(msgs::Vector3d) +
+           sizeof(msgs::Quaternion));
       }
 
       if (this->dataPtr->poseLocalPub &&
@@ -2718,6 +2746,56 @@ void World::PublishWorldStats()
   if (this->dataPtr->statPub && this->dataPtr->statPub->HasConnections())
     this->dataPtr->statPub->Publish(this->dataPtr->worldStatsMsg);
   this->dataPtr->prevStatTime = common::Time::GetWallTime();
+
+  this->PublishPluginStats();
+}
+
+//////////////////////////////////////////////////
+void World::PublishPluginStats()
+{
+  auto profiler = common::PluginProfiler::Instance();
+
+  // The profiler is shared by all the worlds of the process, keep the
+  // plugins of this world, whose names start with the world name
+  const std::string prefix = this->Name() + "::";
+  std::vector<std::shared_ptr<common::PluginTimeStats>> allStats;
+  for (auto const &stats : profiler->AllStats())
+  {
+    if (stats->Name().compare(0, prefix.size(), prefix) == 0)
+      allStats.push_back(stats);
+  }
+
+  // Make plugins which connected since the last call introspectable
+  for (auto const &stats : allStats)
+  {
+    if (this->dataPtr->introspectedPlugins.insert(stats->Name()).second)
+      this->RegisterPluginIntrospectionItems(stats);
+  }
+
+  if (!this->dataPtr->pluginStatPub ||
+      !this->dataPtr->pluginStatPub->HasConnections())
+  {
+    return;
+  }
+
+  msgs::PluginStatistics msg;
+  msgs::Set(msg.mutable_sim_time(), this->SimTime());
+  if (profiler->Budget() > 0)
+    msgs::Set(msg.mutable_budget(), common::Time(profiler->Budget()));
+
+  for (auto const &stats : allStats)
+  {
+    auto pluginMsg = msg.add_plugin();
+    pluginMsg->set_name(stats->Name());
+    pluginMsg->set_count(stats->Count());
+    msgs::Set(pluginMsg->mutable_total(), common::Time(stats->TotalTime()));
+    msgs::Set(pluginMsg->mutable_max(), common::Time(stats->MaxTime()));
+    pluginMsg->set_over_budget(stats->OverBudgetCount());
+    for (auto const &bucket : stats->Histogram())
+      pluginMsg->add_histogram(bucket);
+  }
+
+  this->dataPtr->pluginStatPub->Publish(msg);
 }
 
 //////////////////////////////////////////////////
@@ -3050,6 +3128,12 @@ void World::SetAtmosphereEnabled(const bool _enable)
   this->dataPtr->enableAtmosphere = _enable;
 }
 
+/////////////////////////////////////////////////
+LinkStateBuffer &World::LinkStates() const
+{
+  return this->dataPtr->linkStates;
+}
+
 /////////////////////////////////////////////////
 void World::_AddDirty(Entity *_entity)
 {
@@ -3083,6 +3167,74 @@ void World::RegisterIntrospectionItems()
       timeURI.Str(), std::bind(&World::SimTime, this));
 }
 
+/////////////////////////////////////////////////
+void World::RegisterPluginIntrospectionItems(
+    const std::shared_ptr<common::PluginTimeStats> &_stats)
+{
+  // data://world/<world>/plugin/<scope>/.../<plugin>
+  common::URI uri(this->URI());
+  uri.Path().PushBack("plugin");
+  std::string name = _stats->Name();
+  size_t start = 0;
+  size_t end;
+  while ((end = name.find("::", start)) != std::string::npos)
+  {
+    uri.Path().PushBack(name.substr(start, end - start));
+    start = end + 2;
+  }
+  uri.Path().PushBack(name.substr(start));
+
+  std::weak_ptr<common::PluginTimeStats> weakStats = _stats;
+
+  auto fCount = [weakStats]()
+  {
+    auto stats = weakStats.lock();
+    return stats ? static_cast<int>(stats->Count()) : 0;
+  };
+
+  auto fMean = [weakStats]()
+  {
+    auto stats = weakStats.lock();
+    return stats ? stats->MeanTime() : 0.0;
+  };
+
+  auto fMax = [weakStats]()
+  {
+    auto stats = weakStats.lock();
+    return stats ? stats->MaxTime() : 0.0;
+  };
+
+  auto fOverBudget = [weakStats]()
+  {
+    auto stats = weakStats.lock();
+    return stats ? static_cast<int>(stats->OverBudgetCount()) : 0;
+  };
+
+  common::URI countURI(uri);
+  countURI.Query().Insert("p", "int/update_count");
+  this->dataPtr->introspectionItems.push_back(countURI);
+  gazebo::util::IntrospectionManager::Instance()->Register<int>(
+      countURI.Str(), fCount);
+
+  common::URI meanURI(uri);
+  meanURI.Query().Insert("p", "double/update_time_mean");
+  this->dataPtr->introspectionItems.push_back(meanURI);
+  gazebo::util::IntrospectionManager::Instance()->Register<double>(
+      meanURI.Str(), fMean);
+
+  common::URI maxURI(uri);
+  maxURI.Query().Insert("p", "double/update_time_max");
+  this->dataPtr->introspectionItems.push_back(maxURI);
+  gazebo::util::IntrospectionManager::Instance()->Register<double>(
+      maxURI.Str(), fMax);
+
+  common::URI overBudgetURI(uri);
+  overBudgetURI.Query().Insert("p", "int/over_budget_count");
+  this->dataPtr->introspectionItems.push_back(overBudgetURI);
+  gazebo::util::IntrospectionManager::Instance()->Register<int>(
+      overBudgetURI.Str(), fOverBudget);
+}
+
 /////////////////////////////////////////////////
 void World::UnregisterIntrospectionItems()
 {
@@ -3090,6 +3242,7 @@ void World::UnregisterIntrospectionItems()
     util::IntrospectionManager::Instance()->Unregister(item.Str());
 
   this->dataPtr->introspectionItems.clear();
+  this->dataPtr->introspectedPlugins.clear();
 }
 
 //////////////////////////////////////////////////
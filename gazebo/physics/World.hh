@@ -343,6 +343,13 @@ namespace gazebo
       /// \return Reference to the mutex.
       public: std::mutex &WorldPoseMutex() const;
 
+      /// \brief Get the kinematic state of all the links, updated once per
+      /// iteration. Reading it is cheaper than calling Link::WorldPose,
+      /// Link::WorldLinearVel and Link::WorldAngularVel on each link.
+      /// \return Reference to the link state buffer.
+      /// \sa Link::StateIndex
+      public: LinkStateBuffer &LinkStates() const;
+
       /// \brief check if physics engine is enabled/disabled.
       /// \param True if the physics engine is enabled.
       public: bool PhysicsEnabled() const;
@@ -605,6 +612,16 @@ namespace gazebo
       /// \brief Publish the world stats message.
       private: void PublishWorldStats();
 
+      /// \brief Publish the update time of each plugin, and register
+      /// introspection items for plugins seen for the first time.
+      private: void PublishPluginStats();
+
+      /// \brief Register the update time items of a plugin in the
+      /// introspection service.
+      /// \param[in] _stats Update time stats of the plugin.
+      private: void RegisterPluginIntrospectionItems(
+                   const std::shared_ptr<common::PluginTimeStats> &_stats);
+
       /// \brief Thread function for logging state data.
       private: void LogWorker();
 
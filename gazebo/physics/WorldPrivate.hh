@@ -39,6 +39,7 @@
 
 #include "gazebo/transport/TransportTypes.hh"
 
+#include "gazebo/physics/LinkStateBuffer.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/WorldState.hh"
 
@@ -101,6 +102,9 @@ namespace gazebo
       /// \brief Publisher for world statistics messages.
       public: transport::PublisherPtr statPub;
 
+      /// \brief Publisher for plugin update time statistics.
+      public: transport::PublisherPtr pluginStatPub;
+
       /// \brief Publisher for request response messages.
       public: transport::PublisherPtr responsePub;
 
@@ -122,6 +126,10 @@ namespace gazebo
       /// \brief Publisher for local pose messages.
       public: transport::PublisherPtr poseLocalPub;
 
+      /// \brief Expected size in memory of the next pose message, used to
+      /// size its arena.
+      public: size_t posesMsgSize;
+
       /// \brief Subscriber to world control messages.
       public: transport::SubscriberPtr controlSub;
 
@@ -343,6 +351,9 @@ namespace gazebo
       /// physics::Link in World::Update.
       public: std::list<Entity*> dirtyPoses;
 
+      /// \brief Kinematic state of all the links.
+      public: LinkStateBuffer linkStates;
+
       /// \brief Class to manage preset simulation parameter profiles.
       public: PresetManagerPtr presetManager;
 
@@ -362,6 +373,10 @@ namespace gazebo
       /// \brief All the introspection items regsitered for this.
       public: std::vector<common::URI> introspectionItems;
 
+      /// \brief Names of the plugins whose update times have been
+      /// registered as introspection items.
+      public: std::set<std::string> introspectedPlugins;
+
       /// \brief Node for ignition transport communication.
       public: ignition::transport::Node ignNode;
     };
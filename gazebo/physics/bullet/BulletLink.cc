@@ -327,7 +327,7 @@ void BulletLink::OnPoseChange()
     return;
   }
 
-  // this->SetEnabled(true);
+  this->SetEnabled(true);
 
   const ignition::math::Pose3d myPose = this->WorldInertialPose();
 
@@ -338,23 +338,28 @@ void BulletLink::OnPoseChange()
 //////////////////////////////////////////////////
 bool BulletLink::GetEnabled() const
 {
-  // This function and its counterpart BulletLink::SetEnabled
-  // don't do anything yet.
-  return true;
+  if (!this->rigidLink)
+    return true;
+
+  return this->rigidLink->isActive();
 }
 
 //////////////////////////////////////////////////
-void BulletLink::SetEnabled(bool /*_enable*/) const
+void BulletLink::SetEnabled(bool _enable) const
 {
-  /*
   if (!this->rigidLink)
     return;
 
   if (_enable)
+  {
     this->rigidLink->activate(true);
-  else
+  }
+  // Leave bodies which aren't allowed to sleep awake
+  else if (this->rigidLink->getActivationState() != DISABLE_DEACTIVATION &&
+           this->rigidLink->getActivationState() != DISABLE_SIMULATION)
+  {
     this->rigidLink->setActivationState(WANTS_DEACTIVATION);
-    */
+  }
 }
 
 //////////////////////////////////////////////////
@@ -367,6 +372,7 @@ void BulletLink::SetLinearVel(const ignition::math::Vector3d &_vel)
     return;
   }
 
+  this->rigidLink->activate();
   this->rigidLink->setLinearVelocity(BulletTypes::ConvertVector3(_vel));
 }
 
@@ -441,6 +447,7 @@ void BulletLink::SetAngularVel(const ignition::math::Vector3d &_vel)
     return;
   }
 
+  this->rigidLink->activate();
   this->rigidLink->setAngularVelocity(BulletTypes::ConvertVector3(_vel));
 }
 
@@ -466,6 +473,7 @@ void BulletLink::SetForce(const ignition::math::Vector3d &_force)
   if (!this->rigidLink)
     return;
 
+  this->rigidLink->activate();
   this->rigidLink->applyCentralForce(
     btVector3(_force.X(), _force.Y(), _force.Z()));
 }
@@ -493,6 +501,7 @@ void BulletLink::SetTorque(const ignition::math::Vector3d &_torque)
     return;
   }
 
+  this->rigidLink->activate();
   this->rigidLink->applyTorque(BulletTypes::ConvertVector3(_torque));
 }
 
@@ -658,9 +667,24 @@ void BulletLink::AddRelativeTorque(const ignition::math::Vector3d &/*_torque*/)
 }
 
 /////////////////////////////////////////////////
-void BulletLink::SetAutoDisable(bool /*_disable*/)
+void BulletLink::SetAutoDisable(bool _disable)
 {
-  gzlog << "BulletLink::SetAutoDisable not yet implemented." << std::endl;
+  if (!this->rigidLink)
+    return;
+
+  // Same restrictions as at initialization, bodies constrained by joints
+  // or carrying sensors never sleep.
+  if (_disable && this->GetModel()->GetJointCount() == 0 &&
+      this->GetSensorCount() == 0)
+  {
+    this->rigidLink->forceActivationState(ACTIVE_TAG);
+    this->rigidLink->setSleepingThresholds(0.1, 0.1);
+    this->rigidLink->setDeactivationTime(1.0);
+  }
+  else
+  {
+    this->rigidLink->forceActivationState(DISABLE_DEACTIVATION);
+  }
 }
 
 //////////////////////////////////////////////////
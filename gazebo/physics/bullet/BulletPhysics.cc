@@ -514,6 +514,42 @@ void BulletPhysics::UpdatePhysics()
 
   this->dynamicsWorld->stepSimulation(
     this->maxStepSize, 1, this->maxStepSize);
+
+  this->UpdateSleepStatistics();
+}
+
+//////////////////////////////////////////////////
+void BulletPhysics::UpdateSleepStatistics()
+{
+  // Bullet already puts whole islands at rest to sleep and skips the
+  // contacts between sleeping bodies, only count the transitions here.
+  const btCollisionObjectArray &objects =
+      this->dynamicsWorld->getCollisionObjectArray();
+
+  // Bodies were added or removed, start over
+  if (this->sleeping.size() != static_cast<size_t>(objects.size()))
+    this->sleeping.assign(objects.size(), false);
+
+  int asleep = 0;
+  for (int i = 0; i < objects.size(); ++i)
+  {
+    if (objects[i]->isStaticOrKinematicObject())
+      continue;
+
+    bool isAsleep = objects[i]->getActivationState() == ISLAND_SLEEPING;
+    if (isAsleep != this->sleeping[i])
+    {
+      if (isAsleep)
+        ++this->sleepCount;
+      else
+        ++this->wakeCount;
+      this->sleeping[i] = isAsleep;
+    }
+
+    if (isAsleep)
+      ++asleep;
+  }
+  this->sleepingBodies = asleep;
 }
 
 //////////////////////////////////////////////////
@@ -701,6 +737,12 @@ bool BulletPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = this->sdf->GetElement("max_contacts")->Get<int>();
   else if (_key == "min_step_size")
     _value = bulletElem->GetElement("solver")->Get<double>("min_step_size");
+  else if (_key == "sleeping_bodies")
+    _value = this->sleepingBodies;
+  else if (_key == "sleep_count")
+    _value = this->sleepCount;
+  else if (_key == "wake_count")
+    _value = this->wakeCount;
   else
   {
     return PhysicsEngine::GetParam(_key, _value);
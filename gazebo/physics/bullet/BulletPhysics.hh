@@ -22,6 +22,7 @@
 #ifndef BULLETPHYSICS_HH
 #define BULLETPHYSICS_HH
 #include <string>
+#include <vector>
 
 #include <boost/thread/thread.hpp>
 #include <boost/thread/mutex.hpp>
@@ -172,6 +173,10 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetSORPGSIters(unsigned int iters);
 
+      /// \brief Count the bodies which fell asleep or woke up during the
+      /// last step.
+      private: void UpdateSleepStatistics();
+
       private: btBroadphaseInterface *broadPhase;
       private: btDefaultCollisionConfiguration *collisionConfig;
       private: btCollisionDispatcher *dispatcher;
@@ -182,6 +187,19 @@ namespace gazebo
 
       /// \brief The type of the solver.
       private: std::string solverType;
+
+      /// \brief Whether each collision object was asleep after the
+      /// previous step, indexed like the dynamics world's object array.
+      private: std::vector<bool> sleeping;
+
+      /// \brief Number of bodies asleep after the last step.
+      private: int sleepingBodies = 0;
+
+      /// \brief Number of times a body fell asleep.
+      private: int sleepCount = 0;
+
+      /// \brief Number of times a body woke up.
+      private: int wakeCount = 0;
     };
 
   /// \}
@@ -56,7 +56,10 @@ ODECollision::ODECollision(LinkPtr _link)
 ODECollision::~ODECollision()
 {
   if (this->collisionId)
+  {
     dGeomDestroy(this->collisionId);
+    ODEPhysics::CollisionsChanged();
+  }
   this->collisionId = nullptr;
 
   this->Fini();
@@ -107,6 +110,8 @@ void ODECollision::OnPoseChange()
     this->OnPoseChangeGlobal();
   else if (this->collisionId && this->placeable)
     this->OnPoseChangeRelative();
+
+  ODEPhysics::CollisionsChanged();
 }
 
 //////////////////////////////////////////////////
@@ -114,6 +119,7 @@ void ODECollision::SetCollision(dGeomID _collisionId, bool _placeable)
 {
   // Must go first in this function
   this->collisionId = _collisionId;
+  ODEPhysics::CollisionsChanged();
 
   Collision::SetCollision(_placeable);
 
@@ -164,6 +170,7 @@ void ODECollision::SetCategoryBits(unsigned int _bits)
     dGeomSetCategoryBits(this->collisionId, _bits);
   if (this->spaceId)
     dGeomSetCategoryBits((dGeomID)this->spaceId, _bits);
+  ODEPhysics::CollisionsChanged();
 }
 
 //////////////////////////////////////////////////
@@ -173,6 +180,7 @@ void ODECollision::SetCollideBits(unsigned int _bits)
     dGeomSetCollideBits(this->collisionId, _bits);
   if (this->spaceId)
     dGeomSetCollideBits((dGeomID)this->spaceId, _bits);
+  ODEPhysics::CollisionsChanged();
 }
 
 //////////////////////////////////////////////////
@@ -22,6 +22,7 @@
 #include "gazebo/common/Exception.hh"
 
 #include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/LinkStateBuffer.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/WorldPrivate.hh"
 #include "gazebo/physics/Model.hh"
@@ -134,8 +135,15 @@ void ODELink::Init()
 }
 
 //////////////////////////////////////////////////
-void ODELink::DisabledCallback(dBodyID /*_id*/)
+void ODELink::DisabledCallback(dBodyID _id)
 {
+  // ODE zeroes the velocity of bodies it disables
+  ODELink *self = static_cast<ODELink*>(dBodyGetData(_id));
+  if (self && self->StateIndex() >= 0)
+  {
+    self->world->LinkStates().SetVelocity(self->StateIndex(),
+        ignition::math::Vector3d::Zero, ignition::math::Vector3d::Zero);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -162,6 +170,24 @@ void ODELink::MoveCallback(dBodyID _id)
   // Tell the world that our pose has changed.
   self->world->_AddDirty(self);
 
+  // Write the state straight into the world's link state buffer, the
+  // world brackets the physics update with BeginWrite and EndWrite.
+  int stateIndex = self->StateIndex();
+  if (stateIndex >= 0)
+  {
+    const dReal *lvel = dBodyGetLinearVel(_id);
+    const dReal *avel = dBodyGetAngularVel(_id);
+    ignition::math::Vector3d angularVel(avel[0], avel[1], avel[2]);
+
+    // Velocity of the link origin, which is offset from the center of mass
+    ignition::math::Vector3d linearVel(lvel[0], lvel[1], lvel[2]);
+    linearVel -= angularVel.Cross(cog);
+
+    LinkStateBuffer &states = self->world->LinkStates();
+    states.SetPose(stateIndex, self->dirtyPose);
+    states.SetVelocity(stateIndex, linearVel, angularVel);
+  }
+
   // self->poseMutex->unlock();
 
   // get force and applied to this body
@@ -254,6 +280,7 @@ void ODELink::OnPoseChange()
   }
 
   this->SetEnabled(true);
+  ODEPhysics::CollisionsChanged();
 
   const ignition::math::Pose3d myPose = this->WorldPose();
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  *
 */
+#include "gazebo/physics/ode/ODELink.hh"
 #include "gazebo/physics/ode/ODEModel.hh"
 
 using namespace gazebo;
@@ -24,6 +25,9 @@ ODEModel::ODEModel(BasePtr _parent, dSpaceID _parentSpaceId)
   : Model(_parent)
 {
   this->spaceId = dSimpleSpaceCreate(_parentSpaceId);
+
+  // Lets the physics engine find the model of a space during collision
+  dGeomSetData(reinterpret_cast<dGeomID>(this->spaceId), this);
 }
 
 //////////////////////////////////////////////////
@@ -40,3 +44,28 @@ dSpaceID ODEModel::GetSpaceId()
 {
   return this->spaceId;
 }
+
+///////////////////////////////////////////////////
+bool ODEModel::IsAtRest() const
+{
+  if (this->IsStatic())
+    return false;
+
+  bool hasBody = false;
+  for (auto const &link : this->GetLinks())
+  {
+    ODELinkPtr odeLink = boost::static_pointer_cast<ODELink>(link);
+    dBodyID body = odeLink->GetODEId();
+    if (body)
+    {
+      if (dBodyIsEnabled(body))
+        return false;
+      hasBody = true;
+    }
+
+    // Self colliding links have a space of their own in the world space
+    if (odeLink->GetSpaceId() != this->spaceId)
+      return false;
+  }
+  return hasBody;
+}
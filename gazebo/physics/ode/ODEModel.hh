@@ -48,6 +48,12 @@ namespace gazebo
       /// \return The collision space ID for this model.
       public: dSpaceID GetSpaceId();
 
+      /// \brief Check whether the model can be moved out of the broadphase
+      /// as a sleeping island: it is dynamic, every one of its bodies was
+      /// auto-disabled by ODE, and all its geoms live in the model's space.
+      /// \return True if the model is at rest.
+      public: bool IsAtRest() const;
+
       /// \brief The collision space for this model
       private: dSpaceID spaceId;
     };
@@ -97,6 +97,11 @@ void ODEMultiRayShape::UpdateRays()
     dSpaceCollide2((dGeomID) (this->superSpaceId),
         (dGeomID) (ode->GetSpaceId()),
         this, &UpdateCallback);
+
+    // Models at rest can still be seen
+    dSpaceCollide2((dGeomID) (this->superSpaceId),
+        (dGeomID) (ode->SleepingSpaceId()),
+        this, &UpdateCallback);
   }
 }
 
@@ -23,10 +23,13 @@
 
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
+#include <tbb/task_scheduler_observer.h>
 
 #include <sdf/sdf.hh>
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <map>
 #include <string>
 #include <utility>
@@ -53,6 +56,7 @@
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/MapShape.hh"
 #include "gazebo/physics/ContactManager.hh"
+#include "gazebo/physics/RayCastBatch.hh"
 
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODELink.hh"
@@ -131,6 +135,168 @@ class Colliders_TBB
   private: dContactGeom* contactCollisions;
 };
 
+/// \brief Version of the collisions of all the worlds, see
+/// ODEPhysics::CollisionsChanged.
+static std::atomic<uint64_t> g_collisionsVersion(0);
+
+/// \brief Number of rays cast by a TBB task.
+static const unsigned int kRayCastGrainSize = 64;
+
+/// \brief Allocates the ODE data of TBB threads, which collide trimeshes.
+class ODEThreadObserver : public tbb::task_scheduler_observer
+{
+  public: ODEThreadObserver()
+  {
+    this->observe(true);
+  }
+
+  public: virtual void on_scheduler_entry(bool /*_isWorker*/)
+  {
+    dAllocateODEDataForThread(dAllocateMaskAll);
+  }
+};
+
+/// \brief Casts a range of the rays of a batch.
+class RayCast_TBB
+{
+  public: RayCast_TBB(ODEPhysicsPrivate *_data, RayCastBatch *_batch)
+    : data(_data), batch(_batch)
+  {
+  }
+
+  public: void operator() (const tbb::blocked_range<unsigned int> &_r) const
+  {
+    // Each task uses its own ray, set up like the rays of ODEMultiRayShape
+    dGeomID ray = dCreateRay(0, 1.0);
+    dGeomRaySetParams(ray, 0, 0);
+    dGeomRaySetClosestHit(ray, 1);
+
+    for (unsigned int i = _r.begin(); i != _r.end(); ++i)
+    {
+      const ignition::math::Vector3d &start = this->batch->starts[i];
+      double length = start.Distance(this->batch->ends[i]);
+      ODECollision *hit = nullptr;
+
+      if (length > 0)
+      {
+        ignition::math::Vector3d dir = this->batch->ends[i] - start;
+        dir.Normalize();
+        dGeomRaySet(ray, start.X(), start.Y(), start.Z(),
+            dir.X(), dir.Y(), dir.Z());
+        dGeomRaySetLength(ray, length);
+
+        // Nearest hit so far, farther hits are ignored like in
+        // ODEMultiRayShape::UpdateCallback
+        auto test = [this, ray, &hit, &length](const ODERayTarget &_target)
+        {
+          if (this->batch->staticOnly && !_target.collision->IsStatic())
+            return length;
+
+          dContactGeom contact;
+          int n;
+          if (_target.serial)
+          {
+            std::lock_guard<std::mutex> lock(this->data->raySerialMutex);
+            n = dCollide(ray, _target.geom, 1, &contact, sizeof(contact));
+          }
+          else
+            n = dCollide(ray, _target.geom, 1, &contact, sizeof(contact));
+
+          if (n > 0 && contact.depth < length)
+          {
+            length = contact.depth;
+            hit = _target.collision;
+          }
+          return length;
+        };
+
+        for (auto const &target : this->data->rayUnbounded)
+          test(target);
+
+        this->data->rayTree.Raycast(start, dir, length,
+            [this, &test](const unsigned int _index, const double)
+            {
+              return test(this->data->rayTargets[_index]);
+            });
+      }
+
+      this->batch->lengths[i] = length;
+      this->batch->retros[i] = hit ? hit->GetLaserRetro() : 0.0;
+      this->batch->fiducials[i] = -1;
+      this->batch->hits[i] = hit;
+    }
+
+    dGeomDestroy(ray);
+  }
+
+  private: ODEPhysicsPrivate *data;
+  private: RayCastBatch *batch;
+};
+
+/// \brief Add the collisions of a space which a sensor ray can hit to the
+/// ray cast targets.
+/// \param[in] _spaceId The space.
+/// \param[out] _targets Targets with a bounded box.
+/// \param[out] _boxes Boxes of the _targets.
+/// \param[out] _unbounded Targets with an unbounded box.
+static void AddRayTargets(dSpaceID _spaceId,
+    std::vector<ODERayTarget> &_targets,
+    std::vector<ignition::math::Box> &_boxes,
+    std::vector<ODERayTarget> &_unbounded)
+{
+  int count = dSpaceGetNumGeoms(_spaceId);
+  for (int i = 0; i < count; ++i)
+  {
+    dGeomID geom = dSpaceGetGeom(_spaceId, i);
+    if (!dGeomIsEnabled(geom))
+      continue;
+
+    // Same filter dSpaceCollide2 applies to the rays of ODEMultiRayShape
+    if (!(dGeomGetCategoryBits(geom) & ~GZ_SENSOR_COLLIDE) &&
+        !(dGeomGetCollideBits(geom) & GZ_SENSOR_COLLIDE))
+    {
+      continue;
+    }
+
+    if (dGeomIsSpace(geom))
+    {
+      AddRayTargets(reinterpret_cast<dSpaceID>(geom), _targets, _boxes,
+          _unbounded);
+      continue;
+    }
+
+    ODECollision *collision = static_cast<ODECollision *>(
+        dGeomGetData(dGeomGetClass(geom) == dGeomTransformClass ?
+          dGeomTransformGetGeom(geom) : geom));
+    if (!collision)
+      continue;
+
+    ODERayTarget target;
+    target.geom = geom;
+    target.collision = collision;
+    target.serial = dGeomGetClass(geom) == dHeightfieldClass;
+
+    // Also brings the position of the geom up to date, so the threads
+    // casting rays only read it
+    dReal aabb[6];
+    dGeomGetAABB(geom, aabb);
+
+    bool bounded = true;
+    for (int a = 0; a < 6; ++a)
+      bounded = bounded && std::isfinite(aabb[a]);
+
+    if (bounded)
+    {
+      _targets.push_back(target);
+      _boxes.push_back(ignition::math::Box(
+            ignition::math::Vector3d(aabb[0], aabb[2], aabb[4]),
+            ignition::math::Vector3d(aabb[1], aabb[3], aabb[5])));
+    }
+    else
+      _unbounded.push_back(target);
+  }
+}
+
 //////////////////////////////////////////////////
 extern "C" void dMessageQuiet(int, const char *, va_list)
 {
@@ -147,12 +313,18 @@ ODEPhysics::ODEPhysics(WorldPtr _world)
   dInitODE2(0);
 
   dAllocateODEDataForThread(dAllocateMaskAll);
+  this->dataPtr->threadObserver.reset(new ODEThreadObserver());
 
   this->dataPtr->worldId = dWorldCreate();
 
   this->dataPtr->spaceId = dHashSpaceCreate(0);
   dHashSpaceSetLevels(this->dataPtr->spaceId, -2, 8);
 
+  // The model spaces moved here are still owned by their models
+  this->dataPtr->sleepingSpaceId = dHashSpaceCreate(0);
+  dHashSpaceSetLevels(this->dataPtr->sleepingSpaceId, -2, 8);
+  dSpaceSetCleanup(this->dataPtr->sleepingSpaceId, 0);
+
   this->dataPtr->contactGroup = dJointGroupCreate(0);
 
   this->dataPtr->colliders.resize(100);
@@ -378,8 +550,27 @@ void ODEPhysics::UpdateCollision()
   // Reset the contact count
   this->contactManager->ResetCount();
 
+  // Models woken up since the last step collide with everything again
+  if (dSpaceGetNumGeoms(this->dataPtr->sleepingSpaceId) > 0)
+    this->WakeIslands();
+
   // Do collision detection; this will add contacts to the contact group
   dSpaceCollide(this->dataPtr->spaceId, this, CollisionCallback);
+
+  // Sleeping models are only collided against the awake ones, contacts
+  // between two of them are dropped unless someone subscribes to them.
+  if (dSpaceGetNumGeoms(this->dataPtr->sleepingSpaceId) > 0)
+  {
+    dSpaceCollide2(reinterpret_cast<dGeomID>(this->dataPtr->spaceId),
+        reinterpret_cast<dGeomID>(this->dataPtr->sleepingSpaceId), this,
+        SleepingCollisionCallback);
+    if (this->contactManager->NeverDropContacts() ||
+        this->contactManager->SubscribersConnected())
+    {
+      dSpaceCollide(this->dataPtr->sleepingSpaceId, this,
+          CollisionCallback);
+    }
+  }
   DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "dSpaceCollide");
 
   // Generate non-trimesh collisions.
@@ -415,6 +606,7 @@ void ODEPhysics::UpdatePhysics()
     // Update the dynamical model
     (*(this->dataPtr->physicsStepFunc))
       (this->dataPtr->worldId, this->maxStepSize);
+    CollisionsChanged();
 
     ignition::math::Vector3d f1, f2, t1, t2;
 
@@ -447,14 +639,114 @@ void ODEPhysics::UpdatePhysics()
              col2->GetLink()->WorldPose().Rot().RotateVectorReverse(t2);
       }
     }
+
+    if (this->dataPtr->sleepingIslands)
+      this->SleepIslands();
   }
 
   DIAG_TIMER_STOP("ODEPhysics::UpdatePhysics");
 }
 
+//////////////////////////////////////////////////
+bool ODEPhysics::CastRays(RayCastBatch &_batch)
+{
+  // The geoms must not move while the rays are cast
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  uint64_t version = g_collisionsVersion;
+  if (!this->dataPtr->rayTreeValid || version != this->dataPtr->rayTreeVersion)
+  {
+    this->BuildRayCastTree();
+    this->dataPtr->rayTreeVersion = version;
+    this->dataPtr->rayTreeValid = true;
+  }
+
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0, _batch.Size(),
+        kRayCastGrainSize), RayCast_TBB(this->dataPtr, &_batch));
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::CollisionsChanged()
+{
+  ++g_collisionsVersion;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::BuildRayCastTree()
+{
+  this->dataPtr->rayTargets.clear();
+  this->dataPtr->rayUnbounded.clear();
+
+  std::vector<ignition::math::Box> boxes;
+  AddRayTargets(this->dataPtr->spaceId, this->dataPtr->rayTargets, boxes,
+      this->dataPtr->rayUnbounded);
+  AddRayTargets(this->dataPtr->sleepingSpaceId, this->dataPtr->rayTargets,
+      boxes, this->dataPtr->rayUnbounded);
+
+  this->dataPtr->rayTree.Build(boxes);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SleepIslands()
+{
+  // ODE disables the bodies of an island together, so a model whose bodies
+  // are all disabled is part of an island at rest. Collect first, moving a
+  // geom changes the indices of the space.
+  std::vector<dGeomID> atRest;
+  int count = dSpaceGetNumGeoms(this->dataPtr->spaceId);
+  for (int i = 0; i < count; ++i)
+  {
+    dGeomID geom = dSpaceGetGeom(this->dataPtr->spaceId, i);
+    if (!dGeomIsSpace(geom))
+      continue;
+
+    ODEModel *model = static_cast<ODEModel *>(dGeomGetData(geom));
+    if (model && model->IsAtRest())
+      atRest.push_back(geom);
+  }
+
+  for (auto const &geom : atRest)
+  {
+    dSpaceRemove(this->dataPtr->spaceId, geom);
+    dSpaceAdd(this->dataPtr->sleepingSpaceId, geom);
+  }
+  this->dataPtr->sleepCount += static_cast<int>(atRest.size());
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::WakeIslands(const bool _all)
+{
+  // Bodies are enabled by ODE when an awake body touches them, and by
+  // gazebo when a force, velocity or pose is set.
+  std::vector<dGeomID> awake;
+  int count = dSpaceGetNumGeoms(this->dataPtr->sleepingSpaceId);
+  for (int i = 0; i < count; ++i)
+  {
+    dGeomID geom = dSpaceGetGeom(this->dataPtr->sleepingSpaceId, i);
+    ODEModel *model = static_cast<ODEModel *>(dGeomGetData(geom));
+    if (_all || !model || !model->IsAtRest())
+      awake.push_back(geom);
+  }
+
+  for (auto const &geom : awake)
+  {
+    dSpaceRemove(this->dataPtr->sleepingSpaceId, geom);
+    dSpaceAdd(this->dataPtr->spaceId, geom);
+  }
+  this->dataPtr->wakeCount += static_cast<int>(awake.size());
+}
+
 //////////////////////////////////////////////////
 void ODEPhysics::Fini()
 {
+  this->dataPtr->threadObserver.reset();
+  this->dataPtr->rayTargets.clear();
+  this->dataPtr->rayUnbounded.clear();
+  this->dataPtr->rayTree.Clear();
+  this->dataPtr->rayTreeValid = false;
+
   dCloseODE();
 
   if (this->dataPtr->contactGroup)
@@ -469,6 +761,11 @@ void ODEPhysics::Fini()
   }
   this->dataPtr->jointFeedbacks.clear();
 
+  // Must go before the top-level space, but leaves the model spaces alone
+  if (this->dataPtr->sleepingSpaceId)
+    dSpaceDestroy(this->dataPtr->sleepingSpaceId);
+  this->dataPtr->sleepingSpaceId = nullptr;
+
   if (this->dataPtr->spaceId)
   {
     dSpaceSetCleanup(this->dataPtr->spaceId, 0);
@@ -912,6 +1209,12 @@ dSpaceID ODEPhysics::GetSpaceId() const
   return this->dataPtr->spaceId;
 }
 
+//////////////////////////////////////////////////
+dSpaceID ODEPhysics::SleepingSpaceId() const
+{
+  return this->dataPtr->sleepingSpaceId;
+}
+
 //////////////////////////////////////////////////
 std::string ODEPhysics::GetStepType() const
 {
@@ -1007,6 +1310,34 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
   }
 }
 
+//////////////////////////////////////////////////
+void ODEPhysics::SleepingCollisionCallback(void *_data, dGeomID _o1,
+    dGeomID _o2)
+{
+  ODEPhysics *self = static_cast<ODEPhysics*>(_data);
+
+  // Static models have no bodies, their contacts with a sleeping model
+  // would be dropped unless a sensor or a subscriber wants them. In that
+  // case CollisionCallback checks each pair of collisions.
+  if (dGeomGetCategoryBits(_o1) != GZ_SENSOR_COLLIDE &&
+      dGeomGetCategoryBits(_o2) != GZ_SENSOR_COLLIDE &&
+      !self->contactManager->NeverDropContacts() &&
+      !self->contactManager->SubscribersConnected())
+  {
+    for (auto const &geom : {_o1, _o2})
+    {
+      if (dGeomIsSpace(geom))
+      {
+        ODEModel *model = static_cast<ODEModel *>(dGeomGetData(geom));
+        if (model && model->IsStatic())
+          return;
+      }
+    }
+  }
+
+  CollisionCallback(_data, _o1, _o2);
+}
+
 
 //////////////////////////////////////////////////
 void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
@@ -1566,6 +1897,13 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
         dSetMessageHandler(0);
       }
     }
+    else if (_key == "sleeping_islands")
+    {
+      boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+      this->dataPtr->sleepingIslands = boost::any_cast<bool>(_value);
+      if (!this->dataPtr->sleepingIslands)
+        this->WakeIslands(true);
+    }
     else
     {
       return PhysicsEngine::SetParam(_key, _value);
@@ -1659,6 +1997,14 @@ bool ODEPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = dGetMessageHandler() != 0;
   else if (_key == "world_step_solver")
     _value = this->GetWorldStepSolverType();
+  else if (_key == "sleeping_islands")
+    _value = this->dataPtr->sleepingIslands;
+  else if (_key == "sleeping_models")
+    _value = dSpaceGetNumGeoms(this->dataPtr->sleepingSpaceId);
+  else if (_key == "sleep_count")
+    _value = this->dataPtr->sleepCount;
+  else if (_key == "wake_count")
+    _value = this->dataPtr->wakeCount;
   else
   {
     return PhysicsEngine::GetParam(_key, _value);
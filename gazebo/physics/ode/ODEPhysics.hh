@@ -117,6 +117,17 @@ namespace gazebo
       // Documentation inherited
       public: virtual void UpdatePhysics();
 
+      // Documentation inherited
+      public: virtual bool WritesLinkStates() const {return true;}
+
+      // Documentation inherited
+      public: virtual bool CastRays(RayCastBatch &_batch);
+
+      /// \brief Signal that a collision was added, removed or moved outside
+      /// of a physics step, so the snapshot of the collisions used by
+      /// CastRays is built again.
+      public: static void CollisionsChanged();
+
       // Documentation inherited
       public: virtual void Fini();
 
@@ -231,6 +242,11 @@ namespace gazebo
       /// \return The space id for the world.
       public: dSpaceID GetSpaceId() const;
 
+      /// \brief Get the space of the models at rest, which are moved out
+      /// of the world space while sleeping islands are enabled.
+      /// \return The space id of the sleeping models.
+      public: dSpaceID SleepingSpaceId() const;
+
       /// \brief Get the world id.
       /// \return The world id.
       public: dWorldID GetWorldId();
@@ -305,6 +321,28 @@ namespace gazebo
       private: static void CollisionCallback(void *_data, dGeomID _o1,
                                              dGeomID _o2);
 
+      /// \brief Collision callback between the top-level space and the
+      /// space of the sleeping models. Skips the static models, which
+      /// can't wake a sleeping model up.
+      /// \param[in] _data Pointer to user data.
+      /// \param[in] _o1 First geom to check for collisions.
+      /// \param[in] _o2 Second geom to check for collisions.
+      private: static void SleepingCollisionCallback(void *_data,
+                                                     dGeomID _o1,
+                                                     dGeomID _o2);
+
+      /// \brief Gather the collisions rays can hit, and build the bounding
+      /// box tree used by CastRays.
+      private: void BuildRayCastTree();
+
+      /// \brief Move the models which came to rest during the last step to
+      /// the sleeping space.
+      private: void SleepIslands();
+
+      /// \brief Move the sleeping models with an enabled body back to the
+      /// top-level space.
+      /// \param[in] _all True to wake up all the sleeping models.
+      private: void WakeIslands(const bool _all = false);
 
       /// \brief Create a triangle mesh object collider.
       /// \param[in] _collision1 The first collision object.
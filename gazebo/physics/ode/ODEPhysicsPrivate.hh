@@ -18,11 +18,16 @@
 #ifndef _ODEPHYSICS_PRIVATE_HH_
 #define _ODEPHYSICS_PRIVATE_HH_
 
+#include <tbb/task_scheduler_observer.h>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <utility>
 
+#include "gazebo/physics/BoundingBoxTree.hh"
 #include "gazebo/physics/Contact.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 
@@ -45,6 +50,20 @@ namespace gazebo
       public: dJointFeedback feedbacks[MAX_CONTACT_JOINTS];
     };
 
+    /// \brief A collision which rays are cast against.
+    class ODERayTarget
+    {
+      /// \brief Geom of the collision.
+      public: dGeomID geom;
+
+      /// \brief The collision.
+      public: ODECollision *collision;
+
+      /// \brief True if ODE keeps state in the geom while colliding it,
+      /// like heightfields, so it can only be tested by one thread at once.
+      public: bool serial;
+    };
+
     class ODEPhysicsPrivate
     {
       /// \brief Top-level world for all bodies
@@ -89,6 +108,44 @@ namespace gazebo
 
       /// \brief Maximum number of contact points per collision pair.
       public: unsigned int maxContacts;
+
+      /// \brief True to move models at rest out of the top-level space.
+      public: bool sleepingIslands = false;
+
+      /// \brief Space holding the model spaces of the models at rest. Only
+      /// collided against the top-level space.
+      public: dSpaceID sleepingSpaceId = nullptr;
+
+      /// \brief Number of times a model was put to sleep.
+      public: int sleepCount = 0;
+
+      /// \brief Number of times a sleeping model was woken up.
+      public: int wakeCount = 0;
+
+      /// \brief Collisions in the ray cast tree, indexed by tree item.
+      public: std::vector<ODERayTarget> rayTargets;
+
+      /// \brief Collisions with an unbounded box, such as planes, which
+      /// are tested by every ray.
+      public: std::vector<ODERayTarget> rayUnbounded;
+
+      /// \brief Boxes of the rayTargets.
+      public: BoundingBoxTree rayTree;
+
+      /// \brief Version of the collisions the ray cast tree was built
+      /// from, see ODEPhysics::CollisionsChanged.
+      public: uint64_t rayTreeVersion = 0;
+
+      /// \brief True once the ray cast tree was built.
+      public: bool rayTreeValid = false;
+
+      /// \brief Serializes the ray tests against collisions which aren't
+      /// safe to test from several threads at once.
+      public: std::mutex raySerialMutex;
+
+      /// \brief Allocates the ODE thread data of the TBB worker threads
+      /// which cast rays.
+      public: std::unique_ptr<tbb::task_scheduler_observer> threadObserver;
     };
   }
 }
@@ -100,7 +100,8 @@ void UserCamera::Load()
     &UserCamera::OnJoyPose, this);
 
   this->dataPtr->posePub =
-    this->dataPtr->node->Advertise<msgs::Pose>("~/user_camera/pose", 1, 30.0);
+    this->dataPtr->node->Advertise<msgs::Pose>("~/user_camera/pose", 1, 30.0,
+        true);
 }
 
 //////////////////////////////////////////////////
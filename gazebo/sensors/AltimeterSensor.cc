@@ -212,3 +212,10 @@ void AltimeterSensor::SetReferenceAltitude(const double _refAlt)
   // Save the new reference height
   this->dataPtr->altMsg.set_vertical_reference(_refAlt);
 }
+
+//////////////////////////////////////////////////
+bool AltimeterSensor::IsActive() const
+{
+  return Sensor::IsActive() ||
+    (this->dataPtr->altPub && this->dataPtr->altPub->HasConnections());
+}
@@ -81,6 +81,44 @@ TEST_F(CameraSensor_TEST, CreateCamera)
   EXPECT_EQ(sensor->ImageHeight(), 0u);
 }
 
+/////////////////////////////////////////////////
+TEST_F(CameraSensor_TEST, CheckActivity)
+{
+  this->Load("worlds/empty.world");
+  this->SpawnCamera("camera", "camera", ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d::Zero);
+
+  sensors::CameraSensorPtr sensor =
+     std::dynamic_pointer_cast<sensors::CameraSensor>(
+         sensors::SensorManager::Instance()->GetSensor(
+           "default::camera::body::camera"));
+  ASSERT_TRUE(sensor != nullptr);
+
+  // Cameras are updated by the image container, which checks their
+  // activity as well
+  int sleep = 0;
+  int maxSleep = 20;
+  while (sleep < maxSleep && !sensor->ImageData())
+  {
+    sleep++;
+    common::Time::MSleep(100);
+  }
+  EXPECT_TRUE(sensor->ImageData() != nullptr);
+  EXPECT_GT(sensor->ActiveUpdateCount(), 0u);
+
+  // Without always_on and subscribers, the camera is idle
+  sensor->SetActive(false);
+  EXPECT_FALSE(sensor->IsActive());
+  uint64_t idle = sensor->IdleUpdateCount();
+  sleep = 0;
+  while (sleep < maxSleep && sensor->IdleUpdateCount() == idle)
+  {
+    sleep++;
+    common::Time::MSleep(100);
+  }
+  EXPECT_GT(sensor->IdleUpdateCount(), idle);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -21,6 +21,8 @@
 #endif
 
 #include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <functional>
 #include <sstream>
 
 #include "gazebo/common/Exception.hh"
@@ -43,6 +45,48 @@ using namespace sensors;
 
 GZ_REGISTER_STATIC_SENSOR("contact", ContactSensor)
 
+/// \brief Number of world updates whose contacts are kept until the next
+/// sensor update.
+static const unsigned int kMaxIncomingBatches = 100;
+
+//////////////////////////////////////////////////
+/// \brief Fill a contact message from a sample, as
+/// physics::Contact::FillMsg would from the contact.
+/// \param[in] _worldName Name of the world.
+/// \param[in] _sample Contact to convert.
+/// \param[out] _msg Message to fill.
+static void FillContactMsg(const std::string &_worldName,
+    const ContactSample &_sample, msgs::Contact &_msg)
+{
+  const physics::Contact &contact = _sample.contact;
+  _msg.set_world(_worldName);
+  _msg.set_collision1(_sample.collision1);
+  _msg.set_collision2(_sample.collision2);
+  msgs::Set(_msg.mutable_time(), contact.time);
+
+  for (int j = 0; j < contact.count; ++j)
+  {
+    _msg.add_depth(contact.depths[j]);
+
+    msgs::Set(_msg.add_position(), contact.positions[j]);
+    msgs::Set(_msg.add_normal(), contact.normals[j]);
+
+    msgs::JointWrench *jntWrench = _msg.add_wrench();
+    jntWrench->set_body_1_name(_sample.collision1);
+    jntWrench->set_body_1_id(_sample.collision1Id);
+    jntWrench->set_body_2_name(_sample.collision2);
+    jntWrench->set_body_2_id(_sample.collision2Id);
+
+    msgs::Wrench *wrenchMsg = jntWrench->mutable_body_1_wrench();
+    msgs::Set(wrenchMsg->mutable_force(), contact.wrench[j].body1Force);
+    msgs::Set(wrenchMsg->mutable_torque(), contact.wrench[j].body1Torque);
+
+    wrenchMsg = jntWrench->mutable_body_2_wrench();
+    msgs::Set(wrenchMsg->mutable_force(), contact.wrench[j].body2Force);
+    msgs::Set(wrenchMsg->mutable_torque(), contact.wrench[j].body2Torque);
+  }
+}
+
 //////////////////////////////////////////////////
 ContactSensor::ContactSensor()
 : Sensor(sensors::OTHER),
@@ -83,6 +127,9 @@ void ContactSensor::Load(const std::string &_worldName, sdf::ElementPtr _sdf)
     this->dataPtr->contactsPub =
       this->node->Advertise<msgs::Contacts>(topicName, 100);
   }
+
+  this->dataPtr->batchPub = this->node->Advertise<msgs::Contacts>(
+      this->dataPtr->contactsPub->GetTopic() + "/batch", 10);
 }
 
 //////////////////////////////////////////////////
@@ -113,18 +160,48 @@ void ContactSensor::Load(const std::string &_worldName)
     collisionElem = collisionElem->GetNextElement("collision");
   }
 
-  if (!this->dataPtr->collisions.empty())
+  // Sensors start as active, the filter is removed if nothing wants the
+  // contacts
+  this->SetFilterEnabled(true);
+}
+
+//////////////////////////////////////////////////
+void ContactSensor::SetFilterEnabled(const bool _enable)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->filterMutex);
+  if (this->dataPtr->collisions.empty() || !this->world)
+    return;
+
+  physics::ContactManager *mgr = this->world->Physics()->GetContactManager();
+  if (mgr->HasFilter(this->dataPtr->filterName) == _enable)
+    return;
+
+  if (_enable)
   {
-    // request the contact manager to publish messages to a custom topic for
-    // this sensor
-    physics::ContactManager *mgr = this->world->Physics()->GetContactManager();
-    std::string topic = mgr->CreateFilter(this->dataPtr->filterName,
-        this->dataPtr->collisions);
-    if (!this->dataPtr->contactSub)
-    {
-      this->dataPtr->contactSub = this->node->Subscribe(topic,
-          &ContactSensor::OnContacts, this);
-    }
+    // request the contact manager to filter the contacts of this sensor's
+    // collisions, and hand them to us directly after each world update
+    mgr->CreateFilter(this->dataPtr->filterName, this->dataPtr->collisions);
+    mgr->SetFilterCallback(this->dataPtr->filterName,
+        std::bind(&ContactSensor::OnContacts, this, std::placeholders::_1));
+  }
+  else
+  {
+    mgr->RemoveFilter(this->dataPtr->filterName);
+  }
+}
+
+//////////////////////////////////////////////////
+void ContactSensor::OnActivityChanged(const bool _active)
+{
+  this->SetFilterEnabled(_active);
+
+  // Drop the contacts received before the sensor became idle, they would
+  // be stale when it becomes active again
+  if (!_active)
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->incomingCount = 0;
+    this->dataPtr->incomingBatches.clear();
   }
 }
 
@@ -140,87 +217,78 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Don't do anything if there is no new data to process.
-  if (this->dataPtr->incomingContacts.empty())
+  if (this->dataPtr->incomingBatches.empty())
     return false;
 
-  std::vector<std::string>::iterator collIter;
-  std::string collision1;
-
-  // Clear the outgoing contact message.
-  this->dataPtr->contactsMsg.clear_contact();
-
-  // Iterate over all the contact messages
-  for (auto iter = this->dataPtr->incomingContacts.begin();
-       iter != this->dataPtr->incomingContacts.end(); ++iter)
-  {
-    // Iterate over all the contacts in the message
-    for (int i = 0; i < (*iter)->contact_size(); ++i)
-    {
-      collision1 = (*iter)->contact(i).collision1();
-
-      // Try to find the first collision's name
-      collIter = std::find(this->dataPtr->collisions.begin(),
-          this->dataPtr->collisions.end(), collision1);
-
-      // If unable to find the first collision's name, try the second
-      if (collIter == this->dataPtr->collisions.end())
-      {
-        collision1 = (*iter)->contact(i).collision2();
-        collIter = std::find(this->dataPtr->collisions.begin(),
-            this->dataPtr->collisions.end(), collision1);
-      }
-
-      // If this sensor is monitoring one of the collision's in the
-      // contact, then add the contact to our outgoing message.
-      if (collIter != this->dataPtr->collisions.end())
-      {
-        int count = (*iter)->contact(i).position_size();
-
-        // Check to see if the contact arrays all have the same size.
-        if (count != (*iter)->contact(i).normal_size() ||
-            count != (*iter)->contact(i).wrench_size() ||
-            count != (*iter)->contact(i).depth_size())
-        {
-          gzerr << "Contact message has invalid array sizes\n";
-          continue;
-        }
-
-        // Copy the contact message.
-        msgs::Contact *contactMsg = this->dataPtr->contactsMsg.add_contact();
-        contactMsg->CopyFrom((*iter)->contact(i));
-      }
-    }
-  }
-
-  // Clear the incoming contact list.
-  this->dataPtr->incomingContacts.clear();
+  // The contacts received since the last update become the sensor's
+  // contacts, and the previous ones are reused for the next update.
+  std::swap(this->dataPtr->contacts, this->dataPtr->incomingContacts);
+  this->dataPtr->contactCount = this->dataPtr->incomingCount;
+  this->dataPtr->incomingCount = 0;
+  this->dataPtr->incomingBatches.clear();
 
   this->lastMeasurementTime = this->world->SimTime();
-  msgs::Set(this->dataPtr->contactsMsg.mutable_time(),
-            this->lastMeasurementTime);
+  this->dataPtr->contactsMsgDirty = true;
 
   // Generate a outgoing message only if someone is listening.
   if (this->dataPtr->contactsPub &&
       this->dataPtr->contactsPub->HasConnections())
   {
+    this->FillContactsMsg();
     this->dataPtr->contactsPub->Publish(this->dataPtr->contactsMsg);
   }
 
+  // Add the contacts to the batch only if someone is listening. Also
+  // flushes the updates left when batching is turned off.
+  const unsigned int batchSize = this->dataPtr->batchSize;
+  if (this->dataPtr->batchPub &&
+      this->dataPtr->batchPub->HasConnections() &&
+      (batchSize > 1 || this->dataPtr->batchUpdates > 0))
+  {
+    for (unsigned int i = 0; i < this->dataPtr->contactCount; ++i)
+    {
+      FillContactMsg(this->world->Name(), this->dataPtr->contacts[i],
+          *this->dataPtr->batchMsg.add_contact());
+    }
+
+    if (++this->dataPtr->batchUpdates >= batchSize)
+    {
+      msgs::Set(this->dataPtr->batchMsg.mutable_time(),
+          this->lastMeasurementTime);
+      this->dataPtr->batchPub->Publish(this->dataPtr->batchMsg);
+      this->dataPtr->batchMsg.clear_contact();
+      this->dataPtr->batchUpdates = 0;
+    }
+  }
+
   return true;
 }
 
 //////////////////////////////////////////////////
-void ContactSensor::Fini()
+void ContactSensor::FillContactsMsg() const
 {
-  if (this->world && this->world->Running())
+  if (!this->dataPtr->contactsMsgDirty)
+    return;
+
+  this->dataPtr->contactsMsg.clear_contact();
+  for (unsigned int i = 0; i < this->dataPtr->contactCount; ++i)
   {
-    physics::ContactManager *mgr =
-        this->world->Physics()->GetContactManager();
-    mgr->RemoveFilter(this->dataPtr->filterName);
+    FillContactMsg(this->world->Name(), this->dataPtr->contacts[i],
+        *this->dataPtr->contactsMsg.add_contact());
   }
+  msgs::Set(this->dataPtr->contactsMsg.mutable_time(),
+            this->lastMeasurementTime);
+  this->dataPtr->contactsMsgDirty = false;
+}
+
+//////////////////////////////////////////////////
+void ContactSensor::Fini()
+{
+  if (this->world && this->world->Running())
+    this->SetFilterEnabled(false);
 
-  this->dataPtr->contactSub.reset();
   this->dataPtr->contactsPub.reset();
+  this->dataPtr->batchPub.reset();
   Sensor::Fini();
 }
 
@@ -248,12 +316,13 @@ unsigned int ContactSensor::GetCollisionContactCount(
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   unsigned int result = 0;
 
-  for (int i = 0; i < this->dataPtr->contactsMsg.contact_size(); ++i)
+  for (unsigned int i = 0; i < this->dataPtr->contactCount; ++i)
   {
-    if (this->dataPtr->contactsMsg.contact(i).collision1() == _collisionName ||
-        this->dataPtr->contactsMsg.contact(i).collision2() == _collisionName)
+    const ContactSample &sample = this->dataPtr->contacts[i];
+    if (sample.collision1 == _collisionName ||
+        sample.collision2 == _collisionName)
     {
-      result += this->dataPtr->contactsMsg.contact(i).position_size();
+      result += sample.contact.count;
     }
   }
 
@@ -264,6 +333,7 @@ unsigned int ContactSensor::GetCollisionContactCount(
 msgs::Contacts ContactSensor::Contacts() const
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->FillContactsMsg();
   return this->dataPtr->contactsMsg;
 }
 
@@ -275,52 +345,83 @@ std::map<std::string, gazebo::physics::Contact> ContactSensor::Contacts(
 
   std::map<std::string, gazebo::physics::Contact> result;
 
-  std::string collision2;
-
-  for (int i = 0; i < this->dataPtr->contactsMsg.contact_size(); ++i)
+  for (unsigned int i = 0; i < this->dataPtr->contactCount; ++i)
   {
-    collision2.clear();
-
-    if (this->dataPtr->contactsMsg.contact(i).collision1() == _collisionName)
-    {
-      collision2 = this->dataPtr->contactsMsg.contact(i).collision2();
-    }
-    else if (this->dataPtr->contactsMsg.contact(i).collision2() ==
-        _collisionName)
-    {
-      collision2 =  this->dataPtr->contactsMsg.contact(i).collision1();
-    }
-
-    if (collision2.empty())
-      continue;
-
-    result[collision2] = this->dataPtr->contactsMsg.contact(i);
+    const ContactSample &sample = this->dataPtr->contacts[i];
+    if (sample.collision1 == _collisionName)
+      result[sample.collision2] = sample.contact;
+    else if (sample.collision2 == _collisionName)
+      result[sample.collision1] = sample.contact;
   }
 
   return result;
 }
 
 //////////////////////////////////////////////////
-void ContactSensor::OnContacts(ConstContactsPtr &_msg)
+void ContactSensor::OnContacts(
+    const std::vector<physics::Contact *> &_contacts)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Only store information if the sensor is active
-  if (this->IsActive())
+  if (!this->IsActive())
+    return;
+
+  // Copy the contacts for processing in UpdateImpl, reusing the entries of
+  // previous updates. The collisions are only known to exist during this
+  // call, so their names are copied and the copies don't point to them.
+  unsigned int batch = 0;
+  for (auto const &contact : _contacts)
   {
-    // Store the contacts message for processing in UpdateImpl
-    this->dataPtr->incomingContacts.push_back(_msg);
+    if (contact->count == 0)
+      continue;
 
-    // Prevent the incomingContacts list to grow indefinitely.
-    if (this->dataPtr->incomingContacts.size() > 100)
-      this->dataPtr->incomingContacts.pop_front();
+    if (this->dataPtr->incomingCount == this->dataPtr->incomingContacts.size())
+      this->dataPtr->incomingContacts.emplace_back();
+
+    ContactSample &sample =
+        this->dataPtr->incomingContacts[this->dataPtr->incomingCount++];
+    sample.contact = *contact;
+    sample.collision1 = contact->collision1->GetScopedName();
+    sample.collision2 = contact->collision2->GetScopedName();
+    sample.collision1Id = contact->collision1->GetId();
+    sample.collision2Id = contact->collision2->GetId();
+    sample.contact.collision1 = nullptr;
+    sample.contact.collision2 = nullptr;
+    ++batch;
+  }
+  this->dataPtr->incomingBatches.push_back(batch);
+
+  // Prevent the incoming contacts to grow indefinitely, by dropping the
+  // oldest world update.
+  if (this->dataPtr->incomingBatches.size() > kMaxIncomingBatches)
+  {
+    unsigned int oldest = this->dataPtr->incomingBatches.front();
+    auto begin = this->dataPtr->incomingContacts.begin();
+    std::rotate(begin, begin + oldest, begin + this->dataPtr->incomingCount);
+    this->dataPtr->incomingCount -= oldest;
+    this->dataPtr->incomingBatches.pop_front();
   }
 }
 
 //////////////////////////////////////////////////
 bool ContactSensor::IsActive() const
 {
-  return this->active ||
+  return Sensor::IsActive() ||
     (this->dataPtr->contactsPub &&
-     this->dataPtr->contactsPub->HasConnections());
+     this->dataPtr->contactsPub->HasConnections()) ||
+    (this->dataPtr->batchPub &&
+     this->dataPtr->batchPub->HasConnections());
+}
+
+//////////////////////////////////////////////////
+void ContactSensor::SetPublishBatchSize(const unsigned int _size)
+{
+  this->dataPtr->batchSize = std::max(_size, 1u);
+}
+
+//////////////////////////////////////////////////
+unsigned int ContactSensor::PublishBatchSize() const
+{
+  return this->dataPtr->batchSize;
 }
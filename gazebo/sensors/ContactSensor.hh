@@ -20,6 +20,7 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 
@@ -94,10 +95,11 @@ namespace gazebo
       /// to publish all contacts generated within a timestep onto
       /// Gazebo topic ~/physics/contacts.
       ///
-      /// Each ContactSensor subscribes to the Gazebo ~/physics/contacts topic,
-      /// retrieves all contact pairs in a time step and filters them wthin
-      /// ContactSensor::OnContacts against <collision> body name
-      /// specified by the ContactSensor SDF.
+      /// Each ContactSensor registers a filter with the ContactManager for the
+      /// <collision> bodies specified by the ContactSensor SDF, and receives
+      /// the matching contacts of each time step in
+      /// ContactSensor::OnContacts, without going through a topic. The
+      /// message is only built when it is published or requested.
       /// All collision pairs between ContactSensor <collision> body and
       /// other bodies in the world are stored in an array inside
       /// contacts.proto.
@@ -126,15 +128,47 @@ namespace gazebo
 
       /// \brief Gets contacts of a collision
       /// \param[in] _collisionName Name of collision
-      /// \return Container of contacts
+      /// \return Container of contacts, keyed by the scoped name of the
+      /// other collision. The collision1 and collision2 pointers of the
+      /// contacts are null, since the collisions may have been removed.
       public: std::map<std::string, physics::Contact> Contacts(
                   const std::string &_collisionName) const;
 
       // Documentation inherited.
       public: virtual bool IsActive() const;
 
-      /// \brief Callback for contact messages from the physics engine.
-      private: void OnContacts(ConstContactsPtr &_msg);
+      /// \brief Set the number of updates sent per message on the batch
+      /// topic, which is the contact topic followed by "/batch". A batch
+      /// holds the contacts of all its updates, each contact with its own
+      /// time.
+      /// \param[in] _size Number of updates per message, 1 to publish every
+      /// update on its own.
+      public: void SetPublishBatchSize(const unsigned int _size);
+
+      /// \brief Get the number of updates sent per message on the batch
+      /// topic.
+      /// \return Number of updates per message.
+      /// \sa SetPublishBatchSize
+      public: unsigned int PublishBatchSize() const;
+
+      // Documentation inherited.
+      protected: virtual void OnActivityChanged(const bool _active);
+
+      /// \brief Create or remove the contact manager filter of the
+      /// sensor's collisions. Without the filter, the physics engine doesn't
+      /// generate their contacts for the sensor.
+      /// \param[in] _enable True to create the filter, false to remove it.
+      private: void SetFilterEnabled(const bool _enable);
+
+      /// \brief Callback for the filtered contacts from the contact
+      /// manager, after each world update.
+      /// \param[in] _contacts Contacts of the sensor's collisions.
+      private: void OnContacts(
+                   const std::vector<physics::Contact *> &_contacts);
+
+      /// \brief Fill the contacts message from the contacts of the last
+      /// update, if not done yet. The mutex must be locked.
+      private: void FillContactsMsg() const;
 
       /// \internal
       /// \brief Private data pointer
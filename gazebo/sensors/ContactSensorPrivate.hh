@@ -17,18 +17,41 @@
 #ifndef _GAZEBO_SENSORS_CONTACTSENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_CONTACTSENSOR_PRIVATE_HH_
 
+#include <atomic>
+#include <deque>
 #include <vector>
-#include <list>
 #include <string>
 #include <mutex>
 
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/Contact.hh"
 
 namespace gazebo
 {
   namespace sensors
   {
+    /// \internal
+    /// \brief A contact copied from the contact manager, with the names of
+    /// its collisions taken while they were known to exist.
+    class ContactSample
+    {
+      /// \brief The contact, without its collision pointers.
+      public: physics::Contact contact;
+
+      /// \brief Scoped name of the first collision.
+      public: std::string collision1;
+
+      /// \brief Scoped name of the second collision.
+      public: std::string collision2;
+
+      /// \brief Id of the first collision.
+      public: uint32_t collision1Id = 0;
+
+      /// \brief Id of the second collision.
+      public: uint32_t collision2Id = 0;
+    };
+
     /// \internal
     /// \brief Contact sensor private data.
     class ContactSensorPrivate
@@ -39,24 +62,51 @@ namespace gazebo
       /// \brief Output contact information.
       public: transport::PublisherPtr contactsPub;
 
-      /// \brief Subscription to contact messages from the physics engine
-      public: transport::SubscriberPtr contactSub;
-
       /// \brief Mutex to protect reads and writes.
       public: mutable std::mutex mutex;
 
-      /// \brief Contacts message used to output sensor data.
+      /// \brief Contacts message used to output sensor data. Only filled
+      /// from contacts when needed, see contactsMsgDirty.
       public: msgs::Contacts contactsMsg;
 
-      /// \type ContactMsgs_L
-      /// List of contact messages
-      typedef std::list<boost::shared_ptr<msgs::Contacts const> > ContactMsgs_L;
+      /// \brief True if contactsMsg doesn't hold the current contacts yet.
+      public: bool contactsMsgDirty = false;
 
-      /// \brief List of incoming messages.
-      public: ContactMsgs_L incomingContacts;
+      /// \brief Contacts of the last update. Only the first contactCount
+      /// entries are valid, the others are kept to be reused.
+      public: std::vector<ContactSample> contacts;
+
+      /// \brief Number of valid entries in contacts.
+      public: unsigned int contactCount = 0;
+
+      /// \brief Contacts received since the last update, stored like
+      /// contacts.
+      public: std::vector<ContactSample> incomingContacts;
+
+      /// \brief Number of valid entries in incomingContacts.
+      public: unsigned int incomingCount = 0;
+
+      /// \brief Number of contacts received at each world update since the
+      /// last sensor update, oldest first.
+      public: std::deque<unsigned int> incomingBatches;
 
       /// \brief Name of filter used to filter contact messages.
       public: std::string filterName;
+
+      /// \brief Mutex to protect the creation and removal of the filter.
+      public: std::mutex filterMutex;
+
+      /// \brief Publishes the contacts of several updates at once.
+      public: transport::PublisherPtr batchPub;
+
+      /// \brief Contacts waiting to be published on batchPub.
+      public: msgs::Contacts batchMsg;
+
+      /// \brief Number of updates in batchMsg.
+      public: unsigned int batchUpdates = 0;
+
+      /// \brief Number of updates per message on batchPub.
+      public: std::atomic<unsigned int> batchSize{1};
     };
   }
 }
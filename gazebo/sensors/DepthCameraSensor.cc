@@ -21,6 +21,9 @@
 #endif
 
 #include <functional>
+#include <vector>
+
+#include "gazebo/common/Assert.hh"
 
 #include "gazebo/physics/World.hh"
 
@@ -35,6 +38,7 @@
 #include "gazebo/sensors/CameraSensor.hh"
 #include "gazebo/sensors/DepthCameraSensorPrivate.hh"
 #include "gazebo/sensors/DepthCameraSensor.hh"
+#include "gazebo/sensors/RayCastRenderer.hh"
 
 using namespace gazebo;
 using namespace sensors;
@@ -64,11 +68,11 @@ void DepthCameraSensor::Load(const std::string &_worldName)
 //////////////////////////////////////////////////
 void DepthCameraSensor::Init()
 {
-  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
-      rendering::RenderEngine::NONE)
+  // Without rendering, cast the rays against the collisions instead
+  if (RayCastRenderer::Selected(this->Type(), this->ScopedName()))
   {
-    gzerr << "Unable to create DepthCameraSensor. Rendering is disabled."
-        << std::endl;
+    this->InitRayCaster();
+    Sensor::Init();
     return;
   }
 
@@ -133,49 +137,138 @@ void DepthCameraSensor::Init()
 }
 
 //////////////////////////////////////////////////
-bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
+void DepthCameraSensor::InitRayCaster()
 {
-  if (!this->Rendered())
-    return false;
+  // Measurements are timed by the world, there is no scene to render
+  this->scene.reset();
 
-  this->camera->PostRender();
+  const unsigned int width = this->ImageWidth();
+  const unsigned int height = this->ImageHeight();
+  if (width == 0u || height == 0u)
+  {
+    gzerr << "image has zero size" << std::endl;
+    return;
+  }
 
-  if (this->imagePub && this->imagePub->HasConnections())
+  sdf::ElementPtr cameraSdf = this->sdf->GetElement("camera");
+  sdf::ElementPtr clipSdf = cameraSdf->GetElement("clip");
+  this->dataPtr->nearClip = clipSdf->Get<double>("near");
+  this->dataPtr->farClip = clipSdf->Get<double>("far");
+  const double hfov = cameraSdf->Get<double>("horizontal_fov");
+
+  this->dataPtr->cameraPose = this->pose;
+  if (cameraSdf->HasElement("pose"))
+  {
+    this->dataPtr->cameraPose =
+      cameraSdf->Get<ignition::math::Pose3d>("pose") + this->pose;
+  }
+
+  this->dataPtr->parentEntity = this->world->EntityByName(this->ParentName());
+  GZ_ASSERT(this->dataPtr->parentEntity != nullptr,
+      "Unable to get the parent entity.");
+
+  // A ray through the center of each pixel of a pinhole camera looking
+  // along +X, the first row at the top. The rays go from the near to the
+  // far clip plane, so the depth of a hit is linear in the part of its ray
+  // before it.
+  const double focal = 0.5 * width / tan(0.5 * hfov);
+  std::vector<ignition::math::Vector3d> starts;
+  std::vector<ignition::math::Vector3d> ends;
+  starts.reserve(width * height);
+  ends.reserve(width * height);
+  for (unsigned int v = 0; v < height; ++v)
   {
-    msgs::ImageStamped msg;
-    msgs::Set(msg.mutable_time(), this->scene->SimTime());
-    msg.mutable_image()->set_width(this->camera->ImageWidth());
-    msg.mutable_image()->set_height(this->camera->ImageHeight());
-    msg.mutable_image()->set_pixel_format(common::Image::R_FLOAT32);
+    for (unsigned int u = 0; u < width; ++u)
+    {
+      ignition::math::Vector3d dir(1.0,
+          (0.5 * width - u - 0.5) / focal,
+          (0.5 * height - v - 0.5) / focal);
+      starts.push_back(dir * this->dataPtr->nearClip);
+      ends.push_back(dir * this->dataPtr->farClip);
+    }
+  }
 
+  this->dataPtr->rayCaster.reset(new RayCastRenderer(this->world));
+  this->dataPtr->rayCaster->SetRays(starts, ends);
 
-    msg.mutable_image()->set_step(this->camera->ImageWidth() *
-        this->camera->ImageDepth());
+  if (!this->dataPtr->depthBuffer)
+    this->dataPtr->depthBuffer = new float[width * height];
+}
 
-    unsigned int depthSamples = msg.image().width() * msg.image().height();
+//////////////////////////////////////////////////
+void DepthCameraSensor::RayCastDepth()
+{
+  this->lastMeasurementTime = this->world->SimTime();
+  this->dataPtr->rayCaster->Render(
+      this->dataPtr->cameraPose + this->dataPtr->parentEntity->WorldPose());
+
+  const std::vector<double> &fractions = this->dataPtr->rayCaster->Fractions();
+  const double span = this->dataPtr->farClip - this->dataPtr->nearClip;
+  for (unsigned int i = 0; i < fractions.size(); ++i)
+  {
+    this->dataPtr->depthBuffer[i] =
+      this->dataPtr->nearClip + fractions[i] * span;
+  }
+}
+
+//////////////////////////////////////////////////
+bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
+{
+  if (this->dataPtr->rayCaster)
+  {
+    this->RayCastDepth();
+  }
+  else
+  {
+    if (!this->Rendered())
+      return false;
+
+    this->camera->PostRender();
+  }
+
+  if (this->imagePub && this->imagePub->HasConnections())
+  {
+    // Shared with the subscribers instead of copied, with the image
+    // fields in an arena
+    auto msg = msgs::NewArenaMessage<msgs::ImageStamped>();
+    msgs::Set(msg->mutable_time(), this->dataPtr->rayCaster ?
+        this->lastMeasurementTime : this->scene->SimTime());
+    msg->mutable_image()->set_width(this->ImageWidth());
+    msg->mutable_image()->set_height(this->ImageHeight());
+    msg->mutable_image()->set_pixel_format(common::Image::R_FLOAT32);
+
+    unsigned int depthSamples = msg->image().width() * msg->image().height();
     float f;
     // cppchecker recommends using sizeof(varname)
     unsigned int depthBufferSize = depthSamples * sizeof(f);
+    msg->mutable_image()->set_step(msg->image().width() * sizeof(f));
 
-    if (!this->dataPtr->depthBuffer)
-      this->dataPtr->depthBuffer = new float[depthSamples];
+    double nearClip = this->dataPtr->nearClip;
+    double farClip = this->dataPtr->farClip;
+    if (!this->dataPtr->rayCaster)
+    {
+      if (!this->dataPtr->depthBuffer)
+        this->dataPtr->depthBuffer = new float[depthSamples];
 
-    memcpy(this->dataPtr->depthBuffer, this->dataPtr->depthCamera->DepthData(),
-        depthBufferSize);
+      memcpy(this->dataPtr->depthBuffer,
+          this->dataPtr->depthCamera->DepthData(), depthBufferSize);
+      nearClip = this->camera->NearClip();
+      farClip = this->camera->FarClip();
+    }
 
     for (unsigned int i = 0; i < depthSamples; ++i)
     {
       // Mask ranges outside of min/max to +/- inf, as per REP 117
-      if (this->dataPtr->depthBuffer[i] >= this->camera->FarClip())
+      if (this->dataPtr->depthBuffer[i] >= farClip)
       {
         this->dataPtr->depthBuffer[i] = ignition::math::INF_D;
       }
-      else if (this->dataPtr->depthBuffer[i] <= this->camera->NearClip())
+      else if (this->dataPtr->depthBuffer[i] <= nearClip)
       {
         this->dataPtr->depthBuffer[i] = -ignition::math::INF_D;
       }
     }
-    msg.mutable_image()->set_data(this->dataPtr->depthBuffer, depthBufferSize);
+    msg->mutable_image()->set_data(this->dataPtr->depthBuffer, depthBufferSize);
     this->imagePub->Publish(msg);
   }
 
@@ -52,11 +52,14 @@ namespace gazebo
       public: virtual void Init();
 
       /// \brief Gets the raw depth data from the sensor.
-      /// \return The pointer to the depth data array.
+      /// \return The pointer to the depth data array, null before the first
+      /// update.
       public: virtual const float *DepthData() const;
 
       /// \brief Returns a pointer to the rendering::DepthCamera
-      /// \return Depth Camera pointer
+      /// \return Depth Camera pointer, null when the depth image is cast on
+      /// the CPU.
+      /// \sa RayCastRenderer
       public: virtual rendering::DepthCameraPtr DepthCamera() const;
 
       /// \brief Load the sensor with default parameters
@@ -66,6 +69,13 @@ namespace gazebo
       // Documentation inherited
       protected: virtual bool UpdateImpl(const bool _force);
 
+      /// \brief Set up casting a ray through each pixel on the CPU, against
+      /// the collisions of the world, instead of rendering the depth image.
+      private: void InitRayCaster();
+
+      /// \brief Fill the depth buffer by casting the rays.
+      private: void RayCastDepth();
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<DepthCameraSensorPrivate> dataPtr;
@@ -17,7 +17,13 @@
 #ifndef _GAZEBO_SENSORS_DEPTHCAMERASENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_DEPTHCAMERASENSOR_PRIVATE_HH_
 
+#include <memory>
+
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/sensors/RayCastRenderer.hh"
 
 namespace gazebo
 {
@@ -32,6 +38,24 @@ namespace gazebo
 
       /// \brief Local pointer to the depthCamera.
       public: rendering::DepthCameraPtr depthCamera;
+
+      /// \brief Casts a ray through each pixel on the CPU instead of
+      /// rendering the depth image, null when the depth camera is used.
+      public: std::unique_ptr<RayCastRenderer> rayCaster;
+
+      /// \brief Pose of the camera relative to its parent, when the rays
+      /// are cast on the CPU.
+      public: ignition::math::Pose3d cameraPose;
+
+      /// \brief Parent entity of the camera, when the rays are cast on the
+      /// CPU.
+      public: physics::EntityPtr parentEntity;
+
+      /// \brief Near clip distance.
+      public: double nearClip = 0.0;
+
+      /// \brief Far clip distance.
+      public: double farClip = 0.0;
     };
   }
 }
@@ -20,6 +20,9 @@
   #include <Winsock2.h>
 #endif
 
+#include <algorithm>
+#include <vector>
+
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/physics/World.hh"
@@ -167,6 +170,8 @@ void ForceTorqueSensor::Load(const std::string &_worldName)
 
   this->dataPtr->wrenchPub =
     this->node->Advertise<msgs::WrenchStamped>(this->Topic());
+  this->dataPtr->batchPub =
+    this->node->Advertise<msgs::WrenchStamped_V>(this->Topic() + "/batch");
 }
 
 //////////////////////////////////////////////////
@@ -180,6 +185,7 @@ void ForceTorqueSensor::Init()
 void ForceTorqueSensor::Fini()
 {
   this->dataPtr->wrenchPub.reset();
+  this->dataPtr->batchPub.reset();
   this->dataPtr->parentJoint.reset();
 
   Sensor::Fini();
@@ -270,10 +276,34 @@ bool ForceTorqueSensor::UpdateImpl(const bool /*_force*/)
   msgs::Set(this->dataPtr->wrenchMsg.mutable_wrench()->mutable_torque(),
       measuredTorque);
 
+  WrenchSample sample;
+  sample.force = measuredForce;
+  sample.torque = measuredTorque;
+  this->dataPtr->history.Push(this->lastMeasurementTime, sample);
+
   this->dataPtr->update(this->dataPtr->wrenchMsg);
 
-  if (this->dataPtr->wrenchPub)
+  // Publish the message, on its own only if someone listens when
+  // batching
+  const unsigned int batchSize = this->dataPtr->batchSize;
+  if (this->dataPtr->wrenchPub &&
+      (batchSize <= 1 || this->dataPtr->wrenchPub->HasConnections()))
+  {
     this->dataPtr->wrenchPub->Publish(this->dataPtr->wrenchMsg);
+  }
+
+  // Also flushes the measures left when batching is turned off
+  if (this->dataPtr->batchPub &&
+      (batchSize > 1 || this->dataPtr->batchMsg.wrench_size() > 0))
+  {
+    this->dataPtr->batchMsg.add_wrench()->CopyFrom(this->dataPtr->wrenchMsg);
+    if (static_cast<unsigned int>(
+          this->dataPtr->batchMsg.wrench_size()) >= batchSize)
+    {
+      this->dataPtr->batchPub->Publish(this->dataPtr->batchMsg);
+      this->dataPtr->batchMsg.Clear();
+    }
+  }
 
   return true;
 }
@@ -281,7 +311,8 @@ bool ForceTorqueSensor::UpdateImpl(const bool /*_force*/)
 //////////////////////////////////////////////////
 bool ForceTorqueSensor::IsActive() const
 {
-  return Sensor::IsActive() || this->dataPtr->wrenchPub->HasConnections();
+  return Sensor::IsActive() || this->dataPtr->wrenchPub->HasConnections() ||
+    (this->dataPtr->batchPub && this->dataPtr->batchPub->HasConnections());
 }
 
 //////////////////////////////////////////////////
@@ -290,3 +321,39 @@ event::ConnectionPtr ForceTorqueSensor::ConnectUpdate(
 {
   return this->dataPtr->update.Connect(_subscriber);
 }
+
+//////////////////////////////////////////////////
+unsigned int ForceTorqueSensor::History(const unsigned int _count,
+    msgs::WrenchStamped_V &_history) const
+{
+  std::vector<SampleHistory<WrenchSample>::Sample> samples;
+  this->dataPtr->history.Last(_count, samples);
+
+  _history.Clear();
+  for (auto const &sample : samples)
+  {
+    msgs::WrenchStamped *msg = _history.add_wrench();
+    msgs::Set(msg->mutable_time(), sample.time);
+    msgs::Set(msg->mutable_wrench()->mutable_force(), sample.value.force);
+    msgs::Set(msg->mutable_wrench()->mutable_torque(), sample.value.torque);
+  }
+  return _history.wrench_size();
+}
+
+//////////////////////////////////////////////////
+unsigned int ForceTorqueSensor::HistorySize() const
+{
+  return this->dataPtr->history.Capacity();
+}
+
+//////////////////////////////////////////////////
+void ForceTorqueSensor::SetPublishBatchSize(const unsigned int _size)
+{
+  this->dataPtr->batchSize = std::max(_size, 1u);
+}
+
+//////////////////////////////////////////////////
+unsigned int ForceTorqueSensor::PublishBatchSize() const
+{
+  return this->dataPtr->batchSize;
+}
@@ -82,6 +82,35 @@ namespace gazebo
       public: event::ConnectionPtr ConnectUpdate(
                   std::function<void (msgs::WrenchStamped)> _subscriber);
 
+      /// \brief Get the last measures of the sensor, oldest first. The
+      /// measures are read without blocking the sensor, so a plugin running
+      /// slower than the sensor can get every measure it missed.
+      /// \param[in] _count Maximum number of measures, at most
+      /// HistorySize().
+      /// \param[out] _history The measures, replaced.
+      /// \return Number of measures.
+      public: unsigned int History(const unsigned int _count,
+                  msgs::WrenchStamped_V &_history) const;
+
+      /// \brief Get the number of measures kept by the sensor.
+      /// \return Number of measures.
+      /// \sa History
+      public: unsigned int HistorySize() const;
+
+      /// \brief Set the number of measures sent per message on the batch
+      /// topic, which is Topic() followed by "/batch". With more than one
+      /// measure per batch, a message per measure is only published while
+      /// Topic() has subscribers.
+      /// \param[in] _size Number of measures per msgs::WrenchStamped_V
+      /// message, 1 to publish every measure on its own.
+      public: void SetPublishBatchSize(const unsigned int _size);
+
+      /// \brief Get the number of measures sent per message on the batch
+      /// topic.
+      /// \return Number of measures per msgs::WrenchStamped_V message.
+      /// \sa SetPublishBatchSize
+      public: unsigned int PublishBatchSize() const;
+
       // Documentation inherited.
       protected: virtual bool UpdateImpl(const bool _force);
 
@@ -17,20 +17,37 @@
 #ifndef _GAZEBO_SENSORS_FORCETORQUESENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_FORCETORQUESENSOR_PRIVATE_HH_
 
+#include <atomic>
 #include <mutex>
 #include <ignition/math/Matrix3.hh>
+#include <ignition/math/Vector3.hh>
 
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/sensors/SampleHistory.hh"
 #include "gazebo/transport/TransportTypes.hh"
 
 namespace gazebo
 {
   namespace sensors
   {
+    /// \internal
+    /// \brief A force torque measure.
+    class WrenchSample
+    {
+      /// \brief Measured force.
+      public: ignition::math::Vector3d force;
+
+      /// \brief Measured torque.
+      public: ignition::math::Vector3d torque;
+    };
+
     /// \internal
     /// \brief Force torque sensor private data.
     class ForceTorqueSensorPrivate
     {
+      /// \brief Number of measures kept in the history.
+      public: static constexpr unsigned int kHistorySize = 1000;
+
       /// \brief Update event.
       public: event::EventT<void(msgs::WrenchStamped)> update;
 
@@ -66,6 +83,18 @@ namespace gazebo
       ///        orientation in a vector expressed in joint orientation.
       ///        Necessary is the measure is specified in joint frame.
       public: ignition::math::Matrix3d rotationSensorChild;
+
+      /// \brief Last measures, written by UpdateImpl only.
+      public: SampleHistory<WrenchSample> history{kHistorySize};
+
+      /// \brief Publishes batches of measures.
+      public: transport::PublisherPtr batchPub;
+
+      /// \brief Measures waiting to be published on batchPub.
+      public: msgs::WrenchStamped_V batchMsg;
+
+      /// \brief Number of measures per message on batchPub.
+      public: std::atomic<unsigned int> batchSize{1};
     };
   }
 }
@@ -74,6 +74,17 @@ void ForceTorqueSensor_TEST::ForceTorqueTest(const std::string &_physicsEngine)
   EXPECT_EQ(sensor->Force(), ignition::math::Vector3d(0, 0, 0));
 
   EXPECT_TRUE(sensor->IsActive());
+
+  // Nothing measured yet
+  msgs::WrenchStamped_V history;
+  EXPECT_GT(sensor->HistorySize(), 0u);
+  EXPECT_EQ(sensor->History(10, history), 0u);
+
+  EXPECT_EQ(sensor->PublishBatchSize(), 1u);
+  sensor->SetPublishBatchSize(10);
+  EXPECT_EQ(sensor->PublishBatchSize(), 10u);
+  sensor->SetPublishBatchSize(0);
+  EXPECT_EQ(sensor->PublishBatchSize(), 1u);
 }
 
 /////////////////////////////////////////////////
@@ -145,17 +145,35 @@ void GaussianNoiseModel::Fini()
 double GaussianNoiseModel::ApplyImpl(double _in)
 {
   // Add independent (uncorrelated) Gaussian noise to each input value.
-  double whiteNoise = ignition::math::Rand::DblNormal(this->mean, this->stdDev);
-  double output = _in + this->bias + whiteNoise;
+  double whiteNoise = this->random.Normal(this->mean, this->stdDev);
+  return this->Quantize(_in + this->bias + whiteNoise);
+}
+
+//////////////////////////////////////////////////
+void GaussianNoiseModel::ApplyImpl(double *_data, const size_t _count)
+{
+  // Draw all the white noise at once
+  this->samples.resize(_count);
+  this->random.Normal(this->samples.data(), _count, this->mean,
+      this->stdDev);
+
+  for (size_t i = 0; i < _count; ++i)
+    _data[i] += this->bias + this->samples[i];
+
   if (this->quantized)
   {
-    // Apply this->precision
-    if (!ignition::math::equal(this->precision, 0.0, 1e-6))
-    {
-      output = std::round(output / this->precision) * this->precision;
-    }
+    for (size_t i = 0; i < _count; ++i)
+      _data[i] = this->Quantize(_data[i]);
   }
-  return output;
+}
+
+//////////////////////////////////////////////////
+double GaussianNoiseModel::Quantize(const double _value) const
+{
+  // Apply this->precision
+  if (this->quantized && !ignition::math::equal(this->precision, 0.0, 1e-6))
+    return std::round(_value / this->precision) * this->precision;
+  return _value;
 }
 
 //////////////////////////////////////////////////
@@ -57,6 +57,9 @@ namespace gazebo
         // Documentation inherited.
         public: double ApplyImpl(double _in);
 
+        // Documentation inherited.
+        public: virtual void ApplyImpl(double *_data, const size_t _count);
+
         /// \brief Accessor for mean.
         /// \return Mean of Gaussian noise.
         public: double GetMean() const;
@@ -83,6 +86,11 @@ namespace gazebo
         /// \brief Sample the bias.
         private: void SampleBias();
 
+        /// \brief Round a value to the precision, if quantized.
+        /// \param[in] _value The value.
+        /// \return The rounded value.
+        private: double Quantize(const double _value) const;
+
         /// \brief If type starts with GAUSSIAN, the mean of the distribution
         /// from which we sample when adding noise.
         protected: double mean;
@@ -108,6 +116,9 @@ namespace gazebo
         /// \brief The standard deviation of the Gaussian distribution from
         /// which bias values are drawn.
         private: double biasStdDev;
+
+        /// \brief Samples of white noise, reused between calls.
+        private: std::vector<double> samples;
     };
 
     /// \class GaussianNoiseModel
@@ -241,3 +241,10 @@ double GpsSensor::VelocityUp() const
 {
   return this->dataPtr->lastGpsMsg.velocity_up();
 }
+
+//////////////////////////////////////////////////
+bool GpsSensor::IsActive() const
+{
+  return Sensor::IsActive() ||
+    (this->dataPtr->gpsPub && this->dataPtr->gpsPub->HasConnections());
+}
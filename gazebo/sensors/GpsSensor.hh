@@ -57,6 +57,9 @@ namespace gazebo
       // Documentation inherited
       public: virtual void Init();
 
+      // Documentation inherited
+      public: virtual bool IsActive() const;
+
       // Documentation inherited
       protected: virtual bool UpdateImpl(const bool _force);
 
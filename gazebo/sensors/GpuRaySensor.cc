@@ -39,6 +39,7 @@
 #include "gazebo/rendering/GpuLaser.hh"
 
 #include "gazebo/sensors/Noise.hh"
+#include "gazebo/sensors/RayCastRenderer.hh"
 #include "gazebo/sensors/SensorFactory.hh"
 #include "gazebo/sensors/GpuRaySensorPrivate.hh"
 #include "gazebo/sensors/GpuRaySensor.hh"
@@ -130,10 +131,11 @@ void GpuRaySensor::Load(const std::string &_worldName)
 //////////////////////////////////////////////////
 void GpuRaySensor::Init()
 {
-  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
-      rendering::RenderEngine::NONE)
+  // Without rendering, cast the rays against the collisions instead
+  if (RayCastRenderer::Selected(this->Type(), this->ScopedName()))
   {
-    gzerr << "Unable to create GpuRaySensor. Rendering is disabled.\n";
+    this->InitRayCaster();
+    Sensor::Init();
     return;
   }
 
@@ -329,10 +331,52 @@ void GpuRaySensor::Init()
   Sensor::Init();
 }
 
+//////////////////////////////////////////////////
+void GpuRaySensor::InitRayCaster()
+{
+  // Measurements are timed by the world, there is no scene to render
+  this->scene.reset();
+
+  // One ray per range, no interpolation between rays
+  const unsigned int horzCount = this->dataPtr->horzRangeCount;
+  const unsigned int vertCount = this->dataPtr->vertRangeCount;
+  const double horzStep = horzCount > 1 ? this->AngleResolution() : 0.0;
+  const double vertStep =
+    vertCount > 1 ? this->VerticalAngleResolution() : 0.0;
+  const double horzMin = this->AngleMin().Radian();
+  const double vertMin = this->VerticalAngleMin().Radian();
+
+  std::vector<ignition::math::Vector3d> starts;
+  std::vector<ignition::math::Vector3d> ends;
+  starts.reserve(horzCount * vertCount);
+  ends.reserve(horzCount * vertCount);
+  for (unsigned int j = 0; j < vertCount; ++j)
+  {
+    for (unsigned int i = 0; i < horzCount; ++i)
+    {
+      // Same directions as the rays of RaySensor
+      ignition::math::Quaterniond ray(0.0, -(vertMin + j * vertStep),
+          horzMin + i * horzStep);
+      ignition::math::Vector3d axis = ray * ignition::math::Vector3d::UnitX;
+      starts.push_back(axis * this->dataPtr->rangeMin);
+      ends.push_back(axis * this->dataPtr->rangeMax);
+    }
+  }
+
+  this->dataPtr->rayCaster.reset(new RayCastRenderer(this->world));
+  this->dataPtr->rayCaster->SetRays(starts, ends);
+  this->dataPtr->laserFrame.assign(horzCount * vertCount * 3, 0.0f);
+  this->dataPtr->rangeCountRatio =
+    static_cast<double>(horzCount) / vertCount;
+
+  this->dataPtr->laserMsg.mutable_scan()->set_frame(this->ParentName());
+}
+
 //////////////////////////////////////////////////
 void GpuRaySensor::Fini()
 {
   this->dataPtr->scanPub.reset();
+  this->dataPtr->rayCaster.reset();
 
   if (this->dataPtr->laserCam)
   {
@@ -349,48 +393,72 @@ event::ConnectionPtr GpuRaySensor::ConnectNewLaserFrame(
   std::function<void(const float *, unsigned int, unsigned int, unsigned int,
   const std::string &)> _subscriber)
 {
+  if (this->dataPtr->rayCaster)
+    return this->dataPtr->newLaserFrame.Connect(_subscriber);
+
   return this->dataPtr->laserCam->ConnectNewLaserFrame(_subscriber);
 }
 
 //////////////////////////////////////////////////
 unsigned int GpuRaySensor::CameraCount() const
 {
+  if (this->dataPtr->rayCaster)
+    return 1;
+
   return this->dataPtr->laserCam->CameraCount();
 }
 
 //////////////////////////////////////////////////
 bool GpuRaySensor::IsHorizontal() const
 {
+  if (this->dataPtr->rayCaster)
+    return true;
+
   return this->dataPtr->laserCam->IsHorizontal();
 }
 
 //////////////////////////////////////////////////
 double GpuRaySensor::HorzFOV() const
 {
+  if (this->dataPtr->rayCaster)
+    return (this->AngleMax() - this->AngleMin()).Radian();
+
   return this->dataPtr->laserCam->HorzFOV();
 }
 
 //////////////////////////////////////////////////
 double GpuRaySensor::CosHorzFOV() const
 {
+  if (this->dataPtr->rayCaster)
+    return this->HorzFOV();
+
   return this->dataPtr->laserCam->CosHorzFOV();
 }
 
 //////////////////////////////////////////////////
 double GpuRaySensor::VertFOV() const
 {
+  if (this->dataPtr->rayCaster)
+    return (this->VerticalAngleMax() - this->VerticalAngleMin()).Radian();
+
   return this->dataPtr->laserCam->VertFOV();
 }
 
 //////////////////////////////////////////////////
 double GpuRaySensor::CosVertFOV() const
 {
+  if (this->dataPtr->rayCaster)
+    return this->VertFOV();
+
   return this->dataPtr->laserCam->CosVertFOV();
 }
 
 //////////////////////////////////////////////////
 double GpuRaySensor::RayCountRatio() const
 {
+  if (this->dataPtr->rayCaster)
+    return this->dataPtr->rangeCountRatio;
+
   return this->dataPtr->laserCam->RayCountRatio();
 }
 
@@ -580,79 +648,122 @@ void GpuRaySensor::Render()
 //////////////////////////////////////////////////
 bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
 {
-  if (!this->dataPtr->rendered)
-    return false;
+  if (this->dataPtr->rayCaster)
+  {
+    this->lastMeasurementTime = this->world->SimTime();
+    this->dataPtr->rayCaster->Render(
+        this->pose + this->dataPtr->parentEntity->WorldPose());
+  }
+  else
+  {
+    if (!this->dataPtr->rendered)
+      return false;
 
-  this->dataPtr->laserCam->PostRender();
+    this->dataPtr->laserCam->PostRender();
+  }
 
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  msgs::Set(this->dataPtr->laserMsg.mutable_time(),
-      this->lastMeasurementTime);
+    msgs::Set(this->dataPtr->laserMsg.mutable_time(),
+        this->lastMeasurementTime);
 
-  msgs::LaserScan *scan = this->dataPtr->laserMsg.mutable_scan();
+    msgs::LaserScan *scan = this->dataPtr->laserMsg.mutable_scan();
 
-  // Store the latest laser scans into laserMsg
-  msgs::Set(scan->mutable_world_pose(),
-      this->pose + this->dataPtr->parentEntity->WorldPose());
-  scan->set_angle_min(this->AngleMin().Radian());
-  scan->set_angle_max(this->AngleMax().Radian());
-  scan->set_angle_step(this->AngleResolution());
-  scan->set_count(this->RangeCount());
+    // Store the latest laser scans into laserMsg
+    msgs::Set(scan->mutable_world_pose(),
+        this->pose + this->dataPtr->parentEntity->WorldPose());
+    scan->set_angle_min(this->AngleMin().Radian());
+    scan->set_angle_max(this->AngleMax().Radian());
+    scan->set_angle_step(this->AngleResolution());
+    scan->set_count(this->RangeCount());
 
-  scan->set_vertical_angle_min(this->VerticalAngleMin().Radian());
-  scan->set_vertical_angle_max(this->VerticalAngleMax().Radian());
-  scan->set_vertical_angle_step(this->VerticalAngleResolution());
-  scan->set_vertical_count(this->dataPtr->vertRangeCount);
+    scan->set_vertical_angle_min(this->VerticalAngleMin().Radian());
+    scan->set_vertical_angle_max(this->VerticalAngleMax().Radian());
+    scan->set_vertical_angle_step(this->VerticalAngleResolution());
+    scan->set_vertical_count(this->dataPtr->vertRangeCount);
 
-  scan->set_range_min(this->dataPtr->rangeMin);
-  scan->set_range_max(this->dataPtr->rangeMax);
+    scan->set_range_min(this->dataPtr->rangeMin);
+    scan->set_range_max(this->dataPtr->rangeMax);
 
-  const int numRays = this->dataPtr->vertRangeCount *
-    this->dataPtr->horzRangeCount;
-  if (scan->ranges_size() != numRays)
-  {
-    // gzdbg << "Size mismatch; allocating memory\n";
-    scan->clear_ranges();
-    scan->clear_intensities();
-    for (int i = 0; i < numRays; ++i)
+    const int numRays = this->dataPtr->vertRangeCount *
+      this->dataPtr->horzRangeCount;
+    if (scan->ranges_size() != numRays)
     {
-      scan->add_ranges(ignition::math::NAN_F);
-      scan->add_intensities(ignition::math::NAN_F);
+      // gzdbg << "Size mismatch; allocating memory\n";
+      scan->clear_ranges();
+      scan->clear_intensities();
+      for (int i = 0; i < numRays; ++i)
+      {
+        scan->add_ranges(ignition::math::NAN_F);
+        scan->add_intensities(ignition::math::NAN_F);
+      }
     }
-  }
 
-  auto dataIter = this->dataPtr->laserCam->LaserDataBegin();
-  auto dataEnd = this->dataPtr->laserCam->LaserDataEnd();
-  for (int i = 0; dataIter != dataEnd; ++dataIter, ++i)
-  {
-    const rendering::GpuLaserData data = *dataIter;
-    double range = data.range;
-    double intensity = data.intensity;
+    auto setReading = [&](const int _index, double _range,
+        const double _intensity)
+    {
+      // Mask ranges outside of min/max to +/- inf, as per REP 117
+      if (_range >= this->dataPtr->rangeMax)
+      {
+        _range = ignition::math::INF_D;
+      }
+      else if (_range <= this->dataPtr->rangeMin)
+      {
+        _range = -ignition::math::INF_D;
+      }
+
+      _range = ignition::math::isnan(_range) ? this->dataPtr->rangeMax : _range;
+      scan->set_ranges(_index, _range);
+      scan->set_intensities(_index, _intensity);
+    };
 
-    // Mask ranges outside of min/max to +/- inf, as per REP 117
-    if (range >= this->dataPtr->rangeMax)
+    if (this->dataPtr->rayCaster)
     {
-      range = ignition::math::INF_D;
+      const std::vector<double> &fractions =
+        this->dataPtr->rayCaster->Fractions();
+      const std::vector<double> &retros = this->dataPtr->rayCaster->Retros();
+      const double rangeSpan =
+        this->dataPtr->rangeMax - this->dataPtr->rangeMin;
+      for (int i = 0; i < numRays; ++i)
+      {
+        double range = this->dataPtr->rangeMin + fractions[i] * rangeSpan;
+        this->dataPtr->laserFrame[i * 3] = range;
+        this->dataPtr->laserFrame[i * 3 + 1] = retros[i];
+        setReading(i, range, retros[i]);
+      }
     }
-    else if (range <= this->dataPtr->rangeMin)
+    else
     {
-      range = -ignition::math::INF_D;
+      auto dataIter = this->dataPtr->laserCam->LaserDataBegin();
+      auto dataEnd = this->dataPtr->laserCam->LaserDataEnd();
+      for (int i = 0; dataIter != dataEnd; ++dataIter, ++i)
+      {
+        const rendering::GpuLaserData data = *dataIter;
+        setReading(i, data.range, data.intensity);
+      }
     }
-    else if (this->noises.find(GPU_RAY_NOISE) != this->noises.end())
+
+    // Noise on all the ranges which aren't masked at once
+    auto noise = this->noises.find(GPU_RAY_NOISE);
+    if (noise != this->noises.end())
     {
-      range = this->noises[GPU_RAY_NOISE]->Apply(range);
-      range = ignition::math::clamp(range,
-          this->dataPtr->rangeMin, this->dataPtr->rangeMax);
+      noise->second->ApplyInRange(scan->mutable_ranges()->mutable_data(),
+          scan->ranges_size(), this->dataPtr->rangeMin,
+          this->dataPtr->rangeMax);
     }
 
-    range = ignition::math::isnan(range) ? this->dataPtr->rangeMax : range;
-    scan->set_ranges(i, range);
-    scan->set_intensities(i, intensity);
+    if (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections())
+      this->dataPtr->scanPub->Publish(this->dataPtr->laserMsg);
   }
 
-  if (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections())
-    this->dataPtr->scanPub->Publish(this->dataPtr->laserMsg);
+  // Outside of the lock, subscribers may read the ranges
+  if (this->dataPtr->rayCaster)
+  {
+    this->dataPtr->newLaserFrame(this->dataPtr->laserFrame.data(),
+        this->dataPtr->horzRangeCount, this->dataPtr->vertRangeCount, 3,
+        "FLOAT32");
+  }
 
   this->dataPtr->rendered = false;
 
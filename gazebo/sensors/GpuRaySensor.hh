@@ -78,7 +78,9 @@ namespace gazebo
       public: virtual std::string Topic() const;
 
       /// \brief Returns a pointer to the internally kept rendering::GpuLaser
-      /// \return Pointer to GpuLaser
+      /// \return Pointer to GpuLaser, null when the rays are cast on the
+      /// CPU.
+      /// \sa RayCastRenderer
       public: rendering::GpuLaserPtr LaserCamera() const;
 
       /// \brief Get the minimum angle
@@ -251,6 +253,10 @@ namespace gazebo
       /// brief Render the camera.
       private: void Render();
 
+      /// \brief Set up casting the rays on the CPU, against the
+      /// collisions of the world, instead of rendering them.
+      private: void InitRayCaster();
+
       /// \internal
       /// \brief Private data pointer.
       private: std::unique_ptr<GpuRaySensorPrivate> dataPtr;
@@ -17,13 +17,18 @@
 #ifndef _GAZEBO_SENSORS_GPURAYENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_GPURAYENSOR_PRIVATE_HH_
 
+#include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 #include <sdf/sdf.hh>
 
+#include "gazebo/common/Event.hh"
 #include "gazebo/rendering/RenderTypes.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/sensors/RayCastRenderer.hh"
 
 namespace gazebo
 {
@@ -86,6 +91,19 @@ namespace gazebo
 
       /// \brief True if the sensor was rendered.
       public: bool rendered;
+
+      /// \brief Casts the rays on the CPU instead of rendering them, null
+      /// when the GPU laser is used.
+      public: std::unique_ptr<RayCastRenderer> rayCaster;
+
+      /// \brief Range and intensity of each reading cast on the CPU, three
+      /// floats per reading like the frames of the GPU laser.
+      public: std::vector<float> laserFrame;
+
+      /// \brief New laser frame event, when the rays are cast on the CPU.
+      public: event::EventT<void(const float *_frame, unsigned int _width,
+                  unsigned int _height, unsigned int _depth,
+                  const std::string &_format)> newLaserFrame;
     };
   }
 }
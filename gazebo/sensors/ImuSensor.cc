@@ -20,9 +20,13 @@
   #include <Winsock2.h>
 #endif
 
+#include <algorithm>
+#include <vector>
+
 #include <boost/algorithm/string.hpp>
 #include <ignition/math/Rand.hh>
 
+#include "gazebo/common/Events.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publisher.hh"
 
@@ -45,10 +49,7 @@ ImuSensor::ImuSensor()
 : Sensor(sensors::OTHER),
   dataPtr(new ImuSensorPrivate)
 {
-  this->dataPtr->dataIndex = 0;
   this->dataPtr->dataDirty = false;
-  this->dataPtr->incomingLinkData[0].reset();
-  this->dataPtr->incomingLinkData[1].reset();
 }
 
 //////////////////////////////////////////////////
@@ -90,6 +91,9 @@ void ImuSensor::Load(const std::string &_worldName, sdf::ElementPtr _sdf)
       this->node->Advertise<msgs::IMU>(topicName, 500);
   }
 
+  this->dataPtr->batchPub = this->node->Advertise<msgs::IMU_V>(
+      this->dataPtr->pub->GetTopic() + "/batch", 50);
+
   // Get the imu element pointer
   sdf::ElementPtr imuElem = this->sdf->GetElement("imu");
 
@@ -189,12 +193,11 @@ void ImuSensor::Load(const std::string &_worldName, sdf::ElementPtr _sdf)
     gzlog << out.str();
   }
 
-  // Start publishing measurements on the topic.
-  this->dataPtr->parentEntity->SetPublishData(true);
-
-  std::string topic = "~/" + this->dataPtr->parentEntity->GetScopedName();
-  this->dataPtr->linkDataSub = this->node->Subscribe(topic,
-    &ImuSensor::OnLinkData, this);
+  // Sample the link velocities directly from physics at the end of every
+  // world update.
+  this->dataPtr->worldUpdateEndConnection =
+    event::Events::ConnectWorldUpdateEnd(
+        std::bind(&ImuSensor::OnWorldUpdateEnd, this));
 }
 
 //////////////////////////////////////////////////
@@ -233,15 +236,15 @@ void ImuSensor::Fini()
   // Clean transport
   {
     this->dataPtr->pub.reset();
-    this->dataPtr->linkDataSub.reset();
+    this->dataPtr->batchPub.reset();
   }
 
-  if (this->dataPtr->parentEntity)
-    this->dataPtr->parentEntity->SetPublishData(false);
-  this->dataPtr->parentEntity.reset();
-
-  this->dataPtr->incomingLinkData[0].reset();
-  this->dataPtr->incomingLinkData[1].reset();
+  this->dataPtr->worldUpdateEndConnection.reset();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->parentEntity.reset();
+    this->dataPtr->dataDirty = false;
+  }
 
   Sensor::Fini();
 }
@@ -254,14 +257,30 @@ msgs::IMU ImuSensor::ImuMessage() const
 }
 
 //////////////////////////////////////////////////
-void ImuSensor::OnLinkData(ConstLinkDataPtr &_msg)
+void ImuSensor::OnWorldUpdateEnd()
 {
+  if (!this->dataPtr->sampling)
+    return;
+
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  // Store the contacts message for processing in UpdateImpl
-  this->dataPtr->incomingLinkData[this->dataPtr->dataIndex] = _msg;
+  if (!this->dataPtr->parentEntity)
+    return;
+
+  // Store the link state for processing in UpdateImpl
+  this->dataPtr->sampleTime = this->world->SimTime();
+  this->dataPtr->sampleLinearVel =
+    this->dataPtr->parentEntity->WorldLinearVel();
+  this->dataPtr->sampleAngularVel =
+    this->dataPtr->parentEntity->WorldAngularVel();
   this->dataPtr->dataDirty = true;
 }
 
+//////////////////////////////////////////////////
+void ImuSensor::OnActivityChanged(const bool _active)
+{
+  this->dataPtr->sampling = _active;
+}
+
 //////////////////////////////////////////////////
 ignition::math::Vector3d ImuSensor::AngularVelocity(const bool _noiseFree) const
 {
@@ -306,8 +325,9 @@ void ImuSensor::SetWorldToReferenceOrientation(
 //////////////////////////////////////////////////
 bool ImuSensor::UpdateImpl(const bool /*_force*/)
 {
-  msgs::LinkData msg;
-  int readIndex = 0;
+  common::Time timestamp;
+  ignition::math::Vector3d linkWorldLinearVel;
+  ignition::math::Vector3d linkWorldAngularVel;
 
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
@@ -316,16 +336,12 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
     if (!this->dataPtr->dataDirty)
       return false;
 
-    readIndex = this->dataPtr->dataIndex;
-    this->dataPtr->dataIndex ^= 1;
+    timestamp = this->dataPtr->sampleTime;
+    linkWorldLinearVel = this->dataPtr->sampleLinearVel;
+    linkWorldAngularVel = this->dataPtr->sampleAngularVel;
     this->dataPtr->dataDirty = false;
   }
 
-  // toggle the index
-  msg.CopyFrom(*this->dataPtr->incomingLinkData[readIndex].get());
-
-  common::Time timestamp = msgs::Convert(msg.time());
-
   double dt = (timestamp - this->lastMeasurementTime).Double();
 
   this->lastMeasurementTime = timestamp;
@@ -344,10 +360,6 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
       this->dataPtr->parentEntity->WorldPose();
     ignition::math::Pose3d imuWorldPose = this->pose + parentEntityPose;
 
-    // Get the angular velocity
-    ignition::math::Vector3d linkWorldAngularVel = msgs::ConvertIgn(
-        msg.angular_velocity());
-
     /////////////////////////////////////////////////////////////////////
     // Set the IMU angular velocity (defined in imu's local frame)
     /////////////////////////////////////////////////////////////////////
@@ -359,10 +371,8 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
     /////////////////////////////////////////////////////////////////////
     // Compute and set the IMU linear acceleration in the imu local frame
     /////////////////////////////////////////////////////////////////////
-    // first get imu link's linear velocity in world frame
-    ignition::math::Vector3d linkWorldLinearVel
-        = msgs::ConvertIgn(msg.linear_velocity());
-    // next, account for vel in world frame of the imu
+    // start from the imu link's linear velocity in world frame, and
+    // account for vel in world frame of the imu
     // given the imu frame is offset from link frame, and link is rotating
     // compute the velocity of the imu axis origin in world frame
     ignition::math::Vector3d imuWorldLinearVel = linkWorldLinearVel +
@@ -437,9 +447,35 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
       }
     }
 
-    // Publish the message
-    if (this->dataPtr->pub)
+    ImuSample sample;
+    sample.orientation = imuReferenceOrientation;
+    sample.angularVelocity =
+      msgs::ConvertIgn(this->dataPtr->imuMsg.angular_velocity());
+    sample.linearAcceleration =
+      msgs::ConvertIgn(this->dataPtr->imuMsg.linear_acceleration());
+    this->dataPtr->history.Push(timestamp, sample);
+
+    // Publish the message, on its own only if someone listens when
+    // batching
+    const unsigned int batchSize = this->dataPtr->batchSize;
+    if (this->dataPtr->pub &&
+        (batchSize <= 1 || this->dataPtr->pub->HasConnections()))
+    {
       this->dataPtr->pub->Publish(this->dataPtr->imuMsg);
+    }
+
+    // Also flushes the samples left when batching is turned off
+    if (this->dataPtr->batchPub &&
+        (batchSize > 1 || this->dataPtr->batchMsg.imu_size() > 0))
+    {
+      this->dataPtr->batchMsg.add_imu()->CopyFrom(this->dataPtr->imuMsg);
+      if (static_cast<unsigned int>(
+            this->dataPtr->batchMsg.imu_size()) >= batchSize)
+      {
+        this->dataPtr->batchPub->Publish(this->dataPtr->batchMsg);
+        this->dataPtr->batchMsg.Clear();
+      }
+    }
   }
 
   return true;
@@ -448,6 +484,47 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
 //////////////////////////////////////////////////
 bool ImuSensor::IsActive() const
 {
-  return this->active ||
-         (this->dataPtr->pub && this->dataPtr->pub->HasConnections());
+  return Sensor::IsActive() ||
+         (this->dataPtr->pub && this->dataPtr->pub->HasConnections()) ||
+         (this->dataPtr->batchPub &&
+          this->dataPtr->batchPub->HasConnections());
+}
+
+//////////////////////////////////////////////////
+unsigned int ImuSensor::History(const unsigned int _count,
+    msgs::IMU_V &_history) const
+{
+  std::vector<SampleHistory<ImuSample>::Sample> samples;
+  this->dataPtr->history.Last(_count, samples);
+
+  _history.Clear();
+  for (auto const &sample : samples)
+  {
+    msgs::IMU *msg = _history.add_imu();
+    msgs::Set(msg->mutable_stamp(), sample.time);
+    msg->set_entity_name(this->ParentName());
+    msgs::Set(msg->mutable_orientation(), sample.value.orientation);
+    msgs::Set(msg->mutable_angular_velocity(), sample.value.angularVelocity);
+    msgs::Set(msg->mutable_linear_acceleration(),
+        sample.value.linearAcceleration);
+  }
+  return _history.imu_size();
+}
+
+//////////////////////////////////////////////////
+unsigned int ImuSensor::HistorySize() const
+{
+  return this->dataPtr->history.Capacity();
+}
+
+//////////////////////////////////////////////////
+void ImuSensor::SetPublishBatchSize(const unsigned int _size)
+{
+  this->dataPtr->batchSize = std::max(_size, 1u);
+}
+
+//////////////////////////////////////////////////
+unsigned int ImuSensor::PublishBatchSize() const
+{
+  return this->dataPtr->batchSize;
 }
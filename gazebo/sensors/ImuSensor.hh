@@ -108,9 +108,41 @@ namespace gazebo
       public: void SetWorldToReferenceOrientation(
         const ignition::math::Quaterniond &_orientation);
 
-      /// \brief Callback when link data is received
-      /// \param[in] _msg Message containing link data
-      private: void OnLinkData(ConstLinkDataPtr &_msg);
+      /// \brief Get the last samples of the IMU, oldest first. The samples
+      /// are read without blocking the sensor, so a plugin running slower
+      /// than the sensor can get every sample it missed.
+      /// \param[in] _count Maximum number of samples, at most
+      /// HistorySize().
+      /// \param[out] _history The samples, replaced.
+      /// \return Number of samples.
+      public: unsigned int History(const unsigned int _count,
+                  msgs::IMU_V &_history) const;
+
+      /// \brief Get the number of samples kept by the IMU.
+      /// \return Number of samples.
+      /// \sa History
+      public: unsigned int HistorySize() const;
+
+      /// \brief Set the number of samples sent per message on the batch
+      /// topic, which is the IMU topic followed by "/batch". With more than
+      /// one sample per batch, a message per sample is only published while
+      /// the IMU topic has subscribers.
+      /// \param[in] _size Number of samples per msgs::IMU_V message, 1 to
+      /// publish every sample on its own.
+      public: void SetPublishBatchSize(const unsigned int _size);
+
+      /// \brief Get the number of samples sent per message on the batch
+      /// topic.
+      /// \return Number of samples per msgs::IMU_V message.
+      /// \sa SetPublishBatchSize
+      public: unsigned int PublishBatchSize() const;
+
+      // Documentation inherited.
+      protected: virtual void OnActivityChanged(const bool _active);
+
+      /// \brief Sample the velocities of the parent link at the end of a
+      /// world update.
+      private: void OnWorldUpdateEnd();
 
       /// \internal
       /// \brief Private data pointer.
@@ -17,22 +17,43 @@
 #ifndef GAZEBO_SENSORS_IMUSENSOR_PRIVATE_HH_
 #define GAZEBO_SENSORS_IMUSENSOR_PRIVATE_HH_
 
-#include <array>
+#include <atomic>
 #include <mutex>
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Pose3.hh>
+#include <ignition/math/Quaternion.hh>
 
+#include "gazebo/common/CommonTypes.hh"
+#include "gazebo/common/Time.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/sensors/SampleHistory.hh"
 #include "gazebo/transport/TransportTypes.hh"
 
 namespace gazebo
 {
   namespace sensors
   {
+    /// \internal
+    /// \brief An IMU sample, with noise.
+    class ImuSample
+    {
+      /// \brief Orientation relative to the reference frame.
+      public: ignition::math::Quaterniond orientation;
+
+      /// \brief Angular velocity in the IMU frame.
+      public: ignition::math::Vector3d angularVelocity;
+
+      /// \brief Linear acceleration in the IMU frame.
+      public: ignition::math::Vector3d linearAcceleration;
+    };
+
     /// \internal
     /// \brief Imu sensor private data.
     class ImuSensorPrivate
     {
+      /// \brief Number of samples kept in the history, one second of a 1 kHz
+      /// IMU.
+      public: static constexpr unsigned int kHistorySize = 1000;
       /// \brief transform from world frame to Imu reference frame.
       public: ignition::math::Quaterniond worldToReference;
 
@@ -50,8 +71,9 @@ namespace gazebo
       /// \brief Imu data publisher
       public: transport::PublisherPtr pub;
 
-      /// \brief Subscriber to link data published by parent entity
-      public: transport::SubscriberPtr linkDataSub;
+      /// \brief Connection to the end of world updates, where the link
+      /// state is sampled.
+      public: event::ConnectionPtr worldUpdateEndConnection;
 
       /// \brief Parent entity which the IMU is attached to
       public: physics::LinkPtr parentEntity;
@@ -62,18 +84,38 @@ namespace gazebo
       /// \brief Mutex to protect reads and writes.
       public: mutable std::mutex mutex;
 
-      /// \brief Buffer for storing link data
-      public: std::array<boost::shared_ptr<msgs::LinkData const>, 2>
-              incomingLinkData;
+      /// \brief Simulation time of the last link state sample.
+      public: common::Time sampleTime;
 
-      /// \brief Index for accessing element in the link data array
-      public: unsigned int dataIndex;
+      /// \brief Linear velocity of the parent link in world frame, at
+      /// sampleTime.
+      public: ignition::math::Vector3d sampleLinearVel;
 
-      /// \brief True if new link data is received
+      /// \brief Angular velocity of the parent link in world frame, at
+      /// sampleTime.
+      public: ignition::math::Vector3d sampleAngularVel;
+
+      /// \brief True if the link state was sampled since the last update
       public: bool dataDirty;
 
+      /// \brief False while the sensor is idle, the link state isn't
+      /// sampled then.
+      public: std::atomic<bool> sampling{true};
+
       /// \brief Noise free angular velocity.
       public: ignition::math::Vector3d angularVel;
+
+      /// \brief Last samples, written by UpdateImpl only.
+      public: SampleHistory<ImuSample> history{kHistorySize};
+
+      /// \brief Batched imu data publisher
+      public: transport::PublisherPtr batchPub;
+
+      /// \brief Samples waiting to be published on batchPub.
+      public: msgs::IMU_V batchMsg;
+
+      /// \brief Number of samples per message on batchPub.
+      public: std::atomic<unsigned int> batchSize{1};
     };
   }
 }
@@ -20,6 +20,8 @@
 #endif
 #include <gtest/gtest.h>
 
+#include <atomic>
+
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/test/helper_physics_generator.hh"
 #include "gazebo/sensors/ImuSensor.hh"
@@ -32,8 +34,19 @@ class ImuSensor_TEST : public ServerFixture,
 {
   public: void BasicImuSensorCheck(const std::string &_physicsEngine);
   public: void LinearAccelerationTest(const std::string &_physicsEngine);
+  public: void HistoryTest(const std::string &_physicsEngine);
 };
 
+/// \brief Number of samples received on the batch topic.
+static std::atomic<int> batchSamples(0);
+
+/////////////////////////////////////////////////
+void OnImuBatch(ConstIMU_VPtr &_msg)
+{
+  EXPECT_EQ(_msg->imu_size(), 5);
+  batchSamples += _msg->imu_size();
+}
+
 static std::string imuSensorString =
 "<sdf version='1.3'>"
 "  <sensor name='imu' type='imu'>"
@@ -146,6 +159,62 @@ void ImuSensor_TEST::LinearAccelerationTest(const std::string &_physicsEngine)
   EXPECT_NEAR(imuSensor->LinearAcceleration().Z(), -gravityZ, 0.4);
 }
 
+/////////////////////////////////////////////////
+// Read the samples missed between two polls, and publish them in batches
+void ImuSensor_TEST::HistoryTest(const std::string &_physicsEngine)
+{
+  Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  std::string imuSensorName = "imuSensor";
+  std::string topic = "~/" + imuSensorName + "_" + _physicsEngine;
+  SpawnUnitImuSensor("imuModel", imuSensorName, "box", topic,
+      ignition::math::Vector3d(0, 0, 3), ignition::math::Vector3d::Zero);
+
+  sensors::ImuSensorPtr imuSensor =
+      std::dynamic_pointer_cast<sensors::ImuSensor>(
+      sensors::get_sensor(imuSensorName));
+  ASSERT_TRUE(imuSensor != nullptr);
+
+  sensors::SensorManager::Instance()->Init();
+  imuSensor->SetActive(true);
+
+  EXPECT_EQ(imuSensor->PublishBatchSize(), 1u);
+  imuSensor->SetPublishBatchSize(5);
+  EXPECT_EQ(imuSensor->PublishBatchSize(), 5u);
+  EXPECT_GT(imuSensor->HistorySize(), 0u);
+
+  batchSamples = 0;
+  transport::SubscriberPtr sub =
+    this->node->Subscribe(topic + "/batch", &OnImuBatch);
+
+  msgs::IMU_V history;
+  EXPECT_EQ(imuSensor->History(10, history), 0u);
+
+  world->Step(100);
+
+  // Every sample is kept, oldest first, the last one is the latest message
+  EXPECT_EQ(imuSensor->History(10, history), 10u);
+  EXPECT_EQ(history.imu_size(), 10);
+  for (int i = 1; i < history.imu_size(); ++i)
+  {
+    EXPECT_LT(msgs::Convert(history.imu(i - 1).stamp()),
+        msgs::Convert(history.imu(i).stamp()));
+  }
+  msgs::IMU last = imuSensor->ImuMessage();
+  EXPECT_EQ(msgs::Convert(history.imu(9).stamp()),
+      msgs::Convert(last.stamp()));
+  EXPECT_EQ(msgs::ConvertIgn(history.imu(9).linear_acceleration()),
+      msgs::ConvertIgn(last.linear_acceleration()));
+
+  // The batches add up to the samples
+  for (int i = 0; i < 50 && batchSamples < 10; ++i)
+    common::Time::MSleep(10);
+  EXPECT_GE(batchSamples, 10);
+  EXPECT_EQ(batchSamples % 5, 0);
+}
+
 /////////////////////////////////////////////////
 TEST_P(ImuSensor_TEST, BasicImuSensorCheck)
 {
@@ -158,6 +227,12 @@ TEST_P(ImuSensor_TEST, LinearAccelerationTest)
   LinearAccelerationTest(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(ImuSensor_TEST, HistoryTest)
+{
+  HistoryTest(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, ImuSensor_TEST,
                         PHYSICS_ENGINE_VALUES);
 
@@ -19,9 +19,14 @@
   // pulled in by anybody (e.g., Boost).
   #include <Winsock2.h>
 #endif
+#include <algorithm>
+#include <cmath>
+#include <map>
+
 #include <boost/algorithm/string.hpp>
 #include "gazebo/transport/transport.hh"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/LinkStateBuffer.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Model.hh"
 
@@ -34,6 +39,175 @@ using namespace sensors;
 
 GZ_REGISTER_STATIC_SENSOR("logical_camera", LogicalCameraSensor)
 
+/// \brief Number of times the tree of model bounds is refit before it is
+/// built again, as refitting makes the nodes overlap more and more.
+static const unsigned int kMaxRefits = 30;
+
+//////////////////////////////////////////////////
+/// \brief Check whether a box can be stored in a tree.
+/// \param[in] _box The box.
+/// \return True if the box is finite and not empty.
+static bool IsBounded(const ignition::math::Box &_box)
+{
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    if (!std::isfinite(_box.Min()[i]) || !std::isfinite(_box.Max()[i]) ||
+        _box.Min()[i] > _box.Max()[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<ModelBoundsIndex> ModelBoundsIndex::Get(
+    physics::WorldPtr _world)
+{
+  static std::mutex indexMutex;
+  static std::map<std::string, std::weak_ptr<ModelBoundsIndex>> indices;
+
+  std::lock_guard<std::mutex> lock(indexMutex);
+  std::weak_ptr<ModelBoundsIndex> &weak = indices[_world->Name()];
+  std::shared_ptr<ModelBoundsIndex> index = weak.lock();
+  if (!index || index->world != _world)
+  {
+    index.reset(new ModelBoundsIndex);
+    index->world = _world;
+    weak = index;
+  }
+  return index;
+}
+
+//////////////////////////////////////////////////
+void ModelBoundsIndex::AddEntries(const physics::Model_V &_models)
+{
+  for (auto const &model : _models)
+  {
+    Entry entry;
+    entry.model = model;
+    entry.scopedName = model->GetScopedName();
+    entry.links = model->GetLinks();
+    entry.linkPoses.resize(entry.links.size());
+    this->entries.push_back(entry);
+
+    // The bounds of a model don't contain its nested models, which get
+    // their own entries.
+    this->AddEntries(model->NestedModels());
+  }
+}
+
+//////////////////////////////////////////////////
+void ModelBoundsIndex::Update()
+{
+  const uint64_t seq = this->world->LinkStates().Sequence();
+  const unsigned int count = this->world->ModelCount();
+  if (this->valid && seq == this->sequence && count == this->modelCount)
+    return;
+
+  bool rebuild = !this->valid || count != this->modelCount;
+  if (!rebuild)
+  {
+    physics::Model_V current = this->world->Models();
+    rebuild = current != this->models;
+  }
+
+  if (rebuild)
+  {
+    this->models = this->world->Models();
+    this->entries.clear();
+    this->AddEntries(this->models);
+    this->boxes.assign(this->entries.size(), ignition::math::Box());
+  }
+
+  // Only compute the bounds of models with a link which moved
+  bool changed = rebuild;
+  for (unsigned int i = 0; i < this->entries.size(); ++i)
+  {
+    Entry &entry = this->entries[i];
+    bool moved = rebuild;
+    for (unsigned int j = 0; j < entry.links.size(); ++j)
+    {
+      const ignition::math::Pose3d pose = entry.links[j]->WorldPose();
+      if (pose != entry.linkPoses[j])
+      {
+        entry.linkPoses[j] = pose;
+        moved = true;
+      }
+    }
+
+    if (moved)
+    {
+      this->boxes[i] = entry.model->BoundingBox();
+      changed = true;
+    }
+  }
+
+  // A sequence number is odd while the links are being written, check
+  // them again next time.
+  this->sequence = (seq % 2 == 0) ? seq : seq - 1;
+  this->modelCount = count;
+  this->valid = true;
+
+  if (!changed)
+    return;
+
+  std::vector<unsigned int> bounds;
+  this->unbounded.clear();
+  for (unsigned int i = 0; i < this->boxes.size(); ++i)
+  {
+    if (IsBounded(this->boxes[i]))
+      bounds.push_back(i);
+    else
+      this->unbounded.push_back(i);
+  }
+
+  this->treeBoxes.resize(bounds.size());
+  for (unsigned int i = 0; i < bounds.size(); ++i)
+    this->treeBoxes[i] = this->boxes[bounds[i]];
+
+  if (rebuild || bounds != this->bounded || this->refits >= kMaxRefits)
+  {
+    this->bounded.swap(bounds);
+    this->tree.Build(this->treeBoxes);
+    this->refits = 0;
+  }
+  else
+  {
+    this->tree.Refit(this->treeBoxes);
+    ++this->refits;
+  }
+}
+
+//////////////////////////////////////////////////
+void ModelBoundsIndex::Query(const ignition::math::Frustum &_frustum,
+    std::vector<unsigned int> &_visible) const
+{
+  _visible.clear();
+
+  // Skip the subtrees whose bounds are outside of the frustum
+  this->tree.Query(
+      [&_frustum](const ignition::math::Box &_box)
+      {
+        return _frustum.Contains(_box);
+      },
+      [&](const unsigned int _item)
+      {
+        const unsigned int entry = this->bounded[_item];
+        if (_frustum.Contains(this->boxes[entry]))
+          _visible.push_back(entry);
+      });
+
+  for (auto const entry : this->unbounded)
+  {
+    if (_frustum.Contains(this->boxes[entry]))
+      _visible.push_back(entry);
+  }
+
+  // Report the models in the order of the world
+  std::sort(_visible.begin(), _visible.end());
+}
+
 //////////////////////////////////////////////////
 LogicalCameraSensor::LogicalCameraSensor()
 : Sensor(sensors::OTHER),
@@ -62,6 +236,9 @@ void LogicalCameraSensor::Load(const std::string &_worldName,
   // Store parent model's name for use in the UpdateImpl function.
   this->dataPtr->modelName =
     this->dataPtr->parentLink->GetModel()->GetScopedName();
+
+  // The bounds of the models are shared by the cameras of the world
+  this->dataPtr->modelIndex = ModelBoundsIndex::Get(this->world);
 }
 
 //////////////////////////////////////////////////
@@ -111,36 +288,10 @@ void LogicalCameraSensor::Init()
 //////////////////////////////////////////////////
 void LogicalCameraSensor::Fini()
 {
+  this->dataPtr->modelIndex.reset();
   Sensor::Fini();
 }
 
-//////////////////////////////////////////////////
-void LogicalCameraSensorPrivate::AddVisibleModels(
-    ignition::math::Pose3d &_myPose, const physics::Model_V &_models)
-{
-  for (auto const &model : _models)
-  {
-    auto const &scopedName = model->GetScopedName();
-    auto const aabb = model->BoundingBox();
-
-    if (this->modelName != scopedName && this->frustum.Contains(aabb))
-    {
-      // Add new model msg
-      msgs::LogicalCameraImage::Model *modelMsg = this->msg.add_model();
-
-      // Set the name and pose reported by the sensor.
-      modelMsg->set_name(scopedName);
-      msgs::Set(modelMsg->mutable_pose(),
-          model->WorldPose() - _myPose);
-    }
-    // Check nested models
-    // Note, the model AABB does not necessarily contain the nested model
-    // so nested models must be searched even if the frustum does not contain
-    // the parent model.
-    AddVisibleModels(_myPose, model->NestedModels());
-  }
-}
-
 //////////////////////////////////////////////////
 bool LogicalCameraSensor::UpdateImpl(const bool _force)
 {
@@ -160,8 +311,27 @@ bool LogicalCameraSensor::UpdateImpl(const bool _force)
     // Set the camera's pose in the message.
     msgs::Set(this->dataPtr->msg.mutable_pose(), myPose);
 
-    // Recursively check if models and nested models are in the frustum.
-    this->dataPtr->AddVisibleModels(myPose, this->world->Models());
+    // Check if models and nested models are in the frustum.
+    ModelBoundsIndex &index = *this->dataPtr->modelIndex;
+    std::lock_guard<std::mutex> indexLock(index.mutex);
+    index.Update();
+    index.Query(this->dataPtr->frustum, this->dataPtr->visible);
+
+    for (auto const entry : this->dataPtr->visible)
+    {
+      const ModelBoundsIndex::Entry &visible = index.entries[entry];
+      if (visible.scopedName == this->dataPtr->modelName)
+        continue;
+
+      // Add new model msg
+      msgs::LogicalCameraImage::Model *modelMsg =
+        this->dataPtr->msg.add_model();
+
+      // Set the name and pose reported by the sensor.
+      modelMsg->set_name(visible.scopedName);
+      msgs::Set(modelMsg->mutable_pose(),
+          visible.model->WorldPose() - myPose);
+    }
 
     // Send the message.
     this->dataPtr->pub->Publish(this->dataPtr->msg);
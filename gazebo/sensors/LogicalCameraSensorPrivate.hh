@@ -17,26 +17,124 @@
 #ifndef _GAZEBO_SENSORS_LOGICAL_CAMERASENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_LOGICAL_CAMERASENSOR_PRIVATE_HH_
 
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
+#include <ignition/math/Box.hh>
 #include <ignition/math/Frustum.hh>
+#include <ignition/math/Pose3.hh>
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/BoundingBoxTree.hh"
 #include "gazebo/physics/Link.hh"
 
 namespace gazebo
 {
   namespace sensors
   {
+    /// \internal
+    /// \brief Bounds of the models and nested models of a world, in a
+    /// bounding box tree shared by the logical cameras of the world.
+    class ModelBoundsIndex
+    {
+      /// \brief Get the index of a world, created by the first camera
+      /// which asks for it.
+      /// \param[in] _world The world.
+      /// \return The index of the world.
+      public: static std::shared_ptr<ModelBoundsIndex> Get(
+                  physics::WorldPtr _world);
+
+      /// \brief Bring the bounds and the tree up to date. Only the bounds
+      /// of models whose links moved are computed again, and nothing is
+      /// done if no link moved since the last call. Call with the mutex
+      /// locked.
+      public: void Update();
+
+      /// \brief Find the models which may be visible.
+      /// \param[in] _frustum Frustum of the camera.
+      /// \param[out] _visible Index of the entry of each model whose
+      /// bounds are in the frustum, in the order of the entries. Call with
+      /// the mutex locked, after Update.
+      public: void Query(const ignition::math::Frustum &_frustum,
+                  std::vector<unsigned int> &_visible) const;
+
+      /// \brief Add entries for models and their nested models.
+      /// \param[in] _models The models.
+      private: void AddEntries(const physics::Model_V &_models);
+
+      /// \brief A model of the index.
+      public: class Entry
+              {
+                /// \brief The model.
+                public: physics::ModelPtr model;
+
+                /// \brief Scoped name of the model.
+                public: std::string scopedName;
+
+                /// \brief Links of the model, not of its nested models.
+                public: physics::Link_V links;
+
+                /// \brief World pose of each link when the bounds were
+                /// computed.
+                public: std::vector<ignition::math::Pose3d> linkPoses;
+              };
+
+      /// \brief World of the models.
+      public: physics::WorldPtr world;
+
+      /// \brief Models of the world at the last update.
+      public: physics::Model_V models;
+
+      /// \brief Models, each followed by its nested models, in the order
+      /// of the world.
+      public: std::vector<Entry> entries;
+
+      /// \brief Bounds of each entry.
+      public: std::vector<ignition::math::Box> boxes;
+
+      /// \brief Entries with empty or infinite bounds, which are tested
+      /// against each frustum instead of being in the tree.
+      public: std::vector<unsigned int> unbounded;
+
+      /// \brief Entry of each item of the tree.
+      public: std::vector<unsigned int> bounded;
+
+      /// \brief Bounds of each item of the tree.
+      public: std::vector<ignition::math::Box> treeBoxes;
+
+      /// \brief Tree of the bounded entries.
+      public: physics::BoundingBoxTree tree;
+
+      /// \brief Link state sequence number of the last update.
+      public: uint64_t sequence = 0;
+
+      /// \brief Number of models in the world at the last update.
+      public: unsigned int modelCount = 0;
+
+      /// \brief True once the entries have been built.
+      public: bool valid = false;
+
+      /// \brief Number of times the tree was refit since it was built.
+      public: unsigned int refits = 0;
+
+      /// \brief Protects the index, which cameras update and query from
+      /// several threads.
+      public: std::mutex mutex;
+    };
+
     /// \internal
     /// \brief Logical camera sensor private data.
     class LogicalCameraSensorPrivate
     {
-      /// \brief Add models that are visible to the camera to a vector of models
-      /// \param[in] _myPose pose of the logical camera
-      /// \param[in] _models list of models to test against frustum
-      public: void AddVisibleModels(ignition::math::Pose3d &_myPose,
-        const physics::Model_V &_models);
+      /// \brief Bounds of the models of the world, shared with the other
+      /// logical cameras.
+      public: std::shared_ptr<ModelBoundsIndex> modelIndex;
+
+      /// \brief Index of the entry of each visible model, reused between
+      /// updates.
+      public: std::vector<unsigned int> visible;
 
       /// \brief Publisher of msgs::LogicalCameraImage messages.
       public: transport::PublisherPtr pub;
@@ -24,6 +24,7 @@
 #include <ignition/math/Pose3.hh>
 
 #include "gazebo/transport/Node.hh"
+#include "gazebo/transport/Publisher.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Link.hh"
@@ -191,3 +192,10 @@ ignition::math::Vector3d MagnetometerSensor::MagneticField() const
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   return msgs::ConvertIgn(this->dataPtr->magMsg.field_tesla());
 }
+
+//////////////////////////////////////////////////
+bool MagnetometerSensor::IsActive() const
+{
+  return Sensor::IsActive() ||
+    (this->dataPtr->magPub && this->dataPtr->magPub->HasConnections());
+}
@@ -21,7 +21,12 @@
   #include <Winsock2.h>
 #endif
 
+#include <climits>
+
 #include <boost/function.hpp>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Rand.hh>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 
@@ -81,6 +86,10 @@ NoisePtr NoiseFactory::NewNoiseModel(sdf::ElementPtr _sdf,
 Noise::Noise(NoiseType _type)
   : type(_type)
 {
+  // Distinct streams for noise models which aren't seeded by a sensor
+  const uint64_t high = ignition::math::Rand::IntUniform(0, INT_MAX);
+  const uint64_t low = ignition::math::Rand::IntUniform(0, INT_MAX);
+  this->random.SetSeed((high << 32) | low);
 }
 
 //////////////////////////////////////////////////
@@ -122,12 +131,81 @@ double Noise::Apply(double _in)
     return this->ApplyImpl(_in);
 }
 
+//////////////////////////////////////////////////
+void Noise::Apply(double *_data, const size_t _count)
+{
+  if (this->type == NONE)
+    return;
+  else if (this->type == CUSTOM)
+  {
+    if (this->customNoiseCallback)
+    {
+      for (size_t i = 0; i < _count; ++i)
+        _data[i] = this->customNoiseCallback(_data[i]);
+    }
+    else
+    {
+      gzerr << "Custom noise callback function not set!"
+          << " Please call SetCustomNoiseCallback within a sensor plugin."
+          << std::endl;
+    }
+  }
+  else
+    this->ApplyImpl(_data, _count);
+}
+
+//////////////////////////////////////////////////
+void Noise::ApplyInRange(double *_data, const size_t _count,
+    const double _min, const double _max)
+{
+  if (this->type == NONE)
+    return;
+
+  this->inRangeIndices.clear();
+  this->inRangeValues.clear();
+  for (size_t i = 0; i < _count; ++i)
+  {
+    if (_data[i] > _min && _data[i] < _max)
+    {
+      this->inRangeIndices.push_back(i);
+      this->inRangeValues.push_back(_data[i]);
+    }
+  }
+
+  this->Apply(this->inRangeValues.data(), this->inRangeValues.size());
+
+  for (size_t i = 0; i < this->inRangeIndices.size(); ++i)
+  {
+    _data[this->inRangeIndices[i]] =
+      ignition::math::clamp(this->inRangeValues[i], _min, _max);
+  }
+}
+
 //////////////////////////////////////////////////
 double Noise::ApplyImpl(double _in)
 {
   return _in;
 }
 
+//////////////////////////////////////////////////
+void Noise::ApplyImpl(double *_data, const size_t _count)
+{
+  for (size_t i = 0; i < _count; ++i)
+    _data[i] = this->ApplyImpl(_data[i]);
+}
+
+//////////////////////////////////////////////////
+void Noise::SetSeed(const uint64_t _seed)
+{
+  this->random.SetSeed(_seed);
+}
+
+//////////////////////////////////////////////////
+uint64_t Noise::Seed() const
+{
+  return this->random.Seed();
+}
+
 //////////////////////////////////////////////////
 Noise::NoiseType Noise::GetNoiseType() const
 {
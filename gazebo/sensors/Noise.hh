@@ -18,12 +18,15 @@
 #ifndef _GAZEBO_NOISE_HH_
 #define _GAZEBO_NOISE_HH_
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
 
 #include <boost/function.hpp>
 #include <sdf/sdf.hh>
 
+#include "gazebo/common/Philox.hh"
 #include "gazebo/rendering/RenderTypes.hh"
 #include "gazebo/sensors/SensorTypes.hh"
 #include "gazebo/util/system.hh"
@@ -82,12 +85,46 @@ namespace gazebo
       /// \return Data with noise applied.
       public: double Apply(double _in);
 
+      /// \brief Apply noise to an array of data values, in place. Faster
+      /// than calling Apply for each value.
+      /// \param[in,out] _data Data values.
+      /// \param[in] _count Number of values.
+      public: void Apply(double *_data, const size_t _count);
+
+      /// \brief Apply noise to the values of an array which are strictly
+      /// between a minimum and a maximum, such as ranges which aren't
+      /// masked, and clamp the results. The other values are left alone.
+      /// \param[in,out] _data Data values.
+      /// \param[in] _count Number of values.
+      /// \param[in] _min Minimum value.
+      /// \param[in] _max Maximum value.
+      public: void ApplyInRange(double *_data, const size_t _count,
+                                const double _min, const double _max);
+
       /// \brief Apply noise to input data value. This gets overriden by
       /// derived classes, and called by Apply.
       /// \param[in] _in Input data value.
       /// \return Data with noise applied.
       public: virtual double ApplyImpl(double _in);
 
+      /// \brief Apply noise to an array of data values, in place. Derived
+      /// classes override this to generate their samples at once, the
+      /// default calls ApplyImpl for each value.
+      /// \param[in,out] _data Data values.
+      /// \param[in] _count Number of values.
+      public: virtual void ApplyImpl(double *_data, const size_t _count);
+
+      /// \brief Set the seed of the random numbers of this noise model.
+      /// Sensors seed their noise models from the global seed and their
+      /// name, so that their noise doesn't depend on the order in which
+      /// sensors are updated.
+      /// \param[in] _seed The seed.
+      public: void SetSeed(const uint64_t _seed);
+
+      /// \brief Get the seed of the random numbers of this noise model.
+      /// \return The seed.
+      public: uint64_t Seed() const;
+
       /// \brief Finalize the noise model
       public: virtual void Fini();
 
@@ -120,6 +157,16 @@ namespace gazebo
 
       /// \brief Callback function for applying custom noise to sensor data.
       private: std::function<double (double)> customNoiseCallback;
+
+      /// \brief Index of the values ApplyInRange applies noise to, reused
+      /// between calls.
+      private: std::vector<size_t> inRangeIndices;
+
+      /// \brief Values ApplyInRange applies noise to, reused between calls.
+      private: std::vector<double> inRangeValues;
+
+      /// \brief Random numbers of this noise model, for derived classes.
+      protected: common::Philox random;
     };
     /// \}
   }
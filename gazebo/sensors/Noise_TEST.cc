@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/mean.hpp>
@@ -373,6 +376,66 @@ TEST_F(NoiseTest, OnApplyNoise)
   }
 }
 
+//////////////////////////////////////////////////
+TEST_F(NoiseTest, ApplyArray)
+{
+  const double mean = 1.5;
+  const double stddev = 0.5;
+  sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", mean, stddev, 0, 0, 0));
+  noise->SetSeed(7);
+
+  // Gaussian noise on all the values at once
+  const unsigned int count = 10000;
+  std::vector<double> values(count, 10.0);
+  noise->Apply(values.data(), values.size());
+
+  double sum = 0.0;
+  for (auto const value : values)
+    sum += value;
+  double avg = sum / count;
+  EXPECT_NEAR(avg, 10.0 + mean, g_sigma * stddev / sqrt(count));
+
+  double variance = 0.0;
+  for (auto const value : values)
+    variance += (value - avg) * (value - avg);
+  EXPECT_NEAR(sqrt(variance / count), stddev, 0.05);
+
+  // The same seed gives the same noise
+  std::vector<double> again(count, 10.0);
+  noise->SetSeed(7);
+  noise->Apply(again.data(), again.size());
+  EXPECT_EQ(values, again);
+
+  // Only values between the limits get noise, and are clamped
+  std::vector<double> ranges = {-1.0, 0.0, 0.5, 5.0, 9.9, 10.0, 20.0};
+  noise->ApplyInRange(ranges.data(), ranges.size(), 0.0, 10.0);
+  EXPECT_DOUBLE_EQ(ranges[0], -1.0);
+  EXPECT_DOUBLE_EQ(ranges[1], 0.0);
+  EXPECT_DOUBLE_EQ(ranges[5], 10.0);
+  EXPECT_DOUBLE_EQ(ranges[6], 20.0);
+  EXPECT_NE(ranges[3], 5.0);
+  EXPECT_DOUBLE_EQ(ranges[4], 10.0);
+  for (unsigned int i = 2; i < 5; ++i)
+  {
+    EXPECT_GE(ranges[i], 0.0);
+    EXPECT_LE(ranges[i], 10.0);
+  }
+
+  // None leaves the values alone, custom calls the callback for each
+  sensors::NoisePtr none = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("none", 0, 0, 0, 0, 0));
+  std::vector<double> untouched = {1.0, 2.0};
+  none->Apply(untouched.data(), untouched.size());
+  EXPECT_DOUBLE_EQ(untouched[0], 1.0);
+  EXPECT_DOUBLE_EQ(untouched[1], 2.0);
+
+  none->SetCustomNoiseCallback(boost::bind(&OnApplyCustomNoise, _1));
+  none->Apply(untouched.data(), untouched.size());
+  EXPECT_DOUBLE_EQ(untouched[0], 2.0);
+  EXPECT_DOUBLE_EQ(untouched[1], 4.0);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -175,3 +175,10 @@ void RFIDSensor::AddTag(RFIDTag *_tag)
 {
   this->dataPtr->tags.push_back(_tag);
 }
+
+//////////////////////////////////////////////////
+bool RFIDSensor::IsActive() const
+{
+  return Sensor::IsActive() ||
+    (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections());
+}
@@ -60,6 +60,9 @@ namespace gazebo
       // Documentation inherited
       public: void AddTag(RFIDTag *_tag);
 
+      // Documentation inherited.
+      public: virtual bool IsActive() const;
+
       // Documentation inherited.
       protected: virtual bool UpdateImpl(const bool _force);
 
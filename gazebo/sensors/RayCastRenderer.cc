@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cstdlib>
+
+#include <boost/algorithm/string/trim.hpp>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/common/CommonIface.hh"
+
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/RayShape.hh"
+#include "gazebo/physics/World.hh"
+
+#include "gazebo/rendering/RenderEngine.hh"
+
+#include "gazebo/sensors/RayCastRendererPrivate.hh"
+#include "gazebo/sensors/RayCastRenderer.hh"
+
+using namespace gazebo;
+using namespace sensors;
+
+//////////////////////////////////////////////////
+RayCastRenderer::RayCastRenderer(physics::WorldPtr _world)
+: dataPtr(new RayCastRendererPrivate)
+{
+  GZ_ASSERT(_world != nullptr, "RayCastRenderer needs a world");
+  this->dataPtr->world = _world;
+}
+
+//////////////////////////////////////////////////
+RayCastRenderer::~RayCastRenderer()
+{
+}
+
+//////////////////////////////////////////////////
+bool RayCastRenderer::Selected(const std::string &_type,
+    const std::string &_scopedName)
+{
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    return true;
+  }
+
+  const char *env = std::getenv("GAZEBO_RAYCAST_SENSORS");
+  if (!env)
+    return false;
+
+  for (auto name : common::split(env, ","))
+  {
+    boost::algorithm::trim(name);
+    if (name == "all" || name == _type || name == _scopedName)
+      return true;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+void RayCastRenderer::SetRays(
+    const std::vector<ignition::math::Vector3d> &_starts,
+    const std::vector<ignition::math::Vector3d> &_ends)
+{
+  GZ_ASSERT(_starts.size() == _ends.size(),
+      "A ray needs both a start and an end");
+
+  this->dataPtr->starts = _starts;
+  this->dataPtr->ends = _ends;
+  this->dataPtr->batch.Resize(_starts.size());
+  this->dataPtr->fractions.assign(_starts.size(), 1.0);
+  this->dataPtr->retros.assign(_starts.size(), 0.0);
+}
+
+//////////////////////////////////////////////////
+unsigned int RayCastRenderer::RayCount() const
+{
+  return this->dataPtr->starts.size();
+}
+
+//////////////////////////////////////////////////
+void RayCastRenderer::Render(const ignition::math::Pose3d &_pose)
+{
+  physics::RayCastBatch &batch = this->dataPtr->batch;
+  const unsigned int count = batch.Size();
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    batch.starts[i] = _pose.CoordPositionAdd(this->dataPtr->starts[i]);
+    batch.ends[i] = _pose.CoordPositionAdd(this->dataPtr->ends[i]);
+  }
+
+  physics::PhysicsEnginePtr physics = this->dataPtr->world->Physics();
+  if (physics->CastRays(batch))
+  {
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      double length = batch.starts[i].Distance(batch.ends[i]);
+      this->dataPtr->fractions[i] = length > 0 ?
+          std::min(batch.lengths[i] / length, 1.0) : 1.0;
+      this->dataPtr->retros[i] = batch.retros[i];
+    }
+    return;
+  }
+
+  // One ray at a time, the engine doesn't report laser retros this way
+  if (!this->dataPtr->testRay)
+  {
+    this->dataPtr->testRay = boost::dynamic_pointer_cast<physics::RayShape>(
+        physics->CreateShape("ray", physics::CollisionPtr()));
+  }
+
+  boost::recursive_mutex::scoped_lock lock(
+      *physics->GetPhysicsUpdateMutex());
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    double dist;
+    std::string entityName;
+    this->dataPtr->testRay->SetPoints(batch.starts[i], batch.ends[i]);
+    this->dataPtr->testRay->GetIntersection(dist, entityName);
+
+    double length = batch.starts[i].Distance(batch.ends[i]);
+    this->dataPtr->fractions[i] = !entityName.empty() && length > 0 ?
+        std::min(dist / length, 1.0) : 1.0;
+    this->dataPtr->retros[i] = 0.0;
+  }
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &RayCastRenderer::Fractions() const
+{
+  return this->dataPtr->fractions;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &RayCastRenderer::Retros() const
+{
+  return this->dataPtr->retros;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_RAYCASTRENDERER_HH_
+#define GAZEBO_SENSORS_RAYCASTRENDERER_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    // Forward declare private data class.
+    class RayCastRendererPrivate;
+
+    /// \addtogroup gazebo_sensors
+    /// \{
+
+    /// \class RayCastRenderer RayCastRenderer.hh sensors/sensors.hh
+    /// \brief Renders ranges on the CPU, by casting rays against the
+    /// collisions of a world instead of drawing its visuals with OGRE.
+    ///
+    /// GpuRaySensor and DepthCameraSensor use it when rendering is not
+    /// available, or when selected for a sensor with the
+    /// GAZEBO_RAYCAST_SENSORS environment variable: a comma separated list
+    /// of sensor types (e.g. "gpu_ray,depth") or scoped sensor names, or
+    /// "all".
+    class GZ_SENSORS_VISIBLE RayCastRenderer
+    {
+      /// \brief Constructor.
+      /// \param[in] _world World to cast the rays in.
+      public: explicit RayCastRenderer(physics::WorldPtr _world);
+
+      /// \brief Destructor.
+      public: virtual ~RayCastRenderer();
+
+      /// \brief Check whether a sensor should be rendered by casting rays.
+      /// \param[in] _type Type of the sensor.
+      /// \param[in] _scopedName Scoped name of the sensor.
+      /// \return True if rendering is not available, or the sensor is
+      /// listed in GAZEBO_RAYCAST_SENSORS.
+      public: static bool Selected(const std::string &_type,
+                                   const std::string &_scopedName);
+
+      /// \brief Set the rays to cast.
+      /// \param[in] _starts Start of each ray, in the sensor frame.
+      /// \param[in] _ends End of each ray, in the sensor frame.
+      public: void SetRays(const std::vector<ignition::math::Vector3d> &_starts,
+                           const std::vector<ignition::math::Vector3d> &_ends);
+
+      /// \brief Get the number of rays.
+      /// \return Number of rays.
+      public: unsigned int RayCount() const;
+
+      /// \brief Cast all the rays.
+      /// \param[in] _pose Pose of the sensor in the world frame.
+      public: void Render(const ignition::math::Pose3d &_pose);
+
+      /// \brief Get the part of each ray before its nearest hit, from 0 at
+      /// its start to 1 at its end, which is also the value of rays that
+      /// hit nothing.
+      /// \return Fraction of each ray, as of the last Render.
+      public: const std::vector<double> &Fractions() const;
+
+      /// \brief Get the laser retro of the collision hit by each ray.
+      /// \return Laser retro of each ray, 0 when nothing was hit or the
+      /// physics engine doesn't report it.
+      public: const std::vector<double> &Retros() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<RayCastRendererPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
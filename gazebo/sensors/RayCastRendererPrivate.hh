@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_RAYCASTRENDERER_PRIVATE_HH_
+#define GAZEBO_SENSORS_RAYCASTRENDERER_PRIVATE_HH_
+
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/RayCastBatch.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \internal
+    /// \brief Ray cast renderer private data.
+    class RayCastRendererPrivate
+    {
+      /// \brief World the rays are cast in.
+      public: physics::WorldPtr world;
+
+      /// \brief Start of each ray, in the sensor frame.
+      public: std::vector<ignition::math::Vector3d> starts;
+
+      /// \brief End of each ray, in the sensor frame.
+      public: std::vector<ignition::math::Vector3d> ends;
+
+      /// \brief Rays in the world frame and their hits.
+      public: physics::RayCastBatch batch;
+
+      /// \brief Part of each ray before its nearest hit.
+      public: std::vector<double> fractions;
+
+      /// \brief Laser retro of the collision hit by each ray.
+      public: std::vector<double> retros;
+
+      /// \brief Ray tested one at a time, for physics engines which can't
+      /// cast a batch of rays.
+      public: physics::RayShapePtr testRay;
+    };
+  }
+}
+#endif
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class RayCastRenderer_TEST : public ServerFixture
+{
+  /// \brief Spawn a box with its front face at x = 1.5, and a model at
+  /// the origin with a sensor looking at it.
+  /// \param[in] _sensor SDF of the sensor.
+  public: void SpawnScene(const std::string &_sensor)
+  {
+    std::ostringstream box;
+    box << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='box'><static>true</static>"
+      << "<pose>2 0 0.5 0 0 0</pose>"
+      << "<link name='link'><collision name='collision'>"
+      << "<laser_retro>50</laser_retro>"
+      << "<geometry><box><size>1 1 1</size></box></geometry>"
+      << "</collision></link></model></sdf>";
+    this->SpawnSDF(box.str());
+    this->WaitUntilEntitySpawn("box", 100, 100);
+
+    std::ostringstream sensor;
+    sensor << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='sensor_model'><static>true</static>"
+      << "<pose>0 0 0.5 0 0 0</pose>"
+      << "<link name='link'>" << _sensor << "</link></model></sdf>";
+    this->SpawnSDF(sensor.str());
+    this->WaitUntilSensorSpawn("sensor_model::link::sensor", 100, 100);
+
+    sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+    for (int i = 0; i < 100 && !mgr->SensorsInitialized(); ++i)
+      common::Time::MSleep(100);
+    EXPECT_TRUE(mgr->SensorsInitialized());
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Frame of a laser, copied by its new frame callback.
+std::vector<float> g_laserFrame;
+
+/////////////////////////////////////////////////
+void OnNewLaserFrame(const float *_frame, unsigned int _width,
+    unsigned int _height, unsigned int _depth,
+    const std::string &/*_format*/)
+{
+  g_laserFrame.assign(_frame, _frame + _width * _height * _depth);
+}
+
+/////////////////////////////////////////////////
+/// \brief A gpu_ray sensor selected to cast its rays on the CPU
+TEST_F(RayCastRenderer_TEST, GpuRaySensor)
+{
+  setenv("GAZEBO_RAYCAST_SENSORS", "gpu_ray", 1);
+  this->Load("worlds/empty.world", true);
+
+  this->SpawnScene(
+      "<sensor name='sensor' type='gpu_ray'>"
+      "<update_rate>10</update_rate>"
+      "<ray><scan><horizontal>"
+      "<samples>11</samples><resolution>1</resolution>"
+      "<min_angle>-0.2</min_angle><max_angle>0.2</max_angle>"
+      "</horizontal></scan>"
+      "<range><min>0.1</min><max>10</max><resolution>0.01</resolution>"
+      "</range></ray></sensor>");
+
+  sensors::GpuRaySensorPtr sensor =
+    std::dynamic_pointer_cast<sensors::GpuRaySensor>(
+        sensors::SensorManager::Instance()->GetSensor(
+          "sensor_model::link::sensor"));
+  ASSERT_TRUE(sensor != nullptr);
+  EXPECT_TRUE(sensor->LaserCamera() == nullptr);
+  EXPECT_EQ(sensor->RangeCount(), 11);
+  EXPECT_TRUE(sensor->IsHorizontal());
+  EXPECT_NEAR(sensor->HorzFOV(), 0.4, 1e-6);
+
+  event::ConnectionPtr connection = sensor->ConnectNewLaserFrame(
+      std::bind(&OnNewLaserFrame, std::placeholders::_1,
+        std::placeholders::_2, std::placeholders::_3, std::placeholders::_4,
+        std::placeholders::_5));
+
+  sensor->Update(true);
+
+  // Rays hit the front face of the box, the middle one straight on
+  std::vector<double> ranges;
+  sensor->Ranges(ranges);
+  ASSERT_EQ(ranges.size(), 11u);
+  EXPECT_NEAR(ranges[5], 1.5, 1e-4);
+  for (unsigned int i = 0; i < ranges.size(); ++i)
+  {
+    double angle = -0.2 + i * 0.04;
+    EXPECT_NEAR(ranges[i], 1.5 / cos(angle), 1e-4) << i;
+  }
+
+  ASSERT_EQ(g_laserFrame.size(), 11u * 3u);
+  EXPECT_NEAR(g_laserFrame[5 * 3], 1.5, 1e-4);
+  EXPECT_DOUBLE_EQ(g_laserFrame[5 * 3 + 1], 50.0);
+
+  // Nothing in range after the box is moved away
+  physics::ModelPtr box = physics::get_world()->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  box->SetWorldPose(ignition::math::Pose3d(20, 0, 0.5, 0, 0, 0));
+  sensor->Update(true);
+  sensor->Ranges(ranges);
+  EXPECT_TRUE(std::isinf(ranges[5]));
+
+  unsetenv("GAZEBO_RAYCAST_SENSORS");
+}
+
+/////////////////////////////////////////////////
+/// \brief A depth camera selected by name to cast its rays on the CPU
+TEST_F(RayCastRenderer_TEST, DepthCameraSensor)
+{
+  setenv("GAZEBO_RAYCAST_SENSORS", "sensor_model::link::sensor", 1);
+  this->Load("worlds/empty.world", true);
+
+  const unsigned int width = 32;
+  const unsigned int height = 24;
+  std::ostringstream camera;
+  camera << "<sensor name='sensor' type='depth'>"
+    << "<update_rate>10</update_rate>"
+    << "<camera><horizontal_fov>1.047</horizontal_fov>"
+    << "<image><width>" << width << "</width>"
+    << "<height>" << height << "</height></image>"
+    << "<clip><near>0.1</near><far>10</far></clip>"
+    << "</camera></sensor>";
+  this->SpawnScene(camera.str());
+
+  sensors::DepthCameraSensorPtr sensor =
+    std::dynamic_pointer_cast<sensors::DepthCameraSensor>(
+        sensors::SensorManager::Instance()->GetSensor(
+          "sensor_model::link::sensor"));
+  ASSERT_TRUE(sensor != nullptr);
+  EXPECT_TRUE(sensor->DepthCamera() == nullptr);
+  EXPECT_EQ(sensor->ImageWidth(), width);
+  EXPECT_EQ(sensor->ImageHeight(), height);
+
+  sensor->Update(true);
+  const float *depth = sensor->DepthData();
+  ASSERT_TRUE(depth != nullptr);
+
+  // The face of the box is perpendicular to the camera: every pixel on it
+  // has the same depth
+  for (unsigned int v = height / 2 - 2; v < height / 2 + 2; ++v)
+  {
+    for (unsigned int u = width / 2 - 2; u < width / 2 + 2; ++u)
+      EXPECT_NEAR(depth[v * width + u], 1.5, 1e-4) << u << " " << v;
+  }
+
+  // The top corners look above the box, at nothing
+  EXPECT_NEAR(depth[0], 10.0, 1e-4);
+  EXPECT_NEAR(depth[width - 1], 10.0, 1e-4);
+
+  unsetenv("GAZEBO_RAYCAST_SENSORS");
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
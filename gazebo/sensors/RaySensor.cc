@@ -414,6 +414,12 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
   bool interp =
     ((rayCount != rangeCount) || (verticalRayCount != verticalRangeCount));
 
+  // Read the results of all the rays directly
+  const std::vector<double> &ranges = this->dataPtr->laserShape->Ranges();
+  const std::vector<double> &retros = this->dataPtr->laserShape->Retros();
+  GZ_ASSERT(ranges.size() >= rayCount * verticalRayCount,
+      "Fewer ray results than rays");
+
   // interpolate in vertical direction
   for (unsigned int j = 0; j < verticalRangeCount; ++j)
   {
@@ -455,24 +461,20 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
         j4 = hjb + vjb * rayCount;
 
         // range readings of 4 corners
-        r1 = this->LaserShape()->GetRange(j1);
-        r2 = this->LaserShape()->GetRange(j2);
-        r3 = this->LaserShape()->GetRange(j3);
-        r4 = this->LaserShape()->GetRange(j4);
+        r1 = ranges[j1];
+        r2 = ranges[j2];
+        r3 = ranges[j3];
+        r4 = ranges[j4];
         range = (1-vb)*((1 - hb) * r1 + hb * r2)
             + vb *((1 - hb) * r3 + hb * r4);
 
         // intensity is averaged
-        intensity = 0.25 * (this->LaserShape()->GetRetro(j1)
-            + this->LaserShape()->GetRetro(j2)
-            + this->LaserShape()->GetRetro(j3)
-            + this->LaserShape()->GetRetro(j4));
+        intensity = 0.25 * (retros[j1] + retros[j2] + retros[j3] + retros[j4]);
       }
       else
       {
-        range = this->dataPtr->laserShape->GetRange(j * this->RayCount() + i);
-        intensity = this->dataPtr->laserShape->GetRetro(j *
-            this->RayCount() + i);
+        range = ranges[j * rayCount + i];
+        intensity = retros[j * rayCount + i];
       }
 
       // Mask ranges outside of min/max to +/- inf, as per REP 117
@@ -484,20 +486,21 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
       {
         range = -ignition::math::INF_D;
       }
-      else if (this->noises.find(RAY_NOISE) !=
-               this->noises.end())
-      {
-        // currently supports only one noise model per laser sensor
-        range = this->noises[RAY_NOISE]->Apply(range);
-        range = ignition::math::clamp(range,
-            this->RangeMin(), this->RangeMax());
-      }
 
       scan->add_ranges(range);
       scan->add_intensities(intensity);
     }
   }
 
+  // Noise on all the ranges which aren't masked at once
+  // currently supports only one noise model per laser sensor
+  auto noise = this->noises.find(RAY_NOISE);
+  if (noise != this->noises.end())
+  {
+    noise->second->ApplyInRange(scan->mutable_ranges()->mutable_data(),
+        scan->ranges_size(), this->RangeMin(), this->RangeMax());
+  }
+
   if (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections())
     this->dataPtr->scanPub->Publish(this->dataPtr->laserMsg);
 
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_SAMPLEHISTORY_HH_
+#define GAZEBO_SENSORS_SAMPLEHISTORY_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \addtogroup gazebo_sensors
+    /// \{
+
+    /// \class SampleHistory SampleHistory.hh sensors/sensors.hh
+    /// \brief Ring buffer of the last timestamped samples of a sensor.
+    ///
+    /// One thread, the sensor's, pushes samples. Any number of threads can
+    /// read the last samples at the same time without a lock: a sample
+    /// overwritten while it was being copied is left out of the copy, like
+    /// LinkStateBuffer::State. T must be plain data, without pointers.
+    template<typename T>
+    class SampleHistory
+    {
+      /// \brief A sample and its time.
+      public: class Sample
+              {
+                /// \brief Simulation time of the sample.
+                public: common::Time time;
+
+                /// \brief The sample.
+                public: T value;
+              };
+
+      /// \brief Constructor.
+      /// \param[in] _capacity Number of samples kept.
+      public: explicit SampleHistory(const unsigned int _capacity = 0)
+              {
+                this->SetCapacity(_capacity);
+              }
+
+      /// \brief Set the number of samples kept, and drop all of them. Not
+      /// thread safe, call before any sample is pushed or read.
+      /// \param[in] _capacity Number of samples kept.
+      public: void SetCapacity(const unsigned int _capacity)
+              {
+                this->capacity = _capacity;
+                this->slots.reset(_capacity > 0 ? new Slot[_capacity] :
+                    nullptr);
+                this->count.store(0, std::memory_order_release);
+              }
+
+      /// \brief Get the number of samples kept.
+      /// \return Capacity of the buffer.
+      public: unsigned int Capacity() const
+              {
+                return this->capacity;
+              }
+
+      /// \brief Get the number of samples pushed since the buffer was
+      /// created, including those which were overwritten.
+      /// \return Number of samples pushed.
+      public: uint64_t Count() const
+              {
+                return this->count.load(std::memory_order_acquire);
+              }
+
+      /// \brief Add a sample, overwriting the oldest one when the buffer is
+      /// full. Only one thread may push.
+      /// \param[in] _time Simulation time of the sample.
+      /// \param[in] _value The sample.
+      public: void Push(const common::Time &_time, const T &_value)
+              {
+                if (this->capacity == 0)
+                  return;
+
+                const uint64_t index =
+                  this->count.load(std::memory_order_relaxed);
+                Slot &slot = this->slots[index % this->capacity];
+
+                // Odd while the slot is written
+                slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                slot.sample.time = _time;
+                slot.sample.value = _value;
+                slot.sequence.store(2 * index + 2, std::memory_order_release);
+
+                this->count.store(index + 1, std::memory_order_release);
+              }
+
+      /// \brief Copy the last samples, oldest first.
+      /// \param[in] _n Maximum number of samples.
+      /// \param[out] _samples The samples, replaced.
+      /// \return Number of samples copied.
+      public: unsigned int Last(const unsigned int _n,
+                  std::vector<Sample> &_samples) const
+              {
+                _samples.clear();
+                const uint64_t end = this->Count();
+                const uint64_t n = std::min<uint64_t>(
+                    std::min<uint64_t>(_n, this->capacity), end);
+
+                for (uint64_t index = end - n; index < end; ++index)
+                {
+                  const Slot &slot = this->slots[index % this->capacity];
+                  const uint64_t before =
+                    slot.sequence.load(std::memory_order_acquire);
+                  if (before != 2 * index + 2)
+                    continue;
+
+                  Sample sample = slot.sample;
+                  std::atomic_thread_fence(std::memory_order_acquire);
+                  if (slot.sequence.load(std::memory_order_relaxed) == before)
+                    _samples.push_back(sample);
+                }
+                return _samples.size();
+              }
+
+      /// \brief Copy the samples more recent than a time, oldest first.
+      /// \param[in] _time Time of the last sample already read.
+      /// \param[out] _samples The samples, replaced.
+      /// \return Number of samples copied.
+      public: unsigned int Since(const common::Time &_time,
+                  std::vector<Sample> &_samples) const
+              {
+                this->Last(this->capacity, _samples);
+                _samples.erase(_samples.begin(),
+                    std::find_if(_samples.begin(), _samples.end(),
+                      [&_time](const Sample &_sample)
+                      {
+                        return _sample.time > _time;
+                      }));
+                return _samples.size();
+              }
+
+      /// \brief A sample in the buffer.
+      private: class Slot
+               {
+                 /// \brief Twice the index of the sample plus 2, odd while
+                 /// it is written.
+                 public: std::atomic<uint64_t> sequence{0};
+
+                 /// \brief The sample.
+                 public: Sample sample;
+               };
+
+      /// \brief Number of samples kept.
+      private: unsigned int capacity = 0;
+
+      /// \brief Samples, indexed by their index modulo the capacity.
+      private: std::unique_ptr<Slot[]> slots;
+
+      /// \brief Number of samples pushed.
+      private: std::atomic<uint64_t> count{0};
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gazebo/sensors/SampleHistory.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SampleHistoryTest : public gazebo::testing::AutoLogFixture { };
+
+/// \brief A sample with redundant fields, to detect torn copies.
+struct TestSample
+{
+  int a;
+  int b;
+};
+
+/////////////////////////////////////////////////
+TEST_F(SampleHistoryTest, LastAndSince)
+{
+  sensors::SampleHistory<TestSample> history(4);
+  EXPECT_EQ(history.Capacity(), 4u);
+
+  std::vector<sensors::SampleHistory<TestSample>::Sample> samples;
+  EXPECT_EQ(history.Last(10, samples), 0u);
+
+  for (int i = 0; i < 3; ++i)
+    history.Push(common::Time(i), TestSample{i, -i});
+  EXPECT_EQ(history.Count(), 3u);
+
+  EXPECT_EQ(history.Last(10, samples), 3u);
+  EXPECT_EQ(samples[0].value.a, 0);
+  EXPECT_EQ(samples[2].value.a, 2);
+  EXPECT_EQ(samples[2].time, common::Time(2));
+
+  // The oldest samples are overwritten
+  for (int i = 3; i < 10; ++i)
+    history.Push(common::Time(i), TestSample{i, -i});
+  EXPECT_EQ(history.Last(10, samples), 4u);
+  EXPECT_EQ(samples[0].value.a, 6);
+  EXPECT_EQ(samples[3].value.a, 9);
+
+  EXPECT_EQ(history.Last(2, samples), 2u);
+  EXPECT_EQ(samples[0].value.a, 8);
+
+  EXPECT_EQ(history.Since(common::Time(7), samples), 2u);
+  EXPECT_EQ(samples[0].value.a, 8);
+  EXPECT_EQ(history.Since(common::Time(9), samples), 0u);
+
+  // A new capacity drops the samples
+  history.SetCapacity(2);
+  EXPECT_EQ(history.Count(), 0u);
+  EXPECT_EQ(history.Last(10, samples), 0u);
+
+  // Nothing is kept without capacity
+  sensors::SampleHistory<TestSample> empty;
+  empty.Push(common::Time(1), TestSample{1, -1});
+  EXPECT_EQ(empty.Last(10, samples), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SampleHistoryTest, ConcurrentReads)
+{
+  sensors::SampleHistory<TestSample> history(8);
+  std::atomic<bool> done(false);
+
+  std::thread writer([&history, &done]()
+  {
+    for (int i = 0; i < 200000; ++i)
+      history.Push(common::Time(0, i), TestSample{i, -i});
+    done = true;
+  });
+
+  std::vector<sensors::SampleHistory<TestSample>::Sample> samples;
+  while (!done)
+  {
+    history.Last(8, samples);
+    for (unsigned int i = 0; i < samples.size(); ++i)
+    {
+      // Never torn, always in order
+      ASSERT_EQ(samples[i].value.a, -samples[i].value.b);
+      if (i > 0)
+      {
+        ASSERT_LT(samples[i - 1].value.a, samples[i].value.a);
+      }
+    }
+  }
+  writer.join();
+
+  EXPECT_EQ(history.Last(8, samples), 8u);
+  EXPECT_EQ(samples.back().value.a, 199999);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -20,6 +20,8 @@
   #include <Winsock2.h>
 #endif
 
+#include <ignition/math/Rand.hh>
+
 #include "gazebo/transport/transport.hh"
 
 #include "gazebo/physics/PhysicsIface.hh"
@@ -29,6 +31,7 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/PluginProfiler.hh"
 
 #include "gazebo/rendering/Camera.hh"
 #include "gazebo/rendering/Distortion.hh"
@@ -47,6 +50,37 @@ using namespace sensors;
 
 sdf::ElementPtr SensorPrivate::sdfSensor;
 
+//////////////////////////////////////////////////
+/// \brief Compute the seed of a noise model of a sensor, which only depends
+/// on the global seed and the sensor, so the same sensor gets the same
+/// noise whatever the order sensors are loaded and updated in.
+/// \param[in] _scopedName Scoped name of the sensor.
+/// \param[in] _type Type of the noise.
+/// \return The seed.
+static uint64_t NoiseSeed(const std::string &_scopedName,
+    const SensorNoiseType _type)
+{
+  // FNV-1a, stable across platforms unlike std::hash
+  uint64_t hash = 14695981039346656037ULL;
+  auto mix = [&hash](const uint64_t _value)
+  {
+    for (int i = 0; i < 8; ++i)
+    {
+      hash ^= (_value >> (8 * i)) & 0xff;
+      hash *= 1099511628211ULL;
+    }
+  };
+
+  mix(ignition::math::Rand::Seed());
+  mix(static_cast<uint64_t>(_type));
+  for (auto const c : _scopedName)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
 //////////////////////////////////////////////////
 Sensor::Sensor(SensorCategory _cat)
 : dataPtr(new SensorPrivate)
@@ -114,6 +148,12 @@ void Sensor::Init()
 {
   this->SetUpdateRate(this->sdf->Get<double>("update_rate"));
 
+  for (auto &noise : this->noises)
+  {
+    if (noise.second)
+      noise.second->SetSeed(NoiseSeed(this->ScopedName(), noise.first));
+  }
+
   // Load the plugins
   if (this->sdf->HasElement("plugin"))
   {
@@ -288,6 +328,10 @@ void Sensor::LoadPlugin(sdf::ElementPtr _sdf)
     }
 
     SensorPtr myself = shared_from_this();
+
+    // Attribute the event connections of the plugin to it
+    common::PluginProfilerScope scope(this->ScopedName() + "::" + name);
+
     plugin->Load(myself, _sdf);
     plugin->Init();
     this->plugins.push_back(plugin);
@@ -303,7 +347,37 @@ void Sensor::SetActive(const bool _value)
 //////////////////////////////////////////////////
 bool Sensor::IsActive() const
 {
-  return this->active;
+  return this->active || this->dataPtr->updated.ConnectionCount() > 0;
+}
+
+//////////////////////////////////////////////////
+bool Sensor::CheckActivity()
+{
+  const bool isActive = this->IsActive();
+  if (isActive)
+    ++this->dataPtr->activeUpdates;
+  else
+    ++this->dataPtr->idleUpdates;
+
+  if (isActive != this->dataPtr->lastActive)
+  {
+    this->dataPtr->lastActive = isActive;
+    this->OnActivityChanged(isActive);
+  }
+
+  return isActive;
+}
+
+//////////////////////////////////////////////////
+uint64_t Sensor::ActiveUpdateCount() const
+{
+  return this->dataPtr->activeUpdates;
+}
+
+//////////////////////////////////////////////////
+uint64_t Sensor::IdleUpdateCount() const
+{
+  return this->dataPtr->idleUpdates;
 }
 
 //////////////////////////////////////////////////
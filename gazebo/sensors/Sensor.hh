@@ -118,10 +118,34 @@ namespace gazebo
       /// \param[in] _value True if active, false if not.
       public: virtual void SetActive(const bool _value);
 
-      /// \brief Returns true if sensor generation is active.
+      /// \brief Returns true if sensor generation is active, which is the
+      /// case if something wants the output of the sensor: always_on or
+      /// SetActive forces it, a subscriber to ConnectUpdated such as a
+      /// sensor plugin or a logger, or a subscriber to one of the sensor's
+      /// topics. Idle sensors are not updated by the SensorManager.
       /// \return True if active, false if not.
       public: virtual bool IsActive() const;
 
+      /// \brief Check if the sensor is active when one of its updates is
+      /// due, and count the answer. Calls OnActivityChanged when the answer
+      /// differs from the previous one. Called by the SensorManager, for
+      /// image sensors at each update of their container.
+      /// \return True if active, false if not.
+      /// \sa IsActive
+      public: bool CheckActivity();
+
+      /// \brief Get the number of due updates for which the sensor was
+      /// active.
+      /// \return Number of active updates.
+      /// \sa CheckActivity
+      public: uint64_t ActiveUpdateCount() const;
+
+      /// \brief Get the number of due updates skipped because the sensor
+      /// was idle.
+      /// \return Number of idle updates.
+      /// \sa CheckActivity
+      public: uint64_t IdleUpdateCount() const;
+
       /// \brief Get sensor type.
       /// \return Type of sensor.
       public: std::string Type() const;
@@ -193,6 +217,13 @@ namespace gazebo
       /// \return True when sensor should be updated.
       protected: bool NeedsUpdate();
 
+      /// \brief Called by CheckActivity when the sensor becomes active or
+      /// idle, for sensors to suspend the work they do outside of their
+      /// updates while idle. Sensors start as active.
+      /// \param[in] _active True if the sensor became active, false if it
+      /// became idle.
+      protected: virtual void OnActivityChanged(const bool /*_active*/) {}
+
       /// \brief Load a plugin for this sensor.
       /// \param[in] _sdf SDF parameters.
       private: void LoadPlugin(sdf::ElementPtr _sdf);
@@ -20,9 +20,14 @@
   #include <Winsock2.h>
 #endif
 
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
 #include <functional>
+#include <limits>
 #include <boost/bind.hpp>
 #include "gazebo/common/Assert.hh"
+#include "gazebo/common/Console.hh"
 #include "gazebo/common/Time.hh"
 
 #include "gazebo/physics/PhysicsIface.hh"
@@ -41,9 +46,131 @@ using namespace sensors;
 /// for timing coordination.
 boost::mutex g_sensorTimingMutex;
 
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \internal
+    /// \brief Runs sensor updates on a fixed set of threads. Each thread
+    /// initializes the physics engine for itself, since sensors such as ray
+    /// sensors query the collision engine.
+    class SensorWorkerPool
+    {
+      /// \brief Destructor. Stops the threads.
+      public: ~SensorWorkerPool()
+      {
+        this->Stop();
+      }
+
+      /// \brief Start the threads. Does nothing if already started.
+      /// \param[in] _threads Number of threads.
+      public: void Start(const unsigned int _threads)
+      {
+        boost::mutex::scoped_lock lock(this->mutex);
+        if (!this->threads.empty())
+          return;
+
+        this->stop = false;
+        for (unsigned int i = 0; i < std::max(1u, _threads); ++i)
+        {
+          this->threads.push_back(std::unique_ptr<boost::thread>(
+              new boost::thread(std::bind(&SensorWorkerPool::Run, this))));
+        }
+      }
+
+      /// \brief Run the tasks already posted and stop the threads.
+      public: void Stop()
+      {
+        {
+          boost::mutex::scoped_lock lock(this->mutex);
+          this->stop = true;
+        }
+        this->condition.notify_all();
+
+        for (auto &thread : this->threads)
+          thread->join();
+        this->threads.clear();
+      }
+
+      /// \brief Post a task.
+      /// \param[in] _task Task to run.
+      /// \return False if the pool isn't running, in which case the task
+      /// is dropped.
+      public: bool Post(const std::function<void()> &_task)
+      {
+        {
+          boost::mutex::scoped_lock lock(this->mutex);
+          if (this->threads.empty() || this->stop)
+            return false;
+          this->tasks.push_back(_task);
+        }
+        this->condition.notify_one();
+        return true;
+      }
+
+      /// \brief Get the number of threads to use. This is the value of
+      /// GAZEBO_SENSOR_THREADS if set, otherwise the number of cores up to 8.
+      /// \return Number of threads.
+      public: static unsigned int DefaultThreadCount()
+      {
+        const char *env = std::getenv("GAZEBO_SENSOR_THREADS");
+        if (env && *env)
+        {
+          int threads = std::atoi(env);
+          if (threads > 0)
+            return threads;
+          gzerr << "Invalid GAZEBO_SENSOR_THREADS [" << env << "]\n";
+        }
+        return std::max(1u,
+            std::min(8u, boost::thread::hardware_concurrency()));
+      }
+
+      /// \brief Run tasks until stopped.
+      private: void Run()
+      {
+        physics::WorldPtr world = physics::get_world();
+        if (world && world->Physics())
+          world->Physics()->InitForThread();
+        world.reset();
+
+        while (true)
+        {
+          std::function<void()> task;
+          {
+            boost::mutex::scoped_lock lock(this->mutex);
+            while (this->tasks.empty() && !this->stop)
+              this->condition.wait(lock);
+            if (this->tasks.empty())
+              return;
+            task = this->tasks.front();
+            this->tasks.pop_front();
+          }
+          task();
+        }
+      }
+
+      /// \brief The threads.
+      private: std::vector<std::unique_ptr<boost::thread>> threads;
+
+      /// \brief Tasks waiting for a thread.
+      private: std::deque<std::function<void()>> tasks;
+
+      /// \brief True to stop the threads once the tasks are done.
+      private: bool stop = false;
+
+      /// \brief Protects the tasks and the stop flag.
+      private: boost::mutex mutex;
+
+      /// \brief Notified when a task is posted or the pool stops.
+      private: boost::condition_variable condition;
+    };
+  }
+}
+
 //////////////////////////////////////////////////
 SensorManager::SensorManager()
-  : initialized(false), removeAllSensors(false)
+  : initialized(false), removeAllSensors(false),
+    workerPool(new SensorWorkerPool())
 {
   // sensors::IMAGE container
   this->sensorContainers.push_back(new ImageSensorContainer());
@@ -69,6 +196,7 @@ SensorManager::~SensorManager()
     delete (*iter);
   }
   this->sensorContainers.clear();
+  this->workerPool->Stop();
 
   this->initSensors.clear();
 }
@@ -76,6 +204,9 @@ SensorManager::~SensorManager()
 //////////////////////////////////////////////////
 void SensorManager::RunThreads()
 {
+  // The threads updating the non-image sensors, shared by their containers
+  this->workerPool->Start(SensorWorkerPool::DefaultThreadCount());
+
   // Start the non-image sensor containers. The first item in the
   // sensorsContainers list are the image-based sensors, which rely on the
   // rendering engine, which in turn requires that they run in the main
@@ -98,6 +229,7 @@ void SensorManager::Stop()
     GZ_ASSERT((*iter) != nullptr, "Sensor Constainer is null");
     (*iter)->Stop();
   }
+  this->workerPool->Stop();
 
   if (!physics::worlds_running())
     this->worlds.clear();
@@ -211,6 +343,22 @@ void SensorManager::ResetLastUpdateTimes()
   }
 }
 
+//////////////////////////////////////////////////
+bool SensorManager::UpdateStats(const std::string &_name,
+    SensorUpdateStats &_stats) const
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+
+  // Image sensors are updated by the main thread, skip their container
+  for (auto iter = ++this->sensorContainers.begin();
+       iter != this->sensorContainers.end(); ++iter)
+  {
+    if ((*iter)->UpdateStats(_name, _stats))
+      return true;
+  }
+  return false;
+}
+
 //////////////////////////////////////////////////
 void SensorManager::Init()
 {
@@ -458,11 +606,13 @@ void SensorManager::SensorContainer::Fini()
   for (iter = this->sensors.begin(); iter != this->sensors.end(); ++iter)
   {
     GZ_ASSERT((*iter) != nullptr, "Sensor is null");
+    this->WaitIdle(iter->get(), lock);
     (*iter)->Fini();
   }
 
   // Remove all the sensors from the current sensor vector.
   this->sensors.clear();
+  this->schedules.clear();
 
   this->initialized = false;
 }
@@ -490,6 +640,11 @@ void SensorManager::SensorContainer::Stop()
     delete this->runThread;
     this->runThread = nullptr;
   }
+
+  // Let the workers finish the updates already posted
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  for (auto &sensor : this->sensors)
+    this->WaitIdle(sensor.get(), lock);
 }
 
 //////////////////////////////////////////////////
@@ -519,38 +674,15 @@ void SensorManager::SensorContainer::RunLoop()
   // Release engine pointer, we don't need it in the loop
   engine.reset();
 
-  common::Time sleepTime, startTime, eventTime, diffTime;
-  double maxUpdateRate = 0;
+  // The shortest time between two updates of a sensor, for sensors without
+  // an update rate which update at every step.
+  common::Time minPeriod(world->Physics()->GetMaxStepSize());
 
   boost::mutex tmpMutex;
   boost::mutex::scoped_lock lock2(tmpMutex);
 
-  // Wait for a sensor to be added.
-  // Use a while loop since world resets will notify the runCondition.
-  while (this->sensors.empty())
-  {
-    this->runCondition.wait(lock2);
-    if (this->stop)
-      return;
-  }
-
-  {
-    boost::recursive_mutex::scoped_lock lock(this->mutex);
-
-    // Get the minimum update rate from the sensors.
-    for (Sensor_V::iterator iter = this->sensors.begin();
-        iter != this->sensors.end() && !this->stop; ++iter)
-    {
-      GZ_ASSERT((*iter) != nullptr, "Sensor is null");
-      maxUpdateRate = std::max((*iter)->UpdateRate(), maxUpdateRate);
-    }
-  }
-
-  // Calculate an appropriate sleep time.
-  if (maxUpdateRate > 0)
-    sleepTime.Set(1.0 / (maxUpdateRate));
-  else
-    sleepTime.Set(0, 1e6);
+  SensorWorkerPool *pool = SensorManager::Instance()->workerPool.get();
+  const common::Time never(std::numeric_limits<int32_t>::max(), 0);
 
   while (!this->stop)
   {
@@ -563,42 +695,77 @@ void SensorManager::SensorContainer::RunLoop()
         return;
     }
 
-    // Get the start time of the update.
-    startTime = world->SimTime();
-
-    this->Update(false);
-
-    // Compute the time it took to update the sensors.
-    // It's possible that the world time was reset during the Update. This
-    // would case a negative diffTime. Instead, just use a event time of zero
-    diffTime = std::max(common::Time::Zero, world->SimTime() - startTime);
+    common::Time simTime = world->SimTime();
+    common::Time nextEvent = never;
+    uint64_t wakeups;
 
-    // Set the default sleep time
-    eventTime = std::max(common::Time::Zero, sleepTime - diffTime);
+    // Post the sensors whose update is due, and find when the next one is
+    {
+      boost::recursive_mutex::scoped_lock lock(this->mutex);
+      for (auto &sensor : this->sensors)
+      {
+        Schedule &schedule = this->schedules[sensor.get()];
+        if (schedule.pending)
+          continue;
+
+        if (schedule.nextUpdate <= simTime)
+        {
+          // Idle sensors don't update, skip them without a round trip
+          // through the pool.
+          if (!sensor->CheckActivity())
+          {
+            schedule.nextUpdate = simTime +
+              std::max(minPeriod, common::Time(
+                    sensor->UpdateRate() > 0 ? 1.0 / sensor->UpdateRate() : 0));
+          }
+          else
+          {
+            schedule.pending = true;
+            common::Time due = schedule.nextUpdate;
+            if (!pool->Post(std::bind(
+                    &SensorManager::SensorContainer::UpdateSensor, this,
+                    world, sensor, due)))
+            {
+              schedule.pending = false;
+            }
+            continue;
+          }
+        }
+
+        nextEvent = std::min(nextEvent, schedule.nextUpdate);
+      }
+      this->waitUntil = nextEvent;
+      wakeups = this->wakeups;
+    }
 
     // Make sure update time is reasonable.
     // During log playback, time can jump forward an arbitrary amount.
-    if (diffTime.sec >= maxSensorUpdate && !util::LogPlay::Instance()->IsOpen())
+    if (nextEvent != never && nextEvent - simTime > maxSensorUpdate &&
+        !util::LogPlay::Instance()->IsOpen())
     {
-      gzwarn << "Took over 1000*max_step_size to update a sensor "
-        << "(took " << diffTime.sec << " sec, which is more than "
-        << "the max update of " << maxSensorUpdate << " sec). "
+      gzwarn << "Next sensor update is over 1000*max_step_size away "
+        << "(" << (nextEvent - simTime).Double() << " sec, which is more "
+        << "than the max update of " << maxSensorUpdate << " sec). "
         << "This warning can be ignored during log playback" << std::endl;
     }
 
-    // Make sure eventTime is not negative.
-    if (eventTime < common::Time::Zero)
+    boost::mutex::scoped_lock timingLock(g_sensorTimingMutex);
+
+    // A worker scheduled an update earlier than nextEvent since we looked
     {
-      gzerr << "Time to next sensor update is negative." << std::endl;
-      continue;
+      boost::recursive_mutex::scoped_lock lock(this->mutex);
+      if (this->wakeups != wakeups)
+        continue;
     }
 
-    boost::mutex::scoped_lock timingLock(g_sensorTimingMutex);
-
-    // Add an event to trigger when the appropriate simulation time has been
-    // reached.
-    SensorManager::Instance()->simTimeEventHandler->AddRelativeEvent(
-        eventTime, &this->runCondition);
+    // Add an event to trigger when the next update is due. If all the
+    // sensors are being updated, the workers wake us up when they are done.
+    if (nextEvent != never)
+    {
+      SensorManager::Instance()->simTimeEventHandler->AddRelativeEvent(
+          std::max(common::Time::Zero, nextEvent - world->SimTime()),
+          &this->runCondition);
+    }
 
     // This if statement helps prevent deadlock on osx during teardown.
     if (!this->stop)
@@ -608,6 +775,88 @@ void SensorManager::SensorContainer::RunLoop()
   }
 }
 
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::UpdateSensor(physics::WorldPtr _world,
+    SensorPtr _sensor, const common::Time _due)
+{
+  // The run loop's world, which stays valid while the update is pending,
+  // unlike physics::get_world() which fails once the world is removed
+  common::Time start = _world->SimTime();
+  common::Time wallStart = common::Time::GetWallTime();
+
+  _sensor->Update(false);
+
+  double duration = (common::Time::GetWallTime() - wallStart).Double();
+  double period = _sensor->UpdateRate() > 0 ? 1.0 / _sensor->UpdateRate() : 0;
+
+  bool wake = false;
+  {
+    boost::recursive_mutex::scoped_lock lock(this->mutex);
+    auto iter = this->schedules.find(_sensor.get());
+    if (iter != this->schedules.end())
+    {
+      Schedule &schedule = iter->second;
+
+      // Keep the update rate, unless the sensor fell behind, in which case
+      // it doesn't try to catch up. A sensor updates at most once per step.
+      schedule.nextUpdate = std::max(_due + common::Time(period),
+          start + common::Time(_world->Physics()->GetMaxStepSize()));
+      schedule.pending = false;
+
+      SensorUpdateStats &stats = schedule.stats;
+      double latency = std::max(0.0, (start - _due).Double());
+      ++stats.count;
+      stats.meanLatency += (latency - stats.meanLatency) / stats.count;
+      stats.maxLatency = std::max(stats.maxLatency, latency);
+      stats.meanDuration += (duration - stats.meanDuration) / stats.count;
+      stats.maxDuration = std::max(stats.maxDuration, duration);
+
+      if (schedule.nextUpdate < this->waitUntil)
+      {
+        ++this->wakeups;
+        wake = true;
+      }
+    }
+  }
+  this->idleCondition.notify_all();
+
+  if (wake)
+  {
+    boost::mutex::scoped_lock timingLock(g_sensorTimingMutex);
+    this->runCondition.notify_all();
+  }
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::WaitIdle(Sensor *_sensor,
+    boost::unique_lock<boost::recursive_mutex> &_lock)
+{
+  auto iter = this->schedules.find(_sensor);
+  while (iter != this->schedules.end() && iter->second.pending)
+  {
+    this->idleCondition.wait(_lock);
+    iter = this->schedules.find(_sensor);
+  }
+}
+
+//////////////////////////////////////////////////
+bool SensorManager::SensorContainer::UpdateStats(const std::string &_name,
+    SensorUpdateStats &_stats) const
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  for (auto const &sensor : this->sensors)
+  {
+    if (sensor->ScopedName() == _name)
+    {
+      auto iter = this->schedules.find(sensor.get());
+      _stats = iter != this->schedules.end() ?
+          iter->second.stats : SensorUpdateStats();
+      return true;
+    }
+  }
+  return false;
+}
+
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::Update(bool _force)
 {
@@ -616,11 +865,13 @@ void SensorManager::SensorContainer::Update(bool _force)
   if (this->sensors.empty())
     gzlog << "Updating a sensor container without any sensors.\n";
 
-  // Update all the sensors in this container.
+  // Update all the sensors in this container. Their activity is checked
+  // here, since they don't go through RunLoop.
   for (Sensor_V::iterator iter = this->sensors.begin();
        iter != this->sensors.end(); ++iter)
   {
     GZ_ASSERT((*iter) != nullptr, "Sensor is null");
+    (*iter)->CheckActivity();
     (*iter)->Update(_force);
   }
 }
@@ -660,6 +911,7 @@ void SensorManager::SensorContainer::AddSensor(SensorPtr _sensor)
   {
     boost::recursive_mutex::scoped_lock lock(this->mutex);
     this->sensors.push_back(_sensor);
+    this->schedules[_sensor.get()] = Schedule();
   }
 
   // Tell the run loop that we have received a sensor
@@ -682,7 +934,10 @@ bool SensorManager::SensorContainer::RemoveSensor(const std::string &_name)
 
     if ((*iter)->ScopedName() == _name)
     {
+      // Don't finalize the sensor while a worker updates it
+      this->WaitIdle(iter->get(), lock);
       (*iter)->Fini();
+      this->schedules.erase(iter->get());
       this->sensors.erase(iter);
       removed = true;
       break;
@@ -706,6 +961,10 @@ void SensorManager::SensorContainer::ResetLastUpdateTimes()
     (*iter)->ResetLastUpdateTime();
   }
 
+  // Time went back, so schedule all the sensors now
+  for (auto &schedule : this->schedules)
+    schedule.second.nextUpdate = common::Time::Zero;
+
   // Tell the run loop that world time has been reset.
   this->runCondition.notify_one();
 }
@@ -721,10 +980,12 @@ void SensorManager::SensorContainer::RemoveSensors()
   for (iter = this->sensors.begin(); iter != this->sensors.end(); ++iter)
   {
     GZ_ASSERT((*iter) != nullptr, "Sensor is null");
+    this->WaitIdle(iter->get(), lock);
     (*iter)->Fini();
   }
 
   this->sensors.clear();
+  this->schedules.clear();
 }
 
 //////////////////////////////////////////////////
@@ -18,10 +18,13 @@
 #define _GAZEBO_SENSORMANAGER_HH_
 
 #include <boost/thread.hpp>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <list>
 #include <map>
+#include <memory>
+#include <unordered_map>
 
 #include <sdf/sdf.hh>
 
@@ -82,10 +85,37 @@ namespace gazebo
       /// \brief Connect to the World::UpdateBegin event.
       private: event::ConnectionPtr updateConnection;
     };
+
+    /// \brief Runs sensor updates on a fixed set of threads.
+    class SensorWorkerPool;
     /// \endcond
 
     /// \addtogroup gazebo_sensors
     /// \{
+
+    /// \class SensorUpdateStats SensorManager.hh sensors/sensors.hh
+    /// \brief Update statistics of a sensor run by the sensor threads.
+    class GZ_SENSORS_VISIBLE SensorUpdateStats
+    {
+      /// \brief Number of updates.
+      public: uint64_t count = 0;
+
+      /// \brief Mean delay between the simulation time at which an update
+      /// was due and the simulation time at which it started, in seconds.
+      public: double meanLatency = 0;
+
+      /// \brief Largest delay between the simulation time at which an
+      /// update was due and the simulation time at which it started, in
+      /// seconds.
+      public: double maxLatency = 0;
+
+      /// \brief Mean wall clock duration of an update, in seconds.
+      public: double meanDuration = 0;
+
+      /// \brief Largest wall clock duration of an update, in seconds.
+      public: double maxDuration = 0;
+    };
+
     /// \class SensorManager SensorManager.hh sensors/sensors.hh
     /// \brief Class to manage and update all sensors
     class GZ_SENSORS_VISIBLE SensorManager : public SingletonT<SensorManager>
@@ -108,7 +138,10 @@ namespace gazebo
       public: void Init();
 
       /// \brief Run sensor updates in separate threads.
-      /// This will only run non-image based sensor updates.
+      /// This will only run non-image based sensor updates. Each sensor is
+      /// updated when its next update is due in simulation time, on a pool
+      /// of GAZEBO_SENSOR_THREADS threads (by default the number of cores,
+      /// up to 8), so a slow sensor doesn't delay the others.
       public: void RunThreads();
 
       /// \brief Stop the run thread
@@ -172,6 +205,14 @@ namespace gazebo
       /// \brief Reset last update times in all sensors.
       public: void ResetLastUpdateTimes();
 
+      /// \brief Get the update statistics of a sensor run by the sensor
+      /// threads, see RunThreads.
+      /// \param[in] _name Scoped name of the sensor.
+      /// \param[out] _stats Statistics since the sensor was added.
+      /// \return False if the sensor is not run by the sensor threads.
+      public: bool UpdateStats(const std::string &_name,
+                               SensorUpdateStats &_stats) const;
+
       /// \brief Add a new sensor to a sensor container.
       /// \param[in] _sensor Pointer to a sensor to add.
       private: void AddSensor(SensorPtr _sensor);
@@ -234,10 +275,47 @@ namespace gazebo
                  /// \brief Reset last update times in all sensors.
                  public: void ResetLastUpdateTimes();
 
-                 /// \brief A loop to update the sensor. Used by the
-                 /// runThread.
+                 /// \brief Get the update statistics of a sensor.
+                 /// \param[in] _name Scoped name of the sensor.
+                 /// \param[out] _stats Statistics of the sensor.
+                 /// \return False if the sensor isn't in this container.
+                 public: bool UpdateStats(const std::string &_name,
+                                          SensorUpdateStats &_stats) const;
+
+                 /// \brief A loop which posts the sensors whose update is
+                 /// due to the worker pool. Used by the runThread.
                  private: void RunLoop();
 
+                 /// \brief Update a sensor on a worker thread, and schedule
+                 /// its next update.
+                 /// \param[in] _world World the run loop schedules the
+                 /// updates with.
+                 /// \param[in] _sensor Sensor to update.
+                 /// \param[in] _due Simulation time the update was due.
+                 private: void UpdateSensor(physics::WorldPtr _world,
+                                            SensorPtr _sensor,
+                                            const common::Time _due);
+
+                 /// \brief Wait until a sensor is not being updated by a
+                 /// worker thread. The mutex must be locked once.
+                 /// \param[in] _sensor The sensor.
+                 /// \param[in] _lock Lock of the mutex.
+                 private: void WaitIdle(Sensor *_sensor,
+                    boost::unique_lock<boost::recursive_mutex> &_lock);
+
+                 /// \brief Update schedule of a sensor.
+                 private: class Schedule
+                          {
+                            /// \brief Simulation time of the next update.
+                            public: common::Time nextUpdate;
+
+                            /// \brief True while posted to the worker pool.
+                            public: bool pending = false;
+
+                            /// \brief Update statistics.
+                            public: SensorUpdateStats stats;
+                          };
+
                  /// \brief The set of sensors to maintain.
                  public: Sensor_V sensors;
 
@@ -257,6 +335,21 @@ namespace gazebo
                  /// \brief Condition used to block the RunLoop if no
                  /// sensors are present.
                  private: boost::condition_variable runCondition;
+
+                 /// \brief Schedule of each sensor, protected by mutex.
+                 private: std::unordered_map<Sensor *, Schedule> schedules;
+
+                 /// \brief Notified when a worker finishes a sensor update.
+                 private: boost::condition_variable_any idleCondition;
+
+                 /// \brief Simulation time until which the RunLoop waits,
+                 /// protected by mutex. A worker which schedules an earlier
+                 /// update wakes the RunLoop.
+                 private: common::Time waitUntil;
+
+                 /// \brief Number of times workers asked the RunLoop to
+                 /// wake up, protected by mutex.
+                 private: uint64_t wakeups = 0;
                };
       /// \endcond
 
@@ -303,6 +396,9 @@ namespace gazebo
       /// \brief Pointer to the sim time event handler.
       private: SimTimeEventHandler *simTimeEventHandler;
 
+      /// \brief Threads which update the non-image sensors.
+      private: std::unique_ptr<SensorWorkerPool> workerPool;
+
       /// \brief All the worlds whose sensors have been initialized. This
       /// includes worlds without sensors..
       private: std::map<std::string, physics::WorldPtr> worlds;
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_SENSORS_SENSOR_PRIVATE_HH_
 #define GAZEBO_SENSORS_SENSOR_PRIVATE_HH_
 
+#include <atomic>
 #include <mutex>
 #include <sdf/sdf.hh>
 
@@ -54,6 +55,15 @@ namespace gazebo
       /// \brief The sensors unique ID.
       public: uint32_t id;
 
+      /// \brief Activity of the sensor at the last CheckActivity.
+      public: bool lastActive = true;
+
+      /// \brief Number of due updates for which the sensor was active.
+      public: std::atomic<uint64_t> activeUpdates{0};
+
+      /// \brief Number of due updates for which the sensor was idle.
+      public: std::atomic<uint64_t> idleUpdates{0};
+
       /// \brief An SDF pointer that allows us to only read the sensor.sdf
       /// file once, which in turns limits disk reads.
       public: static sdf::ElementPtr sdfSensor;
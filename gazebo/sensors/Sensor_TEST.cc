@@ -207,6 +207,33 @@ TEST_F(Sensor_TEST, SetPose)
   EXPECT_EQ(sensor.Pose(), ignition::math::Pose3d(0, 1, 2, 3, 4, 5));
 }
 
+/////////////////////////////////////////////////
+/// \brief A sensor is active only while something wants its output
+TEST_F(Sensor_TEST, Demand)
+{
+  sensors::Sensor sensor(gazebo::sensors::OTHER);
+  EXPECT_FALSE(sensor.IsActive());
+  EXPECT_FALSE(sensor.CheckActivity());
+  EXPECT_EQ(sensor.IdleUpdateCount(), 1u);
+  EXPECT_EQ(sensor.ActiveUpdateCount(), 0u);
+
+  // A subscriber to the updates, like a plugin or a logger
+  event::ConnectionPtr connection = sensor.ConnectUpdated([](){});
+  EXPECT_TRUE(sensor.IsActive());
+  EXPECT_TRUE(sensor.CheckActivity());
+  EXPECT_EQ(sensor.ActiveUpdateCount(), 1u);
+
+  connection.reset();
+  EXPECT_FALSE(sensor.CheckActivity());
+  EXPECT_EQ(sensor.IdleUpdateCount(), 2u);
+
+  // Forced
+  sensor.SetActive(true);
+  EXPECT_TRUE(sensor.CheckActivity());
+  EXPECT_EQ(sensor.ActiveUpdateCount(), 2u);
+  EXPECT_EQ(sensor.IdleUpdateCount(), 2u);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -175,3 +175,10 @@ void WirelessReceiver::Fini()
 {
   WirelessTransceiver::Fini();
 }
+
+//////////////////////////////////////////////////
+bool WirelessReceiver::IsActive() const
+{
+  return Sensor::IsActive() ||
+    (this->pub && this->pub->HasConnections());
+}
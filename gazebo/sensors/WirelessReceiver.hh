@@ -65,6 +65,9 @@ namespace gazebo
       /// \return Receiver sensitivity (dBm).
       public: double Sensitivity() const;
 
+      // Documentation inherited
+      public: virtual bool IsActive() const;
+
       // Documentation inherited
       protected: virtual bool UpdateImpl(const bool _force);
 
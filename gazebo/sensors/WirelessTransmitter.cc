@@ -20,6 +20,8 @@
   #include <Winsock2.h>
 #endif
 
+#include <cmath>
+
 #include <ignition/math/Rand.hh>
 
 #include "gazebo/msgs/msgs.hh"
@@ -42,6 +44,159 @@ const double WirelessTransmitterPrivate::NObstacle = 12.0;
 const double WirelessTransmitterPrivate::ModelStdDev = 6.0;
 const double WirelessTransmitterPrivate::Step = 1.0;
 const double WirelessTransmitterPrivate::MaxRadius = 10.0;
+const double WirelessTransmitterPrivate::MapResolution = 0.5;
+const double WirelessTransmitterPrivate::MapTolerance = 0.25;
+
+/////////////////////////////////////////////////
+bool PropagationMap::Obstructed(const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_end, bool &_obstructed) const
+{
+  const double tolerance = WirelessTransmitterPrivate::MapTolerance;
+  if (this->size == 0 || _start.Distance(this->origin) > tolerance ||
+      std::abs(_end.Z() - this->origin.Z()) > tolerance)
+  {
+    return false;
+  }
+
+  const int half = static_cast<int>(this->size / 2);
+  const int i = half + static_cast<int>(std::round((_end.X() -
+          this->origin.X()) / WirelessTransmitterPrivate::MapResolution));
+  const int j = half + static_cast<int>(std::round((_end.Y() -
+          this->origin.Y()) / WirelessTransmitterPrivate::MapResolution));
+  if (i < 0 || j < 0 || i >= static_cast<int>(this->size) ||
+      j >= static_cast<int>(this->size))
+  {
+    return false;
+  }
+
+  // Near the edge of an obstacle's shadow the receiver may be in the open
+  // even though the center of its cell isn't
+  _obstructed = true;
+  for (int di = -1; di <= 1 && _obstructed; ++di)
+  {
+    for (int dj = -1; dj <= 1 && _obstructed; ++dj)
+    {
+      const int ni = i + di;
+      const int nj = j + dj;
+      _obstructed = ni >= 0 && nj >= 0 &&
+        ni < static_cast<int>(this->size) &&
+        nj < static_cast<int>(this->size) &&
+        this->obstructed[ni * this->size + nj] != 0;
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool WirelessTransmitterPrivate::StaticModelsMoved(physics::WorldPtr _world)
+{
+  // While no model is added or removed, the poses of the listed static
+  // models are compared
+  if (_world->ModelCount() == this->modelCount)
+  {
+    bool moved = false;
+    for (auto const &entry : this->staticModels)
+    {
+      physics::ModelPtr model = std::get<0>(entry).lock();
+      if (!model || model->WorldPose() != std::get<2>(entry))
+      {
+        moved = true;
+        break;
+      }
+    }
+
+    if (!moved)
+      return false;
+  }
+
+  std::vector<std::tuple<boost::weak_ptr<physics::Model>, uint32_t,
+      ignition::math::Pose3d>> models;
+  physics::Model_V all = _world->Models();
+  for (auto const &model : all)
+  {
+    if (model->IsStatic())
+    {
+      models.push_back(std::make_tuple(boost::weak_ptr<physics::Model>(model),
+            model->GetId(), model->WorldPose()));
+    }
+  }
+  this->modelCount = static_cast<unsigned int>(all.size());
+
+  // Models other than static ones may have been added or removed
+  bool changed = models.size() != this->staticModels.size();
+  for (unsigned int k = 0; !changed && k < models.size(); ++k)
+  {
+    changed = std::get<1>(models[k]) != std::get<1>(this->staticModels[k]) ||
+      std::get<2>(models[k]) != std::get<2>(this->staticModels[k]);
+  }
+
+  this->staticModels.swap(models);
+  return changed;
+}
+
+/////////////////////////////////////////////////
+void WirelessTransmitterPrivate::UpdateMap(physics::PhysicsEnginePtr _physics,
+    const ignition::math::Vector3d &_origin)
+{
+  std::shared_ptr<PropagationMap> newMap(new PropagationMap);
+  newMap->origin = _origin;
+
+  // One ray from the transmitter to the center of each cell
+  const int half = static_cast<int>(std::ceil(MaxRadius / MapResolution));
+  newMap->size = 2 * half + 1;
+  this->batch.Resize(newMap->size * newMap->size);
+  this->batch.staticOnly = true;
+  unsigned int k = 0;
+  for (int i = -half; i <= half; ++i)
+  {
+    for (int j = -half; j <= half; ++j, ++k)
+    {
+      this->batch.starts[k] = _origin;
+      this->batch.ends[k] = _origin +
+        ignition::math::Vector3d(i * MapResolution, j * MapResolution, 0);
+    }
+  }
+
+  this->CastRays(_physics, this->batch, newMap->obstructed);
+
+  std::lock_guard<std::mutex> lock(this->mapMutex);
+  this->map = newMap;
+}
+
+/////////////////////////////////////////////////
+void WirelessTransmitterPrivate::CastRays(physics::PhysicsEnginePtr _physics,
+    physics::RayCastBatch &_batch, std::vector<uint8_t> &_obstructed)
+{
+  // Avoid computing the intersection of coincident points
+  // This prevents an assertion in bullet (issue #849)
+  for (unsigned int i = 0; i < _batch.Size(); ++i)
+  {
+    if (_batch.starts[i] == _batch.ends[i])
+      _batch.ends[i].Z() += 0.00001;
+  }
+
+  _obstructed.assign(_batch.Size(), 0);
+  if (_physics->CastRays(_batch))
+  {
+    for (unsigned int i = 0; i < _batch.Size(); ++i)
+      _obstructed[i] = _batch.hits[i] != nullptr;
+    return;
+  }
+
+  // Acquire the mutex for avoiding race condition with the physics engine
+  boost::recursive_mutex::scoped_lock lock(*(
+        _physics->GetPhysicsUpdateMutex()));
+
+  // One ray at a time, against all the models
+  for (unsigned int i = 0; i < _batch.Size(); ++i)
+  {
+    std::string entityName;
+    double dist;
+    this->testRay->SetPoints(_batch.starts[i], _batch.ends[i]);
+    this->testRay->GetIntersection(dist, entityName);
+    _obstructed[i] = !entityName.empty();
+  }
+}
 
 /////////////////////////////////////////////////
 WirelessTransmitter::WirelessTransmitter()
@@ -85,8 +240,9 @@ void WirelessTransmitter::Init()
 {
   WirelessTransceiver::Init();
 
-  // This ray will be used in SignalStrength() for checking obstacles
-  // between the transmitter and a given point.
+  // This ray will be used for checking obstacles between the transmitter
+  // and a given point, with physics engines which can't cast a batch of
+  // rays.
   this->dataPtr->testRay = boost::dynamic_pointer_cast<RayShape>(
       this->world->Physics()->CreateShape("ray", CollisionPtr()));
 }
@@ -96,6 +252,21 @@ bool WirelessTransmitter::UpdateImpl(const bool /*_force*/)
 {
   this->referencePose = this->pose + this->parentEntity.lock()->WorldPose();
 
+  // Compute the propagation map again when static obstacles or the
+  // transmitter moved
+  const ignition::math::Vector3d &origin = this->referencePose.Pos();
+  bool staticModelsMoved = this->dataPtr->StaticModelsMoved(this->world);
+  std::shared_ptr<const PropagationMap> map;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mapMutex);
+    map = this->dataPtr->map;
+  }
+  if (staticModelsMoved || !map ||
+      map->origin.Distance(origin) > WirelessTransmitterPrivate::MapTolerance)
+  {
+    this->dataPtr->UpdateMap(this->world->Physics(), origin);
+  }
+
   if (this->dataPtr->visualize)
   {
     msgs::PropagationGrid msg;
@@ -154,34 +325,36 @@ double WirelessTransmitter::SignalStrength(
     const ignition::math::Pose3d &_receiver,
     const double _rxGain)
 {
-  std::string entityName;
-  double dist;
   ignition::math::Vector3d end = _receiver.Pos();
   ignition::math::Vector3d start = this->referencePose.Pos();
 
-  // Avoid computing the intersection of coincident points
-  // This prevents an assertion in bullet (issue #849)
-  if (start == end)
+  // Looking for obstacles between start and end points. The propagation
+  // map only holds static models, so unless it shows the receiver well
+  // behind a static obstacle, a ray is cast against all the models, which
+  // finds the dynamic ones along the path.
+  std::shared_ptr<const PropagationMap> map;
   {
-    end.Z() += 0.00001;
+    std::lock_guard<std::mutex> lock(this->dataPtr->mapMutex);
+    map = this->dataPtr->map;
   }
 
-  // Acquire the mutex for avoiding race condition with the physics engine
-  boost::recursive_mutex::scoped_lock lock(*(
-        this->world->Physics()->GetPhysicsUpdateMutex()));
+  bool obstructed = false;
+  if (!map || !map->Obstructed(start, end, obstructed) || !obstructed)
+  {
+    physics::RayCastBatch batch;
+    batch.Resize(1);
+    batch.starts[0] = start;
+    batch.ends[0] = end;
+
+    std::vector<uint8_t> hits;
+    this->dataPtr->CastRays(this->world->Physics(), batch, hits);
+    obstructed = hits[0] != 0;
+  }
 
   // Compute the value of n depending on the obstacles between Tx and Rx
-  double n = WirelessTransmitterPrivate::NEmpty;
-
-  // Looking for obstacles between start and end points
-  this->dataPtr->testRay->SetPoints(start, end);
-  this->dataPtr->testRay->GetIntersection(dist, entityName);
-
   // ToDo: The ray intersects with my own collision model. Fix it.
-  if (entityName != "")
-  {
-    n = WirelessTransmitterPrivate::NObstacle;
-  }
+  double n = obstructed ? WirelessTransmitterPrivate::NObstacle :
+    WirelessTransmitterPrivate::NEmpty;
 
   double distance = std::max(1.0,
       this->referencePose.Pos().Distance(_receiver.Pos()));
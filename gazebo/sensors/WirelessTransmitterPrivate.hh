@@ -17,17 +17,79 @@
 #ifndef _GAZEBO_SENSORS_WIRELESSTRANSMITTER_PRIVATE_HH_
 #define _GAZEBO_SENSORS_WIRELESSTRANSMITTER_PRIVATE_HH_
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
+#include <vector>
+#include <boost/weak_ptr.hpp>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/RayCastBatch.hh"
 
 namespace gazebo
 {
   namespace sensors
   {
+    /// \internal
+    /// \brief Obstacles around a transmitter, on a horizontal grid aligned
+    /// with the world axes and centered on the transmitter.
+    class PropagationMap
+    {
+      /// \brief Look up whether there are obstacles between the
+      /// transmitter and a receiver. A receiver is only known to be behind
+      /// an obstacle if its cell and the cells around it are, since the
+      /// receiver can be anywhere in its cell. Gaps in the obstacles
+      /// narrower than a cell can still be missed.
+      /// \param[in] _start Position of the transmitter.
+      /// \param[in] _end Position of the receiver.
+      /// \param[out] _obstructed True if the receiver's cell and its
+      /// neighbours are obstructed.
+      /// \return False if the map doesn't cover the receiver, or the
+      /// transmitter moved too far since the map was computed.
+      public: bool Obstructed(const ignition::math::Vector3d &_start,
+                  const ignition::math::Vector3d &_end,
+                  bool &_obstructed) const;
+
+      /// \brief Position of the transmitter when the map was computed.
+      public: ignition::math::Vector3d origin;
+
+      /// \brief Number of cells along each axis.
+      public: unsigned int size = 0;
+
+      /// \brief For each cell, row by row along x, 1 if there are static
+      /// obstacles between the transmitter and the center of the cell.
+      public: std::vector<uint8_t> obstructed;
+    };
+
     /// \internal
     /// \brief Wireless transmitter private data
     class WirelessTransmitterPrivate
     {
+      /// \brief Check whether static models were added, removed or moved
+      /// since the last call.
+      /// \param[in] _world World of the transmitter.
+      /// \return True if the static models changed.
+      public: bool StaticModelsMoved(physics::WorldPtr _world);
+
+      /// \brief Compute the propagation map again, and replace the map.
+      /// \param[in] _physics Physics engine to cast the rays with.
+      /// \param[in] _origin Position of the transmitter.
+      public: void UpdateMap(physics::PhysicsEnginePtr _physics,
+                  const ignition::math::Vector3d &_origin);
+
+      /// \brief Cast a batch of rays against static models, all at once
+      /// when the physics engine supports it, or one at a time against
+      /// all models otherwise.
+      /// \param[in] _physics Physics engine to cast the rays with.
+      /// \param[in,out] _batch Rays to cast.
+      /// \param[out] _obstructed 1 for each ray which hit something.
+      public: void CastRays(physics::PhysicsEnginePtr _physics,
+                  physics::RayCastBatch &_batch,
+                  std::vector<uint8_t> &_obstructed);
+
       /// \brief Constant used in the propagation model when there are no
       /// obstacles between transmitter and receiver
       public: static const double NEmpty;
@@ -47,6 +109,33 @@ namespace gazebo
       /// grid, where the maximum radius covered is MaxRadius
       public: static const double MaxRadius;
 
+      /// \brief Size of the cells of the propagation map.
+      public: static const double MapResolution;
+
+      /// \brief Distance the transmitter can move, and the height of a
+      /// receiver above or below it, before the propagation map isn't used.
+      public: static const double MapTolerance;
+
+      /// \brief Obstacles around the transmitter, computed again when the
+      /// transmitter or a static model moves. Replaced rather than
+      /// modified, so receivers keep using the map they got.
+      public: std::shared_ptr<const PropagationMap> map;
+
+      /// \brief Protects the map pointer.
+      public: std::mutex mapMutex;
+
+      /// \brief Static models, with their id and world pose when the map
+      /// was computed. Only listed again when models are added or removed.
+      public: std::vector<std::tuple<boost::weak_ptr<physics::Model>,
+              uint32_t, ignition::math::Pose3d>> staticModels;
+
+      /// \brief Number of models in the world when the static models were
+      /// listed.
+      public: unsigned int modelCount = 0;
+
+      /// \brief Rays cast to compute the map.
+      public: physics::RayCastBatch batch;
+
       // \brief When true it will publish the propagation grid to be used
       // by the transmitter visual layer
       public: bool visualize = false;
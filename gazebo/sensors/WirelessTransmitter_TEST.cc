@@ -24,6 +24,8 @@ class WirelessTransmitter_TEST : public ServerFixture
     public: WirelessTransmitter_TEST();
     public: void TestCreateWirelessTransmitter();
     public: void TestSignalStrength();
+    public: void TestStaticObstacle();
+    public: void TestDynamicObstacle();
     public: void TestUpdateImpl();
     public: void TestUpdateImplNoVisual();
     public: void TestInvalidFreq();
@@ -159,6 +161,88 @@ void WirelessTransmitter_TEST::TestSignalStrength()
   EXPECT_NEAR(signStrengthAvg, -62.0, this->tx->ModelStdDev());
 }
 
+/////////////////////////////////////////////////
+/// \brief Test that the propagation map follows static obstacles
+void WirelessTransmitter_TEST::TestStaticObstacle()
+{
+  // A wall between the transmitter and one of two receivers at the same
+  // distance
+  this->SpawnBox("wall", ignition::math::Vector3d(0.2, 4, 1),
+      ignition::math::Vector3d(2, 0, 0.5), ignition::math::Vector3d::Zero,
+      true);
+  ignition::math::Pose3d behindWall(4, 0, 0.055, 0, 0, 0);
+  ignition::math::Pose3d inTheOpen(0, 4, 0.055, 0, 0, 0);
+
+  const int samples = 100;
+  double behindWallAvg = 0.0;
+  double inTheOpenAvg = 0.0;
+  this->tx->Update(true);
+  for (int i = 0; i < samples; ++i)
+  {
+    behindWallAvg += this->tx->SignalStrength(behindWall, tx->Gain());
+    inTheOpenAvg += this->tx->SignalStrength(inTheOpen, tx->Gain());
+  }
+  EXPECT_LT(behindWallAvg / samples, inTheOpenAvg / samples - 20.0);
+
+  // Moving the wall away updates the map
+  physics::ModelPtr wall = physics::get_world()->ModelByName("wall");
+  ASSERT_TRUE(wall != nullptr);
+  wall->SetWorldPose(ignition::math::Pose3d(2, 20, 0.5, 0, 0, 0));
+  this->tx->Update(true);
+
+  behindWallAvg = 0.0;
+  inTheOpenAvg = 0.0;
+  for (int i = 0; i < samples; ++i)
+  {
+    behindWallAvg += this->tx->SignalStrength(behindWall, tx->Gain());
+    inTheOpenAvg += this->tx->SignalStrength(inTheOpen, tx->Gain());
+  }
+  EXPECT_NEAR(behindWallAvg / samples, inTheOpenAvg / samples,
+      this->tx->ModelStdDev());
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that dynamic obstacles, which the propagation map doesn't
+/// hold, attenuate the signal
+void WirelessTransmitter_TEST::TestDynamicObstacle()
+{
+  // A box between the transmitter and one of two receivers at the same
+  // distance
+  this->SpawnBox("box", ignition::math::Vector3d(0.2, 4, 1),
+      ignition::math::Vector3d(2, 0, 0.5), ignition::math::Vector3d::Zero,
+      false);
+  physics::ModelPtr box = physics::get_world()->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  EXPECT_FALSE(box->IsStatic());
+
+  ignition::math::Pose3d behindBox(4, 0, 0.055, 0, 0, 0);
+  ignition::math::Pose3d inTheOpen(0, 4, 0.055, 0, 0, 0);
+
+  const int samples = 100;
+  double behindBoxAvg = 0.0;
+  double inTheOpenAvg = 0.0;
+  this->tx->Update(true);
+  for (int i = 0; i < samples; ++i)
+  {
+    behindBoxAvg += this->tx->SignalStrength(behindBox, tx->Gain());
+    inTheOpenAvg += this->tx->SignalStrength(inTheOpen, tx->Gain());
+  }
+  EXPECT_LT(behindBoxAvg / samples, inTheOpenAvg / samples - 20.0);
+
+  // Moving the box away clears the path without a map update
+  box->SetWorldPose(ignition::math::Pose3d(2, 20, 0.5, 0, 0, 0));
+
+  behindBoxAvg = 0.0;
+  inTheOpenAvg = 0.0;
+  for (int i = 0; i < samples; ++i)
+  {
+    behindBoxAvg += this->tx->SignalStrength(behindBox, tx->Gain());
+    inTheOpenAvg += this->tx->SignalStrength(inTheOpen, tx->Gain());
+  }
+  EXPECT_NEAR(behindBoxAvg / samples, inTheOpenAvg / samples,
+      this->tx->ModelStdDev());
+}
+
 /////////////////////////////////////////////////
 /// \brief Callback executed for every propagation grid message received
 void WirelessTransmitter_TEST::TxMsg(const ConstPropagationGridPtr &_msg)
@@ -254,6 +338,18 @@ TEST_F(WirelessTransmitter_TEST, TestSignalStrength)
   TestSignalStrength();
 }
 
+/////////////////////////////////////////////////
+TEST_F(WirelessTransmitter_TEST, TestStaticObstacle)
+{
+  TestStaticObstacle();
+}
+
+/////////////////////////////////////////////////
+TEST_F(WirelessTransmitter_TEST, TestDynamicObstacle)
+{
+  TestDynamicObstacle();
+}
+
 /////////////////////////////////////////////////
 TEST_F(WirelessTransmitter_TEST, TestUpdateImpl)
 {
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <boost/weak_ptr.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "gazebo/transport/BufferPool.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+const std::size_t BufferPool::MaxFreeCount = 32;
+const std::size_t BufferPool::MaxFreeBytes = 64 * 1024 * 1024;
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Private data for BufferPool. Outstanding buffers hold a weak
+    /// pointer to it, so they can outlive the pool.
+    class BufferPoolPrivate
+    {
+      /// \brief Take back a released buffer, or free it if the pool is
+      /// full.
+      /// \param[in] _buffer Buffer without references left.
+      public: void Release(std::string *_buffer)
+              {
+                {
+                  std::lock_guard<std::mutex> lock(this->mutex);
+                  if (this->free.size() < BufferPool::MaxFreeCount &&
+                      this->freeBytes + _buffer->capacity() <=
+                      BufferPool::MaxFreeBytes)
+                  {
+                    this->freeBytes += _buffer->capacity();
+                    this->free.push_back(_buffer);
+                    return;
+                  }
+                }
+                delete _buffer;
+              }
+
+      /// \brief Free buffers. The size of each buffer is left as it was,
+      /// so resizing to a similar size doesn't touch the memory.
+      public: std::vector<std::string *> free;
+
+      /// \brief Capacity of the free buffers in bytes.
+      public: std::size_t freeBytes = 0;
+
+      /// \brief Protects the free buffers.
+      public: mutable std::mutex mutex;
+
+      /// \brief Number of buffers allocated.
+      public: std::atomic<uint64_t> allocations{0};
+
+      /// \brief Number of buffers reused.
+      public: std::atomic<uint64_t> reuses{0};
+    };
+
+    /// \internal
+    /// \brief Deleter of pooled buffers.
+    class BufferReleaser
+    {
+      /// \brief Constructor
+      /// \param[in] _pool Pool to return the buffer to.
+      public: explicit BufferReleaser(
+                  const boost::shared_ptr<BufferPoolPrivate> &_pool)
+              : pool(_pool)
+              {
+              }
+
+      /// \brief Return the buffer to the pool, or free it if the pool is
+      /// gone.
+      /// \param[in] _buffer Buffer to release.
+      public: void operator()(std::string *_buffer) const
+              {
+                boost::shared_ptr<BufferPoolPrivate> p = this->pool.lock();
+                if (p)
+                  p->Release(_buffer);
+                else
+                  delete _buffer;
+              }
+
+      /// \brief Pool the buffer came from.
+      private: boost::weak_ptr<BufferPoolPrivate> pool;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+BufferPool::BufferPool()
+  : dataPtr(new BufferPoolPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+BufferPool::~BufferPool()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto buffer : this->dataPtr->free)
+    delete buffer;
+  this->dataPtr->free.clear();
+  this->dataPtr->freeBytes = 0;
+}
+
+/////////////////////////////////////////////////
+BufferPtr BufferPool::Acquire(const std::size_t _size)
+{
+  std::string *buffer = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+    // Prefer the smallest free buffer which is large enough, otherwise
+    // grow the largest one.
+    auto best = this->dataPtr->free.end();
+    for (auto iter = this->dataPtr->free.begin();
+         iter != this->dataPtr->free.end(); ++iter)
+    {
+      if (best == this->dataPtr->free.end())
+      {
+        best = iter;
+        continue;
+      }
+
+      bool fits = (*iter)->capacity() >= _size;
+      bool bestFits = (*best)->capacity() >= _size;
+      if ((fits && (!bestFits || (*iter)->capacity() < (*best)->capacity()))
+          || (!fits && !bestFits && (*iter)->capacity() > (*best)->capacity()))
+      {
+        best = iter;
+      }
+    }
+
+    if (best != this->dataPtr->free.end())
+    {
+      buffer = *best;
+      this->dataPtr->freeBytes -= buffer->capacity();
+      *best = this->dataPtr->free.back();
+      this->dataPtr->free.pop_back();
+    }
+  }
+
+  if (buffer)
+    this->dataPtr->reuses++;
+  else
+  {
+    buffer = new std::string();
+    this->dataPtr->allocations++;
+  }
+
+  buffer->resize(_size);
+  return BufferPtr(buffer, BufferReleaser(this->dataPtr));
+}
+
+/////////////////////////////////////////////////
+uint64_t BufferPool::AllocationCount() const
+{
+  return this->dataPtr->allocations;
+}
+
+/////////////////////////////////////////////////
+uint64_t BufferPool::ReuseCount() const
+{
+  return this->dataPtr->reuses;
+}
+
+/////////////////////////////////////////////////
+std::size_t BufferPool::FreeCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->free.size();
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_BUFFERPOOL_HH_
+#define GAZEBO_TRANSPORT_BUFFERPOOL_HH_
+
+#include <boost/shared_ptr.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_TRANSPORT_VISIBLE, gazebo, transport, BufferPool)
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    // Forward declare private data class
+    class BufferPoolPrivate;
+
+    /// \brief Reference counted buffer, returned to its pool once the last
+    /// reference goes away.
+    typedef boost::shared_ptr<std::string> BufferPtr;
+
+    /// \class BufferPool BufferPool.hh transport/transport.hh
+    /// \brief Pool of receive buffers. Connections read incoming messages
+    /// straight into a pooled buffer, which is handed to the read callback
+    /// and parsed there without further copies. Released buffers keep their
+    /// memory, so steady streams of large messages stop allocating.
+    class GZ_TRANSPORT_VISIBLE BufferPool : public SingletonT<BufferPool>
+    {
+      /// \brief Constructor
+      private: BufferPool();
+
+      /// \brief Destructor
+      private: virtual ~BufferPool();
+
+      /// \brief Get a buffer of the given size. Its content is undefined.
+      /// \param[in] _size Size of the buffer in bytes.
+      /// \return The buffer.
+      public: BufferPtr Acquire(const std::size_t _size);
+
+      /// \brief Get the number of buffers allocated because the pool had
+      /// none free.
+      /// \return Number of allocations.
+      public: uint64_t AllocationCount() const;
+
+      /// \brief Get the number of buffers reused from the pool.
+      /// \return Number of reuses.
+      public: uint64_t ReuseCount() const;
+
+      /// \brief Get the number of free buffers in the pool.
+      /// \return Number of free buffers.
+      public: std::size_t FreeCount() const;
+
+      /// \brief Maximum number of free buffers kept.
+      public: static const std::size_t MaxFreeCount;
+
+      /// \brief Maximum memory held by free buffers, in bytes.
+      public: static const std::size_t MaxFreeBytes;
+
+      /// \internal
+      /// \brief Private data pointer, shared with the outstanding buffers.
+      private: boost::shared_ptr<BufferPoolPrivate> dataPtr;
+
+      /// \brief This is a singleton class.
+      private: friend class SingletonT<BufferPool>;
+    };
+    /// \}
+  }
+}
+#endif
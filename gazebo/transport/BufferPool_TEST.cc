@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "gazebo/transport/BufferPool.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class BufferPool : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(BufferPool, Reuse)
+{
+  transport::BufferPool *pool = transport::BufferPool::Instance();
+  uint64_t allocations = pool->AllocationCount();
+  uint64_t reuses = pool->ReuseCount();
+
+  const char *data = nullptr;
+  {
+    transport::BufferPtr buffer = pool->Acquire(1024);
+    ASSERT_TRUE(buffer != nullptr);
+    EXPECT_EQ(buffer->size(), 1024u);
+    data = buffer->data();
+  }
+  EXPECT_GE(pool->FreeCount(), 1u);
+
+  // A smaller buffer reuses the memory of the released one
+  transport::BufferPtr buffer = pool->Acquire(512);
+  EXPECT_EQ(buffer->size(), 512u);
+  EXPECT_EQ(buffer->data(), data);
+  EXPECT_EQ(pool->AllocationCount(), allocations + 1);
+  EXPECT_EQ(pool->ReuseCount(), reuses + 1);
+
+  // Copies share the buffer, which goes back once all are gone
+  size_t freeCount = pool->FreeCount();
+  transport::BufferPtr copy = buffer;
+  buffer.reset();
+  EXPECT_EQ(pool->FreeCount(), freeCount);
+  copy.reset();
+  EXPECT_EQ(pool->FreeCount(), freeCount + 1);
+}
+
+/////////////////////////////////////////////////
+TEST_F(BufferPool, Limit)
+{
+  transport::BufferPool *pool = transport::BufferPool::Instance();
+
+  std::vector<transport::BufferPtr> buffers;
+  for (size_t i = 0; i < transport::BufferPool::MaxFreeCount * 2; ++i)
+    buffers.push_back(pool->Acquire(16));
+  buffers.clear();
+  EXPECT_EQ(pool->FreeCount(), transport::BufferPool::MaxFreeCount);
+
+  // Buffers larger than the pool holds are freed
+  size_t freeCount = pool->FreeCount();
+  pool->Acquire(transport::BufferPool::MaxFreeBytes + 1).reset();
+  EXPECT_LE(pool->FreeCount(), freeCount);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -39,6 +39,13 @@ std::string CallbackHelper::GetMsgType() const
   return std::string();
 }
 
+/////////////////////////////////////////////////
+bool CallbackHelper::HandleSerializedData(CompressedData &_data,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  return this->HandleData(_data.Data(), _cb, _id);
+}
+
 /////////////////////////////////////////////////
 bool CallbackHelper::GetLatching() const
 {
@@ -58,3 +65,9 @@ unsigned int CallbackHelper::GetId() const
 {
   return this->id;
 }
+
+/////////////////////////////////////////////////
+void CallbackHelper::SetStats(const TopicStatsPtr &_stats)
+{
+  this->stats = _stats;
+}
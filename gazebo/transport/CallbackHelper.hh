@@ -21,6 +21,7 @@
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <chrono>
 #include <vector>
 #include <string>
 #include <mutex>
@@ -29,6 +30,8 @@
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/Exception.hh"
 
+#include "gazebo/transport/Compression.hh"
+#include "gazebo/transport/TransportStatistics.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/util/system.hh"
 
@@ -64,6 +67,16 @@ namespace gazebo
       public: virtual bool HandleData(const std::string &_newdata,
                   boost::function<void(uint32_t)> _cb, uint32_t _id) = 0;
 
+      /// \brief Process data published to several callbacks. Callbacks which
+      /// send the data compressed share its compressed forms.
+      /// \param[in] _data Published data and its compressed forms.
+      /// \param[in] _cb If non-null, callback to be invoked which signals
+      /// that transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \return true if successfully processed; false otherwise
+      public: virtual bool HandleSerializedData(CompressedData &_data,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
       /// \brief Process new incoming message
       /// \param[in] _newMsg Incoming message to be processed
       /// \return true if successfully processed; false otherwise
@@ -87,6 +100,14 @@ namespace gazebo
       /// \return The unique ID of this callback.
       public: unsigned int GetId() const;
 
+      /// \brief Set the stats in which to record the parse time and the
+      /// latency of the messages, while the stats are active.
+      /// \param[in] _stats Stats of the subscribed topic.
+      public: void SetStats(const TopicStatsPtr &_stats);
+
+      /// \brief Stats of the subscribed topic, may be null.
+      protected: TopicStatsPtr stats;
+
       /// \brief True means that the callback helper will get the last
       /// published message on the topic.
       protected: bool latching;
@@ -144,8 +165,20 @@ namespace gazebo
                   boost::function<void(uint32_t)> _cb, uint32_t _id)
               {
                 this->SetLatching(false);
-                boost::shared_ptr<M> m(new M);
-                m->ParseFromString(_newdata);
+
+                // Nested messages and repeated fields are parsed into an
+                // arena that is freed with the message
+                boost::shared_ptr<M> m =
+                  msgs::NewArenaMessage<M>(2 * _newdata.size());
+                if (this->stats && this->stats->Active())
+                {
+                  auto start = std::chrono::steady_clock::now();
+                  m->ParseFromString(_newdata);
+                  this->stats->RecordParse(*m,
+                      std::chrono::steady_clock::now() - start);
+                }
+                else
+                  m->ParseFromString(_newdata);
                 this->callback(m);
                 if (!_cb.empty())
                   _cb(_id);
@@ -156,6 +189,8 @@ namespace gazebo
       public: virtual bool HandleMessage(MessagePtr _newMsg)
               {
                 this->SetLatching(false);
+                if (this->stats && _newMsg && this->stats->Active())
+                  this->stats->RecordLatency(*_newMsg);
                 this->callback(boost::dynamic_pointer_cast<M>(_newMsg));
                 return true;
               }
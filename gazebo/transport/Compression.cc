@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+#include "gazebo/gazebo_config.h"
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/Compression.hh"
+
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+
+using namespace gazebo;
+using namespace transport;
+
+const uint32_t Compression::DefaultThreshold = 16384;
+
+// Size of the uncompressed size written before a compressed payload.
+static const std::size_t kSizeLength = 4;
+
+// Largest message accepted when decompressing, as a guard against corrupt
+// size prefixes.
+static const uint32_t kMaxDecompressedSize = 1u << 30;
+
+/////////////////////////////////////////////////
+CompressionCodec Compression::Codec(const std::string &_name)
+{
+  if (_name == "zlib")
+    return CompressionCodec::ZLIB;
+  else if (_name == "lz4")
+    return CompressionCodec::LZ4;
+  return CompressionCodec::NONE;
+}
+
+/////////////////////////////////////////////////
+std::string Compression::Name(const CompressionCodec _codec)
+{
+  switch (_codec)
+  {
+    case CompressionCodec::ZLIB:
+      return "zlib";
+    case CompressionCodec::LZ4:
+      return "lz4";
+    default:
+      return "none";
+  }
+}
+
+/////////////////////////////////////////////////
+bool Compression::Available(const CompressionCodec _codec)
+{
+  switch (_codec)
+  {
+    case CompressionCodec::ZLIB:
+      return true;
+    case CompressionCodec::LZ4:
+#ifdef HAVE_LZ4
+      return true;
+#else
+      return false;
+#endif
+    default:
+      return false;
+  }
+}
+
+/////////////////////////////////////////////////
+CompressionCodec Compression::Requested()
+{
+  const char *env = std::getenv("GAZEBO_TRANSPORT_COMPRESSION");
+  if (!env || !*env)
+    return CompressionCodec::NONE;
+
+  CompressionCodec codec = Codec(env);
+  if (codec == CompressionCodec::NONE && std::string(env) != "none")
+  {
+    gzerr << "Invalid GAZEBO_TRANSPORT_COMPRESSION [" << env
+          << "], must be one of [zlib, lz4, none]\n";
+  }
+  else if (codec != CompressionCodec::NONE && !Available(codec))
+  {
+    gzwarn << "Compression codec [" << env << "] is not available, "
+           << "messages will not be compressed\n";
+    codec = CompressionCodec::NONE;
+  }
+  return codec;
+}
+
+/////////////////////////////////////////////////
+uint32_t Compression::RequestedThreshold()
+{
+  const char *env = std::getenv("GAZEBO_TRANSPORT_COMPRESSION_THRESHOLD");
+  if (env && *env)
+  {
+    try
+    {
+      return static_cast<uint32_t>(std::stoul(env));
+    }
+    catch(...)
+    {
+      gzerr << "Invalid GAZEBO_TRANSPORT_COMPRESSION_THRESHOLD [" << env
+            << "]\n";
+    }
+  }
+  return DefaultThreshold;
+}
+
+/////////////////////////////////////////////////
+bool Compression::Compress(const CompressionCodec _codec,
+    const std::string &_data, std::string &_out)
+{
+  if (!Available(_codec) || _data.size() > kMaxDecompressedSize)
+    return false;
+
+  _out.clear();
+  uint32_t size = static_cast<uint32_t>(_data.size());
+  for (std::size_t i = 0; i < kSizeLength; ++i)
+    _out.push_back(static_cast<char>((size >> (8 * i)) & 0xFF));
+
+  if (_codec == CompressionCodec::ZLIB)
+  {
+    try
+    {
+      boost::iostreams::filtering_ostream out;
+      out.push(boost::iostreams::zlib_compressor(
+            boost::iostreams::zlib_params(
+              boost::iostreams::zlib::best_speed)));
+      out.push(boost::iostreams::back_inserter(_out));
+      out.write(_data.data(), _data.size());
+      boost::iostreams::close(out);
+    }
+    catch(std::exception &_e)
+    {
+      gzerr << "zlib compression failed [" << _e.what() << "]\n";
+      return false;
+    }
+    return true;
+  }
+
+#ifdef HAVE_LZ4
+  if (_codec == CompressionCodec::LZ4)
+  {
+    int bound = LZ4_compressBound(static_cast<int>(_data.size()));
+    _out.resize(kSizeLength + bound);
+    int written = LZ4_compress_default(_data.data(), &_out[kSizeLength],
+        static_cast<int>(_data.size()), bound);
+    if (written <= 0)
+      return false;
+    _out.resize(kSizeLength + written);
+    return true;
+  }
+#endif
+
+  return false;
+}
+
+/////////////////////////////////////////////////
+bool Compression::Decompress(const CompressionCodec _codec,
+    const std::string &_data, std::string &_out)
+{
+  if (!Available(_codec) || _data.size() < kSizeLength)
+    return false;
+
+  uint32_t size = 0;
+  for (std::size_t i = 0; i < kSizeLength; ++i)
+    size |= static_cast<uint32_t>(static_cast<uint8_t>(_data[i])) << (8 * i);
+  if (size > kMaxDecompressedSize)
+    return false;
+
+  const char *payload = _data.data() + kSizeLength;
+  std::size_t payloadSize = _data.size() - kSizeLength;
+
+  if (_codec == CompressionCodec::ZLIB)
+  {
+    _out.clear();
+    _out.reserve(size);
+    try
+    {
+      boost::iostreams::filtering_istream in;
+      in.push(boost::iostreams::zlib_decompressor());
+      in.push(boost::iostreams::array_source(payload, payloadSize));
+      boost::iostreams::copy(in, boost::iostreams::back_inserter(_out));
+    }
+    catch(std::exception &_e)
+    {
+      gzerr << "zlib decompression failed [" << _e.what() << "]\n";
+      return false;
+    }
+    return _out.size() == size;
+  }
+
+#ifdef HAVE_LZ4
+  if (_codec == CompressionCodec::LZ4)
+  {
+    _out.resize(size);
+    int read = LZ4_decompress_safe(payload, &_out[0],
+        static_cast<int>(payloadSize), static_cast<int>(size));
+    return read >= 0 && static_cast<uint32_t>(read) == size;
+  }
+#endif
+
+  return false;
+}
+
+/////////////////////////////////////////////////
+CompressedData::CompressedData(const BufferPtr &_data)
+  : data(_data)
+{
+}
+
+/////////////////////////////////////////////////
+const std::string &CompressedData::Data() const
+{
+  return *this->data;
+}
+
+/////////////////////////////////////////////////
+const BufferPtr &CompressedData::Payload(CompressionCodec &_codec,
+    const uint32_t _threshold)
+{
+  int index = static_cast<int>(_codec);
+  if (_codec == CompressionCodec::NONE || index >= kCodecCount ||
+      this->data->size() < _threshold)
+  {
+    _codec = CompressionCodec::NONE;
+    return this->data;
+  }
+
+  if (!this->computed[index])
+  {
+    this->computed[index] = true;
+    this->compressed[index].reset(new std::string);
+    this->useful[index] = Compression::Compress(_codec, *this->data,
+        *this->compressed[index]) &&
+      this->compressed[index]->size() < this->data->size();
+  }
+
+  if (!this->useful[index])
+  {
+    _codec = CompressionCodec::NONE;
+    return this->data;
+  }
+  return this->compressed[index];
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_COMPRESSION_HH_
+#define GAZEBO_TRANSPORT_COMPRESSION_HH_
+
+#include <cstdint>
+#include <string>
+
+#include "gazebo/transport/BufferPool.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \brief Codecs which compress message payloads. The value is written
+    /// in the flags of the FrameHeader of a compressed frame.
+    enum class CompressionCodec : uint8_t
+    {
+      /// \brief Not compressed.
+      NONE = 0,
+
+      /// \brief zlib at its fastest level.
+      ZLIB = 1,
+
+      /// \brief LZ4, if Gazebo was built with liblz4.
+      LZ4 = 2
+    };
+
+    /// \class Compression Compression.hh transport/transport.hh
+    /// \brief Compression of the messages sent to remote subscribers.
+    ///
+    /// A subscriber requests a codec with GAZEBO_TRANSPORT_COMPRESSION
+    /// (zlib or lz4) when it subscribes, and the publisher compresses the
+    /// messages of at least GAZEBO_TRANSPORT_COMPRESSION_THRESHOLD bytes
+    /// that it sends through the connection. Compressed payloads start with
+    /// the uncompressed size, 32 bits little endian.
+    class GZ_TRANSPORT_VISIBLE Compression
+    {
+      /// \brief Get a codec from its name.
+      /// \param[in] _name "zlib", "lz4" or "none".
+      /// \return The codec, NONE if the name is unknown.
+      public: static CompressionCodec Codec(const std::string &_name);
+
+      /// \brief Get the name of a codec.
+      /// \param[in] _codec The codec.
+      /// \return Name of the codec.
+      public: static std::string Name(const CompressionCodec _codec);
+
+      /// \brief Check whether a codec was built in.
+      /// \param[in] _codec The codec.
+      /// \return True if messages can be compressed with it.
+      public: static bool Available(const CompressionCodec _codec);
+
+      /// \brief Get the codec subscriptions of this process request, from
+      /// GAZEBO_TRANSPORT_COMPRESSION.
+      /// \return The codec, NONE if unset or not available.
+      public: static CompressionCodec Requested();
+
+      /// \brief Get the size from which messages are compressed, from
+      /// GAZEBO_TRANSPORT_COMPRESSION_THRESHOLD.
+      /// \return Size in bytes, DefaultThreshold if unset.
+      public: static uint32_t RequestedThreshold();
+
+      /// \brief Compress data.
+      /// \param[in] _codec Codec to use.
+      /// \param[in] _data Data to compress.
+      /// \param[out] _out Compressed payload.
+      /// \return False if the codec is not available or failed.
+      public: static bool Compress(const CompressionCodec _codec,
+                  const std::string &_data, std::string &_out);
+
+      /// \brief Decompress a payload.
+      /// \param[in] _codec Codec the payload was compressed with.
+      /// \param[in] _data Compressed payload.
+      /// \param[out] _out Decompressed data.
+      /// \return False if the codec is not available or the payload is
+      /// invalid.
+      public: static bool Decompress(const CompressionCodec _codec,
+                  const std::string &_data, std::string &_out);
+
+      /// \brief Size from which messages are compressed by default. Smaller
+      /// messages gain little and cost a round through the codec.
+      public: static const uint32_t DefaultThreshold;
+    };
+
+    /// \class CompressedData Compression.hh transport/transport.hh
+    /// \brief A serialized message and its compressed forms. Each form is
+    /// computed when first needed, so a message published to several
+    /// subscribers is compressed once per codec. The forms are shared
+    /// buffers, which connections queue without copying.
+    class GZ_TRANSPORT_VISIBLE CompressedData
+    {
+      /// \brief Constructor.
+      /// \param[in] _data Serialized message, which must not change
+      /// afterwards.
+      public: explicit CompressedData(const BufferPtr &_data);
+
+      /// \brief Get the serialized message.
+      /// \return The uncompressed data.
+      public: const std::string &Data() const;
+
+      /// \brief Get the payload to send to a subscriber.
+      /// \param[in,out] _codec Codec requested by the subscriber. Set to
+      /// NONE if the message is sent uncompressed, because it is below the
+      /// threshold or doesn't get smaller.
+      /// \param[in] _threshold Size from which the message is compressed.
+      /// \return The payload.
+      public: const BufferPtr &Payload(CompressionCodec &_codec,
+                  const uint32_t _threshold);
+
+      /// \brief Number of codecs, including NONE.
+      private: static const int kCodecCount = 3;
+
+      /// \brief The serialized message.
+      private: BufferPtr data;
+
+      /// \brief Compressed forms, indexed by codec.
+      private: BufferPtr compressed[kCodecCount];
+
+      /// \brief Which forms have been computed.
+      private: bool computed[kCodecCount] = {false, false, false};
+
+      /// \brief Which forms are worth sending.
+      private: bool useful[kCodecCount] = {false, false, false};
+    };
+    /// \}
+  }
+}
+#endif
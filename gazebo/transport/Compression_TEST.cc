@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <string>
+
+#include "gazebo/transport/Compression.hh"
+#include "gazebo/transport/Connection.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class Compression : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Data that compresses, like a rendered image.
+std::string Gradient(const std::size_t _size)
+{
+  std::string data(_size, 0);
+  for (std::size_t i = 0; i < _size; ++i)
+    data[i] = static_cast<char>((i / 3) % 256);
+  return data;
+}
+
+/////////////////////////////////////////////////
+TEST_F(Compression, Names)
+{
+  using transport::CompressionCodec;
+  EXPECT_EQ(transport::Compression::Codec("zlib"), CompressionCodec::ZLIB);
+  EXPECT_EQ(transport::Compression::Codec("lz4"), CompressionCodec::LZ4);
+  EXPECT_EQ(transport::Compression::Codec("none"), CompressionCodec::NONE);
+  EXPECT_EQ(transport::Compression::Codec("bogus"), CompressionCodec::NONE);
+  EXPECT_EQ(transport::Compression::Name(CompressionCodec::ZLIB), "zlib");
+  EXPECT_EQ(transport::Compression::Name(CompressionCodec::LZ4), "lz4");
+
+  EXPECT_TRUE(transport::Compression::Available(CompressionCodec::ZLIB));
+  EXPECT_FALSE(transport::Compression::Available(CompressionCodec::NONE));
+}
+
+/////////////////////////////////////////////////
+TEST_F(Compression, Requested)
+{
+  unsetenv("GAZEBO_TRANSPORT_COMPRESSION");
+  unsetenv("GAZEBO_TRANSPORT_COMPRESSION_THRESHOLD");
+  EXPECT_EQ(transport::Compression::Requested(),
+      transport::CompressionCodec::NONE);
+  EXPECT_EQ(transport::Compression::RequestedThreshold(),
+      transport::Compression::DefaultThreshold);
+
+  setenv("GAZEBO_TRANSPORT_COMPRESSION", "zlib", 1);
+  setenv("GAZEBO_TRANSPORT_COMPRESSION_THRESHOLD", "1000", 1);
+  EXPECT_EQ(transport::Compression::Requested(),
+      transport::CompressionCodec::ZLIB);
+  EXPECT_EQ(transport::Compression::RequestedThreshold(), 1000u);
+
+  setenv("GAZEBO_TRANSPORT_COMPRESSION", "bogus", 1);
+  EXPECT_EQ(transport::Compression::Requested(),
+      transport::CompressionCodec::NONE);
+
+  unsetenv("GAZEBO_TRANSPORT_COMPRESSION");
+  unsetenv("GAZEBO_TRANSPORT_COMPRESSION_THRESHOLD");
+}
+
+/////////////////////////////////////////////////
+TEST_F(Compression, RoundTrip)
+{
+  for (auto codec : {transport::CompressionCodec::ZLIB,
+                     transport::CompressionCodec::LZ4})
+  {
+    if (!transport::Compression::Available(codec))
+      continue;
+
+    std::string data = Gradient(100000);
+    std::string compressed, decompressed;
+    ASSERT_TRUE(transport::Compression::Compress(codec, data, compressed));
+    EXPECT_LT(compressed.size(), data.size() / 10);
+    ASSERT_TRUE(transport::Compression::Decompress(codec, compressed,
+          decompressed));
+    EXPECT_EQ(decompressed, data);
+
+    // Empty data
+    ASSERT_TRUE(transport::Compression::Compress(codec, "", compressed));
+    ASSERT_TRUE(transport::Compression::Decompress(codec, compressed,
+          decompressed));
+    EXPECT_TRUE(decompressed.empty());
+
+    // Corrupt payloads are rejected
+    EXPECT_FALSE(transport::Compression::Decompress(codec, "ab",
+          decompressed));
+    compressed = std::string("\x10\x00\x00\x00", 4) + "not compressed";
+    EXPECT_FALSE(transport::Compression::Decompress(codec, compressed,
+          decompressed));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(Compression, CompressedData)
+{
+  transport::BufferPtr data(new std::string(Gradient(50000)));
+  transport::CompressedData payloads(data);
+  EXPECT_EQ(&payloads.Data(), data.get());
+
+  // Below the threshold
+  transport::CompressionCodec codec = transport::CompressionCodec::ZLIB;
+  EXPECT_EQ(payloads.Payload(codec, 100000), data);
+  EXPECT_EQ(codec, transport::CompressionCodec::NONE);
+
+  // Compressed once, shared by all subscribers
+  codec = transport::CompressionCodec::ZLIB;
+  transport::BufferPtr first = payloads.Payload(codec, 1000);
+  EXPECT_EQ(codec, transport::CompressionCodec::ZLIB);
+  EXPECT_LT(first->size(), data->size());
+  codec = transport::CompressionCodec::ZLIB;
+  EXPECT_EQ(payloads.Payload(codec, 1000), first);
+
+  // Data which doesn't get smaller is sent as is
+  transport::BufferPtr noise(new std::string(50000, 0));
+  unsigned int seed = 1;
+  for (auto &c : *noise)
+  {
+    seed = seed * 1103515245u + 12345u;
+    c = static_cast<char>(seed >> 16);
+  }
+  transport::CompressedData noisePayloads(noise);
+  codec = transport::CompressionCodec::ZLIB;
+  EXPECT_EQ(noisePayloads.Payload(codec, 1000), noise);
+  EXPECT_EQ(codec, transport::CompressionCodec::NONE);
+}
+
+/////////////////////////////////////////////////
+TEST_F(Compression, FrameFlags)
+{
+  transport::FrameHeader header;
+  header.flags = static_cast<uint8_t>(transport::CompressionCodec::ZLIB);
+  header.typeId = 42;
+  header.length = 1234;
+
+  char buffer[HEADER_LENGTH];
+  header.Encode(buffer);
+
+  transport::FrameHeader decoded;
+  ASSERT_TRUE(decoded.Decode(buffer));
+  EXPECT_EQ(static_cast<transport::CompressionCodec>(decoded.flags),
+      transport::CompressionCodec::ZLIB);
+  EXPECT_EQ(decoded.length, 1234u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -48,6 +48,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <algorithm>
+#include <cstring>
 
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
@@ -68,6 +70,19 @@ extern void dummy_callback_fn(uint32_t);
 unsigned int Connection::idCounter = 0;
 IOManager *Connection::iomanager = NULL;
 
+// Maximum number of messages in one write. Each message needs two buffers,
+// and asio hands at most 64 buffers to a single writev.
+static const std::size_t kMaxWriteBatchMsgs = 32;
+
+// Maximum number of bytes in one write, unless a single message is larger.
+static const std::size_t kMaxWriteBatchBytes = 65536;
+
+const uint8_t FrameHeader::LatestVersion = 1;
+
+// Marks the first byte of a binary header. ASCII headers hold hex digits,
+// which never have the high bit set.
+static const uint8_t kBinaryFrameMark = 0x80;
+
 // Version 1.52 of boost has an address::is_unspecfied function, but
 // Version 1.46.1 (installed on ubuntu) does not. So this helper function
 // is stolen from adress::is_unspecified function in boost v1.52.
@@ -102,7 +117,12 @@ Connection::Connection()
   this->readQuit = false;
   this->connectError = false;
   this->writeQueue.clear();
+  this->writeBatchSize = 0;
   this->writeCount = 0;
+  this->dropFrame = false;
+  this->frameCodec = CompressionCodec::NONE;
+  this->frameVersion = 0;
+  this->frameTypeId = 0;
 
   this->localURI = std::string("http://") + this->GetLocalHostname() + ":" +
                    boost::lexical_cast<std::string>(this->GetLocalPort());
@@ -245,6 +265,10 @@ void Connection::OnAccept(const boost::system::error_code &e)
   {
     this->acceptConn->isOpen = true;
 
+    boost::system::error_code ec;
+    this->acceptConn->socket->set_option(
+        boost::asio::ip::tcp::no_delay(true), ec);
+
     if (!this->ipWhiteList.empty() &&
         this->ipWhiteList.find("," +
           this->acceptConn->GetRemoteHostname() + ",") == std::string::npos)
@@ -294,7 +318,8 @@ void Connection::EnqueueMsg(const std::string &_buffer, bool _force)
 
 //////////////////////////////////////////////////
 void Connection::EnqueueMsg(const std::string &_buffer,
-    boost::function<void(uint32_t)> _cb, uint32_t _id, bool _force)
+    boost::function<void(uint32_t)> _cb, uint32_t _id, bool _force,
+    const uint8_t _frameFlags)
 {
   // Don't enqueue empty messages
   if (_buffer.empty() || !this->IsOpen())
@@ -302,26 +327,10 @@ void Connection::EnqueueMsg(const std::string &_buffer,
     return;
   }
 
-  char headerBuffer[HEADER_LENGTH + 1];
-  snprintf(headerBuffer, HEADER_LENGTH + 1, "%08x",
-      static_cast<unsigned int>(_buffer.size()));
-
+  if (!this->QueueMsg(BufferPtr(new std::string(_buffer)), _cb, _id,
+        _frameFlags))
   {
-    boost::recursive_mutex::scoped_lock lock(this->writeMutex);
-
-    if (this->writeQueue.empty() ||
-        (this->writeCount > 0 && this->writeQueue.size() == 1) ||
-        (this->writeQueue.back().size() + HEADER_LENGTH + _buffer.size() >
-         4096))
-    {
-      this->writeQueue.push_back(std::string(headerBuffer) + _buffer);
-      this->callbacks.push_back({std::make_pair(_cb, _id)});
-    }
-    else
-    {
-      this->writeQueue.back() += std::string(headerBuffer) + _buffer;
-      this->callbacks.back().push_back(std::make_pair(_cb, _id));
-    }
+    return;
   }
 
   if (_force)
@@ -335,6 +344,59 @@ void Connection::EnqueueMsg(const std::string &_buffer,
   }
 }
 
+//////////////////////////////////////////////////
+void Connection::EnqueueMsg(const BufferPtr &_buffer,
+    boost::function<void(uint32_t)> _cb, uint32_t _id,
+    const uint8_t _frameFlags)
+{
+  // Start writing unless a write is in flight, in which case the message
+  // goes with the next batch once it completes
+  if (this->QueueMsg(_buffer, _cb, _id, _frameFlags))
+    this->ProcessWriteQueue();
+}
+
+//////////////////////////////////////////////////
+bool Connection::QueueMsg(const BufferPtr &_buffer,
+    boost::function<void(uint32_t)> _cb, uint32_t _id,
+    const uint8_t _frameFlags)
+{
+  // Don't enqueue empty messages
+  if (!_buffer || _buffer->empty() || !this->IsOpen())
+  {
+    return false;
+  }
+
+  {
+    boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+
+    // The header and the payload are kept apart, and gathered by the
+    // socket when the message is written.
+    this->writeQueue.emplace_back();
+    ConnectionOutgoingMsg &msg = this->writeQueue.back();
+    if (this->frameVersion > 0)
+    {
+      FrameHeader header;
+      header.version = this->frameVersion;
+      header.typeId = this->frameTypeId;
+      header.flags = _frameFlags;
+      header.length = static_cast<uint32_t>(_buffer->size());
+      header.Encode(msg.header);
+    }
+    else
+    {
+      char headerBuffer[HEADER_LENGTH + 1];
+      snprintf(headerBuffer, HEADER_LENGTH + 1, "%08x",
+          static_cast<unsigned int>(_buffer->size()));
+      std::memcpy(msg.header, headerBuffer, HEADER_LENGTH);
+    }
+    msg.payload = _buffer;
+    msg.cb = _cb;
+    msg.id = _id;
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 void Connection::ProcessWriteQueue(bool _blocking)
 {
@@ -354,14 +416,31 @@ void Connection::ProcessWriteQueue(bool _blocking)
 
   this->writeCount++;
 
-  // Write the serialized data to the socket. We use
-  // "gather-write" to send both the head and the data in
-  // a single write operation
+  // Gather as many queued messages as fit in a batch, and hand their
+  // headers and payloads to the socket in a single write.
+  this->writeBuffers.clear();
+  this->writeBatchSize = 0;
+  std::size_t batchBytes = 0;
+  for (auto const &msg : this->writeQueue)
+  {
+    std::size_t msgBytes = HEADER_LENGTH + msg.payload->size();
+    if (this->writeBatchSize > 0 &&
+        (this->writeBatchSize >= kMaxWriteBatchMsgs ||
+         batchBytes + msgBytes > kMaxWriteBatchBytes))
+    {
+      break;
+    }
+
+    this->writeBuffers.push_back(
+        boost::asio::buffer(msg.header, HEADER_LENGTH));
+    this->writeBuffers.push_back(boost::asio::buffer(*msg.payload));
+    batchBytes += msgBytes;
+    this->writeBatchSize++;
+  }
+
   if (!_blocking)
   {
-    boost::asio::async_write(*this->socket,
-        boost::asio::buffer(this->writeQueue.front().c_str(),
-          this->writeQueue.front().size()),
+    boost::asio::async_write(*this->socket, this->writeBuffers,
           common::weakBind(&Connection::OnWrite, this->shared_from_this(),
             boost::asio::placeholders::error));
   }
@@ -369,9 +448,7 @@ void Connection::ProcessWriteQueue(bool _blocking)
   {
     try
     {
-      boost::asio::write(*this->socket,
-          boost::asio::buffer(this->writeQueue.front().c_str(),
-            this->writeQueue.front().size()));
+      boost::asio::write(*this->socket, this->writeBuffers);
     }
     catch(...)
     {
@@ -397,17 +474,19 @@ std::string Connection::GetRemoteURI() const
 //////////////////////////////////////////////////
 void Connection::PostWrite()
 {
-  // Call the callbacks, if not NULL
-  if (!this->callbacks.empty())
+  // Call the callbacks of the written messages, if not NULL. The queue
+  // is empty if the connection was closed during the write.
+  for (; this->writeBatchSize > 0 && !this->writeQueue.empty();
+       --this->writeBatchSize)
   {
-    for (auto const &callback : this->callbacks.front())
-      if (!callback.first.empty())
-        callback.first(callback.second);
-    this->callbacks.pop_front();
+    const ConnectionOutgoingMsg &msg = this->writeQueue.front();
+    if (!msg.cb.empty())
+      msg.cb(msg.id);
+    this->writeQueue.pop_front();
   }
 
-  if (!this->writeQueue.empty())
-    this->writeQueue.pop_front();
+  this->writeBatchSize = 0;
+  this->writeBuffers.clear();
   this->writeCount--;
 }
 
@@ -418,6 +497,10 @@ void Connection::OnWrite(const boost::system::error_code &_e)
     boost::recursive_mutex::scoped_lock lock(this->writeMutex);
 
     this->PostWrite();
+
+    // Write what was queued meanwhile
+    if (!_e)
+      this->ProcessWriteQueue();
   }
 
   if (_e)
@@ -451,6 +534,9 @@ bool Connection::IsOpen() const
 //////////////////////////////////////////////////
 void Connection::Close()
 {
+  // Writes check that the connection is open with the write mutex held,
+  // so the socket can't go away between the check and the write.
+  boost::recursive_mutex::scoped_lock writeLock(this->writeMutex);
   boost::mutex::scoped_lock lock(this->socketMutex);
 
   if (this->socket && this->socket->is_open())
@@ -487,9 +573,7 @@ void Connection::Close()
     this->acceptor = NULL;
   }
 
-  boost::recursive_mutex::scoped_lock lock2(this->writeMutex);
   this->writeQueue.clear();
-  this->callbacks.clear();
 }
 
 //////////////////////////////////////////////////
@@ -570,7 +654,21 @@ bool Connection::Read(std::string &data)
     if (error)
       throw boost::system::system_error(error);
 
-    data = std::string(&incoming[0], incoming.size());
+    if (this->dropFrame)
+      data.clear();
+    else if (this->frameCodec != CompressionCodec::NONE)
+    {
+      if (!Compression::Decompress(this->frameCodec,
+            std::string(&incoming[0], incoming.size()), data))
+      {
+        gzerr << "Connection[" << this->id << "] unable to decompress a "
+              << "message with codec [" << Compression::Name(this->frameCodec)
+              << "]\n";
+        data.clear();
+      }
+    }
+    else
+      data = std::string(&incoming[0], incoming.size());
     result = true;
   }
 
@@ -630,6 +728,34 @@ unsigned int Connection::GetRemotePort() const
 std::size_t Connection::ParseHeader(const std::string &header)
 {
   std::size_t data_size = 0;
+  this->dropFrame = false;
+  this->frameCodec = CompressionCodec::NONE;
+
+  if (header.size() == HEADER_LENGTH && FrameHeader::IsBinary(header.data()))
+  {
+    FrameHeader frame;
+    if (!frame.Decode(header.data()))
+    {
+      // The rest of the stream can't be followed
+      gzerr << "Connection[" << this->id << "] received a frame of "
+            << "unsupported version [" << static_cast<int>(frame.version)
+            << "], closing it\n";
+      this->Shutdown();
+      return 0;
+    }
+
+    this->dropFrame = frame.typeId != 0 && this->frameTypeId != 0 &&
+      frame.typeId != this->frameTypeId;
+    if (this->dropFrame)
+    {
+      gzwarn << "Connection[" << this->id << "] dropping a frame of type id ["
+             << frame.typeId << "], expected [" << this->frameTypeId << "]\n";
+    }
+    this->frameCodec = static_cast<CompressionCodec>(frame.flags);
+
+    return frame.length;
+  }
+
   std::istringstream is(header);
 
   if (!(is >> std::hex >> data_size))
@@ -964,6 +1090,10 @@ void Connection::OnConnect(const boost::system::error_code &_error,
     {
       this->remoteAddress =
         this->socket->remote_endpoint().address().to_string();
+
+      // Writes are already batched, send each batch right away
+      boost::system::error_code ec;
+      this->socket->set_option(boost::asio::ip::tcp::no_delay(true), ec);
     }
     else
     {
@@ -987,6 +1117,73 @@ unsigned int Connection::GetId() const
   return this->id;
 }
 
+//////////////////////////////////////////////////
+void Connection::SetFrameVersion(const uint8_t _version)
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  this->frameVersion = std::min(_version, FrameHeader::LatestVersion);
+}
+
+//////////////////////////////////////////////////
+uint8_t Connection::FrameVersion() const
+{
+  return this->frameVersion;
+}
+
+//////////////////////////////////////////////////
+void Connection::SetFrameTypeId(const uint16_t _typeId)
+{
+  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  this->frameTypeId = _typeId;
+}
+
+//////////////////////////////////////////////////
+void FrameHeader::Encode(char *_buffer) const
+{
+  uint8_t *out = reinterpret_cast<uint8_t *>(_buffer);
+  out[0] = kBinaryFrameMark | this->version;
+  out[1] = this->flags;
+  out[2] = static_cast<uint8_t>(this->typeId & 0xFF);
+  out[3] = static_cast<uint8_t>(this->typeId >> 8);
+  for (int i = 0; i < 4; ++i)
+    out[4 + i] = static_cast<uint8_t>((this->length >> (8 * i)) & 0xFF);
+}
+
+//////////////////////////////////////////////////
+bool FrameHeader::Decode(const char *_buffer)
+{
+  const uint8_t *in = reinterpret_cast<const uint8_t *>(_buffer);
+  this->version = in[0] & ~kBinaryFrameMark;
+  this->flags = in[1];
+  this->typeId = static_cast<uint16_t>(in[2] | (in[3] << 8));
+  this->length = 0;
+  for (int i = 0; i < 4; ++i)
+    this->length |= static_cast<uint32_t>(in[4 + i]) << (8 * i);
+
+  return IsBinary(_buffer) && this->version > 0 &&
+    this->version <= LatestVersion;
+}
+
+//////////////////////////////////////////////////
+bool FrameHeader::IsBinary(const char *_buffer)
+{
+  return (static_cast<uint8_t>(_buffer[0]) & kBinaryFrameMark) != 0;
+}
+
+//////////////////////////////////////////////////
+uint16_t FrameHeader::TypeId(const std::string &_msgType)
+{
+  // FNV-1a, folded to 16 bits. 0 is kept for "any type".
+  uint32_t hash = 2166136261u;
+  for (auto const c : _msgType)
+  {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  uint16_t id = static_cast<uint16_t>((hash >> 16) ^ (hash & 0xFFFF));
+  return id == 0 ? 1 : id;
+}
+
 //////////////////////////////////////////////////
 std::string Connection::GetIPWhiteList() const
 {
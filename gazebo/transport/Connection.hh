@@ -37,6 +37,8 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/WeakBind.hh"
+#include "gazebo/transport/BufferPool.hh"
+#include "gazebo/transport/Compression.hh"
 #include "gazebo/util/system.hh"
 
 #define HEADER_LENGTH 8
@@ -51,6 +53,53 @@ namespace gazebo
     class Connection;
     typedef boost::shared_ptr<Connection> ConnectionPtr;
 
+    /// \class FrameHeader Connection.hh transport/transport.hh
+    /// \brief Binary message header. It replaces the ASCII hex length on
+    /// connections whose peer announced it can read it, and has the same
+    /// length. The first byte has its high bit set, which no hex digit has,
+    /// so readers accept both kinds of header on any connection.
+    ///
+    /// Layout: version | 0x80, flags, type id (16 bits, little endian),
+    /// payload length (32 bits, little endian).
+    class GZ_TRANSPORT_VISIBLE FrameHeader
+    {
+      /// \brief Encode the header.
+      /// \param[out] _buffer Destination of HEADER_LENGTH bytes.
+      public: void Encode(char *_buffer) const;
+
+      /// \brief Decode a header.
+      /// \param[in] _buffer HEADER_LENGTH bytes.
+      /// \return False if the buffer is not a binary header of a supported
+      /// version.
+      public: bool Decode(const char *_buffer);
+
+      /// \brief Check whether a header is binary rather than ASCII.
+      /// \param[in] _buffer At least one byte of the header.
+      /// \return True for a binary header.
+      public: static bool IsBinary(const char *_buffer);
+
+      /// \brief Get the type id used in frames of a message type.
+      /// \param[in] _msgType Protobuf type name.
+      /// \return Non-zero id.
+      public: static uint16_t TypeId(const std::string &_msgType);
+
+      /// \brief Latest version of the header.
+      public: static const uint8_t LatestVersion;
+
+      /// \brief Version of the header.
+      public: uint8_t version = LatestVersion;
+
+      /// \brief Flags describing the payload: the CompressionCodec of a
+      /// compressed payload, 0 otherwise.
+      public: uint8_t flags = 0;
+
+      /// \brief Type id of the payload, 0 if unspecified.
+      public: uint16_t typeId = 0;
+
+      /// \brief Length of the payload in bytes.
+      public: uint32_t length = 0;
+    };
+
     /// \cond
     /// \brief A task instance that is created when data is read from
     /// a socket and used by TBB
@@ -64,7 +113,41 @@ namespace gazebo
                   boost::function<void (const std::string &)> _func,
                   const std::string &_data) :
                 func(_func),
-                data(_data)
+                data(new std::string(_data)),
+                codec(CompressionCodec::NONE)
+              {
+              }
+
+      /// \brief Constructor
+      /// \param[_in] _func Boost function pointer, which is the function
+      /// that receives the data.
+      /// \param[in] _data Buffer to send to the boost function pointer,
+      /// without copying it.
+      /// \param[in] _codec Codec the buffer was compressed with. It is
+      /// decompressed by the task.
+      public: ConnectionReadTask(
+                  boost::function<void (const std::string &)> _func,
+                  const BufferPtr &_data,
+                  const CompressionCodec _codec = CompressionCodec::NONE) :
+                func(_func),
+                data(_data),
+                codec(_codec)
+              {
+              }
+
+      /// \brief Constructor
+      /// \param[_in] _func Function which receives the buffer itself, and
+      /// can keep it without copying it.
+      /// \param[in] _data Buffer to send to the function.
+      /// \param[in] _codec Codec the buffer was compressed with. It is
+      /// decompressed by the task.
+      public: ConnectionReadTask(
+                  boost::function<void (const BufferPtr &)> _func,
+                  const BufferPtr &_data,
+                  const CompressionCodec _codec = CompressionCodec::NONE) :
+                bufferFunc(_func),
+                data(_data),
+                codec(_codec)
               {
               }
 
@@ -72,15 +155,55 @@ namespace gazebo
       /// callback.
       public: tbb::task *execute()
               {
-                this->func(this->data);
+                if (this->codec != CompressionCodec::NONE)
+                {
+                  BufferPtr decompressed(new std::string());
+                  if (!Compression::Decompress(this->codec, *this->data,
+                        *decompressed))
+                  {
+                    gzerr << "Unable to decompress a message with codec ["
+                          << Compression::Name(this->codec) << "]\n";
+                    decompressed->clear();
+                  }
+                  this->data = decompressed;
+                }
+
+                if (this->bufferFunc)
+                  this->bufferFunc(this->data);
+                else
+                  this->func(*this->data);
                 return NULL;
               }
 
       /// \brief The boost function pointer
       private: boost::function<void (const std::string &)> func;
 
+      /// \brief Function receiving the buffer, used instead of func if set.
+      private: boost::function<void (const BufferPtr &)> bufferFunc;
+
       /// \brief The data to send to the boost function pointer
-      private: std::string data;
+      private: BufferPtr data;
+
+      /// \brief Codec the data was compressed with.
+      private: CompressionCodec codec;
+    };
+
+    /// \brief A message waiting in the write queue of a connection. The
+    /// header and the payload are written as separate buffers.
+    class GZ_TRANSPORT_VISIBLE ConnectionOutgoingMsg
+    {
+      /// \brief Size of the payload as a hex string, not null terminated.
+      public: char header[HEADER_LENGTH];
+
+      /// \brief Serialized data, shared with the other connections it is
+      /// sent on.
+      public: BufferPtr payload;
+
+      /// \brief Callback invoked once the message is written.
+      public: boost::function<void(uint32_t)> cb;
+
+      /// \brief ID passed to the callback.
+      public: uint32_t id;
     };
     /// \endcond
 
@@ -153,19 +276,37 @@ namespace gazebo
 
       /// \brief Write data to the socket
       /// \param[in] _buffer Data to write
-      /// \param[in] _force If true, block until the data has been written
-      /// to the socket, otherwise just enqueue the data for asynchronous write
+      /// \param[in] _force If true, start writing right away, otherwise
+      /// leave the data for the next update of the ConnectionManager, which
+      /// writes the messages queued meanwhile together.
       /// \param[in] _cb If non-null, callback to be invoked after
       /// transmission is complete.
       /// \param[in] _id ID associated with the message data.
+      /// \param[in] _frameFlags Flags of the binary frame header, such as
+      /// the CompressionCodec of a compressed payload.
       public: void EnqueueMsg(const std::string &_buffer,
                   boost::function<void(uint32_t)> _cb, uint32_t _id,
-                  bool _force = false);
+                  bool _force = false, const uint8_t _frameFlags = 0);
+
+      /// \brief Write a shared buffer to the socket, without copying it.
+      /// The buffer must not change until it is written. The write starts
+      /// right away, or with the messages queued meanwhile once the write
+      /// in flight completes.
+      /// \param[in] _buffer Data to write
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \param[in] _frameFlags Flags of the binary frame header, such as
+      /// the CompressionCodec of a compressed payload.
+      public: void EnqueueMsg(const BufferPtr &_buffer,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id,
+                  const uint8_t _frameFlags = 0);
 
       /// \brief Write data to the socket
       /// \param[in] _buffer Data to write
-      /// \param[in] _force If true, block until the data has been written
-      /// to the socket, otherwise just enqueue the data for asynchronous write
+      /// \param[in] _force If true, start writing right away, otherwise
+      /// leave the data for the next update of the ConnectionManager, which
+      /// writes the messages queued meanwhile together.
       public: void EnqueueMsg(const std::string &_buffer, bool _force = false);
 
       /// \brief Get the local URI
@@ -201,7 +342,9 @@ namespace gazebo
       public: static std::string GetLocalHostname();
 
       /// \brief Peform an asyncronous read
-      /// param[in] _handler Callback to invoke on received data
+      /// param[in] _handler Callback to invoke on received data. It takes
+      /// either a const std::string & or, to keep the receive buffer
+      /// without copying it, is a boost::function<void(const BufferPtr &)>.
       public: template<typename Handler>
               void AsyncRead(Handler _handler)
               {
@@ -250,15 +393,18 @@ namespace gazebo
 
                  if (inboundData_size > 0)
                   {
-                    // Start the asynchronous call to receive data
-                    this->inboundData.resize(inboundData_size);
+                    // Start the asynchronous call to receive data straight
+                    // into a pooled buffer
+                    this->inboundData =
+                      BufferPool::Instance()->Acquire(inboundData_size);
 
                     void (Connection::*f)(const boost::system::error_code &e,
                         boost::tuple<Handler>) =
                       &Connection::OnReadData<Handler>;
 
                     boost::asio::async_read(*this->socket,
-                        boost::asio::buffer(this->inboundData),
+                        boost::asio::buffer(&(*this->inboundData)[0],
+                          inboundData_size),
                         common::weakBind(f, this->shared_from_this(),
                                     boost::asio::placeholders::error,
                                     _handler));
@@ -266,7 +412,8 @@ namespace gazebo
                   else
                   {
                     gzerr << "Header is empty\n";
-                    boost::get<0>(_handler)("");
+                    this->Deliver(boost::get<0>(_handler),
+                        BufferPtr(new std::string()));
                     // This code tries to read the header again. We should
                     // never get here.
                     // this->inboundHeader.resize(HEADER_LENGTH);
@@ -300,25 +447,86 @@ namespace gazebo
                     this->isOpen = false;
                 }
 
-                // Inform caller that data has been received
-                std::string data(&this->inboundData[0],
-                                  this->inboundData.size());
-                this->inboundData.clear();
+                // Inform caller that data has been received. The buffer
+                // is handed over without copying it.
+                BufferPtr data;
+                data.swap(this->inboundData);
 
-                if (data.empty())
+                if (!data || data->empty())
+                {
                   gzerr << "OnReadData got empty data!!!\n";
+                  data.reset(new std::string());
+                }
+                else if (this->dropFrame)
+                {
+                  // Frame of another message type, pass an empty message
+                  // so the reader carries on
+                  data.reset(new std::string());
+                }
 
                 if (!_e && !transport::is_stopped())
                 {
-                  ConnectionReadTask *task = new(tbb::task::allocate_root())
-                        ConnectionReadTask(boost::get<0>(_handler), data);
-                  tbb::task::enqueue(*task);
+                  // Compressed frames are decompressed by the task, off the
+                  // IO thread
+                  tbb::task::enqueue(*this->NewReadTask(
+                        boost::get<0>(_handler), data,
+                        this->dropFrame ? CompressionCodec::NONE :
+                        this->frameCodec));
 
                   // Non-tbb version:
                   // boost::get<0>(_handler)(data);
                 }
               }
 
+      /// \brief Create the task handing a received message to a read
+      /// handler which takes the data.
+      /// \param[in] _handler Read handler.
+      /// \param[in] _data Received message.
+      /// \param[in] _codec Codec the message was compressed with.
+      /// \return The task, to enqueue.
+      private: template<typename Handler>
+               static ConnectionReadTask *NewReadTask(const Handler &_handler,
+                   const BufferPtr &_data, const CompressionCodec _codec)
+              {
+                return new(tbb::task::allocate_root()) ConnectionReadTask(
+                    boost::function<void (const std::string &)>(_handler),
+                    _data, _codec);
+              }
+
+      /// \brief Create the task handing a received message to a read
+      /// handler which takes the buffer, and can keep it without copying.
+      /// \param[in] _handler Read handler.
+      /// \param[in] _data Received message.
+      /// \param[in] _codec Codec the message was compressed with.
+      /// \return The task, to enqueue.
+      private: static ConnectionReadTask *NewReadTask(
+                   const boost::function<void (const BufferPtr &)> &_handler,
+                   const BufferPtr &_data, const CompressionCodec _codec)
+              {
+                return new(tbb::task::allocate_root()) ConnectionReadTask(
+                    _handler, _data, _codec);
+              }
+
+      /// \brief Call a read handler which takes the data.
+      /// \param[in] _handler Read handler.
+      /// \param[in] _data Message to pass.
+      private: template<typename Handler>
+               static void Deliver(const Handler &_handler,
+                   const BufferPtr &_data)
+              {
+                _handler(*_data);
+              }
+
+      /// \brief Call a read handler which takes the buffer.
+      /// \param[in] _handler Read handler.
+      /// \param[in] _data Message to pass.
+      private: static void Deliver(
+                   const boost::function<void (const BufferPtr &)> &_handler,
+                   const BufferPtr &_data)
+              {
+                _handler(_data);
+              }
+
       /// \brief Register a function to be called when the connection is shut
       /// down \param[in] _subscriber Function to be called \return Handle
       /// that can be used to unregister the function
@@ -343,6 +551,34 @@ namespace gazebo
       /// \return GAZEBO_IP_WHITE_LIST
       public: std::string GetIPWhiteList() const;
 
+      /// \brief Set the version of the header of outgoing messages. Only
+      /// use a binary header once the peer announced it can read it.
+      /// \param[in] _version 0 for the ASCII header, otherwise a binary
+      /// FrameHeader version.
+      public: void SetFrameVersion(const uint8_t _version);
+
+      /// \brief Get the version of the header of outgoing messages.
+      /// \return 0 for the ASCII header, otherwise a binary FrameHeader
+      /// version.
+      public: uint8_t FrameVersion() const;
+
+      /// \brief Set the type id of the messages on this connection. It is
+      /// written in outgoing binary headers, and incoming binary frames of
+      /// another type are dropped.
+      /// \param[in] _typeId Type id from FrameHeader::TypeId, 0 for any.
+      public: void SetFrameTypeId(const uint16_t _typeId);
+
+      /// \brief Add a message to the write queue, without writing it.
+      /// \param[in] _buffer Data to write
+      /// \param[in] _cb If non-null, callback to be invoked after
+      /// transmission is complete.
+      /// \param[in] _id ID associated with the message data.
+      /// \param[in] _frameFlags Flags of the binary frame header.
+      /// \return False if the message was empty or the connection closed.
+      private: bool QueueMsg(const BufferPtr &_buffer,
+                   boost::function<void(uint32_t)> _cb, uint32_t _id,
+                   const uint8_t _frameFlags);
+
       /// \brief Post write.
       /// Called afer a write is finished.
       private: void PostWrite();
@@ -388,14 +624,17 @@ namespace gazebo
       /// \brief Accepts new connections.
       private: boost::asio::ip::tcp::acceptor *acceptor;
 
-      /// \brief Outgoing data queue
-      private: std::deque<std::string> writeQueue;
+      /// \brief Outgoing messages. Elements are only added at the back and
+      /// removed at the front, so buffers of the write in progress stay
+      /// valid.
+      private: std::deque<ConnectionOutgoingMsg> writeQueue;
+
+      /// \brief Number of messages at the front of writeQueue which are
+      /// being written.
+      private: std::size_t writeBatchSize;
 
-      /// \brief List of callbacks, paired with writeQueue. The callbacks
-      /// are used to notify a publisher when a message is successfully sent.
-      private: std::deque< std::vector<
-               std::pair<boost::function<void(uint32_t)>, uint32_t> > >
-                 callbacks;
+      /// \brief Header and payload buffers of the write in progress.
+      private: std::vector<boost::asio::const_buffer> writeBuffers;
 
       /// \brief Mutex to protect new connections.
       private: boost::mutex connectMutex;
@@ -419,7 +658,19 @@ namespace gazebo
       private: std::vector<char> inboundHeader;
 
       /// \brief Content data from a new message.
-      private: std::vector<char> inboundData;
+      private: BufferPtr inboundData;
+
+      /// \brief True if the message being read should be dropped.
+      private: bool dropFrame;
+
+      /// \brief Codec of the message being read.
+      private: CompressionCodec frameCodec;
+
+      /// \brief Version of the header of outgoing messages, 0 for ASCII.
+      private: uint8_t frameVersion;
+
+      /// \brief Type id of the messages on this connection.
+      private: uint16_t frameTypeId;
 
       /// \brief Set to true to stop reading on the connection.
       private: bool readQuit;
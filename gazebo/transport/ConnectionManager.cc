@@ -21,29 +21,20 @@
 #endif
 
 #include <boost/bind.hpp>
+#include <algorithm>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/transport/ConnectionManager.hh"
+#include "gazebo/transport/TransportStatistics.hh"
 
 #include "gazebo/gazebo_config.h"
 
 using namespace gazebo;
 using namespace transport;
 
-/// TBB task to process nodes.
-class TopicManagerProcessTask : public tbb::task
-{
-  /// Implements the necessary execute function
-  public: tbb::task *execute()
-          {
-            TopicManager::Instance()->ProcessNodes();
-            return NULL;
-          }
-};
-
 /// TBB task to establish subscriber to publisher connection.
 class TopicManagerConnectionTask : public tbb::task
 {
@@ -279,11 +270,6 @@ void ConnectionManager::RunUpdate()
   if (this->masterConn)
     this->masterConn->ProcessWriteQueue();
 
-  // Use TBB to process nodes. Need more testing to see if this makes
-  // a difference.
-  // TopicManagerProcessTask *task = new(tbb::task::allocate_root())
-  //   TopicManagerProcessTask();
-  // tbb::task::enqueue(*task);
   boost::recursive_mutex::scoped_lock lock(this->connectionMutex);
 
   TopicManager::Instance()->ProcessNodes();
@@ -311,12 +297,20 @@ void ConnectionManager::Run()
 
   this->stopped = false;
 
+  // Nodes are processed on the dispatch threads as messages come and go.
+  // The update below handles the master and the nodes the threads missed.
+  TopicManager::Instance()->StartDispatch();
+
   while (!this->stop && this->masterConn && this->masterConn->IsOpen())
   {
     this->RunUpdate();
+    TransportStatistics::Instance()->Update();
     this->updateCondition.timed_wait(lock,
        boost::posix_time::milliseconds(100));
   }
+
+  TransportStatistics::Instance()->Fini();
+  TopicManager::Instance()->StopDispatch();
   this->RunUpdate();
 
   this->stopped = true;
@@ -377,6 +371,38 @@ void ConnectionManager::ProcessMessage(const std::string &_data)
         ++iter;
     }
   }
+  // Publishers advertised since the previous master update
+  else if (packet.type() == "publishers_add")
+  {
+    msgs::Publishers result;
+    result.ParseFromString(packet.serialized_data());
+
+    boost::recursive_mutex::scoped_lock lock(this->listMutex);
+    for (int i = 0; i < result.publisher_size(); ++i)
+      this->publishers.push_back(result.publisher(i));
+  }
+  // Publishers removed since the previous master update
+  else if (packet.type() == "publishers_del")
+  {
+    msgs::Publishers result;
+    result.ParseFromString(packet.serialized_data());
+
+    boost::recursive_mutex::scoped_lock lock(this->listMutex);
+    for (int i = 0; i < result.publisher_size(); ++i)
+    {
+      const msgs::Publish &pub = result.publisher(i);
+      std::list<msgs::Publish>::iterator iter = this->publishers.begin();
+      while (iter != this->publishers.end())
+      {
+        if ((*iter).topic() == pub.topic() &&
+            (*iter).host() == pub.host() &&
+            (*iter).port() == pub.port())
+          iter = this->publishers.erase(iter);
+        else
+          ++iter;
+      }
+    }
+  }
   else if (packet.type() == "topic_namespace_add")
   {
     msgs::GzString result;
@@ -484,11 +510,45 @@ void ConnectionManager::OnRead(ConnectionPtr _connection,
     msgs::Subscribe sub;
     sub.ParseFromString(packet.serialized_data());
 
+    // Use binary frame headers if the subscriber can read them. Older
+    // subscribers keep the ASCII header.
+    if (sub.frame_version() > 0)
+    {
+      _connection->SetFrameTypeId(FrameHeader::TypeId(sub.msg_type()));
+      _connection->SetFrameVersion(static_cast<uint8_t>(std::min<uint32_t>(
+            sub.frame_version(), FrameHeader::LatestVersion)));
+    }
+
     // Create a transport link for the publisher to the remote subscriber
     // via the connection
     SubscriptionTransportPtr subLink(new SubscriptionTransport());
     subLink->Init(_connection, sub.latching());
 
+    // Compress large messages if the subscriber asked for it
+    if (sub.has_compression() && sub.frame_version() > 0)
+    {
+      CompressionCodec codec = Compression::Codec(sub.compression());
+      if (Compression::Available(codec))
+      {
+        subLink->SetCompression(codec, sub.has_compression_threshold() ?
+            sub.compression_threshold() : Compression::DefaultThreshold);
+      }
+      else
+      {
+        gzwarn << "Compression codec [" << sub.compression() << "] requested "
+               << "for topic [" << sub.topic() << "] is not available, "
+               << "sending uncompressed messages\n";
+      }
+    }
+
+    // A subscriber on this host may offer a shared memory ring
+    if (sub.has_shm_ring() && sub.host() == _connection->GetLocalAddress() &&
+        !subLink->InitRing(sub.shm_ring()))
+    {
+      gzwarn << "Unable to open shared memory ring [" << sub.shm_ring()
+             << "] for topic [" << sub.topic() << "], using TCP\n";
+    }
+
     // Connect the publisher to this transport mechanism
     TopicManager::Instance()->ConnectPubToSub(sub.topic(), subLink);
   }
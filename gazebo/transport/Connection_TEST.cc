@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <string>
 #include <stdlib.h>
 
@@ -64,6 +65,103 @@ TEST_F(Connection, IPWhiteList)
     setenv("GAZEBO_IP_WHITE_LIST", ipEnv, 1);
 }
 
+/////////////////////////////////////////////////
+TEST_F(Connection, FrameHeader)
+{
+  transport::FrameHeader header;
+  header.typeId = transport::FrameHeader::TypeId("gazebo.msgs.ImageStamped");
+  header.length = 1024 * 1024 * 3 + 17;
+
+  char buffer[HEADER_LENGTH];
+  header.Encode(buffer);
+  EXPECT_TRUE(transport::FrameHeader::IsBinary(buffer));
+
+  transport::FrameHeader decoded;
+  EXPECT_TRUE(decoded.Decode(buffer));
+  EXPECT_EQ(decoded.version, transport::FrameHeader::LatestVersion);
+  EXPECT_EQ(decoded.flags, 0u);
+  EXPECT_EQ(decoded.typeId, header.typeId);
+  EXPECT_EQ(decoded.length, header.length);
+
+  // ASCII headers are told apart
+  EXPECT_FALSE(transport::FrameHeader::IsBinary("0000001a"));
+  EXPECT_FALSE(transport::FrameHeader::IsBinary("ffffffff"));
+
+  // Versions from the future are refused
+  header.version = transport::FrameHeader::LatestVersion + 1;
+  header.Encode(buffer);
+  EXPECT_TRUE(transport::FrameHeader::IsBinary(buffer));
+  EXPECT_FALSE(decoded.Decode(buffer));
+
+  // Type ids are stable and never 0
+  EXPECT_EQ(transport::FrameHeader::TypeId("gazebo.msgs.Pose"),
+      transport::FrameHeader::TypeId("gazebo.msgs.Pose"));
+  EXPECT_NE(transport::FrameHeader::TypeId("gazebo.msgs.Pose"),
+      transport::FrameHeader::TypeId("gazebo.msgs.PoseStamped"));
+  EXPECT_NE(transport::FrameHeader::TypeId(""), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(Connection, FrameVersion)
+{
+  transport::Connection connection;
+  EXPECT_EQ(connection.FrameVersion(), 0u);
+
+  connection.SetFrameVersion(transport::FrameHeader::LatestVersion);
+  EXPECT_EQ(connection.FrameVersion(), transport::FrameHeader::LatestVersion);
+
+  // Versions this side can't write fall back to the latest one
+  connection.SetFrameVersion(200);
+  EXPECT_EQ(connection.FrameVersion(), transport::FrameHeader::LatestVersion);
+
+  connection.SetFrameVersion(0);
+  EXPECT_EQ(connection.FrameVersion(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(Connection, UnsupportedFrameVersion)
+{
+  transport::ConnectionPtr accepted;
+  std::atomic<int> reads(0);
+  transport::ConnectionPtr server(new transport::Connection());
+  server->Listen(11348, [&](const transport::ConnectionPtr &_conn)
+  {
+    accepted = _conn;
+    accepted->AsyncRead([&](const std::string &) { ++reads; });
+  });
+
+  // A peer writing a header of a version from the future
+  boost::asio::io_service io;
+  boost::asio::ip::tcp::socket peer(io);
+  peer.connect(boost::asio::ip::tcp::endpoint(
+        boost::asio::ip::address::from_string("127.0.0.1"), 11348));
+
+  transport::FrameHeader header;
+  header.version = transport::FrameHeader::LatestVersion + 1;
+  header.length = 4;
+  char buffer[HEADER_LENGTH];
+  header.Encode(buffer);
+  boost::asio::write(peer, boost::asio::buffer(buffer, HEADER_LENGTH));
+
+  // The connection is closed rather than left waiting on the stream
+  for (int i = 0; i < 100 && (!accepted || reads == 0); ++i)
+    common::Time::MSleep(10);
+  ASSERT_TRUE(accepted != nullptr);
+  EXPECT_EQ(reads, 1);
+  EXPECT_FALSE(accepted->IsOpen());
+
+  // and the peer sees it
+  peer.non_blocking(true);
+  boost::system::error_code error = boost::asio::error::would_block;
+  char byte;
+  for (int i = 0; i < 100 && error == boost::asio::error::would_block; ++i)
+  {
+    common::Time::MSleep(10);
+    peer.read_some(boost::asio::buffer(&byte, 1), error);
+  }
+  EXPECT_EQ(error, boost::asio::error::eof);
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
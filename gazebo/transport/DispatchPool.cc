@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/DispatchPool.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Tasks posted under one key.
+    class DispatchStrand
+    {
+      /// \brief Tasks waiting to run, oldest first.
+      public: std::deque<boost::function<void()>> tasks;
+
+      /// \brief True while a thread runs a task of this strand.
+      public: bool active = false;
+    };
+
+    /// \internal
+    /// \brief Private data for DispatchPool.
+    class DispatchPoolPrivate
+    {
+      /// \brief Protects all the members.
+      public: mutable std::mutex mutex;
+
+      /// \brief Wakes threads up when a strand is ready, or on stop.
+      public: std::condition_variable condition;
+
+      /// \brief Worker threads.
+      public: std::vector<std::thread> threads;
+
+      /// \brief Strands with tasks waiting or running.
+      public: std::unordered_map<uint64_t, DispatchStrand> strands;
+
+      /// \brief Keys of the strands which have tasks and no running task,
+      /// in the order they became ready.
+      public: std::deque<uint64_t> ready;
+
+      /// \brief True between Start and Stop.
+      public: bool running = false;
+
+      /// \brief True while Stop waits for the threads.
+      public: bool stopping = false;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+DispatchPool::DispatchPool()
+  : dataPtr(new DispatchPoolPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+DispatchPool::~DispatchPool()
+{
+  this->Stop();
+}
+
+/////////////////////////////////////////////////
+void DispatchPool::Start(const unsigned int _threads)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->running || _threads == 0)
+    return;
+
+  this->dataPtr->running = true;
+  for (unsigned int i = 0; i < _threads; ++i)
+    this->dataPtr->threads.push_back(std::thread(&DispatchPool::Run, this));
+}
+
+/////////////////////////////////////////////////
+void DispatchPool::Stop()
+{
+  std::vector<std::thread> threads;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->running || this->dataPtr->stopping)
+      return;
+    this->dataPtr->stopping = true;
+    threads.swap(this->dataPtr->threads);
+  }
+  this->dataPtr->condition.notify_all();
+
+  for (auto &thread : threads)
+  {
+    // A task may stop the pool it runs on
+    if (thread.get_id() == std::this_thread::get_id())
+      thread.detach();
+    else
+      thread.join();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->running = false;
+    this->dataPtr->stopping = false;
+  }
+  this->dataPtr->condition.notify_all();
+}
+
+/////////////////////////////////////////////////
+bool DispatchPool::Post(const uint64_t _key,
+    const boost::function<void()> &_task)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->running || this->dataPtr->stopping)
+      return false;
+
+    DispatchStrand &strand = this->dataPtr->strands[_key];
+    strand.tasks.push_back(_task);
+
+    // A strand is queued once, when it gets its first task
+    if (strand.active || strand.tasks.size() > 1)
+      return true;
+    this->dataPtr->ready.push_back(_key);
+  }
+  this->dataPtr->condition.notify_one();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool DispatchPool::Running() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->running && !this->dataPtr->stopping;
+}
+
+/////////////////////////////////////////////////
+unsigned int DispatchPool::ThreadCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->threads.size();
+}
+
+/////////////////////////////////////////////////
+unsigned int DispatchPool::DefaultThreadCount()
+{
+  const char *env = std::getenv("GAZEBO_TRANSPORT_THREADS");
+  if (env && *env)
+  {
+    try
+    {
+      return static_cast<unsigned int>(std::max(0, std::stoi(env)));
+    }
+    catch(...)
+    {
+      gzerr << "Invalid GAZEBO_TRANSPORT_THREADS [" << env << "]\n";
+    }
+  }
+
+  return std::max(1u, std::min(4u, std::thread::hardware_concurrency()));
+}
+
+/////////////////////////////////////////////////
+void DispatchPool::Run()
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  while (true)
+  {
+    this->dataPtr->condition.wait(lock, [this]
+        {
+          return !this->dataPtr->ready.empty() ||
+            this->dataPtr->stopping || !this->dataPtr->running;
+        });
+
+    // When stopping, the threads still running a task pick up what is
+    // left in their strand
+    if (this->dataPtr->ready.empty())
+      break;
+
+    uint64_t key = this->dataPtr->ready.front();
+    this->dataPtr->ready.pop_front();
+
+    DispatchStrand &strand = this->dataPtr->strands[key];
+    boost::function<void()> task = strand.tasks.front();
+    strand.tasks.pop_front();
+    strand.active = true;
+
+    lock.unlock();
+    try
+    {
+      task();
+    }
+    catch(std::exception &_e)
+    {
+      gzerr << "Transport task threw an exception: " << _e.what() << "\n";
+    }
+    lock.lock();
+
+    auto iter = this->dataPtr->strands.find(key);
+    iter->second.active = false;
+    if (iter->second.tasks.empty())
+    {
+      this->dataPtr->strands.erase(iter);
+    }
+    else
+    {
+      this->dataPtr->ready.push_back(key);
+      this->dataPtr->condition.notify_one();
+    }
+  }
+}
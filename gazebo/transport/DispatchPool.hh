@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_DISPATCHPOOL_HH_
+#define GAZEBO_TRANSPORT_DISPATCHPOOL_HH_
+
+#include <boost/function.hpp>
+#include <cstdint>
+#include <memory>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    // Forward declare private data class
+    class DispatchPoolPrivate;
+
+    /// \class DispatchPool DispatchPool.hh transport/transport.hh
+    /// \brief A bounded pool of threads running tasks posted under a key.
+    /// Tasks with the same key run one at a time, in the order they were
+    /// posted, while tasks of other keys run on the other threads. A slow
+    /// task therefore only delays the tasks posted after it with the same
+    /// key.
+    class GZ_TRANSPORT_VISIBLE DispatchPool
+    {
+      /// \brief Constructor
+      public: DispatchPool();
+
+      /// \brief Destructor. Stops the threads.
+      public: virtual ~DispatchPool();
+
+      /// \brief Start the threads. Does nothing if already started.
+      /// \param[in] _threads Number of threads. No thread is started if 0,
+      /// and Post refuses all tasks.
+      public: void Start(const unsigned int _threads);
+
+      /// \brief Run the tasks already posted and stop the threads. Tasks
+      /// posted afterwards are refused.
+      public: void Stop();
+
+      /// \brief Post a task.
+      /// \param[in] _key Tasks with the same key run in order, one at a
+      /// time.
+      /// \param[in] _task Task to run.
+      /// \return False if the pool isn't running, in which case the task
+      /// is dropped.
+      public: bool Post(const uint64_t _key,
+                        const boost::function<void()> &_task);
+
+      /// \brief Get whether the pool runs posted tasks.
+      /// \return True once started, and until stopped.
+      public: bool Running() const;
+
+      /// \brief Get the number of threads.
+      /// \return Number of threads, 0 when not running.
+      public: unsigned int ThreadCount() const;
+
+      /// \brief Get the number of threads to use by default. This is the
+      /// value of GAZEBO_TRANSPORT_THREADS if set, otherwise the number of
+      /// cores up to 4.
+      /// \return Default number of threads.
+      public: static unsigned int DefaultThreadCount();
+
+      /// \brief Run tasks until stopped.
+      private: void Run();
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<DispatchPoolPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
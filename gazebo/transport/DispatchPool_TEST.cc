@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/transport/DispatchPool.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class DispatchPool : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(DispatchPool, StartStop)
+{
+  transport::DispatchPool pool;
+  EXPECT_FALSE(pool.Running());
+  EXPECT_FALSE(pool.Post(0, []() {}));
+
+  // No thread, no dispatch
+  pool.Start(0);
+  EXPECT_FALSE(pool.Running());
+
+  pool.Start(2);
+  EXPECT_TRUE(pool.Running());
+  EXPECT_EQ(pool.ThreadCount(), 2u);
+
+  // Stop runs what was posted
+  std::atomic<int> count(0);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_TRUE(pool.Post(i % 3, [&count]() { ++count; }));
+  pool.Stop();
+  EXPECT_EQ(count, 100);
+  EXPECT_FALSE(pool.Running());
+  EXPECT_EQ(pool.ThreadCount(), 0u);
+  EXPECT_FALSE(pool.Post(0, []() {}));
+}
+
+/////////////////////////////////////////////////
+TEST_F(DispatchPool, Order)
+{
+  transport::DispatchPool pool;
+  pool.Start(4);
+
+  // Tasks of a key run in order and one at a time
+  const int keys = 8;
+  const int count = 2000;
+  std::vector<std::vector<int>> results(keys);
+  std::vector<std::atomic<int>> running(keys);
+  std::atomic<bool> overlap(false);
+  for (int i = 0; i < count; ++i)
+  {
+    for (int k = 0; k < keys; ++k)
+    {
+      pool.Post(k, [&, i, k]()
+          {
+            if (running[k]++ != 0)
+              overlap = true;
+            results[k].push_back(i);
+            running[k]--;
+          });
+    }
+  }
+  pool.Stop();
+
+  EXPECT_FALSE(overlap);
+  for (int k = 0; k < keys; ++k)
+  {
+    ASSERT_EQ(results[k].size(), static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i)
+      EXPECT_EQ(results[k][i], i);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(DispatchPool, SlowKey)
+{
+  transport::DispatchPool pool;
+  pool.Start(2);
+
+  // A blocked key doesn't hold back the other keys
+  std::mutex blocker;
+  blocker.lock();
+  std::atomic<int> slow(0);
+  std::atomic<int> fast(0);
+  pool.Post(1, [&]() { std::lock_guard<std::mutex> lock(blocker); ++slow; });
+  pool.Post(1, [&]() { ++slow; });
+  for (int i = 0; i < 100; ++i)
+    pool.Post(2, [&]() { ++fast; });
+
+  for (int i = 0; i < 1000 && fast < 100; ++i)
+    common::Time::MSleep(1);
+  EXPECT_EQ(fast, 100);
+  EXPECT_EQ(slow, 0);
+
+  blocker.unlock();
+  pool.Stop();
+  EXPECT_EQ(slow, 2);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,406 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gazebo/transport/MessageQueue.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+/// \brief Number of cells of the first ring of a queue. Rings double in
+/// size up to the capacity of the queue when they fill up.
+static const unsigned int kInitialRingSize = 16;
+
+/// \brief Bit of the push position which closes a ring to new messages.
+static const uint64_t kSealedBit = 1ull << 63;
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief One slot of a ring.
+    class MessageQueueCell
+    {
+      /// \brief Twice the position of the next message to write in the
+      /// slot while it is free, plus one once the message is written. The
+      /// factor of two tells a full slot from a free one even when the
+      /// ring has a single slot.
+      public: std::atomic<uint64_t> sequence;
+
+      /// \brief The message.
+      public: MessagePtr msg;
+    };
+
+    /// \internal
+    /// \brief A ring of cells tagged with a sequence number, which tells
+    /// pushers and poppers whether a cell is theirs without taking a lock.
+    /// When a ring is full, a bigger one takes the new messages while the
+    /// old one is drained.
+    class MessageQueueRing
+    {
+      /// \brief Result of TryPush.
+      public: enum PushResult
+              {
+                /// \brief The message was appended.
+                PUSHED,
+                /// \brief The ring is full.
+                FULL,
+                /// \brief The ring was replaced by a bigger one.
+                SEALED
+              };
+
+      /// \brief Constructor
+      /// \param[in] _size Number of cells.
+      public: explicit MessageQueueRing(const unsigned int _size)
+              : cells(_size), pushPos(0), popPos(0)
+              {
+                for (unsigned int i = 0; i < _size; ++i)
+                {
+                  this->cells[i].sequence.store(2 * i,
+                      std::memory_order_relaxed);
+                }
+              }
+
+      /// \brief Append a message if there is room.
+      /// \param[in] _msg Message to append.
+      /// \return Whether the message was appended.
+      public: PushResult TryPush(const MessagePtr &_msg);
+
+      /// \brief Take the oldest message out.
+      /// \param[out] _msg The message.
+      /// \return False if the ring is empty.
+      public: bool TryPop(MessagePtr &_msg);
+
+      /// \brief Check whether the ring is sealed and all its messages were
+      /// popped. Only valid after TryPop failed.
+      /// \return True if the ring won't hold messages anymore.
+      public: bool Drained() const;
+
+      /// \brief Get the number of messages in the ring.
+      /// \return Number of messages.
+      public: unsigned int Size() const;
+
+      /// \brief The ring.
+      public: std::vector<MessageQueueCell> cells;
+
+      /// \brief Position of the next message to push, with kSealedBit set
+      /// once the ring was replaced.
+      public: std::atomic<uint64_t> pushPos;
+
+      /// \brief Position of the next message to pop.
+      public: std::atomic<uint64_t> popPos;
+
+      /// \brief Ring which replaced this one, set before it is sealed.
+      public: std::atomic<MessageQueueRing *> next{nullptr};
+    };
+
+    /// \internal
+    /// \brief Private data for MessageQueue. The queue starts with a small
+    /// ring, and rings are only replaced by bigger ones while the queue
+    /// fills up, so queues which stay short use little memory. Drained
+    /// rings are freed with the queue, since another thread may still be
+    /// reading them. Each ring is at least twice as big as the one it
+    /// replaced, so together they take less memory than the last one.
+    class MessageQueuePrivate
+    {
+      /// \brief Constructor
+      /// \param[in] _capacity Maximum number of messages.
+      public: explicit MessageQueuePrivate(const unsigned int _capacity)
+              : capacity(_capacity)
+              {
+                this->rings.emplace_back(new MessageQueueRing(
+                      std::min(_capacity, kInitialRingSize)));
+                this->pushRing.store(this->rings.back().get());
+                this->popRing.store(this->rings.back().get());
+              }
+
+      /// \brief Replace a full ring by a bigger one.
+      /// \param[in] _ring The full ring.
+      public: void Grow(MessageQueueRing *_ring);
+
+      /// \brief Take the oldest message out.
+      /// \param[out] _msg The message.
+      /// \return False if the queue is empty.
+      public: bool TryPop(MessagePtr &_msg);
+
+      /// \brief Get the number of messages in all the rings, which can
+      /// exceed the capacity until the older rings are drained.
+      /// \return Number of messages.
+      public: uint64_t Count() const;
+
+      /// \brief Maximum number of messages.
+      public: const unsigned int capacity;
+
+      /// \brief Ring taking new messages.
+      public: std::atomic<MessageQueueRing *> pushRing{nullptr};
+
+      /// \brief Oldest ring which may hold messages.
+      public: std::atomic<MessageQueueRing *> popRing{nullptr};
+
+      /// \brief All the rings of the queue, from the smallest.
+      public: std::vector<std::unique_ptr<MessageQueueRing>> rings;
+
+      /// \brief Serializes the replacement of the push ring.
+      public: std::mutex growMutex;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+MessageQueueRing::PushResult MessageQueueRing::TryPush(
+    const MessagePtr &_msg)
+{
+  const uint64_t size = this->cells.size();
+  uint64_t pos = this->pushPos.load(std::memory_order_relaxed);
+  MessageQueueCell *cell;
+  while (true)
+  {
+    // A failed exchange loads the sealed bit as well
+    if (pos & kSealedBit)
+      return SEALED;
+
+    cell = &this->cells[pos % size];
+    uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+    int64_t diff = static_cast<int64_t>(seq - 2 * pos);
+
+    // The cell is free, claim it
+    if (diff == 0)
+    {
+      if (this->pushPos.compare_exchange_weak(pos, pos + 1,
+            std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    // The cell still holds a message from the previous lap
+    else if (diff < 0)
+      return FULL;
+    // Another thread pushed meanwhile
+    else
+      pos = this->pushPos.load(std::memory_order_relaxed);
+  }
+
+  cell->msg = _msg;
+  cell->sequence.store(2 * pos + 1, std::memory_order_release);
+  return PUSHED;
+}
+
+/////////////////////////////////////////////////
+bool MessageQueueRing::TryPop(MessagePtr &_msg)
+{
+  const uint64_t size = this->cells.size();
+  uint64_t pos = this->popPos.load(std::memory_order_relaxed);
+  MessageQueueCell *cell;
+  while (true)
+  {
+    cell = &this->cells[pos % size];
+    uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+    int64_t diff = static_cast<int64_t>(seq - (2 * pos + 1));
+
+    // The cell holds a message, claim it
+    if (diff == 0)
+    {
+      if (this->popPos.compare_exchange_weak(pos, pos + 1,
+            std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+    // The message isn't written yet
+    else if (diff < 0)
+      return false;
+    // Another thread popped meanwhile
+    else
+      pos = this->popPos.load(std::memory_order_relaxed);
+  }
+
+  _msg.swap(cell->msg);
+  cell->msg.reset();
+  cell->sequence.store(2 * (pos + size), std::memory_order_release);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool MessageQueueRing::Drained() const
+{
+  // Once sealed, no message is pushed past the sealed position
+  uint64_t push = this->pushPos.load(std::memory_order_acquire);
+  return (push & kSealedBit) &&
+    this->popPos.load(std::memory_order_acquire) == (push & ~kSealedBit);
+}
+
+/////////////////////////////////////////////////
+unsigned int MessageQueueRing::Size() const
+{
+  uint64_t pop = this->popPos.load(std::memory_order_acquire);
+  uint64_t push = this->pushPos.load(std::memory_order_acquire) &
+    ~kSealedBit;
+
+  // Both positions move while we read them
+  return push > pop ? static_cast<unsigned int>(
+      std::min<uint64_t>(push - pop, this->cells.size())) : 0u;
+}
+
+/////////////////////////////////////////////////
+void MessageQueuePrivate::Grow(MessageQueueRing *_ring)
+{
+  std::lock_guard<std::mutex> lock(this->growMutex);
+
+  // Another thread replaced it already
+  if (this->pushRing.load(std::memory_order_acquire) != _ring)
+    return;
+
+  this->rings.emplace_back(new MessageQueueRing(static_cast<unsigned int>(
+        std::min<std::size_t>(2 * _ring->cells.size(), this->capacity))));
+  MessageQueueRing *bigger = this->rings.back().get();
+
+  // Poppers follow next once the ring is sealed and drained, pushers
+  // reload the push ring once it is sealed
+  _ring->next.store(bigger, std::memory_order_release);
+  this->pushRing.store(bigger, std::memory_order_release);
+  _ring->pushPos.fetch_or(kSealedBit, std::memory_order_acq_rel);
+}
+
+/////////////////////////////////////////////////
+bool MessageQueuePrivate::TryPop(MessagePtr &_msg)
+{
+  MessageQueueRing *ring = this->popRing.load(std::memory_order_acquire);
+  while (!ring->TryPop(_msg))
+  {
+    if (!ring->Drained())
+      return false;
+
+    // Move on to the ring which replaced it, unless another thread did
+    MessageQueueRing *next = ring->next.load(std::memory_order_acquire);
+    if (this->popRing.compare_exchange_strong(ring, next,
+          std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+      ring = next;
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+uint64_t MessageQueuePrivate::Count() const
+{
+  uint64_t count = 0;
+  for (MessageQueueRing *ring = this->popRing.load(std::memory_order_acquire);
+       ring; ring = ring->next.load(std::memory_order_acquire))
+  {
+    count += ring->Size();
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+MessageQueue::MessageQueue(const unsigned int _capacity)
+  : dataPtr(new MessageQueuePrivate(std::max(1u, _capacity)))
+{
+}
+
+/////////////////////////////////////////////////
+MessageQueue::~MessageQueue()
+{
+}
+
+/////////////////////////////////////////////////
+unsigned int MessageQueue::Push(const MessagePtr &_msg)
+{
+  unsigned int dropped = 0;
+  MessageQueueRing *ring;
+  while (true)
+  {
+    ring = this->dataPtr->pushRing.load(std::memory_order_acquire);
+    MessageQueueRing::PushResult result = ring->TryPush(_msg);
+    if (result == MessageQueueRing::PUSHED)
+      break;
+
+    if (result == MessageQueueRing::FULL)
+    {
+      if (ring->cells.size() < this->dataPtr->capacity)
+      {
+        this->dataPtr->Grow(ring);
+        continue;
+      }
+
+      // Make room by dropping the oldest message. The pop can fail while
+      // another thread is in the middle of writing or reading that cell.
+      MessagePtr oldest;
+      if (this->dataPtr->TryPop(oldest))
+        ++dropped;
+      else
+        std::this_thread::yield();
+    }
+  }
+
+  // The older rings hold messages on top of the push ring until they are
+  // drained. They are only counted until then, which happens at most once
+  // per ring.
+  if (this->dataPtr->popRing.load(std::memory_order_acquire) != ring)
+  {
+    MessagePtr oldest;
+    while (this->dataPtr->Count() > this->dataPtr->capacity &&
+           this->dataPtr->TryPop(oldest))
+    {
+      ++dropped;
+    }
+  }
+
+  return dropped;
+}
+
+/////////////////////////////////////////////////
+bool MessageQueue::Pop(MessagePtr &_msg)
+{
+  return this->dataPtr->TryPop(_msg);
+}
+
+/////////////////////////////////////////////////
+unsigned int MessageQueue::Clear()
+{
+  unsigned int dropped = 0;
+  MessagePtr msg;
+  while (this->dataPtr->TryPop(msg))
+    ++dropped;
+  return dropped;
+}
+
+/////////////////////////////////////////////////
+unsigned int MessageQueue::Size() const
+{
+  return static_cast<unsigned int>(std::min<uint64_t>(
+        this->dataPtr->Count(), this->dataPtr->capacity));
+}
+
+/////////////////////////////////////////////////
+bool MessageQueue::Empty() const
+{
+  return this->Size() == 0;
+}
+
+/////////////////////////////////////////////////
+unsigned int MessageQueue::Capacity() const
+{
+  return this->dataPtr->capacity;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_MESSAGEQUEUE_HH_
+#define GAZEBO_TRANSPORT_MESSAGEQUEUE_HH_
+
+#include <cstdint>
+#include <memory>
+
+#include "gazebo/transport/TransportTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    // Forward declare private data class
+    class MessageQueuePrivate;
+
+    /// \class MessageQueue MessageQueue.hh transport/transport.hh
+    /// \brief Bounded queue of messages. Any number of threads can push
+    /// and pop at the same time without taking a lock. When the queue is
+    /// full, Push drops the oldest messages to make room for the new one,
+    /// so publishers never wait for a slow subscriber. Memory for the
+    /// messages is allocated as the queue fills up rather than for its
+    /// whole capacity up front, which takes a lock the few times the queue
+    /// grows.
+    class GZ_TRANSPORT_VISIBLE MessageQueue
+    {
+      /// \brief Constructor
+      /// \param[in] _capacity Maximum number of messages in the queue. A
+      /// capacity of 0 is treated as 1.
+      public: explicit MessageQueue(const unsigned int _capacity);
+
+      /// \brief Destructor
+      public: virtual ~MessageQueue();
+
+      /// \brief Append a message, dropping the oldest ones if the queue is
+      /// full.
+      /// \param[in] _msg Message to append.
+      /// \return Number of messages dropped.
+      public: unsigned int Push(const MessagePtr &_msg);
+
+      /// \brief Take the oldest message out of the queue.
+      /// \param[out] _msg The message, unchanged if the queue is empty.
+      /// \return False if the queue is empty.
+      public: bool Pop(MessagePtr &_msg);
+
+      /// \brief Drop all the messages.
+      /// \return Number of messages dropped.
+      public: unsigned int Clear();
+
+      /// \brief Get the number of messages in the queue. Only a hint while
+      /// other threads push or pop.
+      /// \return Number of messages.
+      public: unsigned int Size() const;
+
+      /// \brief Check whether the queue is empty. Only a hint while other
+      /// threads push or pop.
+      /// \return True if there is no message in the queue.
+      public: bool Empty() const;
+
+      /// \brief Get the maximum number of messages in the queue.
+      /// \return Capacity given to the constructor, at least 1.
+      public: unsigned int Capacity() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MessageQueuePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/MessageQueue.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MessageQueue : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+transport::MessagePtr MakeMsg(const int _value)
+{
+  boost::shared_ptr<msgs::GzString> msg(new msgs::GzString);
+  msg->set_data(std::to_string(_value));
+  return msg;
+}
+
+/////////////////////////////////////////////////
+int Value(const transport::MessagePtr &_msg)
+{
+  return std::stoi(boost::dynamic_pointer_cast<msgs::GzString>(_msg)->data());
+}
+
+/////////////////////////////////////////////////
+TEST_F(MessageQueue, PushPop)
+{
+  transport::MessageQueue queue(3);
+  EXPECT_EQ(queue.Capacity(), 3u);
+  EXPECT_TRUE(queue.Empty());
+
+  transport::MessagePtr msg;
+  EXPECT_FALSE(queue.Pop(msg));
+
+  for (int i = 0; i < 3; ++i)
+    EXPECT_EQ(queue.Push(MakeMsg(i)), 0u);
+  EXPECT_EQ(queue.Size(), 3u);
+
+  // The oldest message makes room for the new one
+  EXPECT_EQ(queue.Push(MakeMsg(3)), 1u);
+  EXPECT_EQ(queue.Size(), 3u);
+
+  for (int i = 1; i < 4; ++i)
+  {
+    ASSERT_TRUE(queue.Pop(msg));
+    EXPECT_EQ(Value(msg), i);
+  }
+  EXPECT_FALSE(queue.Pop(msg));
+  EXPECT_TRUE(queue.Empty());
+
+  queue.Push(MakeMsg(4));
+  queue.Push(MakeMsg(5));
+  EXPECT_EQ(queue.Clear(), 2u);
+  EXPECT_TRUE(queue.Empty());
+
+  // Capacity of 0 keeps the latest message
+  transport::MessageQueue latest(0);
+  EXPECT_EQ(latest.Capacity(), 1u);
+  latest.Push(MakeMsg(6));
+  EXPECT_EQ(latest.Push(MakeMsg(7)), 1u);
+  ASSERT_TRUE(latest.Pop(msg));
+  EXPECT_EQ(Value(msg), 7);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MessageQueue, Producers)
+{
+  // Several threads push while one pops. Every message is either popped or
+  // counted as dropped, and the messages of a thread keep their order.
+  transport::MessageQueue queue(16);
+  const int producers = 4;
+  const int count = 10000;
+
+  std::atomic<int> done(0);
+  std::atomic<unsigned int> dropped(0);
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p)
+  {
+    threads.push_back(std::thread([&, p]()
+          {
+            for (int i = 0; i < count; ++i)
+              dropped += queue.Push(MakeMsg(p * count + i));
+            ++done;
+          }));
+  }
+
+  std::vector<int> last(producers, -1);
+  unsigned int popped = 0;
+  bool ordered = true;
+  transport::MessagePtr msg;
+  while (done < producers || !queue.Empty())
+  {
+    if (!queue.Pop(msg))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    ++popped;
+    int value = Value(msg);
+    int p = value / count;
+    if (value % count <= last[p])
+      ordered = false;
+    last[p] = value % count;
+  }
+
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(popped + dropped, static_cast<unsigned int>(producers * count));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MessageQueue, Grow)
+{
+  // The queue grows up to its capacity, keeping the order of the messages
+  transport::MessageQueue queue(1000);
+  EXPECT_EQ(queue.Capacity(), 1000u);
+
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(queue.Push(MakeMsg(i)), 0u);
+  EXPECT_EQ(queue.Size(), 1000u);
+
+  EXPECT_EQ(queue.Push(MakeMsg(1000)), 1u);
+  EXPECT_EQ(queue.Size(), 1000u);
+
+  transport::MessagePtr msg;
+  for (int i = 1; i <= 1000; ++i)
+  {
+    ASSERT_TRUE(queue.Pop(msg));
+    EXPECT_EQ(Value(msg), i);
+  }
+  EXPECT_TRUE(queue.Empty());
+
+  // Several threads push while the queue grows, nothing is lost
+  transport::MessageQueue shared(1000);
+  const int producers = 4;
+  const int count = 250;
+  std::vector<std::thread> threads;
+  std::atomic<unsigned int> dropped(0);
+  for (int p = 0; p < producers; ++p)
+  {
+    threads.push_back(std::thread([&, p]()
+          {
+            for (int i = 0; i < count; ++i)
+              dropped += shared.Push(MakeMsg(p * count + i));
+          }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(dropped, 0u);
+  EXPECT_EQ(shared.Size(), static_cast<unsigned int>(producers * count));
+
+  std::vector<int> last(producers, -1);
+  bool ordered = true;
+  while (shared.Pop(msg))
+  {
+    int value = Value(msg);
+    int p = value / count;
+    if (value % count <= last[p])
+      ordered = false;
+    last[p] = value % count;
+  }
+  EXPECT_TRUE(ordered);
+  for (int p = 0; p < producers; ++p)
+    EXPECT_EQ(last[p], count - 1);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -201,28 +201,68 @@ void Node::ProcessPublishers()
 /////////////////////////////////////////////////
 bool Node::HandleData(const std::string &_topic, const std::string &_msg)
 {
-  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-  this->incomingMsgs[_topic].push_back(_msg);
-  ConnectionManager::Instance()->TriggerUpdate();
+  return this->HandleData(_topic, BufferPtr(new std::string(_msg)));
+}
+
+/////////////////////////////////////////////////
+bool Node::HandleData(const std::string &_topic, const BufferPtr &_msg)
+{
+  bool first;
+  {
+    boost::mutex::scoped_lock lock(this->incomingMsgsMutex);
+    first = this->incomingMsgs.empty() && this->incomingMsgsLocal.empty();
+    this->incomingMsgs[_topic].push_back(_msg);
+  }
+  this->DispatchIncoming(first);
   return true;
 }
 
 /////////////////////////////////////////////////
 bool Node::HandleMessage(const std::string &_topic, MessagePtr _msg)
 {
-  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-  this->incomingMsgsLocal[_topic].push_back(_msg);
-  ConnectionManager::Instance()->TriggerUpdate();
+  bool first;
+  {
+    boost::mutex::scoped_lock lock(this->incomingMsgsMutex);
+    first = this->incomingMsgs.empty() && this->incomingMsgsLocal.empty();
+    this->incomingMsgsLocal[_topic].push_back(_msg);
+  }
+  this->DispatchIncoming(first);
   return true;
 }
 
+/////////////////////////////////////////////////
+void Node::DispatchIncoming(const bool _first)
+{
+  // The first message dispatches the node, the others are processed
+  // along with it
+  TopicManager *manager = TopicManager::Instance();
+  bool dispatched = _first ?
+    manager->DispatchIncoming(shared_from_this()) :
+    manager->DispatchRunning();
+
+  // Otherwise the connection manager update processes the node
+  if (!dispatched)
+    ConnectionManager::Instance()->TriggerUpdate();
+}
+
 /////////////////////////////////////////////////
 void Node::ProcessIncoming()
 {
   boost::recursive_mutex::scoped_lock lock(this->processIncomingMutex);
 
-  if (!this->initialized ||
-      (this->incomingMsgs.empty() && this->incomingMsgsLocal.empty()))
+  if (!this->initialized)
+    return;
+
+  // Take the waiting messages, new ones are added while the callbacks run
+  std::map<std::string, std::list<BufferPtr> > msgs;
+  std::map<std::string, std::list<MessagePtr> > msgsLocal;
+  {
+    boost::mutex::scoped_lock lock2(this->incomingMsgsMutex);
+    msgs.swap(this->incomingMsgs);
+    msgsLocal.swap(this->incomingMsgsLocal);
+  }
+
+  if (msgs.empty() && msgsLocal.empty())
     return;
 
   Callback_M::iterator cbIter;
@@ -230,13 +270,13 @@ void Node::ProcessIncoming()
 
   // For each topic
   {
-    std::list<std::string>::iterator msgIter;
-    std::map<std::string, std::list<std::string> >::iterator inIter;
-    std::map<std::string, std::list<std::string> >::iterator endIter;
+    std::list<BufferPtr>::iterator msgIter;
+    std::map<std::string, std::list<BufferPtr> >::iterator inIter;
+    std::map<std::string, std::list<BufferPtr> >::iterator endIter;
 
     boost::recursive_mutex::scoped_lock lock2(this->incomingMutex);
-    inIter = this->incomingMsgs.begin();
-    endIter = this->incomingMsgs.end();
+    inIter = msgs.begin();
+    endIter = msgs.end();
 
     for (; inIter != endIter; ++inIter)
     {
@@ -244,8 +284,8 @@ void Node::ProcessIncoming()
       cbIter = this->callbacks.find(inIter->first);
       if (cbIter != this->callbacks.end())
       {
-        std::list<std::string>::iterator msgInIter;
-        std::list<std::string>::iterator msgEndIter;
+        std::list<BufferPtr>::iterator msgInIter;
+        std::list<BufferPtr>::iterator msgEndIter;
 
         msgInIter = inIter->second.begin();
         msgEndIter = inIter->second.end();
@@ -257,14 +297,13 @@ void Node::ProcessIncoming()
           for (liter = cbIter->second.begin();
               liter != cbIter->second.end(); ++liter)
           {
-            (*liter)->HandleData(*msgIter,
+            (*liter)->HandleData(**msgIter,
                 boost::bind(&dummy_callback_fn, _1), 0);
           }
         }
       }
     }
 
-    this->incomingMsgs.clear();
   }
 
   {
@@ -273,8 +312,8 @@ void Node::ProcessIncoming()
     std::map<std::string, std::list<MessagePtr> >::iterator endIter;
 
     boost::recursive_mutex::scoped_lock lock2(this->incomingMutex);
-    inIter = this->incomingMsgsLocal.begin();
-    endIter = this->incomingMsgsLocal.end();
+    inIter = msgsLocal.begin();
+    endIter = msgsLocal.end();
 
     for (; inIter != endIter; ++inIter)
     {
@@ -301,7 +340,6 @@ void Node::ProcessIncoming()
       }
     }
 
-    this->incomingMsgsLocal.clear();
   }
 }
 
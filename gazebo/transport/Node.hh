@@ -26,6 +26,7 @@
 #include <string>
 #include <vector>
 
+#include "gazebo/transport/BufferPool.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/util/system.hh"
@@ -43,9 +44,8 @@ namespace gazebo
       /// \param[in] _message Message to publish
       public: PublishTask(transport::PublisherPtr _pub,
                   const google::protobuf::Message &_message)
-              : pub(_pub)
+              : pub(_pub), msg(_message.New())
       {
-        this->msg = _message.New();
         this->msg->CopyFrom(_message);
       }
 
@@ -54,9 +54,9 @@ namespace gazebo
       public: tbb::task *execute()
               {
                 this->pub->WaitForConnection();
-                this->pub->Publish(*this->msg, true);
+                this->pub->Publish(this->msg, true);
                 this->pub->SendMessage();
-                delete this->msg;
+                this->msg.reset();
                 this->pub.reset();
                 return NULL;
               }
@@ -65,7 +65,7 @@ namespace gazebo
       private: transport::PublisherPtr pub;
 
       /// \brief Message to publish
-      private: google::protobuf::Message *msg;
+      private: MessagePtr msg;
     };
     /// \endcond
 
@@ -172,16 +172,20 @@ namespace gazebo
       /// queue for delivery
       /// \param[in] _hz Update rate for the publisher. Units are
       /// 1.0/seconds.
+      /// \param[in] _conflate Keep only the latest outgoing message, for
+      /// state topics where a newer message replaces the older ones, such
+      /// as poses. The queue limit is then ignored.
       /// \return Pointer to new publisher object
       public: template<typename M>
       transport::PublisherPtr Advertise(const std::string &_topic,
                                         unsigned int _queueLimit = 1000,
-                                        double _hzRate = 0)
+                                        double _hzRate = 0,
+                                        bool _conflate = false)
       {
         std::string decodedTopic = this->DecodeTopicName(_topic);
         PublisherPtr publisher =
           transport::TopicManager::Instance()->Advertise<M>(
-              decodedTopic, _queueLimit, _hzRate);
+              decodedTopic, _queueLimit, _hzRate, _conflate);
 
         boost::mutex::scoped_lock lock(this->publisherMutex);
         publisher->SetNode(shared_from_this());
@@ -212,16 +216,18 @@ namespace gazebo
       /// queue for delivery
       /// \param[in] _hz Update rate for the publisher. Units are
       /// 1.0/seconds.
+      /// \param[in] _conflate Keep only the latest outgoing message.
       /// \return Pointer to new publisher object
       public: transport::PublisherPtr Advertise(const std::string &_topic,
                                         const std::string &_msgTypeName,
                                         unsigned int _queueLimit = 1000,
-                                        double _hzRate = 0)
+                                        double _hzRate = 0,
+                                        bool _conflate = false)
       {
         std::string decodedTopic = this->DecodeTopicName(_topic);
         PublisherPtr publisher =
           transport::TopicManager::Instance()->Advertise(
-              decodedTopic, _msgTypeName, _queueLimit, _hzRate);
+              decodedTopic, _msgTypeName, _queueLimit, _hzRate, _conflate);
 
         boost::mutex::scoped_lock lock(this->publisherMutex);
         publisher->SetNode(shared_from_this());
@@ -250,6 +256,8 @@ namespace gazebo
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
           this->callbacks[decodedTopic].push_back(CallbackHelperPtr(
                 new CallbackHelperT<M>(boost::bind(_fp, _obj, _1), _latching)));
+          this->callbacks[decodedTopic].back()->SetStats(
+              TransportStatistics::Instance()->Stats(decodedTopic));
         }
 
         SubscriberPtr result =
@@ -279,6 +287,8 @@ namespace gazebo
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
           this->callbacks[decodedTopic].push_back(
               CallbackHelperPtr(new CallbackHelperT<M>(_fp, _latching)));
+          this->callbacks[decodedTopic].back()->SetStats(
+              TransportStatistics::Instance()->Stats(decodedTopic));
         }
 
         SubscriberPtr result =
@@ -354,6 +364,15 @@ namespace gazebo
       public: bool HandleData(const std::string &_topic,
                               const std::string &_msg);
 
+      /// \brief Handle incoming data, without copying it. The buffer is
+      /// queued until the callbacks of the node parse it.
+      /// \param[in] _topic Topic for which the data was received
+      /// \param[in] _msg The message that was received, which must not
+      /// change afterwards
+      /// \return true if the message was handled successfully, false otherwise
+      public: bool HandleData(const std::string &_topic,
+                              const BufferPtr &_msg);
+
       /// \brief Handle incoming msg.
       /// \param[in] _topic Topic for which the data was received
       /// \param[in] _msg The message that was received
@@ -390,6 +409,10 @@ namespace gazebo
       /// \param[in] _id Id of the callback.
       public: void RemoveCallback(const std::string &_topic, unsigned int _id);
 
+      /// \brief Have the incoming messages processed, after one was added.
+      /// \param[in] _first True if the message was the only one waiting.
+      private: void DispatchIncoming(const bool _first);
+
       /// \internal
       /// \brief Private implementation of Init() and TryInit()
       /// \param[in] _space Namespace to initialize this Node to. Use an empty
@@ -414,7 +437,7 @@ namespace gazebo
       private: typedef std::list<CallbackHelperPtr> Callback_L;
       private: typedef std::map<std::string, Callback_L> Callback_M;
       private: Callback_M callbacks;
-      private: std::map<std::string, std::list<std::string> > incomingMsgs;
+      private: std::map<std::string, std::list<BufferPtr> > incomingMsgs;
 
       /// \brief List of newly arrive messages
       private: std::map<std::string, std::list<MessagePtr> > incomingMsgsLocal;
@@ -423,6 +446,11 @@ namespace gazebo
       private: boost::mutex publisherDeleteMutex;
       private: boost::recursive_mutex incomingMutex;
 
+      /// \brief Protects incomingMsgs and incomingMsgsLocal. It is only
+      /// held to add or take messages, so publishers never wait for the
+      /// callbacks of the node.
+      private: boost::mutex incomingMsgsMutex;
+
       /// \brief make sure we don't call ProcessingIncoming simultaneously
       /// from separate threads.
       private: boost::recursive_mutex processIncomingMutex;
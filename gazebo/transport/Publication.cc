@@ -17,6 +17,7 @@
 
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
+#include <chrono>
 #include "gazebo/common/WeakBind.hh"
 #include "SubscriptionTransport.hh"
 #include "Publication.hh"
@@ -30,9 +31,11 @@ unsigned int Publication::idCounter = 0;
 
 //////////////////////////////////////////////////
 Publication::Publication(const std::string &_topic, const std::string &_msgType)
-  : topic(_topic), msgType(_msgType), locallyAdvertised(false)
+  : topic(_topic), msgType(_msgType), locallyAdvertised(false),
+    serializeCount(0)
 {
   this->id = idCounter++;
+  this->stats = TransportStatistics::Instance()->Stats(_topic);
 }
 
 //////////////////////////////////////////////////
@@ -136,7 +139,9 @@ void Publication::AddTransport(const PublicationTransportPtr &_publink)
   // Don't add a duplicate transport
   if (add)
   {
-    _publink->AddCallback(common::weakBind(&Publication::LocalPublish,
+    void (Publication::*localPublish)(const BufferPtr &) =
+      &Publication::LocalPublish;
+    _publink->AddCallback(common::weakBind(localPublish,
                 this->shared_from_this(), _1));
     this->transports.push_back(_publink);
   }
@@ -246,6 +251,12 @@ void Publication::RemoveSubscription(const std::string &_host,
 
 //////////////////////////////////////////////////
 void Publication::LocalPublish(const std::string &_data)
+{
+  this->LocalPublish(BufferPtr(new std::string(_data)));
+}
+
+//////////////////////////////////////////////////
+void Publication::LocalPublish(const BufferPtr &_data)
 {
   std::list<NodePtr>::iterator iter, endIter;
 
@@ -276,7 +287,7 @@ void Publication::LocalPublish(const std::string &_data)
     {
       if ((*cbIter)->IsLocal())
       {
-        if ((*cbIter)->HandleData(_data,
+        if ((*cbIter)->HandleData(*_data,
               boost::bind(&dummy_callback_fn, _1), 0))
           ++cbIter;
         else
@@ -295,6 +306,8 @@ int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
   int result = 0;
   std::list<NodePtr>::iterator iter, endIter;
 
+  this->stats->RecordPublish();
+
   {
     boost::mutex::scoped_lock lock(this->nodeMutex);
 
@@ -319,14 +332,21 @@ int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
 
     if (!this->callbacks.empty())
     {
-      std::string data;
-      _msg->SerializeToString(&data);
+      BufferPtr data(new std::string);
+      auto start = std::chrono::steady_clock::now();
+      _msg->SerializeToString(data.get());
+      this->stats->RecordSend(data->size(),
+          std::chrono::steady_clock::now() - start);
+      ++this->serializeCount;
+      // Compressed at most once per codec, and queued without copies, for
+      // all remote subscribers
+      CompressedData payloads(data);
       std::list<CallbackHelperPtr>::iterator cbIter;
       cbIter = this->callbacks.begin();
 
       while (cbIter != this->callbacks.end())
       {
-        if ((*cbIter)->HandleData(data, _cb, _id))
+        if ((*cbIter)->HandleSerializedData(payloads, _cb, _id))
         {
           ++result;
           ++cbIter;
@@ -417,6 +437,12 @@ void Publication::AddPublisher(PublisherPtr _pub)
   this->publishers.push_back(_pub);
 }
 
+//////////////////////////////////////////////////
+uint64_t Publication::SerializeCount() const
+{
+  return this->serializeCount;
+}
+
 //////////////////////////////////////////////////
 void Publication::RemovePublisher(PublisherPtr _pub)
 {
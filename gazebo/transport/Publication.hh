@@ -18,6 +18,8 @@
 #ifndef _PUBLICATION_HH_
 #define _PUBLICATION_HH_
 
+#include <atomic>
+#include <cstdint>
 #include <utility>
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
@@ -116,6 +118,13 @@ namespace gazebo
       /// \param[in] _data The data to be published
       public: void LocalPublish(const std::string &_data);
 
+      /// \brief Publish data received from a remote publisher to local
+      /// subscribers. Nodes queue the buffer itself until their callbacks
+      /// parse it.
+      /// \param[in] _data The data to be published, which must not change
+      /// afterwards.
+      public: void LocalPublish(const BufferPtr &_data);
+
       /// \brief Publish data to remote subscribers
       /// \param[in] _msg Message to be published
       /// \param[in] _cb Callback to be invoked after publishing
@@ -164,6 +173,11 @@ namespace gazebo
       /// \param[in,out] _pub Pointer to publisher object to be added
       public: void AddPublisher(PublisherPtr _pub);
 
+      /// \brief Get the number of messages serialized for subscription
+      /// callbacks. Nodes in this process receive messages unserialized.
+      /// \return Number of serializations since construction.
+      public: uint64_t SerializeCount() const;
+
       /// \brief Remove nodes that have been marked for removal
       private: void RemoveNodes();
 
@@ -211,6 +225,12 @@ namespace gazebo
 
       /// \brief Publishers and their last messages.
       private: std::map<uint32_t, MessagePtr> prevMsgs;
+
+      /// \brief Number of messages serialized for subscription callbacks.
+      private: std::atomic<uint64_t> serializeCount;
+
+      /// \brief Message flow of the topic.
+      private: TopicStatsPtr stats;
     };
     /// \}
   }
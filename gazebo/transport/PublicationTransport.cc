@@ -26,6 +26,7 @@
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/transport/ConnectionManager.hh"
 #include "gazebo/transport/PublicationTransport.hh"
+#include "gazebo/transport/ShmManager.hh"
 #include "gazebo/common/WeakBind.hh"
 
 using namespace gazebo;
@@ -39,12 +40,16 @@ PublicationTransport::PublicationTransport(const std::string &_topic,
 : topic(_topic), msgType(_msgType)
 {
   this->id = counter++;
+  this->stats = TransportStatistics::Instance()->Stats(this->topic);
   TopicManager::Instance()->UpdatePublications(this->topic, this->msgType);
 }
 
 /////////////////////////////////////////////////
 PublicationTransport::~PublicationTransport()
 {
+  ShmManager::Instance()->RemoveRing(this->ring);
+  this->ring.reset();
+
   if (this->connection)
   {
     msgs::Subscribe sub;
@@ -72,39 +77,79 @@ void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
   sub.set_port(this->connection->GetLocalPort());
   sub.set_latching(_latched);
 
+  // Announce that binary frame headers can be read, and drop frames of
+  // another message type
+  sub.set_frame_version(FrameHeader::LatestVersion);
+  this->connection->SetFrameTypeId(FrameHeader::TypeId(this->msgType));
+
+  // Ask for large messages to be compressed
+  CompressionCodec codec = Compression::Requested();
+  if (codec != CompressionCodec::NONE)
+  {
+    sub.set_compression(Compression::Name(codec));
+    sub.set_compression_threshold(Compression::RequestedThreshold());
+  }
+
+  // The publisher is on this host, offer it a shared memory ring. All the
+  // data then comes through the ring, in order.
+  if (ShmRing::Enabled() &&
+      this->connection->GetLocalAddress() ==
+      this->connection->GetRemoteAddress())
+  {
+    this->ring = ShmManager::Instance()->CreateRing(
+        common::weakBind(&PublicationTransport::OnShmData,
+          this->shared_from_this(), _1));
+    if (this->ring)
+      sub.set_shm_ring(this->ring->Name());
+  }
+
   this->connection->EnqueueMsg(msgs::Package("sub", sub));
 
   // Put this in PublicationTransportPtr
   // Start reading messages from the remote publisher
-  this->connection->AsyncRead(common::weakBind(&PublicationTransport::OnPublish,
-        this->shared_from_this(), _1));
+  // Messages are read into buffers which are passed on without copies
+  this->connection->AsyncRead(boost::function<void(const BufferPtr &)>(
+        common::weakBind(&PublicationTransport::OnPublish,
+          this->shared_from_this(), _1)));
 }
 
 
 /////////////////////////////////////////////////
 void PublicationTransport::AddCallback(
-    const boost::function<void(const std::string &)> &cb_)
+    const boost::function<void(const BufferPtr &)> &cb_)
 {
   this->callback = cb_;
 }
 
 /////////////////////////////////////////////////
-void PublicationTransport::OnPublish(const std::string &_data)
+void PublicationTransport::OnPublish(const BufferPtr &_data)
 {
   if (this->connection && this->connection->IsOpen())
   {
-    this->connection->AsyncRead(
-        common::weakBind(&PublicationTransport::OnPublish,
-            this->shared_from_this(), _1));
+    this->connection->AsyncRead(boost::function<void(const BufferPtr &)>(
+          common::weakBind(&PublicationTransport::OnPublish,
+            this->shared_from_this(), _1)));
 
-    if (!_data.empty())
+    if (!_data->empty())
     {
+      this->stats->RecordReceive(_data->size());
       if (this->callback)
         (this->callback)(_data);
     }
   }
 }
 
+/////////////////////////////////////////////////
+void PublicationTransport::OnShmData(const BufferPtr &_data)
+{
+  if (_data->empty())
+    return;
+
+  this->stats->RecordReceive(_data->size());
+  if (this->callback)
+    (this->callback)(_data);
+}
+
 /////////////////////////////////////////////////
 const ConnectionPtr PublicationTransport::GetConnection() const
 {
@@ -127,6 +172,8 @@ std::string PublicationTransport::GetMsgType() const
 void PublicationTransport::Fini()
 {
   /// Cancel all async operatiopns.
+  ShmManager::Instance()->RemoveRing(this->ring);
+
   if (this->connection)
   {
     this->connection->Cancel();
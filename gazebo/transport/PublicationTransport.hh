@@ -23,6 +23,8 @@
 #include <string>
 
 #include "gazebo/transport/Connection.hh"
+#include "gazebo/transport/ShmRing.hh"
+#include "gazebo/transport/TransportStatistics.hh"
 #include "gazebo/common/Event.hh"
 #include "gazebo/util/system.hh"
 
@@ -61,7 +63,7 @@ namespace gazebo
       /// \brief Add a callback to the transport
       /// \param[in] _cb The callback to be added
       public: void AddCallback(
-                  const boost::function<void(const std::string &)> &_cb);
+                  const boost::function<void(const BufferPtr &)> &_cb);
 
       /// \brief Get the underlying connection
       /// \return Pointer to the underlying connection
@@ -77,7 +79,12 @@ namespace gazebo
 
       /// \brief Called when data is published.
       /// \param[in] _data Data to be published.
-      private: void OnPublish(const std::string &_data);
+      private: void OnPublish(const BufferPtr &_data);
+
+      /// \brief Called from the shared memory reader thread when data is
+      /// published through the ring.
+      /// \param[in] _data Data to be published.
+      private: void OnShmData(const BufferPtr &_data);
 
       /// \brief The topic for this publication transport.
       private: std::string topic;
@@ -88,14 +95,21 @@ namespace gazebo
       /// \brief The connection for the publication transport
       private: ConnectionPtr connection;
 
+      /// \brief Shared memory ring offered to a publisher on the same
+      /// host, null if not offered.
+      private: ShmRingPtr ring;
+
       /// \brief Callback used when OnPublish is called.
-      private: boost::function<void (const std::string &)> callback;
+      private: boost::function<void (const BufferPtr &)> callback;
 
       /// \brief Counter to give the publication transport a unique id.
       private: static int counter;
 
       /// \brief The unique id for the publication transport.
       private: int id;
+
+      /// \brief Message flow of the topic.
+      private: TopicStatsPtr stats;
     };
     /// \}
   }
@@ -24,11 +24,13 @@
 #endif
 
 #include <boost/bind.hpp>
+#include <vector>
 
 #include <ignition/math/Helpers.hh>
 
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/WeakBind.hh"
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/transport/Publisher.hh"
@@ -40,16 +42,17 @@ uint32_t Publisher::idCounter = 0;
 
 //////////////////////////////////////////////////
 Publisher::Publisher(const std::string &_topic, const std::string &_msgType,
-                     unsigned int _limit, double _hzRate)
+                     unsigned int _limit, double _hzRate, bool _conflate)
   : topic(_topic), msgType(_msgType), queueLimit(_limit),
-    updatePeriod(0)
+    conflate(_conflate), updatePeriod(0), queueLimitWarned(false),
+    messages(_conflate ? 1u : _limit), dropCount(0), copyCount(0)
 {
   if (!ignition::math::equal(_hzRate, 0.0))
     this->updatePeriod = 1.0 / _hzRate;
 
-  this->queueLimitWarned = false;
   this->pubId = 0;
   this->id = ++idCounter;
+  this->stats = TransportStatistics::Instance()->Stats(this->topic);
 }
 
 //////////////////////////////////////////////////
@@ -92,6 +95,40 @@ bool Publisher::WaitForConnection(const common::Time &_timeout) const
 //////////////////////////////////////////////////
 void Publisher::PublishImpl(const google::protobuf::Message &_message,
                             bool _block)
+{
+  if (!this->PrePublish(_message))
+    return;
+
+  // Subscribers get their own copy, the caller may reuse the message
+  MessagePtr msgPtr = msgs::NewArenaMessage(_message);
+  msgPtr->CopyFrom(_message);
+  ++this->copyCount;
+
+  this->Enqueue(msgPtr, _block);
+}
+
+//////////////////////////////////////////////////
+void Publisher::PublishImpl(
+    const boost::shared_ptr<const google::protobuf::Message> &_message,
+    bool _block)
+{
+  if (!_message)
+  {
+    gzerr << "Publishing a null message on topic[" << this->topic << "]\n";
+    return;
+  }
+
+  if (!this->PrePublish(*_message))
+    return;
+
+  // The transport never modifies a queued message, so it can be shared
+  // as is with the subscribers.
+  this->Enqueue(
+      boost::const_pointer_cast<google::protobuf::Message>(_message), _block);
+}
+
+//////////////////////////////////////////////////
+bool Publisher::PrePublish(const google::protobuf::Message &_message)
 {
   if (_message.GetTypeName() != this->msgType)
     gzthrow("Invalid message type\n");
@@ -101,7 +138,7 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
     gzerr << "Publishing an uninitialized message on topic[" <<
       this->topic << "]. Required field [" <<
       _message.InitializationErrorString() << "] missing.\n";
-    return;
+    return false;
   }
 
   // Check if a throttling rate has been set
@@ -115,84 +152,85 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
         (this->currentTime - this->prevPublishTime).Double() <
         this->updatePeriod)
     {
-      return;
+      return false;
     }
 
     // Set the previous time a message was published
     this->prevPublishTime = this->currentTime;
   }
 
-  // Save the latest message
-  MessagePtr msgPtr(_message.New());
-  msgPtr->CopyFrom(_message);
+  return true;
+}
 
-  this->publication->SetPrevMsg(this->id, msgPtr);
+//////////////////////////////////////////////////
+void Publisher::Enqueue(MessagePtr _msg, bool _block)
+{
+  // Save the latest message
+  this->publication->SetPrevMsg(this->id, _msg);
 
+  // The queue drops the oldest messages when full, without waiting for
+  // a send in progress
+  unsigned int dropped = this->messages.Push(_msg);
+  this->stats->RecordQueueDepth(this->messages.Size());
+  if (dropped > 0)
   {
-    boost::mutex::scoped_lock lock(this->mutex);
+    this->dropCount += dropped;
+    this->stats->RecordDrops(dropped);
 
-    this->messages.push_back(msgPtr);
-
-    if (this->messages.size() > this->queueLimit)
+    // Conflating publishers are expected to drop
+    if (!this->conflate && !this->queueLimitWarned.exchange(true))
     {
-      this->messages.pop_front();
-
-      if (!queueLimitWarned)
-      {
-        gzwarn << "Queue limit reached for topic "
-          << this->topic
-          << ", deleting message. "
-          << "This warning is printed only once." << std::endl;
-        queueLimitWarned = true;
-      }
+      gzwarn << "Queue limit reached for topic "
+        << this->topic
+        << ", deleting message. "
+        << "This warning is printed only once." << std::endl;
     }
   }
 
+  // Sends the messages on the dispatch threads, or on the next update of
+  // the connection manager
   TopicManager::Instance()->AddNodeToProcess(this->node);
 
   if (_block)
   {
     this->SendMessage();
   }
-  else
-  {
-    // Tell the connection manager that it needs to update
-    ConnectionManager::Instance()->TriggerUpdate();
-  }
 }
 
 //////////////////////////////////////////////////
 void Publisher::SendMessage()
 {
-  std::list<MessagePtr> localBuffer;
-  std::list<uint32_t> localIds;
+  std::vector<MessagePtr> localBuffer;
+  std::vector<uint32_t> localIds;
 
   {
     boost::mutex::scoped_lock lock(this->mutex);
-    if (!this->pubIds.empty() || this->messages.empty())
+    if (!this->pubIds.empty() || this->messages.Empty())
     {
       return;
     }
 
-    for (unsigned int i = 0; i < this->messages.size(); ++i)
+    // Publishers keep appending while the queue is drained, take what is
+    // there now
+    localBuffer.reserve(this->messages.Size());
+    MessagePtr msg;
+    while (localBuffer.size() < this->messages.Capacity() &&
+           this->messages.Pop(msg))
     {
+      localBuffer.push_back(msg);
       this->pubId = (this->pubId + 1) % 10000;
       this->pubIds[this->pubId] = 0;
       localIds.push_back(this->pubId);
     }
-
-    std::copy(this->messages.begin(), this->messages.end(),
-        std::back_inserter(localBuffer));
-    this->messages.clear();
   }
 
   // Only send messages if there is something to send
   if (!localBuffer.empty())
   {
-    std::list<uint32_t>::iterator pubIter = localIds.begin();
+    std::vector<uint32_t>::iterator pubIter = localIds.begin();
 
     // Send all the current messages
-    for (std::list<MessagePtr>::iterator iter = localBuffer.begin();
+    for (std::vector<MessagePtr>::iterator iter = localBuffer.begin();
         iter != localBuffer.end(); ++iter, ++pubIter)
     {
       // Expected number of calls to the callback function
@@ -267,8 +305,7 @@ void Publisher::SetNode(NodePtr _node)
 //////////////////////////////////////////////////
 unsigned int Publisher::GetOutgoingCount() const
 {
-  boost::mutex::scoped_lock lock(this->mutex);
-  return this->messages.size();
+  return this->messages.Size();
 }
 
 //////////////////////////////////////////////////
@@ -297,9 +334,21 @@ void Publisher::OnPublishComplete(uint32_t _id)
     return;
   }
 
-  std::map<uint32_t, int>::iterator iter = this->pubIds.find(_id);
-  if (iter != this->pubIds.end() && (--iter->second) <= 0)
-    this->pubIds.erase(iter);
+  bool resend = false;
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    std::map<uint32_t, int>::iterator iter = this->pubIds.find(_id);
+    if (iter != this->pubIds.end() && (--iter->second) <= 0)
+    {
+      this->pubIds.erase(iter);
+
+      // Messages published meanwhile can go now
+      resend = this->pubIds.empty() && !this->messages.Empty();
+    }
+  }
+
+  if (resend)
+    TopicManager::Instance()->AddNodeToProcess(this->node);
 }
 
 //////////////////////////////////////////////////
@@ -317,9 +366,9 @@ unsigned int Publisher::GetRemoteSubscriptionCount()
 //////////////////////////////////////////////////
 void Publisher::Fini()
 {
-  if (!this->messages.empty())
+  if (!this->messages.Empty())
     this->SendMessage();
-  this->messages.clear();
+  this->messages.Clear();
 
   if (!this->topic.empty())
     TopicManager::Instance()->Unadvertise(this->topic, this->id);
@@ -355,3 +404,21 @@ uint32_t Publisher::Id() const
 {
   return this->id;
 }
+
+//////////////////////////////////////////////////
+uint64_t Publisher::DropCount() const
+{
+  return this->dropCount;
+}
+
+//////////////////////////////////////////////////
+bool Publisher::Conflate() const
+{
+  return this->conflate;
+}
+
+//////////////////////////////////////////////////
+uint64_t Publisher::CopyCount() const
+{
+  return this->copyCount;
+}
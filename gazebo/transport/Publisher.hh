@@ -24,11 +24,14 @@
 #include <google/protobuf/message.h>
 #include <boost/thread.hpp>
 #include <boost/shared_ptr.hpp>
+#include <atomic>
+#include <cstdint>
 #include <string>
-#include <list>
 #include <map>
 
 #include "gazebo/common/Time.hh"
+#include "gazebo/transport/MessageQueue.hh"
+#include "gazebo/transport/TransportStatistics.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/util/system.hh"
 
@@ -50,8 +53,12 @@ namespace gazebo
       /// \param[in] _limit Maximum number of outgoing messages to queue
       /// \param[in] _hz Update rate for the publisher. Units are
       /// 1.0/seconds.
+      /// \param[in] _conflate Keep only the latest outgoing message, for
+      /// topics where older messages are outdated by newer ones, such as
+      /// poses or world statistics. The queue limit is then ignored.
       public: Publisher(const std::string &_topic, const std::string &_msgType,
-                        unsigned int _limit, double _hzRate);
+                        unsigned int _limit, double _hzRate,
+                        bool _conflate = false);
 
       /// \brief Destructor
       public: virtual ~Publisher();
@@ -98,9 +105,26 @@ namespace gazebo
       /// not be sent out immediately. Check with  GetOutgoingCount() if
       /// there are still messages in the queue which need to be sent out.
       public: template< typename M>
-              void Publish(M _message, bool _block = false)
+              void Publish(const M &_message, bool _block = false)
               { this->PublishImpl(_message, _block); }
 
+      /// \brief Publish a shared message on the topic without copying it.
+      /// Subscribers in this process receive the same object, and it is
+      /// only serialized for remote subscribers. The message must not be
+      /// modified after this call.
+      /// \param[in] _message Message to be published
+      /// \param[in] _block Whether to block until the message is actually
+      /// written into the local message buffer, and SendMessage() is called.
+      /// \sa Publish(const google::protobuf::Message &, bool)
+      public: template<typename M>
+              void Publish(const boost::shared_ptr<M> &_message,
+                           bool _block = false)
+              {
+                this->PublishImpl(
+                    boost::shared_ptr<const google::protobuf::Message>(
+                      _message), _block);
+              }
+
       /// \brief Get the number of outgoing messages
       /// \return The number of outgoing messages
       public: unsigned int GetOutgoingCount() const;
@@ -140,6 +164,20 @@ namespace gazebo
       /// \return Unique id of this publisher.
       public: uint32_t Id() const;
 
+      /// \brief Get the number of outgoing messages dropped because the
+      /// queue was full, or replaced by a newer message when conflating.
+      /// \return Number of messages dropped since construction.
+      public: uint64_t DropCount() const;
+
+      /// \brief Get whether only the latest outgoing message is kept.
+      /// \return True if the publisher conflates its messages.
+      public: bool Conflate() const;
+
+      /// \brief Get the number of messages copied by Publish. Shared
+      /// messages are not copied.
+      /// \return Number of copies made since construction.
+      public: uint64_t CopyCount() const;
+
       /// \brief Implementation of Publish.
       /// \param[in] _message Message to be published.
       /// \param[in] _block Whether to block until the message is actually
@@ -147,6 +185,25 @@ namespace gazebo
       private: void PublishImpl(const google::protobuf::Message &_message,
                                 bool _block);
 
+      /// \brief Implementation of Publish for shared messages.
+      /// \param[in] _message Message to be published.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void PublishImpl(
+                   const boost::shared_ptr<const google::protobuf::Message>
+                   &_message, bool _block);
+
+      /// \brief Check that a message can be published now.
+      /// \param[in] _message Message to be published.
+      /// \return False if the message is invalid or throttled.
+      private: bool PrePublish(const google::protobuf::Message &_message);
+
+      /// \brief Queue a message for publication.
+      /// \param[in] _msg Message to queue, shared with the subscribers.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void Enqueue(MessagePtr _msg, bool _block);
+
       /// \brief Callback when a publish is completed
       /// \param[in] _id ID associated with the publication.
       private: void OnPublishComplete(uint32_t _id);
@@ -161,18 +218,22 @@ namespace gazebo
       /// publication.
       private: unsigned int queueLimit;
 
+      /// \brief True if only the latest message is kept.
+      private: bool conflate;
+
       /// \brief Period at which messages are published. Zero indicates no
       /// limit.
       private: double updatePeriod;
 
       /// \brief True if queueLimit has been reached, and a warning message
       /// was produced.
-      private: bool queueLimitWarned;
+      private: std::atomic<bool> queueLimitWarned;
 
-      /// \brief List of messages to publish.
-      private: std::list<MessagePtr> messages;
+      /// \brief Messages to publish. Publish appends to it without taking
+      /// the mutex.
+      private: MessageQueue messages;
 
-      /// \brief For mutual exclusion.
+      /// \brief Protects the publication ids, and serializes SendMessage.
       private: mutable boost::mutex mutex;
 
       /// \brief The publication pointers. One for normal publication, and
@@ -194,6 +255,15 @@ namespace gazebo
       /// \brief Unique ID for this publisher.
       private: uint32_t id;
 
+      /// \brief Number of messages dropped from the queue.
+      private: std::atomic<uint64_t> dropCount;
+
+      /// \brief Number of messages copied by Publish.
+      private: std::atomic<uint64_t> copyCount;
+
+      /// \brief Message flow of the topic.
+      private: TopicStatsPtr stats;
+
       /// \brief Counter to create unique ID for publishers.
       private: static uint32_t idCounter;
     };
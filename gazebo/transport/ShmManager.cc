@@ -0,0 +1,362 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef _WIN32
+  // Ensure that Winsock2.h is included before Windows.h, which can get
+  // pulled in by anybody (e.g., Boost).
+  #include <Winsock2.h>
+  #include <process.h>
+  #define getpid _getpid
+#else
+  #include <unistd.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/ShmManager.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief A message waiting for room in a ring.
+    struct ShmPendingWrite
+    {
+      /// \brief Serialized message.
+      BufferPtr data;
+
+      /// \brief Number of bytes already written, when the message is
+      /// larger than the ring.
+      uint64_t offset;
+
+      /// \brief Called once the message is written.
+      boost::function<void(uint32_t)> cb;
+
+      /// \brief ID passed to cb.
+      uint32_t id;
+    };
+
+    /// \internal
+    /// \brief Private data for ShmManager
+    class ShmManagerPrivate
+    {
+      /// \brief A ring and the callback for its messages.
+      public: typedef std::pair<ShmRingPtr,
+              boost::function<void(const BufferPtr &)>> Reader;
+
+      /// \brief Callbacks of written messages, with their IDs.
+      public: typedef std::vector<std::pair<boost::function<void(uint32_t)>,
+              uint32_t>> Written;
+
+      /// \brief Doorbell rung by the writers of all the rings.
+      public: ShmDoorbell doorbell;
+
+      /// \brief Rings being read.
+      public: std::vector<Reader> readers;
+
+      /// \brief Protects the readers.
+      public: mutable std::mutex mutex;
+
+      /// \brief Messages waiting for room, by ring written to.
+      public: std::map<ShmRingPtr, std::deque<ShmPendingWrite>> backlogs;
+
+      /// \brief Protects the backlogs. Also makes the writes to a ring
+      /// come from one thread at a time. Locked before the mutex.
+      public: mutable std::mutex writeMutex;
+
+      /// \brief Reader thread, started with the first ring.
+      public: std::thread thread;
+
+      /// \brief Tells the reader thread to stop.
+      public: std::atomic<bool> stop{false};
+
+      /// \brief Used to give the rings unique names.
+      public: unsigned int counter = 0;
+
+      /// \brief Prefix of the names of the shared memory objects.
+      public: std::string prefix;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+ShmManager::ShmManager()
+  : dataPtr(new ShmManagerPrivate)
+{
+  this->dataPtr->prefix = "gazebo_" + std::to_string(getpid()) + "_";
+}
+
+/////////////////////////////////////////////////
+ShmManager::~ShmManager()
+{
+  this->Fini();
+}
+
+/////////////////////////////////////////////////
+ShmRingPtr ShmManager::CreateRing(
+    const boost::function<void(const BufferPtr &)> &_cb)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  if (!this->Start())
+    return ShmRingPtr();
+
+  ShmRingPtr ring(new ShmRing());
+  if (!ring->Create(this->dataPtr->prefix +
+        std::to_string(this->dataPtr->counter++),
+        this->dataPtr->doorbell.Name()))
+  {
+    return ShmRingPtr();
+  }
+
+  this->dataPtr->readers.push_back(std::make_pair(ring, _cb));
+  return ring;
+}
+
+/////////////////////////////////////////////////
+void ShmManager::RemoveRing(const ShmRingPtr &_ring)
+{
+  if (!_ring)
+    return;
+
+  _ring->Close();
+
+  // Messages which will never be written are done, as on a connection
+  // which closes
+  ShmManagerPrivate::Written written;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->writeMutex);
+    auto backlog = this->dataPtr->backlogs.find(_ring);
+    if (backlog != this->dataPtr->backlogs.end())
+    {
+      for (auto const &pending : backlog->second)
+        written.push_back(std::make_pair(pending.cb, pending.id));
+      this->dataPtr->backlogs.erase(backlog);
+    }
+  }
+  for (auto const &cb : written)
+  {
+    if (!cb.first.empty())
+      cb.first(cb.second);
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto iter = this->dataPtr->readers.begin();
+       iter != this->dataPtr->readers.end(); ++iter)
+  {
+    if (iter->first == _ring)
+    {
+      this->dataPtr->readers.erase(iter);
+      break;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void ShmManager::Write(const ShmRingPtr &_ring, const BufferPtr &_data,
+    const boost::function<void(uint32_t)> &_cb, const uint32_t _id)
+{
+  if (!_ring || !_data)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->writeMutex);
+
+    // Messages after one which is waiting wait too, to keep the order
+    auto backlog = this->dataPtr->backlogs.find(_ring);
+    uint64_t offset = 0;
+    if (backlog != this->dataPtr->backlogs.end() ||
+        (!_ring->IsClosed() && !_ring->Write(*_data, offset)))
+    {
+      ShmPendingWrite pending;
+      pending.data = _data;
+      pending.offset = offset;
+      pending.cb = _cb;
+      pending.id = _id;
+      std::deque<ShmPendingWrite> &queue = this->dataPtr->backlogs[_ring];
+      queue.push_back(pending);
+
+      // Wake the thread up, so it retries soon
+      std::lock_guard<std::mutex> threadLock(this->dataPtr->mutex);
+      this->Start();
+      if (queue.size() == 1)
+        this->dataPtr->doorbell.Ring();
+      return;
+    }
+  }
+
+  if (!_cb.empty())
+    _cb(_id);
+}
+
+/////////////////////////////////////////////////
+unsigned int ShmManager::BacklogSize(const ShmRingPtr &_ring) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->writeMutex);
+  auto backlog = this->dataPtr->backlogs.find(_ring);
+  if (backlog == this->dataPtr->backlogs.end())
+    return 0;
+  return static_cast<unsigned int>(backlog->second.size());
+}
+
+/////////////////////////////////////////////////
+unsigned int ShmManager::RingCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return static_cast<unsigned int>(this->dataPtr->readers.size());
+}
+
+/////////////////////////////////////////////////
+void ShmManager::Fini()
+{
+  this->dataPtr->stop = true;
+  this->dataPtr->doorbell.Ring();
+  if (this->dataPtr->thread.joinable())
+    this->dataPtr->thread.join();
+
+  ShmManagerPrivate::Written written;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->writeMutex);
+    for (auto const &backlog : this->dataPtr->backlogs)
+    {
+      for (auto const &pending : backlog.second)
+        written.push_back(std::make_pair(pending.cb, pending.id));
+    }
+    this->dataPtr->backlogs.clear();
+  }
+  for (auto const &cb : written)
+  {
+    if (!cb.first.empty())
+      cb.first(cb.second);
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto &reader : this->dataPtr->readers)
+    reader.first->Close();
+  this->dataPtr->readers.clear();
+}
+
+/////////////////////////////////////////////////
+bool ShmManager::Start()
+{
+  bool result = !this->dataPtr->doorbell.Name().empty() ||
+    this->dataPtr->doorbell.Create(this->dataPtr->prefix + "doorbell");
+
+  // Without a doorbell the thread still writes the backlogs, it polls
+  if (!this->dataPtr->thread.joinable())
+  {
+    this->dataPtr->stop = false;
+    this->dataPtr->thread = std::thread(&ShmManager::Run, this);
+  }
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+void ShmManager::WriteBacklogs()
+{
+  ShmManagerPrivate::Written written;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->writeMutex);
+    auto backlog = this->dataPtr->backlogs.begin();
+    while (backlog != this->dataPtr->backlogs.end())
+    {
+      const ShmRingPtr &ring = backlog->first;
+      std::deque<ShmPendingWrite> &queue = backlog->second;
+      while (!queue.empty() && (ring->IsClosed() ||
+            ring->Write(*queue.front().data, queue.front().offset)))
+      {
+        written.push_back(std::make_pair(queue.front().cb,
+              queue.front().id));
+        queue.pop_front();
+      }
+
+      if (queue.empty())
+        backlog = this->dataPtr->backlogs.erase(backlog);
+      else
+        ++backlog;
+    }
+  }
+
+  for (auto const &cb : written)
+  {
+    if (!cb.first.empty())
+      cb.first(cb.second);
+  }
+}
+
+/////////////////////////////////////////////////
+void ShmManager::Run()
+{
+  std::vector<ShmManagerPrivate::Reader> readers;
+  BufferPtr data(new std::string);
+
+  while (!this->dataPtr->stop)
+  {
+    // Readers of other processes don't signal when they make room, so
+    // the backlogs are retried every millisecond while there are any
+    bool waiting;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->writeMutex);
+      waiting = !this->dataPtr->backlogs.empty();
+    }
+    std::chrono::milliseconds timeout(waiting ? 1 : 100);
+
+    // Rings written to while scanning ring the doorbell again
+    if (this->dataPtr->doorbell.Name().empty())
+      std::this_thread::sleep_for(timeout);
+    else
+    {
+      this->dataPtr->doorbell.Wait(
+          common::Time(0, static_cast<int32_t>(timeout.count() * 1000000)));
+      this->dataPtr->doorbell.Drain();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      readers = this->dataPtr->readers;
+    }
+
+    for (auto &reader : readers)
+    {
+      while (!this->dataPtr->stop && reader.first->Read(*data))
+      {
+        // The callback may keep the buffer, read the next message into a
+        // new one
+        if (reader.second)
+        {
+          reader.second(data);
+          data.reset(new std::string);
+        }
+      }
+    }
+    readers.clear();
+
+    this->WriteBacklogs();
+  }
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_SHMMANAGER_HH_
+#define GAZEBO_TRANSPORT_SHMMANAGER_HH_
+
+#include <boost/function.hpp>
+#include <memory>
+#include <string>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/transport/BufferPool.hh"
+#include "gazebo/transport/ShmRing.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_TRANSPORT_VISIBLE, gazebo, transport, ShmManager)
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    // Forward declare private data class
+    class ShmManagerPrivate;
+
+    /// \class ShmManager ShmManager.hh transport/transport.hh
+    /// \brief Owns the shared memory rings this process reads from. A
+    /// single thread waits on the process doorbell and hands the messages
+    /// of every ring to their callbacks. The same thread writes the
+    /// messages which didn't fit in the rings this process writes to.
+    class GZ_TRANSPORT_VISIBLE ShmManager : public SingletonT<ShmManager>
+    {
+      /// \brief Constructor
+      private: ShmManager();
+
+      /// \brief Destructor
+      private: virtual ~ShmManager();
+
+      /// \brief Create a ring and start reading from it.
+      /// \param[in] _cb Called with each message read, from the reader
+      /// thread. The buffer can be kept.
+      /// \return The new ring, null if shared memory is not available.
+      public: ShmRingPtr CreateRing(
+                  const boost::function<void(const BufferPtr &)> &_cb);
+
+      /// \brief Close a ring and stop reading from it, or stop writing
+      /// to it.
+      /// \param[in] _ring Ring returned by CreateRing, or passed to Write.
+      public: void RemoveRing(const ShmRingPtr &_ring);
+
+      /// \brief Write a message to a ring opened by this process, without
+      /// dropping it. If the ring has no room, the message and the ones
+      /// written after it wait for the reader to make room, in order.
+      /// \param[in] _ring Ring to write to.
+      /// \param[in] _data Serialized message, which must not change.
+      /// \param[in] _cb If non-null, called once the message is in the ring
+      /// or the ring is closed, like after a write to a connection.
+      /// \param[in] _id ID passed to _cb.
+      public: void Write(const ShmRingPtr &_ring, const BufferPtr &_data,
+                  const boost::function<void(uint32_t)> &_cb,
+                  const uint32_t _id);
+
+      /// \brief Get the number of messages waiting for room in a ring.
+      /// \param[in] _ring Ring passed to Write.
+      /// \return Number of messages not written yet.
+      public: unsigned int BacklogSize(const ShmRingPtr &_ring) const;
+
+      /// \brief Get the number of rings being read.
+      /// \return Number of rings.
+      public: unsigned int RingCount() const;
+
+      /// \brief Stop the reader thread and remove all the rings.
+      public: void Fini();
+
+      /// \brief Start the reader thread if it isn't running. The mutex
+      /// must be locked.
+      /// \return False if the doorbell couldn't be created.
+      private: bool Start();
+
+      /// \brief Write the messages waiting for room in the rings.
+      private: void WriteBacklogs();
+
+      /// \brief Reader thread.
+      private: void Run();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ShmManagerPrivate> dataPtr;
+
+      /// \brief This is a singleton class.
+      private: friend class SingletonT<ShmManager>;
+    };
+    /// \}
+  }
+}
+#endif
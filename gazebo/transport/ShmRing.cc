@@ -0,0 +1,571 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef _WIN32
+  // Ensure that Winsock2.h is included before Windows.h, which can get
+  // pulled in by anybody (e.g., Boost).
+  #include <Winsock2.h>
+#endif
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/interprocess_semaphore.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/ShmRing.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+namespace bip = boost::interprocess;
+
+const uint64_t ShmRing::DefaultCapacity = 8u * 1024u * 1024u;
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \brief Identifies a doorbell segment.
+    static const uint32_t kDoorbellMagic = 0x677a6462;
+
+    /// \brief Identifies a ring segment of this layout.
+    static const uint32_t kRingMagic = 0x677a7232;
+
+    /// \brief Set in the size of a frame which is followed by more
+    /// fragments of the same message.
+    static const uint32_t kMoreFragments = 0x80000000u;
+
+    /// \brief Maximum length of a doorbell name stored in a ring.
+    static const size_t kNameLength = 64;
+
+    /// \brief Layout of a doorbell segment.
+    struct ShmDoorbellHeader
+    {
+      /// \brief Constructor
+      ShmDoorbellHeader() : sem(0) {}
+
+      /// \brief Set last, once the semaphore is constructed.
+      std::atomic<uint32_t> magic;
+
+      /// \brief Posted once per message written.
+      bip::interprocess_semaphore sem;
+    };
+
+    /// \brief Layout of the start of a ring segment, followed by the data.
+    struct alignas(64) ShmRingHeader
+    {
+      /// \brief Set last, once the header is initialized.
+      std::atomic<uint32_t> magic;
+
+      /// \brief Non-zero once the reader closed the ring.
+      std::atomic<uint32_t> closed;
+
+      /// \brief Size of the data area in bytes.
+      uint64_t capacity;
+
+      /// \brief Total number of bytes written. Only the writer changes it.
+      alignas(64) std::atomic<uint64_t> head;
+
+      /// \brief Total number of bytes read. Only the reader changes it.
+      alignas(64) std::atomic<uint64_t> tail;
+
+      /// \brief Name of the doorbell of the reading process.
+      char doorbell[kNameLength];
+    };
+
+    /// \internal
+    /// \brief Shared memory segment mapped into this process.
+    class ShmSegment
+    {
+      /// \brief Create a new segment, replacing a stale one.
+      /// \param[in] _name Name of the segment.
+      /// \param[in] _size Size of the segment in bytes.
+      /// \return Address of the mapping, null on error.
+      public: void *Create(const std::string &_name, const uint64_t _size)
+              {
+                try
+                {
+                  bip::shared_memory_object::remove(_name.c_str());
+                  this->shm.reset(new bip::shared_memory_object(
+                        bip::create_only, _name.c_str(), bip::read_write));
+                  this->owner = true;
+                  this->name = _name;
+                  this->shm->truncate(static_cast<bip::offset_t>(_size));
+                  this->region.reset(
+                      new bip::mapped_region(*this->shm, bip::read_write));
+                  return this->region->get_address();
+                }
+                catch(bip::interprocess_exception &_e)
+                {
+                  gzwarn << "Unable to create shared memory [" << _name
+                         << "]: " << _e.what() << std::endl;
+                  this->Reset();
+                  return nullptr;
+                }
+              }
+
+      /// \brief Map an existing segment.
+      /// \param[in] _name Name of the segment.
+      /// \param[in] _minSize Minimum size of the segment in bytes.
+      /// \return Address of the mapping, null on error.
+      public: void *Open(const std::string &_name, const uint64_t _minSize)
+              {
+                try
+                {
+                  this->shm.reset(new bip::shared_memory_object(
+                        bip::open_only, _name.c_str(), bip::read_write));
+                  this->name = _name;
+                  this->region.reset(
+                      new bip::mapped_region(*this->shm, bip::read_write));
+                  if (this->region->get_size() < _minSize)
+                  {
+                    this->Reset();
+                    return nullptr;
+                  }
+                  return this->region->get_address();
+                }
+                catch(bip::interprocess_exception &_e)
+                {
+                  gzwarn << "Unable to open shared memory [" << _name
+                         << "]: " << _e.what() << std::endl;
+                  this->Reset();
+                  return nullptr;
+                }
+              }
+
+      /// \brief Get the size of the mapping.
+      /// \return Size in bytes.
+      public: uint64_t Size() const
+              {
+                return this->region ? this->region->get_size() : 0;
+              }
+
+      /// \brief Unmap the segment, and remove it if it was created here.
+      public: void Reset()
+              {
+                this->region.reset();
+                this->shm.reset();
+                if (this->owner)
+                  bip::shared_memory_object::remove(this->name.c_str());
+                this->owner = false;
+                this->name.clear();
+              }
+
+      /// \brief Shared memory object.
+      public: std::unique_ptr<bip::shared_memory_object> shm;
+
+      /// \brief Mapping of the object.
+      public: std::unique_ptr<bip::mapped_region> region;
+
+      /// \brief Name of the object.
+      public: std::string name;
+
+      /// \brief True if the object was created here.
+      public: bool owner = false;
+    };
+
+    /// \internal
+    /// \brief Private data for ShmDoorbell
+    class ShmDoorbellPrivate
+    {
+      /// \brief Mapped segment.
+      public: ShmSegment segment;
+
+      /// \brief Header in the segment.
+      public: ShmDoorbellHeader *header = nullptr;
+    };
+
+    /// \internal
+    /// \brief Private data for ShmRing
+    class ShmRingPrivate
+    {
+      /// \brief Copy bytes into the ring, wrapping around the end.
+      /// \param[in] _pos Position in the byte stream.
+      /// \param[in] _src Bytes to copy.
+      /// \param[in] _size Number of bytes.
+      public: void CopyIn(const uint64_t _pos, const void *_src,
+                          const uint64_t _size)
+              {
+                uint64_t offset = _pos % this->capacity;
+                uint64_t first = std::min(_size, this->capacity - offset);
+                const char *src = static_cast<const char *>(_src);
+                std::memcpy(this->data + offset, src, first);
+                std::memcpy(this->data, src + first, _size - first);
+              }
+
+      /// \brief Copy bytes out of the ring, wrapping around the end.
+      /// \param[in] _pos Position in the byte stream.
+      /// \param[out] _dst Destination.
+      /// \param[in] _size Number of bytes.
+      public: void CopyOut(const uint64_t _pos, void *_dst,
+                           const uint64_t _size) const
+              {
+                uint64_t offset = _pos % this->capacity;
+                uint64_t first = std::min(_size, this->capacity - offset);
+                char *dst = static_cast<char *>(_dst);
+                std::memcpy(dst, this->data + offset, first);
+                std::memcpy(dst + first, this->data, _size - first);
+              }
+
+      /// \brief Mapped segment.
+      public: ShmSegment segment;
+
+      /// \brief Header at the start of the segment.
+      public: ShmRingHeader *header = nullptr;
+
+      /// \brief Data area after the header.
+      public: char *data = nullptr;
+
+      /// \brief Size of the data area, read once from the header so the
+      /// other process can't change it under us.
+      public: uint64_t capacity = 0;
+
+      /// \brief Doorbell of the reader, opened by the writer.
+      public: ShmDoorbell doorbell;
+
+      /// \brief Fragments read so far of a message split by the writer.
+      public: std::string partial;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+ShmDoorbell::ShmDoorbell()
+  : dataPtr(new ShmDoorbellPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+ShmDoorbell::~ShmDoorbell()
+{
+  if (this->dataPtr->header && this->dataPtr->segment.owner)
+    this->dataPtr->header->~ShmDoorbellHeader();
+  this->dataPtr->segment.Reset();
+}
+
+/////////////////////////////////////////////////
+bool ShmDoorbell::Create(const std::string &_name)
+{
+  void *addr = this->dataPtr->segment.Create(_name,
+      sizeof(ShmDoorbellHeader));
+  if (!addr)
+    return false;
+
+  this->dataPtr->header = new (addr) ShmDoorbellHeader;
+  this->dataPtr->header->magic.store(kDoorbellMagic, std::memory_order_release);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool ShmDoorbell::Open(const std::string &_name)
+{
+  void *addr = this->dataPtr->segment.Open(_name, sizeof(ShmDoorbellHeader));
+  if (!addr)
+    return false;
+
+  auto header = static_cast<ShmDoorbellHeader *>(addr);
+  if (header->magic.load(std::memory_order_acquire) != kDoorbellMagic)
+  {
+    this->dataPtr->segment.Reset();
+    return false;
+  }
+
+  this->dataPtr->header = header;
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string ShmDoorbell::Name() const
+{
+  return this->dataPtr->segment.name;
+}
+
+/////////////////////////////////////////////////
+void ShmDoorbell::Ring()
+{
+  if (this->dataPtr->header)
+    this->dataPtr->header->sem.post();
+}
+
+/////////////////////////////////////////////////
+bool ShmDoorbell::Wait(const common::Time &_timeout)
+{
+  if (!this->dataPtr->header)
+    return false;
+
+  boost::posix_time::ptime deadline =
+    boost::posix_time::microsec_clock::universal_time() +
+    boost::posix_time::microseconds(
+        static_cast<int64_t>(_timeout.Double() * 1e6));
+  return this->dataPtr->header->sem.timed_wait(deadline);
+}
+
+/////////////////////////////////////////////////
+void ShmDoorbell::Drain()
+{
+  if (!this->dataPtr->header)
+    return;
+
+  while (this->dataPtr->header->sem.try_wait())
+    continue;
+}
+
+/////////////////////////////////////////////////
+ShmRing::ShmRing()
+  : dataPtr(new ShmRingPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+ShmRing::~ShmRing()
+{
+  // Only the reader closes the ring, a writer just goes away
+  if (this->dataPtr->segment.owner)
+    this->Close();
+  this->dataPtr->segment.Reset();
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::Create(const std::string &_name, const std::string &_doorbell,
+    const uint64_t _capacity)
+{
+  if (_doorbell.size() >= kNameLength || _capacity == 0)
+    return false;
+
+  void *addr = this->dataPtr->segment.Create(_name,
+      sizeof(ShmRingHeader) + _capacity);
+  if (!addr)
+    return false;
+
+  auto header = new (addr) ShmRingHeader;
+  if (!header->head.is_lock_free())
+  {
+    gzwarn << "64 bit atomics are not lock free, "
+           << "shared memory transport disabled" << std::endl;
+    this->dataPtr->segment.Reset();
+    return false;
+  }
+
+  header->closed.store(0);
+  header->capacity = _capacity;
+  header->head.store(0);
+  header->tail.store(0);
+  std::memset(header->doorbell, 0, kNameLength);
+  std::memcpy(header->doorbell, _doorbell.data(), _doorbell.size());
+  header->magic.store(kRingMagic, std::memory_order_release);
+
+  this->dataPtr->header = header;
+  this->dataPtr->data = static_cast<char *>(addr) + sizeof(ShmRingHeader);
+  this->dataPtr->capacity = _capacity;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::Open(const std::string &_name)
+{
+  void *addr = this->dataPtr->segment.Open(_name, sizeof(ShmRingHeader));
+  if (!addr)
+    return false;
+
+  auto header = static_cast<ShmRingHeader *>(addr);
+  uint64_t capacity = header->capacity;
+  if (header->magic.load(std::memory_order_acquire) != kRingMagic ||
+      capacity == 0 ||
+      this->dataPtr->segment.Size() - sizeof(ShmRingHeader) < capacity)
+  {
+    this->dataPtr->segment.Reset();
+    return false;
+  }
+
+  std::string doorbell(header->doorbell,
+      strnlen(header->doorbell, kNameLength));
+  if (!this->dataPtr->doorbell.Open(doorbell))
+  {
+    this->dataPtr->segment.Reset();
+    return false;
+  }
+
+  this->dataPtr->header = header;
+  this->dataPtr->data = static_cast<char *>(addr) + sizeof(ShmRingHeader);
+  this->dataPtr->capacity = capacity;
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string ShmRing::Name() const
+{
+  return this->dataPtr->segment.name;
+}
+
+/////////////////////////////////////////////////
+uint64_t ShmRing::Capacity() const
+{
+  return this->dataPtr->capacity;
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::Write(const std::string &_data)
+{
+  uint64_t need = sizeof(uint32_t) + _data.size();
+  if (need > this->dataPtr->capacity)
+    return false;
+
+  uint64_t offset = 0;
+  return this->Write(_data, offset);
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::Write(const std::string &_data, uint64_t &_offset)
+{
+  ShmRingHeader *header = this->dataPtr->header;
+  if (!header || header->closed.load(std::memory_order_acquire) ||
+      _offset > _data.size())
+  {
+    return false;
+  }
+
+  uint64_t head = header->head.load(std::memory_order_relaxed);
+  uint64_t tail = header->tail.load(std::memory_order_acquire);
+  if (head - tail > this->dataPtr->capacity)
+    return false;
+
+  bool written = false;
+  uint64_t start = head;
+  do
+  {
+    uint64_t room = this->dataPtr->capacity - (head - tail);
+    uint64_t rest = _data.size() - _offset;
+
+    // Fragments are only used for what doesn't fit in the ring, a message
+    // which fits waits for room to be written whole
+    uint64_t size = rest;
+    if (sizeof(uint32_t) + rest > this->dataPtr->capacity ||
+        rest >= kMoreFragments)
+    {
+      // Wait for a quarter of the ring to be free rather than writing
+      // many small fragments
+      size = std::min<uint64_t>(kMoreFragments - 1,
+          room > sizeof(uint32_t) ? room - sizeof(uint32_t) : 0);
+      if (size == 0 || size < this->dataPtr->capacity / 4)
+        break;
+    }
+    if (sizeof(uint32_t) + size > room)
+      break;
+
+    uint32_t frame = static_cast<uint32_t>(size);
+    if (size < rest)
+      frame |= kMoreFragments;
+
+    this->dataPtr->CopyIn(head, &frame, sizeof(frame));
+    if (size > 0)
+    {
+      this->dataPtr->CopyIn(head + sizeof(frame), _data.data() + _offset,
+          size);
+    }
+    head += sizeof(frame) + size;
+    _offset += size;
+    written = size == rest;
+  } while (!written);
+
+  if (head != start)
+  {
+    header->head.store(head, std::memory_order_release);
+    this->dataPtr->doorbell.Ring();
+  }
+  return written;
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::Read(std::string &_data)
+{
+  ShmRingHeader *header = this->dataPtr->header;
+  if (!header)
+    return false;
+
+  while (true)
+  {
+    uint64_t tail = header->tail.load(std::memory_order_relaxed);
+    uint64_t head = header->head.load(std::memory_order_acquire);
+    if (head == tail)
+      return false;
+
+    // The head and the frame sizes are written by another process, don't
+    // trust them. Drop everything written so far if they don't add up.
+    uint64_t used = head - tail;
+    uint32_t frame = 0;
+    if (used >= sizeof(frame) && used <= this->dataPtr->capacity)
+      this->dataPtr->CopyOut(tail, &frame, sizeof(frame));
+    uint32_t size = frame & ~kMoreFragments;
+    if (used < sizeof(frame) || used > this->dataPtr->capacity ||
+        size > used - sizeof(frame))
+    {
+      gzerr << "Corrupt frame in shared memory ring ["
+            << this->dataPtr->segment.name << "], dropping ["
+            << used << "] bytes" << std::endl;
+      this->dataPtr->partial.clear();
+      header->tail.store(head, std::memory_order_release);
+      return false;
+    }
+
+    // Fragments are gathered until the last one of the message
+    std::string &out = (frame & kMoreFragments) ||
+      !this->dataPtr->partial.empty() ? this->dataPtr->partial : _data;
+    size_t offset = &out == &_data ? 0 : out.size();
+    out.resize(offset + size);
+    if (size > 0)
+      this->dataPtr->CopyOut(tail + sizeof(frame), &out[offset], size);
+    header->tail.store(tail + sizeof(frame) + size,
+        std::memory_order_release);
+
+    if (!(frame & kMoreFragments))
+    {
+      if (&out != &_data)
+      {
+        _data.swap(this->dataPtr->partial);
+        this->dataPtr->partial.clear();
+      }
+      return true;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void ShmRing::Close()
+{
+  if (this->dataPtr->header)
+    this->dataPtr->header->closed.store(1, std::memory_order_release);
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::IsClosed() const
+{
+  return !this->dataPtr->header ||
+    this->dataPtr->header->closed.load(std::memory_order_acquire);
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::Enabled()
+{
+  const char *env = std::getenv("GAZEBO_TRANSPORT_SHM");
+  return !env || std::string(env) != "0";
+}
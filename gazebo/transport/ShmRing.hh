@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_SHMRING_HH_
+#define GAZEBO_TRANSPORT_SHMRING_HH_
+
+#include <boost/shared_ptr.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    // Forward declare private data classes
+    class ShmDoorbellPrivate;
+    class ShmRingPrivate;
+
+    /// \class ShmDoorbell ShmRing.hh transport/transport.hh
+    /// \brief Semaphore in shared memory. Writers ring the doorbell of the
+    /// reading process after each message, so one thread can wait for all
+    /// the rings of a process.
+    class GZ_TRANSPORT_VISIBLE ShmDoorbell
+    {
+      /// \brief Constructor
+      public: ShmDoorbell();
+
+      /// \brief Destructor. Removes the doorbell if it was created by this
+      /// object.
+      public: virtual ~ShmDoorbell();
+
+      /// \brief Create a new doorbell, replacing any stale one with the
+      /// same name.
+      /// \param[in] _name Name of the shared memory object.
+      /// \return True on success.
+      public: bool Create(const std::string &_name);
+
+      /// \brief Open an existing doorbell.
+      /// \param[in] _name Name of the shared memory object.
+      /// \return True on success.
+      public: bool Open(const std::string &_name);
+
+      /// \brief Get the name of the doorbell.
+      /// \return Name of the shared memory object, empty if not open.
+      public: std::string Name() const;
+
+      /// \brief Wake up the waiting reader.
+      public: void Ring();
+
+      /// \brief Wait until the doorbell rings.
+      /// \param[in] _timeout Maximum time to wait.
+      /// \return False if the wait timed out.
+      public: bool Wait(const common::Time &_timeout);
+
+      /// \brief Consume the pending rings without waiting.
+      public: void Drain();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ShmDoorbellPrivate> dataPtr;
+    };
+
+    /// \class ShmRing ShmRing.hh transport/transport.hh
+    /// \brief Single producer, single consumer queue of serialized messages
+    /// in shared memory. Used in place of a TCP connection between a
+    /// publisher and a subscriber on the same host.
+    ///
+    /// The subscriber creates the ring and reads from it. The publisher
+    /// opens it by name, writes messages and rings the doorbell named in
+    /// the ring. Messages are copied once into the ring and once out of
+    /// it, with no system call on either side. Messages larger than the
+    /// ring are written in fragments, which the reader joins.
+    class GZ_TRANSPORT_VISIBLE ShmRing
+    {
+      /// \brief Constructor
+      public: ShmRing();
+
+      /// \brief Destructor. Closes the ring, and removes it if it was
+      /// created by this object.
+      public: virtual ~ShmRing();
+
+      /// \brief Create a new ring to read from.
+      /// \param[in] _name Name of the shared memory object.
+      /// \param[in] _doorbell Name of the doorbell writers should ring.
+      /// \param[in] _capacity Size of the ring in bytes.
+      /// \return True on success.
+      public: bool Create(const std::string &_name,
+                          const std::string &_doorbell,
+                          const uint64_t _capacity = DefaultCapacity);
+
+      /// \brief Open an existing ring to write to.
+      /// \param[in] _name Name of the shared memory object.
+      /// \return True on success.
+      public: bool Open(const std::string &_name);
+
+      /// \brief Get the name of the ring.
+      /// \return Name of the shared memory object, empty if not open.
+      public: std::string Name() const;
+
+      /// \brief Get the size of the ring.
+      /// \return Capacity in bytes, 0 if not open.
+      public: uint64_t Capacity() const;
+
+      /// \brief Append a message to the ring. Never blocks.
+      /// \param[in] _data Serialized message.
+      /// \return False if the message was not written because the ring is
+      /// closed or doesn't have room for it.
+      public: bool Write(const std::string &_data);
+
+      /// \brief Append a message to the ring, or as much of it as there is
+      /// room for. Never blocks. A message which fits in the ring is written
+      /// whole once there is room for it, a larger one is split into
+      /// fragments. Call again with the same offset to write the rest.
+      /// \param[in] _data Serialized message.
+      /// \param[in,out] _offset Number of bytes of _data already written.
+      /// \return True once the whole message is written.
+      public: bool Write(const std::string &_data, uint64_t &_offset);
+
+      /// \brief Take the oldest message out of the ring.
+      /// \param[out] _data Serialized message.
+      /// \return False if the ring holds no complete message.
+      public: bool Read(std::string &_data);
+
+      /// \brief Tell the writer to stop using the ring.
+      public: void Close();
+
+      /// \brief Check whether the reader closed the ring.
+      /// \return True if the ring is closed or not open.
+      public: bool IsClosed() const;
+
+      /// \brief Check whether shared memory transport is enabled. It can be
+      /// turned off by setting GAZEBO_TRANSPORT_SHM to 0.
+      /// \return True if rings should be offered to same-host publishers.
+      public: static bool Enabled();
+
+      /// \brief Default size of a ring, large enough for a few 1 MB images.
+      /// Pages are only committed as they are written to.
+      public: static const uint64_t DefaultCapacity;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ShmRingPrivate> dataPtr;
+    };
+
+    /// \brief boost shared pointer to transport::ShmRing
+    typedef boost::shared_ptr<ShmRing> ShmRingPtr;
+    /// \}
+  }
+}
+#endif
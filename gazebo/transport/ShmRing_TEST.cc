@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "gazebo/transport/ShmRing.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ShmRing : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(ShmRing, WriteRead)
+{
+  transport::ShmDoorbell doorbell;
+  ASSERT_TRUE(doorbell.Create("gazebo_test_shm_doorbell"));
+
+  transport::ShmRing reader;
+  ASSERT_TRUE(reader.Create("gazebo_test_shm_ring",
+        doorbell.Name(), 64));
+  EXPECT_EQ(reader.Name(), "gazebo_test_shm_ring");
+  EXPECT_EQ(reader.Capacity(), 64u);
+  EXPECT_FALSE(reader.IsClosed());
+
+  transport::ShmRing writer;
+  ASSERT_TRUE(writer.Open(reader.Name()));
+  EXPECT_EQ(writer.Capacity(), 64u);
+
+  std::string data;
+  EXPECT_FALSE(reader.Read(data));
+  EXPECT_FALSE(doorbell.Wait(common::Time(0, 1000000)));
+
+  // Messages come out in order, and wrap around the end of the ring
+  for (int i = 0; i < 20; ++i)
+  {
+    std::string msg = "message " + std::to_string(i);
+    EXPECT_TRUE(writer.Write(msg));
+    EXPECT_TRUE(writer.Write(""));
+    EXPECT_TRUE(doorbell.Wait(common::Time(1, 0)));
+    doorbell.Drain();
+
+    ASSERT_TRUE(reader.Read(data));
+    EXPECT_EQ(data, msg);
+    ASSERT_TRUE(reader.Read(data));
+    EXPECT_TRUE(data.empty());
+    EXPECT_FALSE(reader.Read(data));
+  }
+
+  // Messages which don't fit are refused
+  EXPECT_FALSE(writer.Write(std::string(61, 'x')));
+  EXPECT_TRUE(writer.Write(std::string(60, 'x')));
+  EXPECT_FALSE(writer.Write("x"));
+  ASSERT_TRUE(reader.Read(data));
+  EXPECT_EQ(data.size(), 60u);
+
+  // unless they are written in fragments
+  std::string large;
+  for (int i = 0; i < 200; ++i)
+    large += static_cast<char>('a' + i % 26);
+  uint64_t offset = 0;
+  EXPECT_TRUE(writer.Write("first", offset));
+  EXPECT_EQ(offset, 5u);
+  offset = 0;
+  int writes = 1;
+  bool first = false;
+  while (!writer.Write(large, offset))
+  {
+    ASSERT_LT(++writes, 100);
+
+    // The reader only gets whole messages
+    if (reader.Read(data))
+    {
+      EXPECT_FALSE(first);
+      EXPECT_EQ(data, "first");
+      first = true;
+    }
+  }
+  EXPECT_TRUE(first);
+  EXPECT_GT(writes, 2);
+  EXPECT_EQ(offset, large.size());
+  ASSERT_TRUE(reader.Read(data));
+  EXPECT_EQ(data, large);
+  EXPECT_FALSE(reader.Read(data));
+
+  // The writer stops once the reader closes the ring
+  reader.Close();
+  EXPECT_TRUE(writer.IsClosed());
+  EXPECT_FALSE(writer.Write("x"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmRing, OpenMissing)
+{
+  transport::ShmRing writer;
+  EXPECT_FALSE(writer.Open("gazebo_test_shm_missing"));
+  EXPECT_TRUE(writer.IsClosed());
+  EXPECT_FALSE(writer.Write("x"));
+
+  // Ring naming a doorbell which doesn't exist
+  transport::ShmRing reader;
+  ASSERT_TRUE(reader.Create("gazebo_test_shm_ring", "gazebo_test_shm_none"));
+  EXPECT_EQ(reader.Capacity(), transport::ShmRing::DefaultCapacity);
+  EXPECT_FALSE(writer.Open(reader.Name()));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmRing, CorruptFrame)
+{
+  transport::ShmDoorbell doorbell;
+  ASSERT_TRUE(doorbell.Create("gazebo_test_shm_doorbell"));
+
+  transport::ShmRing reader;
+  ASSERT_TRUE(reader.Create("gazebo_test_shm_ring", doorbell.Name(), 64));
+
+  transport::ShmRing writer;
+  ASSERT_TRUE(writer.Open(reader.Name()));
+  ASSERT_TRUE(writer.Write("marker"));
+
+  // Another process overwrites the size of the frame
+  boost::interprocess::shared_memory_object shm(
+      boost::interprocess::open_only, reader.Name().c_str(),
+      boost::interprocess::read_write);
+  boost::interprocess::mapped_region region(shm,
+      boost::interprocess::read_write);
+  char *begin = static_cast<char *>(region.get_address());
+  char *end = begin + region.get_size();
+  char *marker = std::search(begin, end, "marker", "marker" + 6);
+  ASSERT_NE(marker, end);
+  uint32_t size = 1000;
+  std::memcpy(marker - sizeof(size), &size, sizeof(size));
+
+  // The frame is refused and the ring emptied
+  std::string data;
+  EXPECT_FALSE(reader.Read(data));
+  EXPECT_FALSE(reader.Read(data));
+
+  // and can be used again
+  EXPECT_TRUE(writer.Write("next"));
+  ASSERT_TRUE(reader.Read(data));
+  EXPECT_EQ(data, "next");
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmRing, Threads)
+{
+  transport::ShmDoorbell doorbell;
+  ASSERT_TRUE(doorbell.Create("gazebo_test_shm_doorbell"));
+
+  transport::ShmRing reader;
+  ASSERT_TRUE(reader.Create("gazebo_test_shm_ring", doorbell.Name(), 4096));
+
+  const int count = 100000;
+  std::thread writerThread([&]()
+  {
+    transport::ShmRing writer;
+    ASSERT_TRUE(writer.Open("gazebo_test_shm_ring"));
+    for (int i = 0; i < count; ++i)
+    {
+      std::string msg = std::to_string(i);
+      while (!writer.Write(msg))
+        std::this_thread::yield();
+    }
+  });
+
+  std::string data;
+  int next = 0;
+  while (next < count)
+  {
+    if (!reader.Read(data))
+    {
+      doorbell.Wait(common::Time(0, 10000000));
+      continue;
+    }
+    ASSERT_EQ(data, std::to_string(next));
+    ++next;
+  }
+  writerThread.join();
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -23,7 +23,9 @@
 
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
+#include "gazebo/common/Console.hh"
 #include "gazebo/transport/ConnectionManager.hh"
+#include "gazebo/transport/ShmManager.hh"
 #include "gazebo/transport/SubscriptionTransport.hh"
 
 using namespace gazebo;
@@ -39,6 +41,7 @@ SubscriptionTransport::SubscriptionTransport()
 //////////////////////////////////////////////////
 SubscriptionTransport::~SubscriptionTransport()
 {
+  ShmManager::Instance()->RemoveRing(this->ring);
   ConnectionManager::Instance()->RemoveConnection(this->connection);
   this->connection.reset();
 }
@@ -50,22 +53,84 @@ void SubscriptionTransport::Init(ConnectionPtr _conn, bool _latching)
   this->latching = _latching;
 }
 
+//////////////////////////////////////////////////
+bool SubscriptionTransport::InitRing(const std::string &_name)
+{
+  ShmRingPtr newRing(new ShmRing());
+  if (!newRing->Open(_name))
+    return false;
+
+  ShmManager::Instance()->RemoveRing(this->ring);
+  this->ring = newRing;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SubscriptionTransport::SetCompression(const CompressionCodec _codec,
+    const uint32_t _threshold)
+{
+  this->codec = _codec;
+  this->compressionThreshold = _threshold;
+}
+
+//////////////////////////////////////////////////
+CompressionCodec SubscriptionTransport::Codec() const
+{
+  return this->codec;
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::UsesRing() const
+{
+  return this->ring && !this->ring->IsClosed();
+}
+
 //////////////////////////////////////////////////
 bool SubscriptionTransport::HandleMessage(MessagePtr _newMsg)
 {
-  std::string data;
-  _newMsg->SerializeToString(&data);
-  return this->HandleData(data, boost::bind(&dummy_callback_fn, _1), 0);
+  BufferPtr buffer(new std::string);
+  _newMsg->SerializeToString(buffer.get());
+  CompressedData data(buffer);
+  return this->HandleSerializedData(data,
+      boost::bind(&dummy_callback_fn, _1), 0);
 }
 
 //////////////////////////////////////////////////
 bool SubscriptionTransport::HandleData(const std::string &_newdata,
     boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  CompressedData data(BufferPtr(new std::string(_newdata)));
+  return this->HandleSerializedData(data, _cb, _id);
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::HandleSerializedData(CompressedData &_data,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
 {
   bool result = false;
   if (this->connection->IsOpen())
   {
-    this->connection->EnqueueMsg(_newdata, _cb, _id);
+    // Messages to a subscriber with a ring only go through the ring. If
+    // some went through the connection they could overtake the ones in
+    // the ring, and reach the subscriber on two threads at once. Messages
+    // which don't fit yet wait for room, and _cb is called once they are
+    // in the ring.
+    if (this->UsesRing())
+    {
+      CompressionCodec codec = CompressionCodec::NONE;
+      ShmManager::Instance()->Write(this->ring,
+          _data.Payload(codec, this->compressionThreshold), _cb, _id);
+    }
+    else
+    {
+      // The codec is carried by binary frame headers only
+      CompressionCodec frameCodec = this->connection->FrameVersion() > 0 ?
+        this->codec : CompressionCodec::NONE;
+      const BufferPtr &payload =
+        _data.Payload(frameCodec, this->compressionThreshold);
+      this->connection->EnqueueMsg(payload, _cb, _id,
+          static_cast<uint8_t>(frameCodec));
+    }
     result = true;
   }
   else
@@ -19,10 +19,12 @@
 
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
+#include <cstdint>
 #include <string>
 
 #include "Connection.hh"
 #include "CallbackHelper.hh"
+#include "ShmRing.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -50,6 +52,31 @@ namespace gazebo
       /// don't latch
       public: void Init(ConnectionPtr _conn, bool _latching);
 
+      /// \brief Send messages through a shared memory ring created by the
+      /// subscriber instead of the connection, so that the subscriber gets
+      /// them in order and on a single thread. Messages which don't fit
+      /// wait for the subscriber to make room, see ShmManager::Write.
+      /// \param[in] _name Name of the ring.
+      /// \return True if the ring was opened.
+      public: bool InitRing(const std::string &_name);
+
+      /// \brief Compress the messages sent through the connection, as
+      /// requested by the subscriber. The connection must use binary frame
+      /// headers, which carry the codec.
+      /// \param[in] _codec Codec to use, NONE to send uncompressed.
+      /// \param[in] _threshold Size from which messages are compressed.
+      public: void SetCompression(const CompressionCodec _codec,
+                  const uint32_t _threshold);
+
+      /// \brief Get the codec of the messages sent through the connection.
+      /// \return The codec, NONE if messages are sent uncompressed.
+      public: CompressionCodec Codec() const;
+
+      /// \brief Check whether messages go through shared memory.
+      /// \return True if a ring is open and has not been closed by the
+      /// subscriber.
+      public: bool UsesRing() const;
+
       /// \brief Output a message to a connection
       /// \param[in] _newdata The message to be handled
       /// \return true if the message was handled successfully, false otherwise
@@ -59,6 +86,10 @@ namespace gazebo
       public: virtual bool HandleData(const std::string &_newdata,
                   boost::function<void(uint32_t)> _cb, uint32_t _id);
 
+      // Documentation inherited
+      public: virtual bool HandleSerializedData(CompressedData &_data,
+                  boost::function<void(uint32_t)> _cb, uint32_t _id);
+
       // Documentation inherited
       public: virtual bool HandleMessage(MessagePtr _newMsg);
 
@@ -72,6 +103,16 @@ namespace gazebo
       public: virtual bool IsLocal() const;
 
       private: ConnectionPtr connection;
+
+      /// \brief Shared memory ring to the subscriber, null if messages only
+      /// go through the connection.
+      private: ShmRingPtr ring;
+
+      /// \brief Codec of the messages sent through the connection.
+      private: CompressionCodec codec = CompressionCodec::NONE;
+
+      /// \brief Size from which messages are compressed.
+      private: uint32_t compressionThreshold = Compression::DefaultThreshold;
     };
     /// \}
   }
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "gazebo/transport/ShmRing.hh"
+#include "gazebo/transport/SubscriptionTransport.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SubscriptionTransport : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+// A subscriber with a ring gets all its messages in order, through the ring
+// only, even while the ring is full.
+TEST_F(SubscriptionTransport, RingOrder)
+{
+  // Messages only go out while the connection is open
+  transport::ConnectionPtr server(new transport::Connection());
+  server->Listen(11349, [](const transport::ConnectionPtr &) {});
+  transport::ConnectionPtr client(new transport::Connection());
+  ASSERT_TRUE(client->Connect("127.0.0.1", 11349));
+
+  transport::ShmDoorbell doorbell;
+  ASSERT_TRUE(doorbell.Create("gazebo_test_shm_doorbell"));
+  transport::ShmRing reader;
+  ASSERT_TRUE(reader.Create("gazebo_test_shm_ring", doorbell.Name(), 256));
+
+  transport::SubscriptionTransport link;
+  link.Init(client, false);
+  ASSERT_TRUE(link.InitRing(reader.Name()));
+  EXPECT_TRUE(link.UsesRing());
+
+  // Publish much faster than the subscriber reads
+  const int count = 20000;
+  std::atomic<int> written(0);
+  boost::function<void(uint32_t)> cb = [&](uint32_t) {++written;};
+  std::thread publisher([&]()
+  {
+    for (int i = 0; i < count; ++i)
+      EXPECT_TRUE(link.HandleData(std::to_string(i), cb, 0));
+
+    // Larger than the ring
+    EXPECT_TRUE(link.HandleData(std::string(1024, '9'), cb, 0));
+  });
+
+  std::string data;
+  int last = -1;
+  int received = 0;
+  while (received < count + 1)
+  {
+    if (!reader.Read(data))
+    {
+      doorbell.Wait(common::Time(0, 1000000));
+      continue;
+    }
+    if (received == count)
+    {
+      EXPECT_EQ(data, std::string(1024, '9'));
+    }
+    else
+    {
+      int value = std::stoi(data);
+      ASSERT_EQ(value, last + 1);
+      last = value;
+    }
+    ++received;
+    if (received % 16 == 0)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  publisher.join();
+
+  // Nothing is dropped, and the publisher is told once each message is in
+  // the ring
+  EXPECT_EQ(received, count + 1);
+  EXPECT_EQ(written, count + 1);
+  EXPECT_FALSE(reader.Read(data));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
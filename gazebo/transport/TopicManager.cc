@@ -21,9 +21,6 @@
   #include <Winsock2.h>
 #endif
 
-#include <tbb/parallel_for.h>
-#include <tbb/blocked_range.h>
-
 #include <boost/function.hpp>
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/Node.hh"
@@ -33,29 +30,6 @@
 using namespace gazebo;
 using namespace transport;
 
-/// \brief Class to facilitate parallel processing of nodes.
-class NodeProcess_TBB
-{
-  /// \brief Constructor.
-  /// \param[in] _nodes List of nodes to process.
-  public: explicit NodeProcess_TBB(std::vector<NodePtr> *_nodes)
-          : nodes(_nodes) {}
-
-  /// \brief Used by TBB during parallel execution.
-  /// \param[in] _r Range within this->nodes to process.
-  public: void operator() (const tbb::blocked_range<size_t> &_r) const
-  {
-    for (size_t i = _r.begin(); i != _r.end(); i++)
-    {
-      (*this->nodes)[i]->ProcessPublishers();
-    }
-  }
-
-  /// \brief The list of nodes to process.
-  private: std::vector<NodePtr> *nodes;
-};
-
-
 //////////////////////////////////////////////////
 TopicManager::TopicManager()
 {
@@ -148,11 +122,87 @@ void TopicManager::RemoveNode(unsigned int _id)
 //////////////////////////////////////////////////
 void TopicManager::AddNodeToProcess(NodePtr _ptr)
 {
-  if (_ptr)
+  if (!_ptr)
+    return;
+
+  // Outgoing messages have their own strand, so that slow subscribers
+  // of the node don't hold them back. A node waiting to be processed
+  // sends all its publishers at once.
+  unsigned int id = _ptr->GetId();
   {
     boost::mutex::scoped_lock lock(this->processNodesMutex);
+    if (this->nodesToSend.count(id))
+      return;
+    this->nodesToSend.insert(id);
+  }
+
+  boost::weak_ptr<Node> node(_ptr);
+  if (this->dispatchPool.Post(static_cast<uint64_t>(id) * 2 + 1,
+        [this, node, id]()
+        {
+          {
+            boost::mutex::scoped_lock lock(this->processNodesMutex);
+            this->nodesToSend.erase(id);
+          }
+          NodePtr n = node.lock();
+          if (n)
+            n->ProcessPublishers();
+        }))
+  {
+    return;
+  }
+
+  {
+    boost::mutex::scoped_lock lock(this->processNodesMutex);
+    this->nodesToSend.erase(id);
     this->nodesToProcess.insert(_ptr);
   }
+
+  // Tell the connection manager that it needs to update
+  ConnectionManager::Instance()->TriggerUpdate();
+}
+
+//////////////////////////////////////////////////
+void TopicManager::StartDispatch()
+{
+  this->dispatchPool.Start(DispatchPool::DefaultThreadCount());
+  if (!this->dispatchPool.Running())
+    return;
+
+  // Messages may have arrived before the threads started
+  boost::recursive_mutex::scoped_lock lock(this->nodeMutex);
+  for (auto &node : this->nodes)
+    this->DispatchIncoming(node);
+}
+
+//////////////////////////////////////////////////
+void TopicManager::StopDispatch()
+{
+  this->dispatchPool.Stop();
+}
+
+//////////////////////////////////////////////////
+bool TopicManager::DispatchRunning() const
+{
+  return this->dispatchPool.Running();
+}
+
+//////////////////////////////////////////////////
+bool TopicManager::DispatchIncoming(NodePtr _node)
+{
+  // Paused messages stay with the node, which is dispatched again on
+  // resume
+  if (this->pauseIncoming)
+    return this->dispatchPool.Running();
+
+  boost::weak_ptr<Node> node(_node);
+  return this->dispatchPool.Post(static_cast<uint64_t>(_node->GetId()) * 2,
+      [this, node]()
+      {
+        NodePtr n = node.lock();
+        if (n && !this->pauseIncoming)
+          n->ProcessIncoming();
+      });
 }
 
 //////////////////////////////////////////////////
@@ -169,28 +219,8 @@ void TopicManager::ProcessNodes(bool _onlyOut)
     this->nodesToProcess.clear();
   }
 
-  // Note: In general there are very few nodes. So, parallelization is not
-  // needed. Keeping this code for posterity.
-  // int s;
-  // {
-  //   boost::recursive_mutex::scoped_lock lock(this->nodeMutex);
-  //   // store as size might change (spawning)
-  //   s = this->nodes.size();
-  // }
-  // Process nodes in parallel
-  // try
-  // {
-  //   boost::mutex::scoped_lock lock(this->processNodesMutex);
-  //   tbb::parallel_for(tbb::blocked_range<size_t>(0, this->nodes.size(), 10),
-  //       NodeProcess_TBB(&this->nodes));
-  // }
-  // catch(...)
-  // {
-  //   /// Failed to process the nodes this time around. But not to
-  //   /// worry. This function is called again.
-  // }
-
-  if (!this->pauseIncoming && !_onlyOut)
+  // The dispatch threads call the subscribers as messages arrive
+  if (!this->pauseIncoming && !_onlyOut && !this->dispatchPool.Running())
   {
     {
       int s = 0;
@@ -456,4 +486,11 @@ void TopicManager::ClearBuffers()
 void TopicManager::PauseIncoming(bool _pause)
 {
   this->pauseIncoming = _pause;
+
+  if (!this->pauseIncoming && this->dispatchPool.Running())
+  {
+    boost::recursive_mutex::scoped_lock lock(this->nodeMutex);
+    for (auto &node : this->nodes)
+      this->DispatchIncoming(node);
+  }
 }
@@ -19,6 +19,7 @@
 
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
+#include <atomic>
 #include <map>
 #include <list>
 #include <string>
@@ -35,6 +36,7 @@
 #include "gazebo/transport/SubscriptionTransport.hh"
 #include "gazebo/transport/PublicationTransport.hh"
 #include "gazebo/transport/ConnectionManager.hh"
+#include "gazebo/transport/DispatchPool.hh"
 #include "gazebo/transport/Publisher.hh"
 #include "gazebo/transport/Publication.hh"
 #include "gazebo/transport/Subscriber.hh"
@@ -98,16 +100,18 @@ namespace gazebo
       /// to queue
       /// \param[in] _hz Update rate for the publisher. Units are
       /// 1.0/seconds.
+      /// \param[in] _conflate Keep only the latest outgoing message.
       /// \return Pointer to the newly created Publisher
       public: PublisherPtr Advertise(const std::string &_topic,
                                      const std::string &_msgTypeName,
                                      unsigned int _queueLimit,
-                                     double _hzRate)
+                                     double _hzRate,
+                                     bool _conflate = false)
               {
                 this->UpdatePublications(_topic, _msgTypeName);
 
                 PublisherPtr pub = PublisherPtr(new Publisher(_topic,
-                      _msgTypeName, _queueLimit, _hzRate));
+                      _msgTypeName, _queueLimit, _hzRate, _conflate));
 
                 // Connect all local subscription to the publisher
                 PublicationPtr publication = this->FindPublication(_topic);
@@ -144,11 +148,13 @@ namespace gazebo
       /// to queue
       /// \param[in] _hz Update rate for the publisher. Units are
       /// 1.0/seconds.
+      /// \param[in] _conflate Keep only the latest outgoing message.
       /// \return Pointer to the newly created Publisher
       public: template<typename M>
               PublisherPtr Advertise(const std::string &_topic,
                                      unsigned int _queueLimit,
-                                     double _hzRate)
+                                     double _hzRate,
+                                     bool _conflate = false)
               {
                 google::protobuf::Message *msg = nullptr;
                 M msgtype;
@@ -157,7 +163,7 @@ namespace gazebo
                   gzthrow("Advertise requires a google protobuf type");
 
                 return this->Advertise(_topic, msg->GetTypeName(), _queueLimit,
-                        _hzRate);
+                        _hzRate, _conflate);
               }
 
       /// \brief Unadvertise a topic
@@ -237,9 +243,31 @@ namespace gazebo
       public: void PauseIncoming(bool _pause);
 
       /// \brief Add a node to the list of nodes that requires processing.
+      /// Its publishers are sent right away on the dispatch threads when
+      /// they run, otherwise on the next update of the ConnectionManager.
       /// \param[in] _ptr Node to process.
       public: void AddNodeToProcess(NodePtr _ptr);
 
+      /// \brief Start the threads which call the subscribers of each node
+      /// as soon as messages arrive, in order for each node. Until then,
+      /// and after StopDispatch, the ConnectionManager update calls them.
+      /// \sa DispatchPool::DefaultThreadCount
+      public: void StartDispatch();
+
+      /// \brief Deliver the messages already dispatched, and stop the
+      /// dispatch threads.
+      public: void StopDispatch();
+
+      /// \brief Get whether the dispatch threads are running.
+      /// \return True if nodes are processed by the dispatch threads.
+      public: bool DispatchRunning() const;
+
+      /// \brief Call the subscribers of a node on the dispatch threads.
+      /// Nothing is dispatched while incoming messages are paused.
+      /// \param[in] _node Node with new incoming messages.
+      /// \return False if the dispatch threads aren't running.
+      public: bool DispatchIncoming(NodePtr _node);
+
       /// \brief A map of string->list of Node pointers
       typedef std::map<std::string, std::list<NodePtr> > SubNodeMap;
 
@@ -252,6 +280,10 @@ namespace gazebo
       /// \brief Nodes that require processing.
       private: boost::unordered_set<NodePtr> nodesToProcess;
 
+      /// \brief Ids of the nodes waiting for the dispatch threads to send
+      /// their publishers.
+      private: boost::unordered_set<unsigned int> nodesToSend;
+
       private: boost::recursive_mutex nodeMutex;
 
       /// \brief Used to protect subscription connection creation.
@@ -260,7 +292,11 @@ namespace gazebo
       /// \brief Mutex to protect node processing
       private: boost::mutex processNodesMutex;
 
-      private: bool pauseIncoming;
+      private: std::atomic<bool> pauseIncoming;
+
+      /// \brief Threads calling the subscribers and sending the messages
+      /// of the nodes.
+      private: DispatchPool dispatchPool;
 
       // Singleton implementation
       private: friend class SingletonT<TopicManager>;
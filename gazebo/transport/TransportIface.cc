@@ -30,6 +30,7 @@
 #include "gazebo/transport/Publisher.hh"
 #include "gazebo/transport/Subscriber.hh"
 #include "gazebo/transport/ConnectionManager.hh"
+#include "gazebo/transport/ShmManager.hh"
 #include "gazebo/transport/TransportIface.hh"
 
 using namespace gazebo;
@@ -146,6 +147,7 @@ void transport::fini()
   }
   transport::TopicManager::Instance()->Fini();
   transport::ConnectionManager::Instance()->Fini();
+  transport::ShmManager::Instance()->Fini();
 }
 
 /////////////////////////////////////////////////
@@ -0,0 +1,456 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef _WIN32
+  // Ensure that Winsock2.h is included before Windows.h, which can get
+  // pulled in by anybody (e.g., Boost).
+  #include <Winsock2.h>
+  #include <process.h>
+  #define getpid _getpid
+#else
+  #include <unistd.h>
+#endif
+
+#include <boost/asio/ip/host_name.hpp>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/transport/Publisher.hh"
+#include "gazebo/transport/TopicManager.hh"
+#include "gazebo/transport/TransportStatistics.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+const std::string TransportStatistics::TopicName = "/gazebo/transport/stats";
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Private data for TransportStatistics.
+    class TransportStatisticsPrivate
+    {
+      /// \brief Protects the members.
+      public: mutable std::mutex mutex;
+
+      /// \brief Stats of each topic, by name.
+      public: std::unordered_map<std::string, TopicStatsPtr> byTopic;
+
+      /// \brief Stats of each topic, in the order they were created.
+      public: std::vector<TopicStatsPtr> stats;
+
+      /// \brief Counters of each topic at the previous Fill.
+      public: std::unordered_map<const TopicStats *, TopicStatsSample>
+              previous;
+
+      /// \brief Time of the previous Fill.
+      public: std::chrono::steady_clock::time_point lastFill;
+
+      /// \brief Time of the previous publication.
+      public: std::chrono::steady_clock::time_point lastUpdate;
+
+      /// \brief Publisher of the statistics, advertised on the first
+      /// update.
+      public: PublisherPtr publisher;
+
+      /// \brief Host name and process id.
+      public: std::string process;
+
+      /// \brief Whether the statistics have subscribers.
+      public: std::atomic<bool> active{false};
+    };
+
+    /// \internal
+    /// \brief Fields of a message type which can hold its time stamp.
+    class TopicStatsStamp
+    {
+      /// \brief Field holding a msgs::Header, or null.
+      public: const google::protobuf::FieldDescriptor *header = nullptr;
+
+      /// \brief Top level msgs::Time fields, in the order they are looked
+      /// at.
+      public: std::vector<const google::protobuf::FieldDescriptor *> times;
+
+      /// \brief The message type.
+      public: const google::protobuf::Descriptor *type = nullptr;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert a duration to nanoseconds.
+/// \param[in] _time The duration.
+/// \return Nanoseconds.
+static uint64_t ToNs(const std::chrono::steady_clock::duration &_time)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(_time).count();
+}
+
+/////////////////////////////////////////////////
+/// \brief Raise an atomic value to at least another one.
+/// \param[in,out] _max Value to raise.
+/// \param[in] _value New candidate.
+template<typename T>
+static void AtomicMax(std::atomic<T> &_max, const T _value)
+{
+  T current = _max.load(std::memory_order_relaxed);
+  while (current < _value &&
+         !_max.compare_exchange_weak(current, _value,
+           std::memory_order_relaxed))
+  {
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get a singular sub-message field of a message type.
+/// \param[in] _type The message type.
+/// \param[in] _name Name of the field.
+/// \param[in] _fieldType Type of the field.
+/// \return The field, or null if the message type doesn't have it.
+static const google::protobuf::FieldDescriptor *FindField(
+    const google::protobuf::Descriptor *_type, const std::string &_name,
+    const google::protobuf::Descriptor *_fieldType)
+{
+  const google::protobuf::FieldDescriptor *field =
+    _type->FindFieldByName(_name);
+  if (!field || field->is_repeated() || field->message_type() != _fieldType)
+    return nullptr;
+  return field;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the time stamp fields of a message type, looking them up
+/// once per type.
+/// \param[in] _type The message type.
+/// \return The fields, which live as long as the process.
+static const TopicStatsStamp *FindStampFields(
+    const google::protobuf::Descriptor *_type)
+{
+  static std::mutex mutex;
+  static std::unordered_map<const google::protobuf::Descriptor *,
+    std::unique_ptr<TopicStatsStamp>> stamps;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  std::unique_ptr<TopicStatsStamp> &stamp = stamps[_type];
+  if (!stamp)
+  {
+    stamp.reset(new TopicStatsStamp);
+    stamp->type = _type;
+    stamp->header = FindField(_type, "header", msgs::Header::descriptor());
+    for (auto const &name : {"stamp", "time"})
+    {
+      const google::protobuf::FieldDescriptor *field =
+        FindField(_type, name, msgs::Time::descriptor());
+      if (field)
+        stamp->times.push_back(field);
+    }
+  }
+  return stamp.get();
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the time stamp of a message, in its header or in a top
+/// level time field.
+/// \param[in] _msg The message.
+/// \param[in] _stamp Time stamp fields of the message type.
+/// \return The time stamp, or null if the message has none.
+static const msgs::Time *FindStamp(const google::protobuf::Message &_msg,
+    const TopicStatsStamp &_stamp)
+{
+  // The field types were checked against the generated messages
+  const google::protobuf::Reflection *reflection = _msg.GetReflection();
+  if (_stamp.header && reflection->HasField(_msg, _stamp.header))
+  {
+    const msgs::Header &header = static_cast<const msgs::Header &>(
+        reflection->GetMessage(_msg, _stamp.header));
+    return header.has_stamp() ? &header.stamp() : nullptr;
+  }
+
+  for (auto const &field : _stamp.times)
+  {
+    if (reflection->HasField(_msg, field))
+    {
+      return &static_cast<const msgs::Time &>(
+          reflection->GetMessage(_msg, field));
+    }
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+TopicStats::TopicStats(const std::string &_topic,
+    const std::atomic<bool> *_active)
+  : topic(_topic), active(_active), stamp(nullptr), published(0),
+    serialized(0), sentBytes(0), serializeNs(0), received(0),
+    receivedBytes(0), parsed(0), parseNs(0), dropped(0), latencyCount(0),
+    latencyNs(0), maxLatencyNs(0), queueHighWater(0)
+{
+}
+
+/////////////////////////////////////////////////
+const std::string &TopicStats::Topic() const
+{
+  return this->topic;
+}
+
+/////////////////////////////////////////////////
+bool TopicStats::Active() const
+{
+  return !this->active || this->active->load(std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+void TopicStats::RecordPublish()
+{
+  this->published.fetch_add(1, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+void TopicStats::RecordSend(const uint64_t _bytes,
+    const std::chrono::steady_clock::duration &_time)
+{
+  this->serialized.fetch_add(1, std::memory_order_relaxed);
+  this->sentBytes.fetch_add(_bytes, std::memory_order_relaxed);
+  this->serializeNs.fetch_add(ToNs(_time), std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+void TopicStats::RecordReceive(const uint64_t _bytes)
+{
+  this->received.fetch_add(1, std::memory_order_relaxed);
+  this->receivedBytes.fetch_add(_bytes, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+void TopicStats::RecordParse(const google::protobuf::Message &_msg,
+    const std::chrono::steady_clock::duration &_time)
+{
+  this->parsed.fetch_add(1, std::memory_order_relaxed);
+  this->parseNs.fetch_add(ToNs(_time), std::memory_order_relaxed);
+  this->RecordLatency(_msg);
+}
+
+/////////////////////////////////////////////////
+void TopicStats::RecordLatency(const google::protobuf::Message &_msg)
+{
+  // A topic almost always carries a single message type
+  const TopicStatsStamp *fields = this->stamp.load(std::memory_order_acquire);
+  if (!fields || fields->type != _msg.GetDescriptor())
+  {
+    fields = FindStampFields(_msg.GetDescriptor());
+    this->stamp.store(fields, std::memory_order_release);
+  }
+
+  const msgs::Time *stamp = FindStamp(_msg, *fields);
+  if (!stamp)
+    return;
+
+  common::Time latency = common::Time::GetWallTime() -
+    msgs::Convert(*stamp);
+
+  // Many publishers stamp their messages with simulation time, which says
+  // nothing about the delivery time
+  if (latency < common::Time::Zero || latency > common::Time(60, 0))
+    return;
+
+  uint64_t ns = static_cast<uint64_t>(latency.sec) * 1000000000u +
+    latency.nsec;
+  this->latencyCount.fetch_add(1, std::memory_order_relaxed);
+  this->latencyNs.fetch_add(ns, std::memory_order_relaxed);
+  AtomicMax(this->maxLatencyNs, ns);
+}
+
+/////////////////////////////////////////////////
+void TopicStats::RecordQueueDepth(const uint32_t _depth)
+{
+  AtomicMax(this->queueHighWater, _depth);
+}
+
+/////////////////////////////////////////////////
+void TopicStats::RecordDrops(const uint64_t _count)
+{
+  this->dropped.fetch_add(_count, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+TopicStatsSample TopicStats::Sample()
+{
+  TopicStatsSample sample;
+  sample.published = this->published.load(std::memory_order_relaxed);
+  sample.serialized = this->serialized.load(std::memory_order_relaxed);
+  sample.sentBytes = this->sentBytes.load(std::memory_order_relaxed);
+  sample.serializeNs = this->serializeNs.load(std::memory_order_relaxed);
+  sample.received = this->received.load(std::memory_order_relaxed);
+  sample.receivedBytes = this->receivedBytes.load(std::memory_order_relaxed);
+  sample.parsed = this->parsed.load(std::memory_order_relaxed);
+  sample.parseNs = this->parseNs.load(std::memory_order_relaxed);
+  sample.dropped = this->dropped.load(std::memory_order_relaxed);
+  sample.latencyCount = this->latencyCount.load(std::memory_order_relaxed);
+  sample.latencyNs = this->latencyNs.load(std::memory_order_relaxed);
+  sample.maxLatencyNs = this->maxLatencyNs.exchange(0);
+  sample.queueHighWater = this->queueHighWater.exchange(0);
+  return sample;
+}
+
+/////////////////////////////////////////////////
+TransportStatistics::TransportStatistics()
+  : dataPtr(new TransportStatisticsPrivate)
+{
+  this->dataPtr->lastFill = std::chrono::steady_clock::now();
+  this->dataPtr->lastUpdate = this->dataPtr->lastFill;
+  this->dataPtr->process =
+    boost::asio::ip::host_name() + ":" + std::to_string(getpid());
+}
+
+/////////////////////////////////////////////////
+TransportStatistics::~TransportStatistics()
+{
+}
+
+/////////////////////////////////////////////////
+TopicStatsPtr TransportStatistics::Stats(const std::string &_topic)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  TopicStatsPtr &stats = this->dataPtr->byTopic[_topic];
+  if (!stats)
+  {
+    stats.reset(new TopicStats(_topic, &this->dataPtr->active));
+    this->dataPtr->stats.push_back(stats);
+  }
+  return stats;
+}
+
+/////////////////////////////////////////////////
+std::vector<TopicStatsPtr> TransportStatistics::AllStats() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->stats;
+}
+
+/////////////////////////////////////////////////
+void TransportStatistics::Fill(msgs::TransportStatistics &_msg)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  auto now = std::chrono::steady_clock::now();
+  double period = std::chrono::duration<double>(
+      now - this->dataPtr->lastFill).count();
+  this->dataPtr->lastFill = now;
+
+  msgs::Set(_msg.mutable_stamp(), common::Time::GetWallTime());
+  _msg.set_process(this->dataPtr->process);
+  _msg.set_period(period);
+  _msg.clear_topic();
+
+  if (period <= 0)
+    return;
+
+  for (auto const &stats : this->dataPtr->stats)
+  {
+    TopicStatsSample sample = stats->Sample();
+    TopicStatsSample &prev = this->dataPtr->previous[stats.get()];
+
+    uint64_t published = sample.published - prev.published;
+    uint64_t serialized = sample.serialized - prev.serialized;
+    uint64_t received = sample.received - prev.received;
+    uint64_t parsed = sample.parsed - prev.parsed;
+    uint64_t dropped = sample.dropped - prev.dropped;
+    uint64_t latencies = sample.latencyCount - prev.latencyCount;
+
+    // Only topics with activity over the period are reported
+    if (published || serialized || received || parsed || dropped ||
+        sample.queueHighWater > 0)
+    {
+      msgs::TransportStatistics::TopicStatistics *topicMsg =
+        _msg.add_topic();
+      topicMsg->set_topic(stats->Topic());
+      topicMsg->set_publish_rate(published / period);
+      topicMsg->set_send_bandwidth(
+          (sample.sentBytes - prev.sentBytes) / period);
+      topicMsg->set_receive_rate(received / period);
+      topicMsg->set_receive_bandwidth(
+          (sample.receivedBytes - prev.receivedBytes) / period);
+      topicMsg->set_queue_high_water(sample.queueHighWater);
+      topicMsg->set_dropped(dropped);
+      if (serialized > 0)
+      {
+        topicMsg->set_serialize_time(
+            (sample.serializeNs - prev.serializeNs) * 1e-9 / serialized);
+      }
+      if (parsed > 0)
+      {
+        topicMsg->set_parse_time(
+            (sample.parseNs - prev.parseNs) * 1e-9 / parsed);
+      }
+      if (latencies > 0)
+      {
+        topicMsg->set_latency(
+            (sample.latencyNs - prev.latencyNs) * 1e-9 / latencies);
+        topicMsg->set_max_latency(sample.maxLatencyNs * 1e-9);
+      }
+    }
+
+    prev = sample;
+  }
+}
+
+/////////////////////////////////////////////////
+void TransportStatistics::Update()
+{
+  auto now = std::chrono::steady_clock::now();
+  PublisherPtr publisher;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (now - this->dataPtr->lastUpdate < std::chrono::seconds(1))
+      return;
+    this->dataPtr->lastUpdate = now;
+    publisher = this->dataPtr->publisher;
+  }
+
+  // Advertised without the lock, the new publisher gets its own stats
+  if (!publisher)
+  {
+    publisher = TopicManager::Instance()->Advertise<msgs::TransportStatistics>(
+        TopicName, 1, 0, true);
+
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->publisher = publisher;
+  }
+
+  // Filled even without subscribers, so that the first message a new
+  // subscriber gets covers a single period
+  msgs::TransportStatistics msg;
+  this->Fill(msg);
+
+  // Subscribers only record parse times and latencies while someone
+  // listens
+  bool connected = publisher->HasConnections();
+  this->dataPtr->active = connected;
+  if (connected)
+    publisher->Publish(msg, true);
+}
+
+/////////////////////////////////////////////////
+void TransportStatistics::Fini()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->publisher.reset();
+}
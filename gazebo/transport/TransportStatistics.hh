@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_TRANSPORTSTATISTICS_HH_
+#define GAZEBO_TRANSPORT_TRANSPORTSTATISTICS_HH_
+
+#include <google/protobuf/message.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_TRANSPORT_VISIBLE, gazebo, transport,
+    TransportStatistics)
+
+namespace gazebo
+{
+  namespace transport
+  {
+    // Forward declare private data classes
+    class TransportStatisticsPrivate;
+    class TopicStatsStamp;
+
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \class TopicStatsSample TransportStatistics.hh transport/transport.hh
+    /// \brief Counters of a topic read at one point in time. Counts and
+    /// times are totals since the topic was first used.
+    class GZ_TRANSPORT_VISIBLE TopicStatsSample
+    {
+      /// \brief Messages published in this process.
+      public: uint64_t published = 0;
+
+      /// \brief Messages serialized for remote subscribers.
+      public: uint64_t serialized = 0;
+
+      /// \brief Bytes serialized for remote subscribers.
+      public: uint64_t sentBytes = 0;
+
+      /// \brief Total time spent serializing, in nanoseconds.
+      public: uint64_t serializeNs = 0;
+
+      /// \brief Messages received from remote publishers.
+      public: uint64_t received = 0;
+
+      /// \brief Bytes received from remote publishers.
+      public: uint64_t receivedBytes = 0;
+
+      /// \brief Messages parsed for subscriber callbacks.
+      public: uint64_t parsed = 0;
+
+      /// \brief Total time spent parsing, in nanoseconds.
+      public: uint64_t parseNs = 0;
+
+      /// \brief Outgoing messages dropped.
+      public: uint64_t dropped = 0;
+
+      /// \brief Messages with a latency measured from their time stamp.
+      public: uint64_t latencyCount = 0;
+
+      /// \brief Total latency, in nanoseconds.
+      public: uint64_t latencyNs = 0;
+
+      /// \brief Longest latency since the previous sample, in nanoseconds.
+      public: uint64_t maxLatencyNs = 0;
+
+      /// \brief Largest outgoing queue since the previous sample.
+      public: uint32_t queueHighWater = 0;
+    };
+
+    /// \class TopicStats TransportStatistics.hh transport/transport.hh
+    /// \brief Message flow of one topic in this process. The transport
+    /// records into it as messages go through, without taking a lock.
+    class GZ_TRANSPORT_VISIBLE TopicStats
+    {
+      /// \brief Constructor.
+      /// \param[in] _topic Topic name.
+      /// \param[in] _active Flag telling whether the statistics are
+      /// published, null if they always are.
+      public: explicit TopicStats(const std::string &_topic,
+                  const std::atomic<bool> *_active = nullptr);
+
+      /// \brief Get the topic name.
+      /// \return Topic name.
+      public: const std::string &Topic() const;
+
+      /// \brief Check whether the statistics are published. Subscribers
+      /// only time their parsing and measure latencies while they are.
+      /// \return True if the statistics have subscribers.
+      public: bool Active() const;
+
+      /// \brief Record a message published in this process.
+      public: void RecordPublish();
+
+      /// \brief Record a message serialized for remote subscribers.
+      /// \param[in] _bytes Size of the serialized message.
+      /// \param[in] _time Time taken to serialize it.
+      public: void RecordSend(const uint64_t _bytes,
+                  const std::chrono::steady_clock::duration &_time);
+
+      /// \brief Record a message received from a remote publisher.
+      /// \param[in] _bytes Size of the serialized message.
+      public: void RecordReceive(const uint64_t _bytes);
+
+      /// \brief Record a message parsed for a subscriber callback, and its
+      /// latency if it has a time stamp.
+      /// \param[in] _msg The parsed message.
+      /// \param[in] _time Time taken to parse it.
+      public: void RecordParse(const google::protobuf::Message &_msg,
+                  const std::chrono::steady_clock::duration &_time);
+
+      /// \brief Record the latency of a message delivered to a subscriber
+      /// callback, if its header, or its top level `stamp` or `time` field,
+      /// holds a wall time.
+      /// \param[in] _msg The delivered message.
+      public: void RecordLatency(const google::protobuf::Message &_msg);
+
+      /// \brief Record the number of messages queued by a publisher.
+      /// \param[in] _depth Number of outgoing messages.
+      public: void RecordQueueDepth(const uint32_t _depth);
+
+      /// \brief Record outgoing messages dropped by a publisher.
+      /// \param[in] _count Number of messages dropped.
+      public: void RecordDrops(const uint64_t _count);
+
+      /// \brief Read the counters, and start a new period for the maximum
+      /// latency and the queue high-water mark.
+      /// \return Current counters.
+      public: TopicStatsSample Sample();
+
+      /// \brief Topic name.
+      private: std::string topic;
+
+      /// \brief Whether the statistics are published, null if always.
+      private: const std::atomic<bool> *active;
+
+      /// \brief Time stamp fields of the latest message type whose latency
+      /// was recorded.
+      private: std::atomic<const TopicStatsStamp *> stamp;
+
+      /// \brief Messages published.
+      private: std::atomic<uint64_t> published;
+
+      /// \brief Messages serialized.
+      private: std::atomic<uint64_t> serialized;
+
+      /// \brief Bytes serialized.
+      private: std::atomic<uint64_t> sentBytes;
+
+      /// \brief Serialization time in nanoseconds.
+      private: std::atomic<uint64_t> serializeNs;
+
+      /// \brief Messages received.
+      private: std::atomic<uint64_t> received;
+
+      /// \brief Bytes received.
+      private: std::atomic<uint64_t> receivedBytes;
+
+      /// \brief Messages parsed.
+      private: std::atomic<uint64_t> parsed;
+
+      /// \brief Parse time in nanoseconds.
+      private: std::atomic<uint64_t> parseNs;
+
+      /// \brief Messages dropped.
+      private: std::atomic<uint64_t> dropped;
+
+      /// \brief Number of latencies measured.
+      private: std::atomic<uint64_t> latencyCount;
+
+      /// \brief Total latency in nanoseconds.
+      private: std::atomic<uint64_t> latencyNs;
+
+      /// \brief Longest latency of the period in nanoseconds.
+      private: std::atomic<uint64_t> maxLatencyNs;
+
+      /// \brief Largest queue of the period.
+      private: std::atomic<uint32_t> queueHighWater;
+    };
+
+    /// \brief std shared pointer to transport::TopicStats
+    typedef std::shared_ptr<TopicStats> TopicStatsPtr;
+
+    /// \class TransportStatistics TransportStatistics.hh
+    /// transport/transport.hh
+    /// \brief Registry of the message flow of every topic used by this
+    /// process.
+    ///
+    /// Rates, bandwidth, queue high-water marks, serialization and parse
+    /// times, and the latency of stamped messages, are published once
+    /// a second on TopicName while it has subscribers, and can be viewed
+    /// with `gz topic --stats`.
+    class GZ_TRANSPORT_VISIBLE TransportStatistics
+      : public SingletonT<TransportStatistics>
+    {
+      /// \brief Get the stats of a topic, creating them if needed.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \return Stats of the topic.
+      public: TopicStatsPtr Stats(const std::string &_topic);
+
+      /// \brief Get the stats of all the topics.
+      /// \return Stats of all topics, in the order they were created.
+      public: std::vector<TopicStatsPtr> AllStats() const;
+
+      /// \brief Fill a message with the flow of each topic since the
+      /// previous call.
+      /// \param[out] _msg Message to fill.
+      public: void Fill(msgs::TransportStatistics &_msg);
+
+      /// \brief Publish the statistics if a period has elapsed and there
+      /// are subscribers, and update whether the stats of the topics are
+      /// active. Called by the connection manager.
+      public: void Update();
+
+      /// \brief Stop publishing.
+      public: void Fini();
+
+      /// \brief Topic on which statistics are published.
+      public: static const std::string TopicName;
+
+      /// \brief Constructor.
+      private: TransportStatistics();
+
+      /// \brief Destructor.
+      private: virtual ~TransportStatistics();
+
+      /// \brief This is a singleton class.
+      private: friend class SingletonT<TransportStatistics>;
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<TransportStatisticsPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/TransportStatistics.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class TransportStatistics : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Find the statistics of a topic in a message.
+const msgs::TransportStatistics::TopicStatistics *Find(
+    const msgs::TransportStatistics &_msg, const std::string &_topic)
+{
+  for (int i = 0; i < _msg.topic_size(); ++i)
+  {
+    if (_msg.topic(i).topic() == _topic)
+      return &_msg.topic(i);
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportStatistics, Registry)
+{
+  auto registry = transport::TransportStatistics::Instance();
+  transport::TopicStatsPtr stats = registry->Stats("/test/registry");
+  ASSERT_TRUE(stats != nullptr);
+  EXPECT_EQ(stats->Topic(), "/test/registry");
+
+  // The same topic shares its stats
+  EXPECT_EQ(registry->Stats("/test/registry"), stats);
+  EXPECT_NE(registry->Stats("/test/registry2"), stats);
+
+  bool found = false;
+  for (auto const &s : registry->AllStats())
+    found = found || s == stats;
+  EXPECT_TRUE(found);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportStatistics, Sample)
+{
+  transport::TopicStats stats("/test/sample");
+
+  stats.RecordPublish();
+  stats.RecordPublish();
+  stats.RecordSend(100, std::chrono::microseconds(3));
+  stats.RecordReceive(40);
+  stats.RecordQueueDepth(5);
+  stats.RecordQueueDepth(2);
+  stats.RecordDrops(4);
+
+  transport::TopicStatsSample sample = stats.Sample();
+  EXPECT_EQ(sample.published, 2u);
+  EXPECT_EQ(sample.serialized, 1u);
+  EXPECT_EQ(sample.sentBytes, 100u);
+  EXPECT_EQ(sample.serializeNs, 3000u);
+  EXPECT_EQ(sample.received, 1u);
+  EXPECT_EQ(sample.receivedBytes, 40u);
+  EXPECT_EQ(sample.dropped, 4u);
+  EXPECT_EQ(sample.queueHighWater, 5u);
+
+  // Totals carry over, the high-water mark starts again
+  sample = stats.Sample();
+  EXPECT_EQ(sample.published, 2u);
+  EXPECT_EQ(sample.queueHighWater, 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportStatistics, Latency)
+{
+  transport::TopicStats stats("/test/latency");
+
+  // No time stamp
+  msgs::GzString str;
+  str.set_data("test");
+  stats.RecordLatency(str);
+  EXPECT_EQ(stats.Sample().latencyCount, 0u);
+
+  // Stamped with wall time, in the header
+  msgs::Test test;
+  msgs::Set(test.mutable_header()->mutable_stamp(),
+      common::Time::GetWallTime() - common::Time(0, 2000000));
+  stats.RecordParse(test, std::chrono::microseconds(1));
+
+  transport::TopicStatsSample sample = stats.Sample();
+  EXPECT_EQ(sample.parsed, 1u);
+  EXPECT_EQ(sample.latencyCount, 1u);
+  EXPECT_GE(sample.latencyNs, 2000000u);
+  EXPECT_LT(sample.latencyNs, 1000000000u);
+  EXPECT_EQ(sample.maxLatencyNs, sample.latencyNs);
+
+  // Stamped with wall time, in a time field
+  msgs::ImageStamped image;
+  msgs::Set(image.mutable_time(), common::Time::GetWallTime());
+  image.mutable_image()->set_width(1);
+  image.mutable_image()->set_height(1);
+  image.mutable_image()->set_pixel_format(0);
+  image.mutable_image()->set_step(1);
+  image.mutable_image()->set_data("a");
+  stats.RecordLatency(image);
+  EXPECT_EQ(stats.Sample().latencyCount, 2u);
+
+  // Stamped with simulation time
+  msgs::Set(test.mutable_header()->mutable_stamp(), common::Time(12, 0));
+  stats.RecordLatency(test);
+  sample = stats.Sample();
+  EXPECT_EQ(sample.latencyCount, 2u);
+  EXPECT_EQ(sample.maxLatencyNs, 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportStatistics, Fill)
+{
+  auto registry = transport::TransportStatistics::Instance();
+  transport::TopicStatsPtr stats = registry->Stats("/test/fill");
+  transport::TopicStatsPtr idle = registry->Stats("/test/idle");
+
+  msgs::TransportStatistics msg;
+  registry->Fill(msg);
+  EXPECT_FALSE(msg.process().empty());
+
+  for (int i = 0; i < 10; ++i)
+  {
+    stats->RecordPublish();
+    stats->RecordSend(50, std::chrono::microseconds(2));
+  }
+  stats->RecordQueueDepth(3);
+  stats->RecordDrops(1);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  registry->Fill(msg);
+  EXPECT_GT(msg.period(), 0.0);
+  EXPECT_TRUE(Find(msg, "/test/idle") == nullptr);
+
+  const msgs::TransportStatistics::TopicStatistics *topic =
+    Find(msg, "/test/fill");
+  ASSERT_TRUE(topic != nullptr);
+  EXPECT_NEAR(topic->publish_rate() * msg.period(), 10.0, 1e-6);
+  EXPECT_NEAR(topic->send_bandwidth() * msg.period(), 500.0, 1e-6);
+  EXPECT_NEAR(topic->serialize_time(), 2e-6, 1e-9);
+  EXPECT_EQ(topic->queue_high_water(), 3u);
+  EXPECT_EQ(topic->dropped(), 1u);
+  EXPECT_FALSE(topic->has_parse_time());
+  EXPECT_FALSE(topic->has_latency());
+
+  // Only what happened since the previous fill is reported
+  stats->RecordPublish();
+  registry->Fill(msg);
+  topic = Find(msg, "/test/fill");
+  ASSERT_TRUE(topic != nullptr);
+  EXPECT_NEAR(topic->publish_rate() * msg.period(), 1.0, 1e-6);
+  EXPECT_EQ(topic->dropped(), 0u);
+  EXPECT_EQ(topic->queue_high_water(), 0u);
+
+  registry->Fill(msg);
+  EXPECT_TRUE(Find(msg, "/test/fill") == nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TransportStatistics, Active)
+{
+  // Standalone stats are always active
+  transport::TopicStats standalone("/test/standalone");
+  EXPECT_TRUE(standalone.Active());
+
+  // Stats of the registry are active once the statistics have
+  // subscribers, which there aren't without a master
+  auto registry = transport::TransportStatistics::Instance();
+  EXPECT_FALSE(registry->Stats("/test/active")->Active());
+
+  // The latency of a topic carrying several message types
+  transport::TopicStats stats("/test/types");
+  msgs::Test test;
+  msgs::ImageStamped image;
+  for (int i = 0; i < 3; ++i)
+  {
+    msgs::Set(test.mutable_header()->mutable_stamp(),
+        common::Time::GetWallTime());
+    stats.RecordLatency(test);
+    msgs::Set(image.mutable_time(), common::Time::GetWallTime());
+    stats.RecordLatency(image);
+  }
+  EXPECT_EQ(stats.Sample().latencyCount, 6u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -74,6 +74,9 @@ namespace gazebo
 
     /// \brief 1 if contains, 0 if doesn't contain, -1 if unset
     public: int contain = -1;
+
+    /// \brief Rate of the checks in Hz, 0 to check every iteration.
+    public: double updateRate = 0;
   };
 }
 
@@ -159,6 +162,9 @@ void ContainPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
   this->dataPtr->ignNode.Advertise(enableService,
       &ContainPlugin::EnableIgn, this);
 
+  if (_sdf->HasElement("update_rate"))
+    this->dataPtr->updateRate = _sdf->Get<double>("update_rate");
+
   auto enabled = true;
   if (_sdf->HasElement("enabled"))
     enabled = _sdf->Get<bool>("enabled");
@@ -200,7 +206,8 @@ bool ContainPlugin::Enable(const bool _enable)
   {
     // Start update
     this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
-        std::bind(&ContainPlugin::OnUpdate, this, std::placeholders::_1));
+        std::bind(&ContainPlugin::OnUpdate, this, std::placeholders::_1),
+        this->dataPtr->updateRate);
 
     auto topic = "/" + this->dataPtr->ns + "/contain";
 
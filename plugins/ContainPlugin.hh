@@ -39,6 +39,10 @@ namespace gazebo
   ///         via a message - true by default -->
   ///    <enabled>true</enabled>
   ///
+  ///    <!-- Rate in Hz of simulation time at which the volume is checked,
+  ///         every iteration by default -->
+  ///    <update_rate>50</update_rate>
+  ///
   ///    <!-- Scoped name of entity to check -->
   ///    <entity>robot::arm_link</entity>
   ///
@@ -45,14 +45,20 @@ void DepthCameraPlugin::Load(sensors::SensorPtr _sensor,
 {
   this->parentSensor =
     std::dynamic_pointer_cast<sensors::DepthCameraSensor>(_sensor);
-  this->depthCamera = this->parentSensor->DepthCamera();
-
   if (!this->parentSensor)
   {
     gzerr << "DepthCameraPlugin not attached to a depthCamera sensor\n";
     return;
   }
 
+  // Depth images cast on the CPU have no rendering camera to connect to
+  this->depthCamera = this->parentSensor->DepthCamera();
+  if (!this->depthCamera)
+  {
+    gzerr << "DepthCameraPlugin needs a rendered depth camera\n";
+    return;
+  }
+
   this->width = this->depthCamera->ImageWidth();
   this->height = this->depthCamera->ImageHeight();
   this->depth = this->depthCamera->ImageDepth();
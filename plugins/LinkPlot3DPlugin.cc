@@ -63,8 +63,8 @@ class gazebo::LinkPlot3DPluginPrivate
   /// \brief Pointer to the world
   public: physics::WorldPtr world;
 
-  /// \brief Update period
-  public: int period;
+  /// \brief Update rate in Hz
+  public: double frequency = 30.0;
 
   /// \brief PRevious update time.
   public: common::Time prevTime;
@@ -96,11 +96,9 @@ void LinkPlot3DPlugin::Load(physics::ModelPtr _model,
     return;
   }
 
-  // Update period
+  // Update rate
   if (_sdf->HasElement("frequency"))
-      this->dataPtr->period = 1.0/_sdf->Get<int>("frequency");
-  else
-      this->dataPtr->period = 1.0/30.0;
+      this->dataPtr->frequency = _sdf->Get<double>("frequency");
 
   // Construct the plots
   auto plotElem = _sdf->GetElement("plot");
@@ -157,7 +155,8 @@ void LinkPlot3DPlugin::Load(physics::ModelPtr _model,
   if (!this->dataPtr->plots.empty())
   {
     this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
-        std::bind(&LinkPlot3DPlugin::OnUpdate, this));
+        std::bind(&LinkPlot3DPlugin::OnUpdate, this),
+        this->dataPtr->frequency);
   }
 }
 
@@ -175,10 +174,6 @@ void LinkPlot3DPlugin::OnUpdate()
     return;
   }
 
-  // Throttle update
-  if ((currentTime - this->dataPtr->prevTime).Double() < this->dataPtr->period)
-    return;
-
   this->dataPtr->prevTime = currentTime;
 
   // Process each plot
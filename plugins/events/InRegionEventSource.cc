@@ -42,10 +42,15 @@ void InRegionEventSource::Load(const sdf::ElementPtr _sdf)
   else
     gzerr << this->name << " is missing a region element" << std::endl;
 
-  // Listen to the update event. This event is broadcast every
-  // simulation iteration.
+  // Rate in Hz of simulation time at which the region is checked, every
+  // iteration by default
+  double updateRate = 0;
+  if (_sdf->HasElement("update_rate"))
+    updateRate = _sdf->Get<double>("update_rate");
+
+  // Listen to the update event, rate limited if an update rate is given.
   this->updateConnection = event::Events::ConnectWorldUpdateBegin(
-      std::bind(&InRegionEventSource::Update, this));
+      std::bind(&InRegionEventSource::Update, this), updateRate);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
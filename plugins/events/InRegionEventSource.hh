@@ -48,7 +48,8 @@ namespace gazebo
     public: void Info() const;
 
     /// \brief Loads the full name of the model and the region from the world
-    /// file.
+    /// file, and the optional <update_rate> in Hz of simulation time at
+    /// which the region is checked, every iteration by default.
     /// \param[in] _sdf
     public: virtual void Load(const sdf::ElementPtr _sdf);
 
@@ -16,6 +16,7 @@
 */
 
 #include <cmath>
+#include <map>
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/physics/physics.hh"
 #include "gazebo/sensors/sensors.hh"
@@ -676,6 +677,20 @@ void ContactSensor::TorqueTest(const std::string &_physicsEngine)
       }
     }
   }
+
+  // The contacts of a collision are keyed by the name of the other
+  // collision, and don't point to collisions which may be removed
+  std::map<std::string, physics::Contact> colContacts =
+    contactSensor->Contacts(col->GetScopedName());
+  EXPECT_EQ(colContacts.size(),
+      static_cast<size_t>(contacts.contact_size()));
+  for (auto const &colContact : colContacts)
+  {
+    EXPECT_NE(colContact.first, col->GetScopedName());
+    EXPECT_TRUE(colContact.second.collision1 == nullptr);
+    EXPECT_TRUE(colContact.second.collision2 == nullptr);
+    EXPECT_GT(colContact.second.count, 0);
+  }
 }
 
 TEST_P(ContactSensor, TorqueTest)
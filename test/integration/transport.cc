@@ -18,6 +18,9 @@
 #ifndef _WIN32
 #include <unistd.h>
 #endif
+#include <boost/make_shared.hpp>
+#include <string>
+#include <vector>
 #include "gazebo/test/ServerFixture.hh"
 
 using namespace gazebo;
@@ -788,6 +791,160 @@ TEST_F(TransportTest, TryInit)
   EXPECT_EQ(physics::get_world()->Name(), node->GetTopicNamespace());
 }
 
+/////////////////////////////////////////////////
+ConstGzStringPtr g_sharedMsg;
+void ReceiveSharedMsg(ConstGzStringPtr &_msg)
+{
+  g_sharedMsg = _msg;
+}
+
+/////////////////////////////////////////////////
+// Shared messages reach subscribers in this process without a copy
+TEST_F(TransportTest, SharedPublish)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+
+  transport::PublisherPtr pub =
+    node->Advertise<msgs::GzString>("~/test/shared");
+  transport::SubscriberPtr sub = node->Subscribe("~/test/shared",
+      &ReceiveSharedMsg);
+
+  auto msg = boost::make_shared<msgs::GzString>();
+  msg->set_data("shared");
+  pub->Publish(msg, true);
+
+  int timeout = 1000;
+  while (!g_sharedMsg && --timeout > 0)
+    common::Time::MSleep(10);
+  ASSERT_TRUE(g_sharedMsg != nullptr);
+  EXPECT_EQ(g_sharedMsg.get(), msg.get());
+  EXPECT_EQ(pub->CopyCount(), 0u);
+
+  // Publishing by reference still copies
+  g_sharedMsg.reset();
+  pub->Publish(*msg, true);
+  timeout = 1000;
+  while (!g_sharedMsg && --timeout > 0)
+    common::Time::MSleep(10);
+  ASSERT_TRUE(g_sharedMsg != nullptr);
+  EXPECT_NE(g_sharedMsg.get(), msg.get());
+  EXPECT_EQ(g_sharedMsg->data(), "shared");
+  EXPECT_EQ(pub->CopyCount(), 1u);
+
+  // Latching subscribers get the message that was delivered
+  EXPECT_EQ(pub->GetPrevMsgPtr().get(), g_sharedMsg.get());
+  g_sharedMsg.reset();
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> g_conflatedMsgs;
+boost::mutex g_conflatedMutex;
+void ReceiveConflatedMsg(ConstGzStringPtr &_msg)
+{
+  boost::mutex::scoped_lock lock(g_conflatedMutex);
+  g_conflatedMsgs.push_back(_msg->data());
+}
+
+/////////////////////////////////////////////////
+// A conflating publisher only sends its latest message, and counts the
+// ones it dropped
+TEST_F(TransportTest, Conflate)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+
+  transport::PublisherPtr pub =
+    node->Advertise<msgs::GzString>("~/test/conflate", 1000, 0, true);
+  EXPECT_TRUE(pub->Conflate());
+  transport::SubscriberPtr sub = node->Subscribe("~/test/conflate",
+      &ReceiveConflatedMsg);
+
+  const unsigned int count = 1000;
+  msgs::GzString msg;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    msg.set_data(std::to_string(i));
+    pub->Publish(msg);
+  }
+
+  // Every message is either delivered or dropped, and the latest one is
+  // always delivered
+  unsigned int received = 0;
+  for (int i = 0; i < 1000; ++i)
+  {
+    {
+      boost::mutex::scoped_lock lock(g_conflatedMutex);
+      received = g_conflatedMsgs.size();
+      if (received + pub->DropCount() == count)
+        break;
+    }
+    common::Time::MSleep(10);
+  }
+  EXPECT_EQ(received + pub->DropCount(), count);
+  EXPECT_LE(pub->GetOutgoingCount(), 1u);
+
+  boost::mutex::scoped_lock lock(g_conflatedMutex);
+  ASSERT_FALSE(g_conflatedMsgs.empty());
+  EXPECT_EQ(g_conflatedMsgs.back(), std::to_string(count - 1));
+}
+
+/////////////////////////////////////////////////
+std::vector<msgs::TransportStatistics> g_statsMsgs;
+boost::mutex g_statsMutex;
+void ReceiveStatsMsg(ConstTransportStatisticsPtr &_msg)
+{
+  boost::mutex::scoped_lock lock(g_statsMutex);
+  g_statsMsgs.push_back(*_msg);
+}
+
+/////////////////////////////////////////////////
+// Each process publishes the message flow of its topics
+TEST_F(TransportTest, Statistics)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+
+  transport::SubscriberPtr statsSub = node->Subscribe(
+      transport::TransportStatistics::TopicName, &ReceiveStatsMsg);
+
+  transport::PublisherPtr pub =
+    node->Advertise<msgs::GzString>("~/test/stats");
+  transport::SubscriberPtr sub = node->Subscribe("~/test/stats",
+      &ReceiveStringMsg);
+
+  const std::string topic = "/gazebo/default/test/stats";
+  msgs::GzString msg;
+  msg.set_data("test");
+
+  // Statistics are published once a second
+  bool found = false;
+  for (int i = 0; i < 500 && !found; ++i)
+  {
+    pub->Publish(msg);
+    common::Time::MSleep(10);
+
+    boost::mutex::scoped_lock lock(g_statsMutex);
+    for (auto const &stats : g_statsMsgs)
+    {
+      EXPECT_FALSE(stats.process().empty());
+      EXPECT_GT(stats.period(), 0.0);
+      for (auto const &topicStats : stats.topic())
+      {
+        if (topicStats.topic() == topic && topicStats.publish_rate() > 0)
+          found = true;
+      }
+    }
+  }
+  EXPECT_TRUE(found);
+}
+
 /////////////////////////////////////////////////
 // Main
 int main(int argc, char **argv)
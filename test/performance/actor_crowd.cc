@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "gazebo/physics/Actor.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ActorCrowdTest : public ServerFixture {};
+
+/////////////////////////////////////////////////
+TEST_F(ActorCrowdTest, Stress)
+{
+  Load("worlds/actor_crowd.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  unsigned int actorCount = 0;
+  for (auto const &model : world->Models())
+  {
+    if (model->HasType(physics::Base::ACTOR))
+      ++actorCount;
+  }
+  EXPECT_EQ(actorCount, 100u);
+
+  // Animations are refreshed at 30 Hz of sim time, so step through several
+  // seconds of sim time to include many animated frames.
+  const unsigned int steps = 10000;
+  common::Time startTime = common::Time::GetWallTime();
+  world->Step(steps);
+  common::Time endTime = common::Time::GetWallTime();
+
+  gzdbg << "Time elapsed while stepping [" << actorCount << "] actors ["
+        << steps << "] times [" << endTime - startTime << "]\n";
+
+  // Actors must still have valid poses
+  auto actor = boost::dynamic_pointer_cast<physics::Actor>(
+      world->ModelByName("actor_0_0"));
+  ASSERT_TRUE(actor != nullptr);
+  EXPECT_TRUE(actor->WorldPose().IsFinite());
+
+  EXPECT_LT(endTime - startTime, common::Time(60, 0));
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <sys/resource.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ContactSensorStressTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief CPU time used by the process so far.
+/// \return User and system time in seconds.
+double ProcessCpuTime()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6 +
+         usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+}
+
+/////////////////////////////////////////////////
+// Robots with a 1 kHz contact sensor on each of their four feet, pushed
+// along the ground so feet keep making and breaking contact.
+TEST_F(ContactSensorStressTest, WalkingRobots)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  const unsigned int robotCount = 25;
+  const std::vector<std::string> feet = {"fl", "fr", "rl", "rr"};
+  const double footX[] = {0.3, 0.3, -0.3, -0.3};
+  const double footY[] = {0.2, -0.2, 0.2, -0.2};
+
+  for (unsigned int i = 0; i < robotCount; ++i)
+  {
+    std::ostringstream name;
+    name << "robot_" << i;
+
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='" << name.str() << "'>"
+      << "<pose>" << (i % 5) * 2.0 << " " << (i / 5) * 2.0
+      << " 0.3 0 0 0</pose>"
+      << "<link name='body'>"
+      << "<collision name='torso'><pose>0 0 0.2 0 0 0</pose>"
+      << "<geometry><box><size>0.8 0.5 0.2</size></box></geometry>"
+      << "</collision>";
+    for (unsigned int f = 0; f < feet.size(); ++f)
+    {
+      sdf << "<collision name='" << feet[f] << "'>"
+        << "<pose>" << footX[f] << " " << footY[f] << " 0 0 0 0</pose>"
+        << "<geometry><sphere><radius>0.05</radius></sphere></geometry>"
+        << "</collision>";
+    }
+    for (unsigned int f = 0; f < feet.size(); ++f)
+    {
+      sdf << "<sensor name='" << feet[f] << "_contact' type='contact'>"
+        << "<always_on>true</always_on>"
+        << "<update_rate>1000</update_rate>"
+        << "<contact><collision>" << feet[f] << "</collision></contact>"
+        << "</sensor>";
+    }
+    sdf << "</link></model></sdf>";
+
+    this->SpawnSDF(sdf.str());
+    this->WaitUntilEntitySpawn(name.str(), 100, 100);
+    this->WaitUntilSensorSpawn(name.str() + "::body::rr_contact", 100, 100);
+  }
+
+  std::vector<physics::ModelPtr> robots;
+  std::vector<sensors::ContactSensorPtr> contactSensors;
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+  for (unsigned int i = 0; i < robotCount; ++i)
+  {
+    std::string name = "robot_" + std::to_string(i);
+    robots.push_back(world->ModelByName(name));
+    ASSERT_TRUE(robots.back() != nullptr);
+    for (auto const &foot : feet)
+    {
+      contactSensors.push_back(
+          std::dynamic_pointer_cast<sensors::ContactSensor>(
+            mgr->GetSensor(name + "::body::" + foot + "_contact")));
+      ASSERT_TRUE(contactSensors.back() != nullptr);
+    }
+  }
+
+  // Let the robots land
+  world->Step(200);
+
+  const unsigned int steps = 1000;
+  double stepCpuTime = 0;
+  common::Time readTime;
+  unsigned int contactCount = 0;
+  for (unsigned int i = 0; i < steps; ++i)
+  {
+    // Push the robots back and forth, with a small hop
+    if (i % 100 == 0)
+    {
+      double vx = (i / 100) % 2 == 0 ? 0.5 : -0.5;
+      for (auto &robot : robots)
+        robot->SetLinearVel(ignition::math::Vector3d(vx, 0, 0.3));
+    }
+
+    double start = ProcessCpuTime();
+    world->Step(1);
+    stepCpuTime += ProcessCpuTime() - start;
+
+    // Read the sensors as a controller would
+    common::Time readStart = common::Time::GetWallTime();
+    for (auto &sensor : contactSensors)
+    {
+      sensor->Update(true);
+      contactCount += sensor->GetCollisionContactCount(
+          sensor->GetCollisionName(0));
+    }
+    readTime += common::Time::GetWallTime() - readStart;
+  }
+  EXPECT_GT(contactCount, 0u);
+
+  // The contacts message matches the contacts of each collision
+  for (auto &sensor : contactSensors)
+  {
+    msgs::Contacts msg = sensor->Contacts();
+    std::string collision = sensor->GetCollisionName(0);
+    unsigned int points = 0;
+    for (int c = 0; c < msg.contact_size(); ++c)
+    {
+      EXPECT_TRUE(msg.contact(c).collision1() == collision ||
+                  msg.contact(c).collision2() == collision);
+      EXPECT_EQ(msg.contact(c).position_size(), msg.contact(c).wrench_size());
+      points += msg.contact(c).position_size();
+    }
+    EXPECT_EQ(points, sensor->GetCollisionContactCount(collision));
+
+    unsigned int mapPoints = 0;
+    for (auto const &contact : sensor->Contacts(collision))
+      mapPoints += contact.second.count;
+    EXPECT_EQ(mapPoints, points);
+  }
+
+  gzmsg << "[" << contactSensors.size() << "] foot contact sensors, ["
+        << steps << "] steps: [" << stepCpuTime << " s] of CPU stepping, ["
+        << readTime.Double() * 1e6 / (steps * contactSensors.size())
+        << " us] per sensor update and read, [" << contactCount
+        << "] contact points read\n";
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <sys/resource.h>
+
+#include <sstream>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class ImuStressTest : public ServerFixture
+{
+  /// \brief Spawn boxes resting on the ground plane, each with an optional
+  /// 1 kHz IMU, and step the world for one simulated second.
+  /// \param[in] _withImu True to attach an IMU to every box.
+  /// \return CPU time used by the process during the steps, in seconds.
+  public: double Run(const bool _withImu);
+
+  /// \brief Number of robots.
+  public: static const unsigned int kRobotCount = 100;
+};
+
+/////////////////////////////////////////////////
+/// \brief CPU time used by the process so far.
+/// \return User and system time in seconds.
+double ProcessCpuTime()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6 +
+         usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+}
+
+/////////////////////////////////////////////////
+double ImuStressTest::Run(const bool _withImu)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  EXPECT_TRUE(world != nullptr);
+  if (!world)
+    return 0;
+
+  for (unsigned int i = 0; i < kRobotCount; ++i)
+  {
+    std::ostringstream name;
+    name << "robot_" << i;
+
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='" << name.str() << "'>"
+      << "<pose>" << (i % 10) * 2.0 << " " << (i / 10) * 2.0
+      << " 0.5 0 0 0</pose>"
+      << "<link name='body'>"
+      << "<collision name='collision'>"
+      << "<geometry><box><size>1 1 1</size></box></geometry>"
+      << "</collision>";
+    if (_withImu)
+    {
+      sdf << "<sensor name='imu' type='imu'>"
+        << "<always_on>true</always_on>"
+        << "<update_rate>1000</update_rate>"
+        << "<imu/>"
+        << "</sensor>";
+    }
+    sdf << "</link></model></sdf>";
+
+    this->SpawnSDF(sdf.str());
+    this->WaitUntilEntitySpawn(name.str(), 100, 100);
+    if (_withImu)
+      this->WaitUntilSensorSpawn(name.str() + "::body::imu", 100, 100);
+  }
+
+  // Let the boxes settle
+  world->Step(100);
+
+  const unsigned int steps = 1000;
+  double start = ProcessCpuTime();
+  world->Step(steps);
+  double cpuTime = ProcessCpuTime() - start;
+
+  if (_withImu)
+  {
+    sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+    for (unsigned int i = 0; i < kRobotCount; ++i)
+    {
+      std::ostringstream name;
+      name << "robot_" << i << "::body::imu";
+      sensors::ImuSensorPtr imu =
+        std::dynamic_pointer_cast<sensors::ImuSensor>(
+            mgr->GetSensor(name.str()));
+      EXPECT_TRUE(imu != nullptr);
+      if (!imu)
+        continue;
+
+      // The sample is taken from the link at the end of the step, the
+      // reading must be exactly the link velocity in the IMU frame.
+      physics::LinkPtr link = world->ModelByName(
+          "robot_" + std::to_string(i))->GetLink("body");
+      world->Step(1);
+      imu->Update(true);
+      EXPECT_EQ(imu->LastMeasurementTime(), world->SimTime());
+      ignition::math::Quaterniond rot = (imu->Pose() + link->WorldPose()).Rot();
+      EXPECT_EQ(imu->AngularVelocity(true),
+          rot.Inverse().RotateVector(link->WorldAngularVel()));
+
+      // Resting on the ground, the IMU measures the reaction to gravity
+      EXPECT_NEAR(imu->LinearAcceleration(true).Z(),
+          -world->Gravity().Z(), 0.1);
+    }
+  }
+
+  return cpuTime;
+}
+
+/////////////////////////////////////////////////
+// CPU time used by 100 robots with a 1 kHz IMU each, compared with the same
+// robots without sensors, over one simulated second.
+TEST_F(ImuStressTest, Robots)
+{
+  double imuTime = this->Run(true);
+  this->Unload();
+  double baseTime = this->Run(false);
+
+  gzmsg << "[" << kRobotCount << "] robots, 1 s of simulation at 1 kHz: ["
+        << baseTime << " s] of CPU without IMU, [" << imuTime
+        << " s] with an IMU each, [" << (imuTime - baseTime) * 1e6 /
+        (kRobotCount * 1000) << " us] per IMU update\n";
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <thread>
+
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/LinkStateBuffer.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class LinkStatesTest : public ServerFixture {};
+
+/////////////////////////////////////////////////
+TEST_F(LinkStatesTest, Stress)
+{
+  Load("worlds/link_state_grid.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::LinkStateBuffer &states = world->LinkStates();
+  // 400 spheres and the ground plane
+  ASSERT_EQ(states.Size(), 401u);
+
+  std::vector<physics::LinkPtr> links;
+  for (auto const &model : world->Models())
+  {
+    for (auto const &link : model->GetLinks())
+      links.push_back(link);
+  }
+
+  // Read every link after each step through the Link API and through the
+  // buffer, as a plugin sampling the whole world would.
+  const unsigned int steps = 2000;
+  common::Time linkApiTime;
+  common::Time bufferTime;
+  common::Time stepTime;
+  double checksum = 0;
+  for (unsigned int i = 0; i < steps; ++i)
+  {
+    common::Time start = common::Time::GetWallTime();
+    world->Step(1);
+    stepTime += common::Time::GetWallTime() - start;
+
+    start = common::Time::GetWallTime();
+    for (auto const &link : links)
+    {
+      checksum += link->WorldPose().Pos().Z() +
+          link->WorldLinearVel().Z() + link->WorldAngularVel().X();
+    }
+    linkApiTime += common::Time::GetWallTime() - start;
+
+    start = common::Time::GetWallTime();
+    const ignition::math::Pose3d *poses = states.Poses();
+    const ignition::math::Vector3d *linearVels = states.LinearVels();
+    const ignition::math::Vector3d *angularVels = states.AngularVels();
+    for (unsigned int j = 0; j < states.Size(); ++j)
+    {
+      checksum -= poses[j].Pos().Z() + linearVels[j].Z() +
+          angularVels[j].X();
+    }
+    bufferTime += common::Time::GetWallTime() - start;
+  }
+
+  gzdbg << "Stepping [" << links.size() << "] links [" << steps
+        << "] times took [" << stepTime << "]\n"
+        << "Reading them through the Link API took [" << linkApiTime
+        << "], through the link state buffer [" << bufferTime << "]\n";
+
+  // Both paths see the same state
+  EXPECT_NEAR(checksum, 0.0, 1e-3);
+  EXPECT_LT(bufferTime, linkApiTime);
+}
+
+/////////////////////////////////////////////////
+// Time World::Update with and without a thread reading the buffer, and the
+// share of the step spent publishing it.
+TEST_F(LinkStatesTest, Step)
+{
+  Load("worlds/link_state_grid.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::LinkStateBuffer &states = world->LinkStates();
+  ASSERT_EQ(states.Size(), 401u);
+
+  const unsigned int steps = 2000;
+  common::Time stepTime;
+  for (unsigned int i = 0; i < steps; ++i)
+  {
+    common::Time start = common::Time::GetWallTime();
+    world->Step(1);
+    stepTime += common::Time::GetWallTime() - start;
+  }
+
+  // Publishing every slot, which is what EndWrite does after a step in
+  // which every link moved
+  common::Time publishTime;
+  for (unsigned int i = 0; i < steps; ++i)
+  {
+    common::Time start = common::Time::GetWallTime();
+    states.BeginWrite();
+    for (unsigned int j = 0; j < states.Size(); ++j)
+    {
+      states.SetPose(j, states.Poses()[j]);
+      states.SetVelocity(j, states.LinearVels()[j], states.AngularVels()[j]);
+    }
+    states.EndWrite(states.SimTime());
+    publishTime += common::Time::GetWallTime() - start;
+  }
+
+  // Step again while another thread reads every link, as a sensor or
+  // transport thread would
+  std::atomic<bool> stop(false);
+  common::Time readTime;
+  unsigned int reads = 0;
+  std::thread reader([&]()
+  {
+    ignition::math::Pose3d pose;
+    ignition::math::Vector3d linearVel;
+    ignition::math::Vector3d angularVel;
+    while (!stop)
+    {
+      common::Time start = common::Time::GetWallTime();
+      for (unsigned int j = 0; j < states.Size(); ++j)
+        states.State(j, pose, linearVel, angularVel);
+      readTime += common::Time::GetWallTime() - start;
+      ++reads;
+    }
+  });
+
+  common::Time readStepTime;
+  for (unsigned int i = 0; i < steps; ++i)
+  {
+    common::Time start = common::Time::GetWallTime();
+    world->Step(1);
+    readStepTime += common::Time::GetWallTime() - start;
+  }
+  stop = true;
+  reader.join();
+
+  gzdbg << "Stepping [" << states.Size() << "] links [" << steps
+        << "] times took [" << stepTime << "], [" << readStepTime
+        << "] with a reader\n"
+        << "Publishing them took [" << publishTime << "]\n"
+        << "The reader read them [" << reads << "] times in ["
+        << readTime << "]\n";
+
+  ASSERT_GT(reads, 0u);
+  // Publishing is a small part of the step
+  EXPECT_LT(publishTime.Double(), stepTime.Double() * 0.1);
+  // Readers only wait for the publication, not for the whole step
+  EXPECT_LT(readTime.Double() / reads, readStepTime.Double() / steps * 0.5);
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
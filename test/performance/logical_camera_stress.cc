@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Frustum.hh>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class LogicalCameraStressTest : public ServerFixture
+{
+  /// \brief Find the models in the frustum of a camera by testing all of
+  /// them, like the camera used to.
+  /// \param[in] _frustum Frustum of the camera, at its pose.
+  /// \param[in] _models Models to test, with their nested models.
+  /// \param[in] _skip Name of the camera's model.
+  /// \param[out] _names Names of the models in the frustum.
+  public: void Visible(const ignition::math::Frustum &_frustum,
+              const physics::Model_V &_models, const std::string &_skip,
+              std::set<std::string> &_names)
+  {
+    for (auto const &model : _models)
+    {
+      if (model->GetScopedName() != _skip &&
+          _frustum.Contains(model->BoundingBox()))
+      {
+        _names.insert(model->GetScopedName());
+      }
+      this->Visible(_frustum, model->NestedModels(), _skip, _names);
+    }
+  }
+};
+
+/////////////////////////////////////////////////
+// 20 logical cameras among 2000 models, sharing one tree of model bounds,
+// compared with testing every model against every camera.
+TEST_F(LogicalCameraStressTest, ManyCameras)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // A grid of boxes, every tenth with a nested model
+  const unsigned int modelCount = 2000;
+  for (unsigned int i = 0; i < modelCount; ++i)
+  {
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='model_" << i << "'>"
+      << "<static>true</static>"
+      << "<pose>" << (i % 50) * 2.0 << " " << (i / 50) * 2.0
+      << " 0.5 0 0 0</pose>"
+      << "<link name='link'><collision name='collision'>"
+      << "<geometry><box><size>0.5 0.5 0.5</size></box></geometry>"
+      << "</collision></link>";
+    if (i % 10 == 0)
+    {
+      sdf << "<model name='nested'><pose>0 0 1 0 0 0</pose>"
+        << "<link name='link'><collision name='collision'>"
+        << "<geometry><sphere><radius>0.2</radius></sphere></geometry>"
+        << "</collision></link></model>";
+    }
+    sdf << "</model></sdf>";
+    this->SpawnSDF(sdf.str());
+  }
+  this->WaitUntilEntitySpawn("model_" + std::to_string(modelCount - 1),
+      100, 100);
+
+  const unsigned int cameraCount = 20;
+  std::vector<sensors::LogicalCameraSensorPtr> cameras;
+  for (unsigned int i = 0; i < cameraCount; ++i)
+  {
+    std::string name = "camera_" + std::to_string(i);
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='" << name << "'>"
+      << "<static>true</static>"
+      << "<pose>" << -5.0 << " " << i * 4.0 << " 2 0 0.2 "
+      << (i % 2 == 0 ? 0.3 : -0.3) << "</pose>"
+      << "<link name='link'>"
+      << "<sensor name='camera' type='logical_camera'>"
+      << "<logical_camera><near>0.1</near><far>30</far>"
+      << "<horizontal_fov>1.0</horizontal_fov>"
+      << "<aspect_ratio>1.8</aspect_ratio></logical_camera>"
+      << "</sensor></link></model></sdf>";
+    this->SpawnSDF(sdf.str());
+    this->WaitUntilSensorSpawn(name + "::link::camera", 100, 100);
+
+    cameras.push_back(std::dynamic_pointer_cast<sensors::LogicalCameraSensor>(
+        sensors::SensorManager::Instance()->GetSensor(
+          name + "::link::camera")));
+    ASSERT_TRUE(cameras.back() != nullptr);
+  }
+  world->Step(1);
+
+  const int iterations = 10;
+  common::Time start = common::Time::GetWallTime();
+  for (int i = 0; i < iterations; ++i)
+  {
+    for (auto &camera : cameras)
+      camera->Update(true);
+  }
+  double queryTime =
+    (common::Time::GetWallTime() - start).Double() / iterations;
+
+  start = common::Time::GetWallTime();
+  unsigned int seen = 0;
+  for (unsigned int i = 0; i < cameraCount; ++i)
+  {
+    msgs::LogicalCameraImage image = cameras[i]->Image();
+    ignition::math::Frustum frustum;
+    frustum.SetNear(cameras[i]->Near());
+    frustum.SetFar(cameras[i]->Far());
+    frustum.SetFOV(cameras[i]->HorizontalFOV());
+    frustum.SetAspectRatio(cameras[i]->AspectRatio());
+    frustum.SetPose(msgs::ConvertIgn(image.pose()));
+
+    std::set<std::string> expected;
+    this->Visible(frustum, world->Models(),
+        "camera_" + std::to_string(i), expected);
+
+    std::set<std::string> names;
+    for (int j = 0; j < image.model_size(); ++j)
+      names.insert(image.model(j).name());
+    EXPECT_EQ(names, expected) << i;
+    seen += names.size();
+  }
+  double bruteForceTime = (common::Time::GetWallTime() - start).Double();
+  EXPECT_GT(seen, 0u);
+
+  // A model moved in front of a camera is seen by its next update
+  physics::ModelPtr model = world->ModelByName("model_0");
+  ASSERT_TRUE(model != nullptr);
+  model->SetWorldPose(ignition::math::Pose3d(-3, 0, 2, 0, 0, 0));
+  cameras[0]->Update(true);
+  msgs::LogicalCameraImage image = cameras[0]->Image();
+  bool found = false;
+  for (int j = 0; j < image.model_size(); ++j)
+    found = found || image.model(j).name() == "model_0";
+  EXPECT_TRUE(found);
+
+  gzmsg << "[" << cameraCount << "] cameras, [" << modelCount
+        << "] models, [" << seen << "] seen: [" << queryTime * 1000.0
+        << " ms] per update of all cameras, [" << bruteForceTime * 1000.0
+        << " ms] testing every model\n";
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
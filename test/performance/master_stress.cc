@@ -0,0 +1,326 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Number of simulated nodes.
+static const unsigned int g_nodeCount = 50;
+
+/// \brief Number of topics advertised by each node.
+static const unsigned int g_topicsPerNode = 100;
+
+/// \brief Name of a topic advertised by a node.
+/// \param[in] _node Index of the node.
+/// \param[in] _topic Index of the topic.
+/// \return Topic name.
+std::string TopicName(const unsigned int _node, const unsigned int _topic)
+{
+  return "/stress/node_" + std::to_string(_node) + "/topic_" +
+    std::to_string(_topic);
+}
+
+/// \brief A process talking to the master as a ConnectionManager does,
+/// without connecting to the publishers it learns about.
+class StressNode
+{
+  /// \brief Constructor.
+  /// \param[in] _index Index of the node, used as its fake port.
+  public: explicit StressNode(const unsigned int _index)
+          : index(_index)
+  {
+  }
+
+  /// \brief Destructor.
+  public: ~StressNode()
+  {
+    this->Close();
+  }
+
+  /// \brief Connect to the master.
+  /// \return True if connected.
+  public: bool Connect()
+  {
+    std::string host;
+    unsigned int port;
+    if (!transport::get_master_uri(host, port))
+      return false;
+
+    this->conn.reset(new transport::Connection());
+    if (!this->conn->Connect(host, port))
+      return false;
+
+    this->conn->AsyncRead(boost::bind(&StressNode::OnRead, this, _1));
+    return true;
+  }
+
+  /// \brief Close the connection to the master.
+  public: void Close()
+  {
+    if (this->conn)
+      this->conn->Shutdown();
+  }
+
+  /// \brief Queue an advertisement.
+  /// \param[in] _topic Topic name.
+  public: void Advertise(const std::string &_topic)
+  {
+    msgs::Publish msg;
+    msg.set_topic(_topic);
+    msg.set_msg_type("gazebo.msgs.GzString");
+    msg.set_host("127.0.0.1");
+    msg.set_port(20000 + this->index);
+    this->conn->EnqueueMsg(msgs::Package("advertise", msg));
+  }
+
+  /// \brief Queue a subscription.
+  /// \param[in] _topic Topic name.
+  public: void Subscribe(const std::string &_topic)
+  {
+    msgs::Subscribe msg;
+    msg.set_topic(_topic);
+    msg.set_msg_type("gazebo.msgs.GzString");
+    msg.set_host("127.0.0.1");
+    msg.set_port(20000 + this->index);
+    this->conn->EnqueueMsg(msgs::Package("subscribe", msg));
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->wanted.insert(_topic);
+  }
+
+  /// \brief Queue a request for the list of topics.
+  public: void RequestTopics()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->topicCount = -1;
+    }
+    msgs::Request *request = msgs::CreateRequest("get_topics");
+    this->conn->EnqueueMsg(msgs::Package("request", *request));
+    delete request;
+  }
+
+  /// \brief Write queued messages, as ConnectionManager does on each
+  /// update.
+  public: void Write()
+  {
+    if (this->conn && this->conn->IsOpen())
+      this->conn->ProcessWriteQueue();
+  }
+
+  /// \brief Called for each message from the master.
+  /// \param[in] _data Serialized packet.
+  public: void OnRead(const std::string &_data)
+  {
+    if (_data.empty())
+      return;
+    this->conn->AsyncRead(boost::bind(&StressNode::OnRead, this, _1));
+
+    msgs::Packet packet;
+    packet.ParseFromString(_data);
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (packet.type() == "publisher_subscribe" ||
+        packet.type() == "publisher_advertise")
+    {
+      msgs::Publish pub;
+      pub.ParseFromString(packet.serialized_data());
+      if (this->wanted.count(pub.topic()))
+        this->found.insert(pub.topic());
+    }
+    else if (packet.type() == "publishers_add")
+    {
+      msgs::Publishers pubs;
+      pubs.ParseFromString(packet.serialized_data());
+      this->publisherAdds += pubs.publisher_size();
+      ++this->publisherBatches;
+    }
+    else if (packet.type() == "topic_list")
+    {
+      msgs::GzString_V topics;
+      topics.ParseFromString(packet.serialized_data());
+      this->topicCount = topics.data_size();
+    }
+  }
+
+  /// \brief True if the node knows the publishers of all its
+  /// subscriptions.
+  /// \return True if connected to all its topics.
+  public: bool Ready()
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->found.size() == this->wanted.size();
+  }
+
+  /// \brief Index of the node.
+  public: unsigned int index;
+
+  /// \brief Connection to the master.
+  public: transport::ConnectionPtr conn;
+
+  /// \brief Topics subscribed to.
+  public: std::set<std::string> wanted;
+
+  /// \brief Subscribed topics with a known publisher.
+  public: std::set<std::string> found;
+
+  /// \brief Number of publishers advertised to this node.
+  public: unsigned int publisherAdds = 0;
+
+  /// \brief Number of notifications of advertised publishers.
+  public: unsigned int publisherBatches = 0;
+
+  /// \brief Number of topics in the last topic list, -1 while waiting.
+  public: int topicCount = -1;
+
+  /// \brief Protects the received state.
+  public: std::mutex mutex;
+};
+
+class MasterStressTest : public ServerFixture
+{
+  /// \brief Write the queues of all open nodes until a condition holds.
+  /// \param[in] _done Condition to wait for.
+  /// \return True if it held within 120 seconds.
+  protected: bool Wait(const std::function<bool()> &_done)
+  {
+    for (int i = 0; i < 120000; ++i)
+    {
+      for (auto &node : this->nodes)
+        node->Write();
+      if (_done())
+        return true;
+      common::Time::MSleep(1);
+    }
+    return false;
+  }
+
+  // Documentation inherited
+  protected: virtual void TearDown()
+  {
+    // Let pending reads finish before the nodes are destroyed
+    for (auto &node : this->nodes)
+      node->Close();
+    common::Time::MSleep(100);
+    this->nodes.clear();
+    ServerFixture::TearDown();
+  }
+
+  /// \brief Simulated nodes.
+  protected: std::vector<std::unique_ptr<StressNode>> nodes;
+};
+
+/////////////////////////////////////////////////
+// 50 nodes connect at once, each advertising 100 topics and subscribing to
+// the 100 topics of another node, then half of them disconnect.
+TEST_F(MasterStressTest, ConnectStorm)
+{
+  this->Load("worlds/empty.world");
+
+  for (unsigned int i = 0; i < g_nodeCount; ++i)
+  {
+    this->nodes.emplace_back(new StressNode(i));
+    ASSERT_TRUE(this->nodes.back()->Connect());
+  }
+
+  // Connection storm: advertisements and subscriptions interleaved, so
+  // subscribers learn about publishers both ways
+  common::Time start = common::Time::GetWallTime();
+  for (unsigned int t = 0; t < g_topicsPerNode; ++t)
+  {
+    for (unsigned int i = 0; i < g_nodeCount; ++i)
+    {
+      this->nodes[i]->Advertise(TopicName(i, t));
+      this->nodes[i]->Subscribe(TopicName((i + 1) % g_nodeCount, t));
+    }
+  }
+
+  EXPECT_TRUE(this->Wait([this]()
+  {
+    for (auto &node : this->nodes)
+      if (!node->Ready())
+        return false;
+    return true;
+  }));
+  common::Time connectTime = common::Time::GetWallTime() - start;
+
+  unsigned int adds = 0;
+  unsigned int batches = 0;
+  for (auto &node : this->nodes)
+  {
+    std::lock_guard<std::mutex> lock(node->mutex);
+    adds += node->publisherAdds;
+    batches += node->publisherBatches;
+  }
+
+  gzmsg << "[" << g_nodeCount << "] nodes with [" << g_nodeCount *
+    g_topicsPerNode << "] topics connected in [" << connectTime
+    << "] s, [" << adds << "] publishers advertised in [" << batches
+    << "] notifications\n";
+
+  // Disconnect storm: the master drops the topics of closed nodes
+  StressNode *observer = this->nodes.front().get();
+  observer->RequestTopics();
+  ASSERT_TRUE(this->Wait([observer]()
+  {
+    std::lock_guard<std::mutex> lock(observer->mutex);
+    return observer->topicCount >= 0;
+  }));
+  int allTopics = observer->topicCount;
+  gzmsg << "[" << allTopics << "] topics registered\n";
+  EXPECT_GE(allTopics, static_cast<int>(g_nodeCount * g_topicsPerNode));
+
+  start = common::Time::GetWallTime();
+  for (unsigned int i = g_nodeCount / 2; i < g_nodeCount; ++i)
+    this->nodes[i]->Close();
+
+  // Topics of closed nodes that open nodes still subscribe to remain
+  int remaining = allTopics -
+    static_cast<int>((g_nodeCount / 2 - 1) * g_topicsPerNode);
+  bool removed = false;
+  for (int i = 0; i < 6000 && !removed; ++i)
+  {
+    observer->RequestTopics();
+    ASSERT_TRUE(this->Wait([observer]()
+    {
+      std::lock_guard<std::mutex> lock(observer->mutex);
+      return observer->topicCount >= 0;
+    }));
+    removed = observer->topicCount <= remaining;
+    if (!removed)
+      common::Time::MSleep(10);
+  }
+  EXPECT_TRUE(removed);
+  common::Time disconnectTime = common::Time::GetWallTime() - start;
+
+  gzmsg << "[" << g_nodeCount / 2 << "] nodes disconnected in ["
+        << disconnectTime << "] s\n";
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "gazebo/gazebo_config.h"
+#include "gazebo/physics/World.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Number of calls to operator new in this process.
+static std::atomic<uint64_t> g_allocations(0);
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  ++g_allocations;
+  void *ptr = std::malloc(_size ? _size : 1);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+/////////////////////////////////////////////////
+void *operator new[](std::size_t _size)
+{
+  return operator new(_size);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+/////////////////////////////////////////////////
+void operator delete[](void *_ptr, std::size_t) noexcept
+{
+  std::free(_ptr);
+}
+
+class MessageArenaTest : public ServerFixture {};
+
+/////////////////////////////////////////////////
+/// \brief Fill a pose message as World::ProcessMessages does.
+/// \param[out] _msg Message to fill.
+/// \param[in] _count Number of poses.
+void FillPoses(msgs::PosesStamped &_msg, const int _count)
+{
+  msgs::Set(_msg.mutable_time(), common::Time(1, 0));
+  for (int i = 0; i < _count; ++i)
+  {
+    msgs::Pose *pose = _msg.add_pose();
+    pose->set_name("sphere_" + std::to_string(i) + "::link");
+    pose->set_id(i);
+    msgs::Set(pose, ignition::math::Pose3d(i, 0, 1, 0, 0, 0));
+  }
+}
+
+/////////////////////////////////////////////////
+// Allocations and time to build, copy for publishing, and parse a large
+// pose message, with and without arenas.
+TEST_F(MessageArenaTest, PosesStamped)
+{
+  const int poses = 400;
+  const int iterations = 500;
+  std::string data;
+
+  // Heap messages, as before arenas
+  uint64_t heapAllocations = g_allocations;
+  common::Time heapTime = common::Time::GetWallTime();
+  for (int i = 0; i < iterations; ++i)
+  {
+    msgs::PosesStamped msg;
+    FillPoses(msg, poses);
+
+    boost::shared_ptr<google::protobuf::Message> copy(msg.New());
+    copy->CopyFrom(msg);
+    copy->SerializeToString(&data);
+
+    boost::shared_ptr<msgs::PosesStamped> parsed(new msgs::PosesStamped);
+    parsed->ParseFromString(data);
+    EXPECT_EQ(parsed->pose_size(), poses);
+  }
+  heapTime = common::Time::GetWallTime() - heapTime;
+  heapAllocations = g_allocations - heapAllocations;
+
+  // Arena messages, as built by the world and parsed by the transport
+  uint64_t arenaAllocations = g_allocations;
+  common::Time arenaTime = common::Time::GetWallTime();
+  for (int i = 0; i < iterations; ++i)
+  {
+    auto msg = msgs::NewArenaMessage<msgs::PosesStamped>(poses *
+        (sizeof(msgs::Pose) + sizeof(msgs::Vector3d) +
+         sizeof(msgs::Quaternion)));
+    FillPoses(*msg, poses);
+    msg->SerializeToString(&data);
+
+    auto parsed = msgs::NewArenaMessage<msgs::PosesStamped>(2 * data.size());
+    parsed->ParseFromString(data);
+    EXPECT_EQ(parsed->pose_size(), poses);
+  }
+  arenaTime = common::Time::GetWallTime() - arenaTime;
+  arenaAllocations = g_allocations - arenaAllocations;
+
+  gzmsg << "Building, copying and parsing [" << iterations << "] messages "
+        << "of [" << poses << "] poses\n"
+        << "  heap:  [" << heapAllocations / iterations
+        << "] allocations per message, [" << heapTime << "] s\n"
+        << "  arena: [" << arenaAllocations / iterations
+        << "] allocations per message, [" << arenaTime << "] s\n";
+
+  // Names longer than the small string buffer are still allocated on the
+  // heap, once when built and once when parsed
+#ifdef HAVE_PROTOBUF_ARENA
+  EXPECT_LT(arenaAllocations * 4, heapAllocations);
+#endif
+}
+
+/////////////////////////////////////////////////
+unsigned int g_poseMsgs = 0;
+void OnPoses(ConstPosesStampedPtr &/*_msg*/)
+{
+  ++g_poseMsgs;
+}
+
+/////////////////////////////////////////////////
+// Allocations and time of world steps that publish the poses of 400
+// falling spheres. Run before and after a change to compare.
+TEST_F(MessageArenaTest, WorldStep)
+{
+  Load("worlds/link_state_grid.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub = node->Subscribe("~/pose/info", &OnPoses);
+
+  // Let the subscription reach the world
+  world->Step(10);
+
+  const unsigned int steps = 1000;
+  uint64_t allocations = g_allocations;
+  common::Time stepTime = common::Time::GetWallTime();
+  world->Step(steps);
+  stepTime = common::Time::GetWallTime() - stepTime;
+  allocations = g_allocations - allocations;
+
+  gzmsg << "Stepping [" << steps << "] times took [" << stepTime
+        << "] s with [" << allocations / steps
+        << "] allocations per step, [" << g_poseMsgs
+        << "] pose messages received\n";
+
+  EXPECT_GT(g_poseMsgs, 0u);
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class RayCastTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+// A 64 x 1800 rays 3D lidar among a few hundred shapes: all the rays cast
+// at once against a tree of the collisions, on several threads, compared
+// with updating one ray at a time.
+TEST_F(RayCastTest, Lidar3D)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Static shapes in rings around the lidar
+  const std::vector<std::string> geometries = {
+    "<box><size>1 1 2</size></box>",
+    "<sphere><radius>0.6</radius></sphere>",
+    "<cylinder><radius>0.4</radius><length>3</length></cylinder>"};
+  const unsigned int shapeCount = 300;
+  for (unsigned int i = 0; i < shapeCount; ++i)
+  {
+    double angle = i * 2.0 * IGN_PI / 50;
+    double radius = 5.0 + (i / 50) * 4.0;
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='shape_" << i << "'>"
+      << "<static>true</static>"
+      << "<pose>" << radius * cos(angle) << " " << radius * sin(angle)
+      << " " << (i % 3) * 0.5 << " 0 0 " << angle << "</pose>"
+      << "<link name='link'><collision name='collision'>"
+      << "<laser_retro>" << i % 7 << "</laser_retro>"
+      << "<geometry>" << geometries[i % geometries.size()] << "</geometry>"
+      << "</collision></link></model></sdf>";
+    this->SpawnSDF(sdf.str());
+  }
+  this->WaitUntilEntitySpawn("shape_" + std::to_string(shapeCount - 1),
+      100, 100);
+
+  const unsigned int horizontal = 1800;
+  const unsigned int vertical = 64;
+  std::ostringstream sdf;
+  sdf << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='lidar'>"
+    << "<static>true</static>"
+    << "<pose>0 0 1 0 0 0</pose>"
+    << "<link name='link'>"
+    << "<sensor name='lidar' type='ray'>"
+    << "<update_rate>10</update_rate>"
+    << "<ray><scan>"
+    << "<horizontal><samples>" << horizontal << "</samples>"
+    << "<min_angle>-3.14159</min_angle><max_angle>3.14159</max_angle>"
+    << "</horizontal>"
+    << "<vertical><samples>" << vertical << "</samples>"
+    << "<min_angle>-0.4</min_angle><max_angle>0.2</max_angle>"
+    << "</vertical></scan>"
+    << "<range><min>0.2</min><max>40</max></range></ray>"
+    << "</sensor></link></model></sdf>";
+  this->SpawnSDF(sdf.str());
+  this->WaitUntilSensorSpawn("lidar::link::lidar", 100, 100);
+
+  sensors::RaySensorPtr lidar = std::dynamic_pointer_cast<sensors::RaySensor>(
+      sensors::SensorManager::Instance()->GetSensor("lidar::link::lidar"));
+  ASSERT_TRUE(lidar != nullptr);
+  physics::MultiRayShapePtr shape = lidar->LaserShape();
+  ASSERT_TRUE(shape != nullptr);
+  ASSERT_EQ(shape->RayCount(), horizontal * vertical);
+  world->Step(1);
+
+  // Update one ray at a time
+  const int iterations = 5;
+  shape->SetBatchedUpdates(false);
+  common::Time start = common::Time::GetWallTime();
+  for (int i = 0; i < iterations; ++i)
+    shape->Update();
+  double perRayTime =
+    (common::Time::GetWallTime() - start).Double() / iterations;
+  std::vector<double> ranges = shape->Ranges();
+  std::vector<double> retros = shape->Retros();
+
+  // All the rays at once
+  shape->SetBatchedUpdates(true);
+  start = common::Time::GetWallTime();
+  for (int i = 0; i < iterations; ++i)
+    shape->Update();
+  double batchTime =
+    (common::Time::GetWallTime() - start).Double() / iterations;
+
+  ASSERT_EQ(shape->Ranges().size(), ranges.size());
+  unsigned int hits = 0;
+  for (unsigned int i = 0; i < ranges.size(); ++i)
+  {
+    EXPECT_NEAR(shape->Ranges()[i], ranges[i], 1e-6) << i;
+    EXPECT_DOUBLE_EQ(shape->Retros()[i], retros[i]) << i;
+    if (ranges[i] < shape->GetMaxRange())
+      ++hits;
+  }
+  EXPECT_GT(hits, ranges.size() / 10);
+
+  // Moving a shape between steps is seen by the next cast
+  physics::ModelPtr model = world->ModelByName("shape_0");
+  ASSERT_TRUE(model != nullptr);
+  model->SetWorldPose(ignition::math::Pose3d(100, 100, 0, 0, 0, 0));
+  shape->Update();
+  std::vector<double> moved = shape->Ranges();
+  shape->SetBatchedUpdates(false);
+  shape->Update();
+  for (unsigned int i = 0; i < moved.size(); ++i)
+    EXPECT_NEAR(moved[i], shape->Ranges()[i], 1e-6) << i;
+
+  gzmsg << "[" << ranges.size() << "] rays, [" << hits << "] hits among ["
+        << shapeCount << "] shapes: [" << perRayTime * 1000.0
+        << " ms] one ray at a time, [" << batchTime * 1000.0
+        << " ms] at once\n";
+
+  // The lidar still publishes scans
+  lidar->SetActive(true);
+  world->Step(100);
+  std::vector<double> scan;
+  lidar->Ranges(scan);
+  EXPECT_EQ(scan.size(), horizontal * vertical);
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
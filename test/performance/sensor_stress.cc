@@ -16,6 +16,11 @@
 */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "gazebo/physics/PhysicsIface.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -100,6 +105,105 @@ TEST_F(SensorStress_TEST, ResetWorldStressTest)
   }
 }
 
+/////////////////////////////////////////////////
+/// \brief A thousand non-rendering sensors at mixed rates, updated by the
+/// sensor worker threads while the world steps. Every sensor must get its
+/// updates, and the scheduling latency is printed.
+TEST_F(SensorStress_TEST, ThousandSensors)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  struct SensorType
+  {
+    std::string type;
+    double rate;
+    std::string sdf;
+  };
+  std::vector<SensorType> types = {
+    {"imu", 1000, "<imu/>"},
+    {"imu", 250, "<imu/>"},
+    {"altimeter", 100, "<altimeter/>"},
+    {"altimeter", 50, "<altimeter/>"},
+    {"magnetometer", 100, "<magnetometer/>"},
+    {"magnetometer", 20, "<magnetometer/>"},
+    {"imu", 500, "<imu/>"},
+    {"altimeter", 200, "<altimeter/>"},
+    {"magnetometer", 10, "<magnetometer/>"},
+    {"ray", 10, "<ray><scan><horizontal><samples>90</samples>"
+      "<min_angle>-1.57</min_angle><max_angle>1.57</max_angle>"
+      "</horizontal></scan><range><min>0.1</min><max>10</max></range></ray>"}};
+
+  const unsigned int modelCount = 100;
+  std::vector<std::string> names;
+  for (unsigned int i = 0; i < modelCount; ++i)
+  {
+    std::ostringstream name;
+    name << "model_" << i;
+
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='" << name.str() << "'>"
+      << "<pose>" << (i % 10) * 2.0 << " " << (i / 10) * 2.0
+      << " 0.5 0 0 0</pose>"
+      << "<link name='link'>"
+      << "<collision name='collision'>"
+      << "<geometry><box><size>1 1 1</size></box></geometry>"
+      << "</collision>";
+    for (unsigned int s = 0; s < types.size(); ++s)
+    {
+      sdf << "<sensor name='sensor_" << s << "' type='" << types[s].type
+        << "'>"
+        << "<always_on>true</always_on>"
+        << "<update_rate>" << types[s].rate << "</update_rate>"
+        << types[s].sdf
+        << "</sensor>";
+      names.push_back(name.str() + "::link::sensor_" + std::to_string(s));
+    }
+    sdf << "</link></model></sdf>";
+
+    this->SpawnSDF(sdf.str());
+    this->WaitUntilEntitySpawn(name.str(), 100, 100);
+    this->WaitUntilSensorSpawn(names.back(), 100, 100);
+  }
+
+  // One simulated second, giving the workers time to keep up
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+  common::Time start = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < 1000; ++i)
+  {
+    world->Step(1);
+    common::Time::Sleep(common::Time(0, 100000));
+  }
+  double wallTime = (common::Time::GetWallTime() - start).Double();
+
+  double meanLatency = 0;
+  double maxLatency = 0;
+  double meanDuration = 0;
+  double maxDuration = 0;
+  uint64_t updates = 0;
+  for (auto const &name : names)
+  {
+    sensors::SensorUpdateStats stats;
+    ASSERT_TRUE(mgr->UpdateStats("default::" + name, stats)) << name;
+    EXPECT_GT(stats.count, 0u) << name;
+    updates += stats.count;
+    meanLatency += stats.meanLatency * stats.count;
+    meanDuration += stats.meanDuration * stats.count;
+    maxLatency = std::max(maxLatency, stats.maxLatency);
+    maxDuration = std::max(maxDuration, stats.maxDuration);
+  }
+  ASSERT_GT(updates, 0u);
+
+  gzmsg << "[" << names.size() << "] sensors, [" << updates
+        << "] updates in [" << wallTime << " s]: latency mean ["
+        << meanLatency / updates * 1e3 << " ms] max ["
+        << maxLatency * 1e3 << " ms], update mean ["
+        << meanDuration / updates * 1e6 << " us] max ["
+        << maxDuration * 1e6 << " us]\n";
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
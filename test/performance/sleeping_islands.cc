@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+class SleepingIslandsTest : public ServerFixture {};
+
+/////////////////////////////////////////////////
+/// \brief Step the world and return the wall time it took.
+common::Time StepTime(physics::WorldPtr _world, const unsigned int _steps)
+{
+  common::Time start = common::Time::GetWallTime();
+  _world->Step(_steps);
+  return common::Time::GetWallTime() - start;
+}
+
+/////////////////////////////////////////////////
+TEST_F(SleepingIslandsTest, Warehouse)
+{
+  Load("worlds/warehouse.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+  ASSERT_EQ(physics->GetType(), "ode");
+
+  // Let the boxes settle and get disabled by ODE
+  world->Step(2000);
+
+  const unsigned int steps = 2000;
+  common::Time awakeTime = StepTime(world, steps);
+
+  EXPECT_TRUE(physics->SetParam("sleeping_islands", true));
+  EXPECT_TRUE(boost::any_cast<bool>(physics->GetParam("sleeping_islands")));
+  world->Step(1);
+  int sleeping = boost::any_cast<int>(physics->GetParam("sleeping_models"));
+  // 10 shelves with 24 boxes each, nearly all of them at rest
+  EXPECT_GT(sleeping, 200);
+
+  common::Time sleepingTime = StepTime(world, steps);
+
+  gzdbg << "Stepping [" << steps << "] times with [" << sleeping
+        << "] models at rest took [" << awakeTime << "] in the top-level "
+        << "space, [" << sleepingTime << "] with sleeping islands\n";
+  EXPECT_LT(sleepingTime, awakeTime);
+
+  // Teleporting a box wakes it up, it falls onto the floor
+  physics::ModelPtr model = world->ModelByName("box_0_2_0");
+  ASSERT_TRUE(model != nullptr);
+  int wakeCount = boost::any_cast<int>(physics->GetParam("wake_count"));
+  model->SetWorldPose(ignition::math::Pose3d(-3, -2, 1, 0, 0, 0));
+  world->Step(1);
+  EXPECT_EQ(boost::any_cast<int>(physics->GetParam("wake_count")),
+      wakeCount + 1);
+  EXPECT_EQ(boost::any_cast<int>(physics->GetParam("sleeping_models")),
+      sleeping - 1);
+  world->Step(500);
+  EXPECT_NEAR(model->WorldPose().Pos().Z(), 0.15, 0.01);
+
+  // A force on a sleeping box wakes it up, and it pushes its neighbor
+  physics::ModelPtr pushed = world->ModelByName("box_1_0_1");
+  physics::ModelPtr neighbor = world->ModelByName("box_1_0_2");
+  ASSERT_TRUE(pushed != nullptr);
+  ASSERT_TRUE(neighbor != nullptr);
+  ignition::math::Pose3d neighborPose = neighbor->WorldPose();
+  for (unsigned int i = 0; i < 200; ++i)
+  {
+    pushed->GetLink()->AddForce(ignition::math::Vector3d(100, 0, 0));
+    world->Step(1);
+  }
+  EXPECT_GT(neighbor->WorldPose().Pos().X(), neighborPose.Pos().X() + 0.01);
+
+  // Everything comes back to rest
+  world->Step(3000);
+  EXPECT_GE(boost::any_cast<int>(physics->GetParam("sleep_count")),
+      sleeping + 3);
+
+  // Turning the feature off puts all the models back
+  EXPECT_TRUE(physics->SetParam("sleeping_islands", false));
+  EXPECT_EQ(boost::any_cast<int>(physics->GetParam("sleeping_models")), 0);
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
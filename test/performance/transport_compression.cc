@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Fill an image message like a camera looking at a simple scene:
+/// sky gradient, checkered ground and a box.
+/// \param[out] _msg Message to fill.
+/// \param[in] _width Image width.
+/// \param[in] _height Image height.
+/// \param[in] _noise Standard deviation of the camera noise, in intensity
+/// levels.
+void FillImage(msgs::ImageStamped &_msg, const unsigned int _width,
+    const unsigned int _height, const double _noise)
+{
+  std::string data(_width * _height * 3, 0);
+  unsigned int seed = 1;
+  for (unsigned int y = 0; y < _height; ++y)
+  {
+    for (unsigned int x = 0; x < _width; ++x)
+    {
+      double rgb[3];
+      if (y < _height / 2)
+      {
+        rgb[0] = 120 + 60.0 * y / _height;
+        rgb[1] = 160 + 40.0 * y / _height;
+        rgb[2] = 230;
+      }
+      else
+      {
+        bool dark = ((x / 40) + (y / 20)) % 2 == 0;
+        rgb[0] = rgb[1] = rgb[2] = dark ? 90 : 150;
+      }
+      if (x > _width / 3 && x < _width / 2 && y > _height / 3 &&
+          y < _height * 2 / 3)
+      {
+        rgb[0] = 200;
+        rgb[1] = 40;
+        rgb[2] = 30;
+      }
+
+      for (int c = 0; c < 3; ++c)
+      {
+        if (_noise > 0)
+        {
+          // Sum of uniform samples, close enough to a gaussian
+          double n = 0;
+          for (int i = 0; i < 4; ++i)
+          {
+            seed = seed * 1103515245u + 12345u;
+            n += ((seed >> 16) & 0x7FFF) / 32767.0 - 0.5;
+          }
+          rgb[c] += n * _noise * std::sqrt(3.0);
+        }
+        data[(y * _width + x) * 3 + c] = static_cast<char>(
+            std::max(0.0, std::min(255.0, std::round(rgb[c]))));
+      }
+    }
+  }
+
+  msgs::Set(_msg.mutable_time(), common::Time::GetWallTime());
+  _msg.mutable_image()->set_width(_width);
+  _msg.mutable_image()->set_height(_height);
+  _msg.mutable_image()->set_pixel_format(3);
+  _msg.mutable_image()->set_step(_width * 3);
+  _msg.mutable_image()->set_data(data);
+}
+
+/// \brief Reads messages from a connection.
+class Receiver
+{
+  /// \brief Start reading from an accepted connection.
+  /// \param[in] _conn Connection to read from.
+  public: void Start(const transport::ConnectionPtr &_conn)
+  {
+    this->conn = _conn;
+    this->conn->AsyncRead(boost::bind(&Receiver::OnData, this, _1));
+  }
+
+  /// \brief Called for each message read, after decompression.
+  /// \param[in] _data Serialized message.
+  public: void OnData(const std::string &_data)
+  {
+    this->conn->AsyncRead(boost::bind(&Receiver::OnData, this, _1));
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->messages.push_back(_data);
+  }
+
+  /// \brief Wait until a number of messages are received.
+  /// \param[in] _count Number of messages.
+  /// \param[in] _sender Connection to keep writing from.
+  /// \return True if they were received within 30 seconds.
+  public: bool Wait(const size_t _count,
+                    const transport::ConnectionPtr &_sender)
+  {
+    for (int i = 0; i < 30000; ++i)
+    {
+      _sender->ProcessWriteQueue();
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->messages.size() >= _count)
+          return true;
+      }
+      common::Time::MSleep(1);
+    }
+    return false;
+  }
+
+  /// \brief Accepted connection.
+  public: transport::ConnectionPtr conn;
+
+  /// \brief Messages received.
+  public: std::vector<std::string> messages;
+
+  /// \brief Protects the messages.
+  public: std::mutex mutex;
+};
+
+class TransportCompressionTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+// CPU time against bytes saved by each codec, for clean and noisy camera
+// images.
+TEST_F(TransportCompressionTest, Codecs)
+{
+  struct Stream
+  {
+    std::string name;
+    unsigned int width;
+    unsigned int height;
+    double noise;
+  };
+  std::vector<Stream> streams = {
+    {"VGA", 640, 480, 0.0},
+    {"VGA noisy", 640, 480, 1.8},
+    {"720p", 1280, 720, 0.0}};
+
+  const int iterations = 20;
+  for (auto const &stream : streams)
+  {
+    msgs::ImageStamped msg;
+    FillImage(msg, stream.width, stream.height, stream.noise);
+    std::string data;
+    msg.SerializeToString(&data);
+
+    for (auto codec : {transport::CompressionCodec::ZLIB,
+                       transport::CompressionCodec::LZ4})
+    {
+      if (!transport::Compression::Available(codec))
+        continue;
+
+      std::string compressed, decompressed;
+      common::Time start = common::Time::GetWallTime();
+      for (int i = 0; i < iterations; ++i)
+        ASSERT_TRUE(transport::Compression::Compress(codec, data, compressed));
+      double compressTime =
+        (common::Time::GetWallTime() - start).Double() / iterations;
+
+      start = common::Time::GetWallTime();
+      for (int i = 0; i < iterations; ++i)
+      {
+        ASSERT_TRUE(transport::Compression::Decompress(codec, compressed,
+              decompressed));
+      }
+      double decompressTime =
+        (common::Time::GetWallTime() - start).Double() / iterations;
+      EXPECT_EQ(decompressed, data);
+
+      gzmsg << stream.name << " [" << transport::Compression::Name(codec)
+            << "]: [" << data.size() << "] -> [" << compressed.size()
+            << "] bytes ("
+            << 100.0 * compressed.size() / data.size() << "%), compress ["
+            << compressTime * 1000.0 << " ms] ("
+            << data.size() / compressTime / (1024 * 1024)
+            << " MB/s), decompress [" << decompressTime * 1000.0
+            << " ms]\n";
+
+      if (stream.noise <= 0)
+        EXPECT_LT(compressed.size(), data.size() / 4);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+// Images sent compressed to several subscribers through connections,
+// compressed once per message.
+TEST_F(TransportCompressionTest, Connections)
+{
+  // Connections only deliver data while transport is running
+  this->Load("worlds/empty.world");
+
+  const unsigned int subscriberCount = 3;
+  std::vector<std::unique_ptr<Receiver>> receivers;
+  std::vector<transport::ConnectionPtr> servers;
+  std::vector<transport::ConnectionPtr> senders;
+  for (unsigned int i = 0; i < subscriberCount; ++i)
+  {
+    receivers.emplace_back(new Receiver());
+    servers.emplace_back(new transport::Connection());
+    servers.back()->Listen(0,
+        boost::bind(&Receiver::Start, receivers.back().get(), _1));
+
+    senders.emplace_back(new transport::Connection());
+    ASSERT_TRUE(senders.back()->Connect(servers.back()->GetLocalAddress(),
+          servers.back()->GetLocalPort()));
+    senders.back()->SetFrameVersion(transport::FrameHeader::LatestVersion);
+  }
+
+  msgs::ImageStamped msg;
+  FillImage(msg, 640, 480, 0.0);
+
+  const unsigned int count = 50;
+  std::vector<std::string> sent;
+  uint64_t rawBytes = 0;
+  uint64_t wireBytes = 0;
+  common::Time compressTime;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    msgs::Set(msg.mutable_time(), common::Time(i, 0));
+    transport::BufferPtr data(new std::string);
+    msg.SerializeToString(data.get());
+    sent.push_back(*data);
+
+    common::Time start = common::Time::GetWallTime();
+    transport::CompressedData payloads(data);
+    for (auto &sender : senders)
+    {
+      transport::CompressionCodec codec = transport::CompressionCodec::ZLIB;
+      const transport::BufferPtr &payload = payloads.Payload(codec,
+          transport::Compression::DefaultThreshold);
+      EXPECT_EQ(codec, transport::CompressionCodec::ZLIB);
+      sender->EnqueueMsg(payload, boost::function<void(uint32_t)>(), 0,
+          static_cast<uint8_t>(codec));
+      rawBytes += data->size();
+      wireBytes += payload->size();
+    }
+    compressTime += common::Time::GetWallTime() - start;
+  }
+
+  for (unsigned int i = 0; i < subscriberCount; ++i)
+  {
+    ASSERT_TRUE(receivers[i]->Wait(count, senders[i]));
+    std::lock_guard<std::mutex> lock(receivers[i]->mutex);
+    ASSERT_EQ(receivers[i]->messages.size(), count);
+    for (unsigned int m = 0; m < count; ++m)
+      EXPECT_EQ(receivers[i]->messages[m], sent[m]);
+  }
+
+  gzmsg << "[" << count << "] VGA images to [" << subscriberCount
+        << "] subscribers: [" << rawBytes << "] bytes sent as ["
+        << wireBytes << "], [" << compressTime.Double() * 1000.0 / count
+        << " ms] per image\n";
+  EXPECT_LT(wireBytes * 4, rawBytes);
+
+  for (auto &sender : senders)
+    sender->Shutdown();
+  for (auto &server : servers)
+    server->Shutdown();
+  for (auto &receiver : receivers)
+    receiver->conn->Shutdown();
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
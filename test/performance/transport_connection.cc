@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+/// \brief Reads stamped messages from a connection and records their
+/// latency.
+template<typename M>
+class Receiver
+{
+  /// \brief Destructor
+  public: ~Receiver()
+  {
+    if (this->conn)
+      this->conn->Shutdown();
+  }
+
+  /// \brief Start reading from an accepted connection.
+  /// \param[in] _conn Connection to read from.
+  public: void Start(const transport::ConnectionPtr &_conn)
+  {
+    this->conn = _conn;
+    this->conn->AsyncRead(boost::bind(&Receiver::OnData, this, _1));
+  }
+
+  /// \brief Called for each message read.
+  /// \param[in] _data Serialized message.
+  public: void OnData(const std::string &_data)
+  {
+    this->conn->AsyncRead(boost::bind(&Receiver::OnData, this, _1));
+
+    M msg;
+    msg.ParseFromString(_data);
+    common::Time now = common::Time::GetWallTime();
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->latencies.push_back(
+        (now - msgs::Convert(msg.time())).Double() * 1000.0);
+    this->lastTime = now;
+  }
+
+  /// \brief Wait until a number of messages are received.
+  /// \param[in] _count Number of messages.
+  /// \param[in] _sender Connection to keep writing from, since no
+  /// ConnectionManager update drives its queue.
+  /// \return True if they were received within 30 seconds.
+  public: bool Wait(const size_t _count,
+                    const transport::ConnectionPtr &_sender)
+  {
+    for (int i = 0; i < 30000; ++i)
+    {
+      _sender->ProcessWriteQueue();
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->latencies.size() >= _count)
+          return true;
+      }
+      common::Time::MSleep(1);
+    }
+    return false;
+  }
+
+  /// \brief Print latency statistics.
+  /// \param[in] _name Name of the test case.
+  public: void Report(const std::string &_name)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->latencies.empty())
+      return;
+
+    double sum = 0;
+    for (auto const latency : this->latencies)
+      sum += latency;
+    std::sort(this->latencies.begin(), this->latencies.end());
+
+    gzdbg << _name << ": [" << this->latencies.size()
+          << "] messages, latency mean ["
+          << sum / this->latencies.size() << " ms] p99 ["
+          << this->latencies[this->latencies.size() * 99 / 100]
+          << " ms]\n";
+  }
+
+  /// \brief Accepted connection.
+  public: transport::ConnectionPtr conn;
+
+  /// \brief Latency of each message in ms.
+  public: std::vector<double> latencies;
+
+  /// \brief Time the last message was received.
+  public: common::Time lastTime;
+
+  /// \brief Protects the latencies.
+  public: std::mutex mutex;
+};
+
+/// \brief Connect a sender to a receiver through a local server.
+class TransportConnectionTest : public ServerFixture
+{
+  /// \brief Listen and connect.
+  /// \param[in] _accept Called with the accepted connection.
+  protected: void Connect(
+                 const transport::Connection::AcceptCallback &_accept)
+  {
+    // Connections only deliver data while transport is running
+    this->Load("worlds/empty.world");
+
+    this->server.reset(new transport::Connection());
+    this->server->Listen(0, _accept);
+
+    this->sender.reset(new transport::Connection());
+    ASSERT_TRUE(this->sender->Connect(this->server->GetLocalAddress(),
+          this->server->GetLocalPort()));
+  }
+
+  /// \brief Send a message and start writing it, as ConnectionManager
+  /// does on each update.
+  /// \param[in] _data Serialized message.
+  protected: void Send(const std::string &_data)
+  {
+    this->sender->EnqueueMsg(_data);
+    this->sender->ProcessWriteQueue();
+  }
+
+  // Documentation inherited
+  protected: virtual void TearDown()
+  {
+    if (this->sender)
+      this->sender->Shutdown();
+    if (this->server)
+      this->server->Shutdown();
+    ServerFixture::TearDown();
+  }
+
+  /// \brief Listening connection.
+  protected: transport::ConnectionPtr server;
+
+  /// \brief Sending connection.
+  protected: transport::ConnectionPtr sender;
+};
+
+/////////////////////////////////////////////////
+// 10k small pose messages per second, written in batches while a
+// previous write is in flight.
+TEST_F(TransportConnectionTest, SmallMessages)
+{
+  Receiver<msgs::PoseStamped> receiver;
+  this->Connect(boost::bind(&Receiver<msgs::PoseStamped>::Start,
+        &receiver, _1));
+
+  msgs::PoseStamped msg;
+  msgs::Set(msg.mutable_pose(), ignition::math::Pose3d(1, 2, 3, 0, 0, 0));
+
+  const unsigned int count = 20000;
+  common::Time period(0, 100000);
+  common::Time start = common::Time::GetWallTime();
+  common::Time next = start;
+  std::string data;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    msgs::Set(msg.mutable_time(), common::Time::GetWallTime());
+    msg.SerializeToString(&data);
+    this->Send(data);
+
+    next += period;
+    common::Time remaining = next - common::Time::GetWallTime();
+    if (remaining > common::Time::Zero)
+      common::Time::Sleep(remaining);
+  }
+
+  EXPECT_TRUE(receiver.Wait(count, this->sender));
+  receiver.Report("10 kHz poses");
+}
+
+/////////////////////////////////////////////////
+// 1 MB images, at 100 Hz and then as fast as possible.
+TEST_F(TransportConnectionTest, LargeMessages)
+{
+  Receiver<msgs::ImageStamped> receiver;
+  this->Connect(boost::bind(&Receiver<msgs::ImageStamped>::Start,
+        &receiver, _1));
+
+  msgs::ImageStamped msg;
+  msg.mutable_image()->set_width(1024);
+  msg.mutable_image()->set_height(341);
+  msg.mutable_image()->set_pixel_format(3);
+  msg.mutable_image()->set_step(1024 * 3);
+  msg.mutable_image()->set_data(std::string(1024 * 341 * 3, 'x'));
+
+  const unsigned int count = 200;
+  common::Time period(0, 10000000);
+  common::Time next = common::Time::GetWallTime();
+  std::string data;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    msgs::Set(msg.mutable_time(), common::Time::GetWallTime());
+    msg.SerializeToString(&data);
+    this->Send(data);
+
+    next += period;
+    common::Time remaining = next - common::Time::GetWallTime();
+    if (remaining > common::Time::Zero)
+      common::Time::Sleep(remaining);
+  }
+  EXPECT_TRUE(receiver.Wait(count, this->sender));
+  receiver.Report("100 Hz images");
+
+  common::Time start = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    msgs::Set(msg.mutable_time(), common::Time::GetWallTime());
+    msg.SerializeToString(&data);
+    this->Send(data);
+  }
+  EXPECT_TRUE(receiver.Wait(count * 2, this->sender));
+  double elapsed = (receiver.lastTime - start).Double();
+  gzdbg << "Burst of [" << count << "] images: ["
+        << count * data.size() / elapsed / (1024 * 1024) << " MB/s]\n";
+
+  // Images are read into pooled buffers
+  EXPECT_GT(transport::BufferPool::Instance()->ReuseCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+// Pose messages with binary frame headers, as negotiated by subscribers.
+TEST_F(TransportConnectionTest, BinaryFrames)
+{
+  Receiver<msgs::PoseStamped> receiver;
+  this->Connect(boost::bind(&Receiver<msgs::PoseStamped>::Start,
+        &receiver, _1));
+  this->sender->SetFrameTypeId(
+      transport::FrameHeader::TypeId(msgs::PoseStamped().GetTypeName()));
+  this->sender->SetFrameVersion(transport::FrameHeader::LatestVersion);
+
+  msgs::PoseStamped msg;
+  msgs::Set(msg.mutable_pose(), ignition::math::Pose3d(1, 2, 3, 0, 0, 0));
+
+  const unsigned int count = 10000;
+  std::string data;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    msgs::Set(msg.mutable_time(), common::Time::GetWallTime());
+    msg.SerializeToString(&data);
+    this->Send(data);
+  }
+
+  EXPECT_TRUE(receiver.Wait(count, this->sender));
+  receiver.Report("Burst of binary frames");
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
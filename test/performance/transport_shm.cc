@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2019 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gazebo/gazebo.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/transport.hh"
+
+using namespace gazebo;
+
+/// \brief Number of images published in each phase, 10 s at 100 Hz.
+static const unsigned int kImageCount = 1000;
+
+/// \brief Image size, 1 MB of RGB data.
+static const unsigned int kImageWidth = 1024;
+static const unsigned int kImageHeight = 341;
+
+/// \brief Results reported by a subscriber process.
+struct ShmResult
+{
+  /// \brief Number of images received.
+  unsigned int count;
+
+  /// \brief Number of shared memory rings used by the subscriber.
+  unsigned int rings;
+
+  /// \brief Mean latency in ms.
+  double mean;
+
+  /// \brief 99th percentile latency in ms.
+  double p99;
+
+  /// \brief Received data rate in MB/s.
+  double rate;
+};
+
+/// \brief Latencies measured by a subscriber process, in ms.
+std::vector<double> g_latencies;
+
+/// \brief Bytes received by a subscriber process.
+double g_bytes = 0;
+
+/// \brief Time the first image was received.
+common::Time g_firstTime;
+
+/// \brief Time the last image was received.
+common::Time g_lastTime;
+
+/// \brief Protects the subscriber data.
+std::mutex g_mutex;
+
+/////////////////////////////////////////////////
+void ImageCB(ConstImageStampedPtr &_msg)
+{
+  common::Time now = common::Time::GetWallTime();
+  std::lock_guard<std::mutex> lock(g_mutex);
+  if (g_latencies.empty())
+    g_firstTime = now;
+  g_lastTime = now;
+  g_latencies.push_back(
+      (now - msgs::Convert(_msg->time())).Double() * 1000.0);
+  g_bytes += _msg->image().data().size();
+}
+
+/////////////////////////////////////////////////
+/// \brief Subscribe to a topic in a child process, and write the results
+/// to a pipe once all the images are received or the wait times out.
+/// \param[in] _topic Topic to subscribe to.
+/// \param[in] _shm Value of GAZEBO_TRANSPORT_SHM.
+/// \param[in] _fd Write end of the pipe.
+void RunSubscriber(const std::string &_topic, const std::string &_shm,
+    const int _fd)
+{
+  setenv("GAZEBO_TRANSPORT_SHM", _shm.c_str(), 1);
+
+  if (!transport::init())
+    _exit(1);
+  transport::run();
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub = node->Subscribe(_topic, &ImageCB);
+
+  ShmResult result = {};
+  // Give the publisher time for both phases
+  for (int i = 0; i < 600; ++i)
+  {
+    common::Time::MSleep(100);
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (g_latencies.size() >= kImageCount)
+      break;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    result.count = g_latencies.size();
+    result.rings = transport::ShmManager::Instance()->RingCount();
+    if (!g_latencies.empty())
+    {
+      double sum = 0;
+      for (auto const latency : g_latencies)
+        sum += latency;
+      result.mean = sum / g_latencies.size();
+
+      std::sort(g_latencies.begin(), g_latencies.end());
+      result.p99 = g_latencies[
+        std::min(g_latencies.size() - 1, g_latencies.size() * 99 / 100)];
+
+      double elapsed = (g_lastTime - g_firstTime).Double();
+      if (elapsed > 0)
+        result.rate = g_bytes / elapsed / (1024.0 * 1024.0);
+    }
+  }
+
+  if (write(_fd, &result, sizeof(result)) != sizeof(result))
+    _exit(1);
+
+  // Wait to be killed
+  while (true)
+    common::Time::MSleep(500);
+}
+
+/////////////////////////////////////////////////
+/// \brief Publish images at 100 Hz, stamped with the wall time.
+/// \param[in] _pub Publisher to use.
+void PublishImages(transport::PublisherPtr _pub)
+{
+  msgs::ImageStamped msg;
+  msg.mutable_image()->set_width(kImageWidth);
+  msg.mutable_image()->set_height(kImageHeight);
+  msg.mutable_image()->set_pixel_format(3);
+  msg.mutable_image()->set_step(kImageWidth * 3);
+  msg.mutable_image()->set_data(
+      std::string(kImageWidth * kImageHeight * 3, 'x'));
+
+  common::Time period(0, 10000000);
+  common::Time next = common::Time::GetWallTime();
+  for (unsigned int i = 0; i < kImageCount; ++i)
+  {
+    msgs::Set(msg.mutable_time(), common::Time::GetWallTime());
+    _pub->Publish(msg);
+
+    next += period;
+    common::Time remaining = next - common::Time::GetWallTime();
+    if (remaining > common::Time::Zero)
+      common::Time::Sleep(remaining);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the results of a subscriber process.
+/// \param[in] _fd Read end of the pipe.
+/// \param[in] _name Name of the transport.
+/// \return The results, zeroed on error.
+ShmResult ReadResult(const int _fd, const std::string &_name)
+{
+  ShmResult result = {};
+  if (read(_fd, &result, sizeof(result)) != sizeof(result))
+    gzerr << "Unable to read the " << _name << " results\n";
+
+  gzdbg << _name << ": received [" << result.count << "/" << kImageCount
+        << "] images over [" << result.rings << "] rings, latency mean ["
+        << result.mean << " ms] p99 [" << result.p99 << " ms], ["
+        << result.rate << " MB/s]\n";
+  return result;
+}
+
+/////////////////////////////////////////////////
+// Compare the latency and throughput of 1 MB images published at 100 Hz
+// to a subscriber in another process, over TCP and over shared memory.
+TEST(TransportShmTest, Images)
+{
+  int tcpPipe[2];
+  int shmPipe[2];
+  ASSERT_EQ(pipe(tcpPipe), 0);
+  ASSERT_EQ(pipe(shmPipe), 0);
+
+  // Fork the subscribers before any thread is started
+  pid_t tcpPid = fork();
+  ASSERT_GE(tcpPid, 0);
+  if (tcpPid == 0)
+    RunSubscriber("/gazebo/test/images_tcp", "0", tcpPipe[1]);
+
+  pid_t shmPid = fork();
+  ASSERT_GE(shmPid, 0);
+  if (shmPid == 0)
+    RunSubscriber("/gazebo/test/images_shm", "1", shmPipe[1]);
+
+  // The parent runs the master and publishes
+  const char *argv = "TransportShmTest";
+  ASSERT_TRUE(gazebo::setupServer(1, const_cast<char **>(&argv)));
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+
+  transport::PublisherPtr tcpPub =
+    node->Advertise<msgs::ImageStamped>("/gazebo/test/images_tcp", 10);
+  transport::PublisherPtr shmPub =
+    node->Advertise<msgs::ImageStamped>("/gazebo/test/images_shm", 10);
+  tcpPub->WaitForConnection();
+  shmPub->WaitForConnection();
+
+  PublishImages(tcpPub);
+  ShmResult tcp = ReadResult(tcpPipe[0], "TCP");
+
+  PublishImages(shmPub);
+  ShmResult shm = ReadResult(shmPipe[0], "Shared memory");
+
+  kill(tcpPid, SIGKILL);
+  kill(shmPid, SIGKILL);
+  waitpid(tcpPid, nullptr, 0);
+  waitpid(shmPid, nullptr, 0);
+  gazebo::shutdown();
+
+  EXPECT_EQ(tcp.rings, 0u);
+  EXPECT_EQ(shm.rings, 1u);
+  EXPECT_GE(tcp.count, kImageCount * 9 / 10);
+  EXPECT_GE(shm.count, kImageCount * 9 / 10);
+  EXPECT_LT(shm.mean, tcp.mean);
+}
+
+/////////////////////////////////////////////////
+/// Main
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,7 +15,12 @@
  *
 */
 
+#include <boost/make_shared.hpp>
 #include <boost/thread.hpp>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
 #include "gazebo/test/ServerFixture.hh"
 #include "RAMLibrary.hh"
 
@@ -115,6 +120,79 @@ TEST_F(TransportStressTest, LocalPublish)
   delete [] fakeData;
 }
 
+/////////////////////////////////////////////////
+// Compare publishing large images by reference, which copies each message
+// once, to publishing shared messages, which local subscribers receive
+// as is. Nothing is serialized since there are no remote subscribers.
+TEST_F(TransportStressTest, SharedPublish)
+{
+  Load("worlds/empty.world");
+
+  const unsigned int count = 1000;
+  const std::string topic = "~/test/shared_publish__";
+
+  transport::NodePtr testNode = transport::NodePtr(new transport::Node());
+  testNode->Init("default");
+
+  transport::PublisherPtr pub =
+    testNode->Advertise<msgs::Image>(topic, count);
+  transport::SubscriberPtr sub = testNode->Subscribe(topic, &LocalPublishCB);
+
+  transport::PublicationPtr publication =
+    transport::TopicManager::Instance()->FindPublication(
+        testNode->DecodeTopicName(topic));
+  ASSERT_TRUE(publication != nullptr);
+
+  unsigned int width = 2048;
+  unsigned int height = 2048;
+  std::vector<unsigned char> fakeData(width * height);
+
+  auto fakeMsg = boost::make_shared<msgs::Image>();
+  fakeMsg->set_width(width);
+  fakeMsg->set_height(height);
+  fakeMsg->set_pixel_format(0);
+  fakeMsg->set_step(1);
+  fakeMsg->set_data(fakeData.data(), fakeData.size());
+
+  common::Time copyTime;
+  common::Time sharedTime;
+  for (auto shared : {false, true})
+  {
+    {
+      boost::mutex::scoped_lock lock(g_mutex);
+      g_localPublishCount = 0;
+      g_totalExpectedMsgCount = count;
+    }
+
+    common::Time startTime = common::Time::GetWallTime();
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      if (shared)
+        pub->Publish(fakeMsg);
+      else
+        pub->Publish(*fakeMsg);
+    }
+
+    int waitCount = 0;
+    while (g_localPublishCount < count && waitCount < 50)
+    {
+      common::Time::MSleep(100);
+      waitCount++;
+    }
+    EXPECT_EQ(g_localPublishCount, count);
+
+    common::Time diff = g_localPublishEndTime - startTime;
+    (shared ? sharedTime : copyTime) = diff;
+  }
+
+  EXPECT_EQ(pub->CopyCount(), count);
+  EXPECT_EQ(publication->SerializeCount(), 0u);
+
+  gzmsg << "Time to publish " << count << " images by reference = "
+        << copyTime << ", shared = " << sharedTime << "\n";
+  EXPECT_LT(sharedTime, copyTime);
+}
+
 /////////////////////////////////////////////////
 // Create a lot of nodes, each with a publisher and subscriber. Then send
 // out a few large messages.
@@ -236,6 +314,149 @@ TEST_F(TransportStressTest, ManyNodes)
   delete [] fakeData;
 }
 
+/// \brief Subscriber recording how long messages take to reach it.
+class DispatchSubscriber
+{
+  /// \brief Called for each message.
+  /// \param[in] _msg Message stamped with its publication time, with the
+  /// sequence number as pose id.
+  public: void OnMsg(ConstPoseStampedPtr &_msg)
+  {
+    double latency =
+      (common::Time::GetWallTime() - msgs::Convert(_msg->time())).Double();
+
+    bool inOrder = _msg->pose().id() == this->next;
+    this->next = _msg->pose().id() + 1;
+
+    if (this->delay > 0)
+      common::Time::MSleep(this->delay);
+
+    boost::mutex::scoped_lock lock(g_mutex);
+    this->latencies.push_back(latency * 1000.0);
+    if (!inOrder)
+      this->outOfOrder++;
+  }
+
+  /// \brief Node of the subscriber.
+  public: transport::NodePtr node;
+
+  /// \brief The subscriber.
+  public: transport::SubscriberPtr sub;
+
+  /// \brief Time spent in each callback, in ms.
+  public: unsigned int delay = 0;
+
+  /// \brief Next expected sequence number.
+  public: unsigned int next = 0;
+
+  /// \brief Number of messages received out of order.
+  public: unsigned int outOfOrder = 0;
+
+  /// \brief Latency of each message in ms.
+  public: std::vector<double> latencies;
+};
+
+/////////////////////////////////////////////////
+// Publish on hundreds of topics, each with its own subscriber node, while
+// the subscriber of one more topic is slow. Subscribers are called on the
+// dispatch threads, so the slow one shouldn't delay the others, and each
+// of them receives its messages in order.
+TEST_F(TransportStressTest, DispatchLatency)
+{
+  Load("worlds/empty.world");
+
+  const unsigned int topicCount = 200;
+  const unsigned int rounds = 200;
+  const unsigned int slowDelay = 5;
+
+  transport::NodePtr pubNode(new transport::Node());
+  pubNode->Init("default");
+
+  // The last subscriber is the slow one
+  std::vector<transport::PublisherPtr> pubs;
+  std::vector<std::unique_ptr<DispatchSubscriber>> subs;
+  for (unsigned int i = 0; i <= topicCount; ++i)
+  {
+    std::string topic = "~/test/dispatch_" + std::to_string(i);
+    pubs.push_back(pubNode->Advertise<msgs::PoseStamped>(topic, rounds));
+
+    subs.emplace_back(new DispatchSubscriber());
+    subs.back()->node.reset(new transport::Node());
+    subs.back()->node->Init("default");
+    subs.back()->sub = subs.back()->node->Subscribe(topic,
+        &DispatchSubscriber::OnMsg, subs.back().get());
+  }
+  subs.back()->delay = slowDelay;
+
+  msgs::PoseStamped msg;
+  msgs::Set(msg.mutable_pose(), ignition::math::Pose3d::Zero);
+
+  // Publish all the topics at 100 Hz
+  common::Time period(0, 10000000);
+  common::Time next = common::Time::GetWallTime();
+  for (unsigned int r = 0; r < rounds; ++r)
+  {
+    msg.mutable_pose()->set_id(r);
+    for (auto &pub : pubs)
+    {
+      msgs::Set(msg.mutable_time(), common::Time::GetWallTime());
+      pub->Publish(msg);
+    }
+
+    next += period;
+    common::Time remaining = next - common::Time::GetWallTime();
+    if (remaining > common::Time::Zero)
+      common::Time::Sleep(remaining);
+  }
+
+  // Wait for the slow subscriber, which is the last to finish
+  for (int i = 0; i < 300; ++i)
+  {
+    {
+      boost::mutex::scoped_lock lock(g_mutex);
+      if (subs.back()->latencies.size() >= rounds)
+        break;
+    }
+    common::Time::MSleep(100);
+  }
+
+  std::vector<double> latencies;
+  {
+    boost::mutex::scoped_lock lock(g_mutex);
+    for (unsigned int i = 0; i < topicCount; ++i)
+    {
+      EXPECT_EQ(subs[i]->latencies.size(), rounds);
+      EXPECT_EQ(subs[i]->outOfOrder, 0u);
+      latencies.insert(latencies.end(), subs[i]->latencies.begin(),
+          subs[i]->latencies.end());
+    }
+    EXPECT_EQ(subs.back()->latencies.size(), rounds);
+    EXPECT_EQ(subs.back()->outOfOrder, 0u);
+  }
+  ASSERT_FALSE(latencies.empty());
+
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](const double _p)
+  {
+    return latencies[std::min(latencies.size() - 1,
+        static_cast<size_t>(latencies.size() * _p))];
+  };
+
+  gzmsg << "Dispatch latency of " << latencies.size() << " messages on "
+        << topicCount << " topics, with "
+        << transport::DispatchPool::DefaultThreadCount()
+        << " threads: p50 " << percentile(0.5) << " ms, p90 "
+        << percentile(0.9) << " ms, p99 " << percentile(0.99)
+        << " ms, max " << latencies.back() << " ms\n";
+
+  // With a single thread every subscriber waits for the slow one
+  if (transport::DispatchPool::DefaultThreadCount() > 1)
+    EXPECT_LT(percentile(0.9), slowDelay);
+
+  for (auto &sub : subs)
+    sub->sub.reset();
+}
+
 /////////////////////////////////////////////////
 // Main function
 int main(int argc, char **argv)
@@ -22,6 +22,8 @@
 #endif
 
 #include <stdio.h>
+#include <inttypes.h>
+#include <algorithm>
 #include <signal.h>
 #include <tinyxml.h>
 #include <boost/filesystem.hpp>
@@ -838,7 +840,9 @@ StatsCommand::StatsCommand()
     ("world-name,w", po::value<std::string>(), "World name.")
     ("duration,d", po::value<uint64_t>(), "Duration (seconds) to run.")
     ("plot,p", "Output comma-separated values, useful for processing and "
-     "plotting.");
+     "plotting.")
+    ("plugins", "Print the update time of each plugin instead of the world "
+     "statistics.");
 }
 
 /////////////////////////////////////////////////
@@ -848,6 +852,9 @@ void StatsCommand::HelpDetailed()
     "\tPrint gzserver statics to standard out. If a name for the world, \n"
     "\toption -w, is not specified, the first world found on \n"
     "\tthe Gazebo master will be used.\n"
+    "\tWith --plugins, print the wall time spent in the update callbacks\n"
+    "\tof each plugin, slowest first. Set GAZEBO_PLUGIN_BUDGET_MS when\n"
+    "\tstarting gzserver to count callbacks over a budget.\n"
     << std::endl;
 }
 
@@ -862,8 +869,18 @@ bool StatsCommand::RunImpl()
   transport::NodePtr node(new transport::Node());
   node->Init(worldName);
 
-  transport::SubscriberPtr sub =
-    node->Subscribe("~/world_stats", &StatsCommand::CB, this);
+  this->plotHeaderPrinted = false;
+
+  transport::SubscriberPtr sub;
+  if (this->vm.count("plugins"))
+  {
+    sub = node->Subscribe("~/plugin_stats", &StatsCommand::OnPluginStats,
+        this);
+  }
+  else
+  {
+    sub = node->Subscribe("~/world_stats", &StatsCommand::CB, this);
+  }
 
   boost::mutex::scoped_lock lock(this->sigMutex);
   if (this->vm.count("duration"))
@@ -924,12 +941,11 @@ void StatsCommand::CB(ConstWorldStatisticsPtr &_msg)
 
   if (this->vm.count("plot"))
   {
-    static bool first = true;
-    if (first)
+    if (!this->plotHeaderPrinted)
     {
       std::cout << "# real-time factor (percent), simtime (sec), "
         << "realtime (sec), paused (T or F)\n";
-      first = false;
+      this->plotHeaderPrinted = true;
     }
     printf("%4.2f, %16.6f, %16.6f, %c\n",
         percent, simTime.Double(), realTime.Double(), paused);
@@ -940,6 +956,77 @@ void StatsCommand::CB(ConstWorldStatisticsPtr &_msg)
         percent, simTime.Double(), realTime.Double(), paused);
 }
 
+/////////////////////////////////////////////////
+void StatsCommand::OnPluginStats(ConstPluginStatisticsPtr &_msg)
+{
+  GZ_ASSERT(_msg, "Invalid message received");
+
+  // Slowest plugins first
+  std::vector<const msgs::PluginStatistics::PluginTime *> plugins;
+  for (int i = 0; i < _msg->plugin_size(); ++i)
+    plugins.push_back(&_msg->plugin(i));
+  std::sort(plugins.begin(), plugins.end(),
+      [](const msgs::PluginStatistics::PluginTime *_a,
+         const msgs::PluginStatistics::PluginTime *_b)
+      {
+        return msgs::Convert(_a->total()) > msgs::Convert(_b->total());
+      });
+
+  double simTime = msgs::Convert(_msg->sim_time()).Double();
+
+  if (this->vm.count("plot"))
+  {
+    if (!this->plotHeaderPrinted)
+    {
+      std::cout << "# simtime (sec), plugin, count, mean (ms), p95 (ms), "
+        << "max (ms), over budget\n";
+      this->plotHeaderPrinted = true;
+    }
+  }
+  else
+  {
+    printf("SimTime[%4.2f]", simTime);
+    if (_msg->has_budget())
+      printf(" Budget[%4.3f ms]", msgs::Convert(_msg->budget()).Double() * 1e3);
+    printf("\n%-48s %10s %10s %10s %10s %10s\n", "Plugin", "Count",
+        "Mean(ms)", "P95(ms)", "Max(ms)", "OverBudget");
+  }
+
+  for (auto const &plugin : plugins)
+  {
+    double total = msgs::Convert(plugin->total()).Double();
+    double mean = plugin->count() > 0 ? total / plugin->count() : 0.0;
+    double max = msgs::Convert(plugin->max()).Double();
+
+    // Upper bound of the bucket which holds the 95th percentile
+    double p95 = 0;
+    uint64_t seen = 0;
+    for (int b = 0; b < plugin->histogram_size(); ++b)
+    {
+      seen += plugin->histogram(b);
+      if (seen >= 0.95 * plugin->count())
+      {
+        p95 = std::min(common::PluginTimeStats::BucketUpperBound(b), max);
+        break;
+      }
+    }
+
+    if (this->vm.count("plot"))
+    {
+      printf("%16.6f, %s, %" PRIu64 ", %f, %f, %f, %" PRIu64 "\n", simTime,
+          plugin->name().c_str(), plugin->count(), mean * 1e3, p95 * 1e3,
+          max * 1e3, plugin->over_budget());
+    }
+    else
+    {
+      printf("%-48s %10" PRIu64 " %10.3f %10.3f %10.3f %10" PRIu64 "\n",
+          plugin->name().c_str(), plugin->count(), mean * 1e3, p95 * 1e3,
+          max * 1e3, plugin->over_budget());
+    }
+  }
+  fflush(stdout);
+}
+
 /////////////////////////////////////////////////
 SDFCommand::SDFCommand()
   : Command("sdf",
@@ -195,11 +195,18 @@ namespace gazebo
     /// \param[in] _msg World statistics message.
     private: void CB(ConstWorldStatisticsPtr &_msg);
 
+    /// \brief Plugin statistics callback.
+    /// \param[in] _msg Plugin update time statistics message.
+    private: void OnPluginStats(ConstPluginStatisticsPtr &_msg);
+
     /// \brief Sim time buffer
     private: std::list<common::Time> simTimes;
 
     /// \brief Real time buffer
     private: std::list<common::Time> realTimes;
+
+    /// \brief True once the header of the plot output was printed.
+    private: bool plotHeaderPrinted = false;
   };
 
   /// \brief SDF command
@@ -59,11 +59,13 @@ TopicCommand::TopicCommand()
      "View topic data using a QT widget.")
     ("hz,z", po::value<std::string>(), "Get publish frequency.")
     ("bw,b", po::value<std::string>(), "Get topic bandwidth.")
+    ("stats,s", "Get transport statistics of every topic, such as rates, "
+     "queue depths and latencies.")
     ("publish,p", po::value<std::string>(), "Publish message on a topic.")
     ("request,r", po::value<std::string>(), "Send a request.")
     ("unformatted,u", "Output data from echo without formatting.")
     ("duration,d", po::value<uint64_t>(), "Duration (seconds) to run. "
-     "Applicable with echo, hz, and bw")
+     "Applicable with echo, hz, bw, and stats")
     ("msg,m", po::value<std::string>(), "Message to send on topic. "
      "Applicable with publish and request")
     ("file,f", po::value<std::string>(), "Path to a file containing the "
@@ -103,6 +105,8 @@ bool TopicCommand::RunImpl()
     this->Hz(this->vm["hz"].as<std::string>());
   else if (this->vm.count("bw"))
     this->Bw(this->vm["bw"].as<std::string>());
+  else if (this->vm.count("stats"))
+    this->Stats();
   else if (this->vm.count("view"))
     this->View(this->vm["view"].as<std::string>());
   else if (this->vm.count("publish"))
@@ -354,6 +358,54 @@ void TopicCommand::Bw(const std::string &_topic)
     this->sigCondition.wait(lock);
 }
 
+/////////////////////////////////////////////////
+void TopicCommand::StatsCB(ConstTransportStatisticsPtr &_msg)
+{
+  if (_msg->topic_size() == 0)
+    return;
+
+  std::cout << "Process[" << _msg->process() << "] "
+    << "Period[" << std::fixed << std::setprecision(2) << _msg->period()
+    << " s]\n";
+
+  printf("  %-40s %9s %11s %9s %11s %6s %6s %9s %9s %9s %9s\n",
+      "Topic", "Pub Hz", "Send KB/s", "Recv Hz", "Recv KB/s", "Queue",
+      "Drops", "Ser us", "Parse us", "Lat ms", "Max ms");
+
+  for (auto const &topic : _msg->topic())
+  {
+    printf("  %-40s %9.2f %11.2f %9.2f %11.2f %6u %6llu %9.2f %9.2f "
+        "%9.3f %9.3f\n",
+        topic.topic().c_str(),
+        topic.publish_rate(),
+        topic.send_bandwidth() / 1024.0,
+        topic.receive_rate(),
+        topic.receive_bandwidth() / 1024.0,
+        topic.queue_high_water(),
+        static_cast<unsigned long long>(topic.dropped()),
+        topic.serialize_time() * 1e6,
+        topic.parse_time() * 1e6,
+        topic.latency() * 1e3,
+        topic.max_latency() * 1e3);
+  }
+  std::cout << std::endl;
+}
+
+/////////////////////////////////////////////////
+void TopicCommand::Stats()
+{
+  transport::SubscriberPtr sub = this->node->Subscribe(
+      transport::TransportStatistics::TopicName, &TopicCommand::StatsCB,
+      this);
+
+  boost::mutex::scoped_lock lock(this->sigMutex);
+  if (this->vm.count("duration"))
+    this->sigCondition.timed_wait(lock,
+        boost::posix_time::seconds(this->vm["duration"].as<uint64_t>()));
+  else
+    this->sigCondition.wait(lock);
+}
+
 /////////////////////////////////////////////////
 void TopicCommand::View(const std::string &_topic)
 {
@@ -72,6 +72,13 @@ namespace gazebo
     /// \param[in] _topic Topic name.
     private: void Bw(const std::string &_topic);
 
+    /// \brief Subscription callback used by Stats().
+    /// \param[in] _msg Transport statistics of one process.
+    private: void StatsCB(ConstTransportStatisticsPtr &_msg);
+
+    /// \brief Output the transport statistics of every process.
+    private: void Stats();
+
     /// \brief View topic information using QT.
     /// \param[in] _topic Name of the topic to view. Empty will bring up
     /// a topic selector.